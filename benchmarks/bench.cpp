@@ -0,0 +1,125 @@
+// Microbenchmarks of nanobind's binding overheads, see 'run_benchmarks.py'
+
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/trampoline.h>
+#include <nanobind/stl/map.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+#include <utility>
+
+namespace nb = nanobind;
+using namespace nb::literals;
+
+struct Point {
+    double x, y;
+};
+
+struct Source { int value; };
+struct Target {
+    Target(const Source &s) : value(s.value) { }
+    int value;
+};
+
+/// Distinct argument types that make overload resolution try every entry
+template <size_t I> struct Tag { };
+
+struct Base {
+    virtual ~Base() = default;
+    virtual int f(int x) const { return x; }
+};
+
+struct PyBase : Base {
+    NB_TRAMPOLINE(Base, 1);
+    int f(int x) const override { NB_OVERRIDE(f, x); }
+};
+
+/// Many small functions to make module import time measurable
+template <size_t... Is>
+void bind_many(nb::module_ &m, std::index_sequence<Is...>) {
+    static char names[sizeof...(Is)][16];
+    (snprintf(names[Is], sizeof(names[Is]), "f_%zu", Is), ...);
+    (m.def(names[Is], [](int x) { return x + (int) Is; }, "x"_a), ...);
+}
+
+template <size_t... Is>
+void bind_overloads(nb::module_ &m, std::index_sequence<Is...>) {
+    static char names[sizeof...(Is)][16];
+    (snprintf(names[Is], sizeof(names[Is]), "Tag%zu", Is), ...);
+    (nb::class_<Tag<Is>>(m, names[Is]).def(nb::init<>()), ...);
+    (m.def("overloaded", [](Tag<Is>) { return (int) Is; }), ...);
+    m.def("overloaded", [](int x) { return x; });
+}
+
+NB_MODULE(bench_ext, m) {
+    m.attr("nb_version") = nb::make_tuple(NB_VERSION_MAJOR, NB_VERSION_MINOR,
+                                          NB_VERSION_PATCH);
+
+    // Function calls
+    m.def("call_0", []() { });
+    m.def("call_3", [](int a, int b, int c) { return a + b + c; });
+    m.def("call_kw", [](int a, int b, int c) { return a + b + c; },
+          "a"_a, "b"_a, "c"_a);
+    m.def("call_kw_defaults", [](int a, int b, int c) { return a + b + c; },
+          "a"_a, "b"_a = 2, "c"_a = 3);
+
+    // Overload fan-out: 8 overloads are rejected before the last one matches
+    bind_overloads(m, std::make_index_sequence<8>());
+
+    // nb_type_put() and nb_type_get() round trips
+    nb::class_<Point>(m, "Point")
+        .def(nb::init<double, double>())
+        .def_rw("x", &Point::x)
+        .def_rw("y", &Point::y);
+
+    m.def("point_new", []() { return Point{ 1.0, 2.0 }; });
+    m.def("point_x", [](const Point &p) { return p.x; });
+    m.def("point_ref", [](Point &p) -> Point & { return p; },
+          nb::rv_policy::reference);
+
+    // Implicit conversions
+    nb::class_<Source>(m, "Source")
+        .def(nb::init<int>());
+    nb::class_<Target>(m, "Target")
+        .def(nb::init_implicit<const Source &>());
+    m.def("target_value", [](const Target &t) { return t.value; });
+    m.def("float_value", [](double d) { return d; });
+
+    // ndarray_import() from NumPy, PyTorch, etc.
+    m.def("ndarray_first",
+          [](nb::ndarray<const float, nb::ndim<1>, nb::device::cpu> a) {
+              return a.shape(0) ? a(0) : 0.f;
+          });
+
+    // STL casters
+    m.def("list_sum", [](const std::vector<int> &v) {
+        int sum = 0;
+        for (int i : v)
+            sum += i;
+        return sum;
+    });
+    m.def("list_new", [](size_t n) { return std::vector<int>(n, 1); });
+    m.def("map_size", [](const std::map<std::string, int> &d) {
+        return d.size();
+    });
+    m.def("map_new", [](size_t n) {
+        std::map<std::string, int> d;
+        for (size_t i = 0; i < n; ++i)
+            d[std::to_string(i)] = (int) i;
+        return d;
+    });
+
+    // Virtual calls from C++ into a Python override
+    nb::class_<Base, PyBase>(m, "Base")
+        .def(nb::init<>())
+        .def("f", &Base::f);
+    m.def("call_virtual", [](const Base &b, int n) {
+        int sum = 0;
+        for (int i = 0; i < n; ++i)
+            sum += b.f(i);
+        return sum;
+    });
+
+    nb::module_ many = m.def_submodule("many");
+    bind_many(many, std::make_index_sequence<256>());
+}
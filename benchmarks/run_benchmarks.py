@@ -0,0 +1,152 @@
+"""
+Microbenchmarks of nanobind's binding overheads.
+
+Each benchmark reports the best time per operation (in nanoseconds) over
+several repetitions. The results are written as JSON, so that they can be
+recorded and compared across nanobind versions:
+
+    python run_benchmarks.py --output results.json
+"""
+
+import argparse
+import json
+import os
+import platform
+import subprocess
+import sys
+import timeit
+
+import bench_ext as b
+
+
+def bench_calls():
+    yield 'call_0', b.call_0, ()
+    yield 'call_3', b.call_3, (1, 2, 3)
+    yield 'call_kw', lambda: b.call_kw(1, b=2, c=3), ()
+    yield 'call_kw_all', lambda: b.call_kw(a=1, b=2, c=3), ()
+    yield 'call_kw_defaults', b.call_kw_defaults, (1,)
+    yield 'overload_fanout', b.overloaded, (1,)
+    yield 'overload_first', b.overloaded, (b.Tag0(),)
+
+
+def bench_types():
+    p = b.Point(1.0, 2.0)
+    yield 'type_put_move', b.point_new, ()
+    yield 'type_get', b.point_x, (p,)
+    yield 'type_put_get_reference', b.point_ref, (p,)
+    yield 'implicit_conversion_class', b.target_value, (b.Source(1),)
+    yield 'implicit_conversion_int_float', b.float_value, (1,)
+
+
+def bench_ndarray():
+    try:
+        import numpy as np
+        yield 'ndarray_import_numpy', b.ndarray_first, \
+            (np.ones(16, dtype=np.float32),)
+    except ImportError:
+        pass
+
+    try:
+        import torch
+        yield 'ndarray_import_torch', b.ndarray_first, \
+            (torch.ones(16, dtype=torch.float32),)
+    except ImportError:
+        pass
+
+
+def bench_stl():
+    for n in (10, 1000):
+        lst, dct = [1] * n, {str(i): i for i in range(n)}
+        yield f'stl_list_from_python_{n}', b.list_sum, (lst,)
+        yield f'stl_list_to_python_{n}', b.list_new, (n,)
+        yield f'stl_map_from_python_{n}', b.map_size, (dct,)
+        yield f'stl_map_to_python_{n}', b.map_new, (n,)
+
+
+def bench_trampoline():
+    class Derived(b.Base):
+        def f(self, x):
+            return x
+
+    n = 100
+    d = Derived()
+    yield 'trampoline_virtual_call', lambda: b.call_virtual(d, n), (), n
+
+
+def time_op(fn, args, ops, repeat, budget):
+    stmt = (lambda: fn(*args)) if args else fn
+    timer = timeit.Timer(stmt)
+
+    # Calibrate the number of loops so that a repetition takes ~'budget' seconds
+    loops = 1
+    while True:
+        if timer.timeit(loops) >= budget or loops >= 1 << 24:
+            break
+        loops *= 4
+
+    best = min(timer.repeat(repeat=repeat, number=loops))
+    return best / (loops * ops) * 1e9, loops
+
+
+def time_import(repeat):
+    """Import time of the extension in a fresh interpreter (in seconds)."""
+    code = ('import time; t = time.perf_counter(); import bench_ext; '
+            'print(time.perf_counter() - t)')
+    env = dict(os.environ)
+    path = os.path.dirname(os.path.abspath(b.__file__))
+    env['PYTHONPATH'] = os.pathsep.join(filter(None, (path, env.get('PYTHONPATH'))))
+    times = []
+    for _ in range(repeat):
+        out = subprocess.check_output([sys.executable, '-c', code], env=env)
+        times.append(float(out))
+    return min(times)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[1])
+    parser.add_argument('-o', '--output', help='output file (default: stdout)')
+    parser.add_argument('-r', '--repeat', type=int, default=5,
+                        help='number of repetitions per benchmark')
+    parser.add_argument('-b', '--budget', type=float, default=0.05,
+                        help='minimum duration of a repetition in seconds')
+    parser.add_argument('-k', '--filter', default='',
+                        help='only run benchmarks whose name contains this string')
+    args = parser.parse_args()
+
+    results = []
+    for group in (bench_calls, bench_types, bench_ndarray, bench_stl,
+                  bench_trampoline):
+        for name, fn, fn_args, *ops in group():
+            if args.filter not in name:
+                continue
+            ns, loops = time_op(fn, fn_args, ops[0] if ops else 1,
+                                args.repeat, args.budget)
+            results.append({'name': name, 'unit': 'ns', 'value': ns,
+                            'loops': loops, 'repeat': args.repeat})
+            print(f'{name:40} {ns:10.1f} ns', file=sys.stderr)
+
+    if args.filter in 'module_import':
+        t = time_import(args.repeat)
+        results.append({'name': 'module_import', 'unit': 'ms',
+                        'value': t * 1e3, 'loops': 1, 'repeat': args.repeat})
+        print(f'{"module_import":40} {t * 1e3:10.2f} ms', file=sys.stderr)
+
+    report = {
+        'nanobind': '.'.join(str(v) for v in b.nb_version),
+        'python': platform.python_version(),
+        'implementation': platform.python_implementation(),
+        'platform': platform.platform(),
+        'machine': platform.machine(),
+        'results': results
+    }
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(report, f, indent=2)
+    else:
+        json.dump(report, sys.stdout, indent=2)
+        print()
+
+
+if __name__ == '__main__':
+    main()
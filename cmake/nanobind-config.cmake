@@ -63,6 +63,22 @@ endif()
 set(NB_SUFFIX   ${NB_SUFFIX}   CACHE INTERNAL "")
 set(NB_SUFFIX_S ${NB_SUFFIX_S} CACHE INTERNAL "")
 
+# Check whether the interpreter was built without the GIL (PEP 703)
+if(NOT DEFINED NB_PYTHON_FREE_THREADED)
+  execute_process(
+    COMMAND "${Python_EXECUTABLE}" "-c"
+      "import sysconfig; print(sysconfig.get_config_var('Py_GIL_DISABLED') or 0)"
+    RESULT_VARIABLE NB_FT_RET
+    OUTPUT_VARIABLE NB_FT_OUT
+    OUTPUT_STRIP_TRAILING_WHITESPACE)
+
+  if(NB_FT_RET EQUAL 0 AND NB_FT_OUT STREQUAL "1")
+    set(NB_PYTHON_FREE_THREADED TRUE CACHE INTERNAL "")
+  else()
+    set(NB_PYTHON_FREE_THREADED FALSE CACHE INTERNAL "")
+  endif()
+endif()
+
 get_filename_component(NB_DIR "${CMAKE_CURRENT_LIST_FILE}" PATH)
 get_filename_component(NB_DIR "${NB_DIR}" PATH)
 
@@ -121,7 +137,12 @@ function (nanobind_build_library TARGET_NAME)
     ${NB_DIR}/include/nanobind/nb_tuple.h
     ${NB_DIR}/include/nanobind/nb_types.h
     ${NB_DIR}/include/nanobind/ndarray.h
+    ${NB_DIR}/include/nanobind/ndarray_chunks.h
     ${NB_DIR}/include/nanobind/trampoline.h
+    ${NB_DIR}/include/nanobind/vectorize.h
+    ${NB_DIR}/include/nanobind/callback_queue.h
+    ${NB_DIR}/include/nanobind/generator.h
+    ${NB_DIR}/include/nanobind/sequence_view.h
     ${NB_DIR}/include/nanobind/operators.h
     ${NB_DIR}/include/nanobind/stl/array.h
     ${NB_DIR}/include/nanobind/stl/bind_map.h
@@ -134,6 +155,7 @@ function (nanobind_build_library TARGET_NAME)
     ${NB_DIR}/include/nanobind/stl/detail/traits.h
     ${NB_DIR}/include/nanobind/stl/filesystem.h
     ${NB_DIR}/include/nanobind/stl/function.h
+    ${NB_DIR}/include/nanobind/stl/future.h
     ${NB_DIR}/include/nanobind/stl/list.h
     ${NB_DIR}/include/nanobind/stl/map.h
     ${NB_DIR}/include/nanobind/stl/optional.h
@@ -153,12 +175,18 @@ function (nanobind_build_library TARGET_NAME)
 
     ${NB_DIR}/src/buffer.h
     ${NB_DIR}/src/hash.h
+    ${NB_DIR}/src/nb_inst_map.h
     ${NB_DIR}/src/nb_internals.h
     ${NB_DIR}/src/nb_internals.cpp
     ${NB_DIR}/src/nb_func.cpp
     ${NB_DIR}/src/nb_type.cpp
     ${NB_DIR}/src/nb_enum.cpp
     ${NB_DIR}/src/nb_ndarray.cpp
+    ${NB_DIR}/src/nb_future.cpp
+    ${NB_DIR}/src/nb_pickle.cpp
+    ${NB_DIR}/src/nb_member.cpp
+    ${NB_DIR}/src/nb_mmap.cpp
+    ${NB_DIR}/src/nb_arrow.cpp
     ${NB_DIR}/src/nb_static_property.cpp
     ${NB_DIR}/src/common.cpp
     ${NB_DIR}/src/error.cpp
@@ -286,7 +314,7 @@ endfunction()
 
 function(nanobind_add_module name)
   cmake_parse_arguments(PARSE_ARGV 1 ARG
-    "STABLE_ABI;NB_STATIC;NB_SHARED;PROTECT_STACK;LTO;NOMINSIZE;NOSTRIP;MUSL_DYNAMIC_LIBCPP"
+    "STABLE_ABI;FREE_THREADED;SUBINTERPRETERS;TYPE_STATS;NB_STATIC;NB_SHARED;PROTECT_STACK;LTO;NOMINSIZE;NOSTRIP;MUSL_DYNAMIC_LIBCPP"
     "NB_DOMAIN" "")
 
   add_library(${name} MODULE ${ARG_UNPARSED_ARGUMENTS})
@@ -308,6 +336,22 @@ function(nanobind_add_module name)
     set(ARG_STABLE_ABI FALSE)
   endif()
 
+  # Free-threaded builds require a free-threaded interpreter and do not
+  # support the stable ABI
+  if (NOT NB_PYTHON_FREE_THREADED)
+    set(ARG_FREE_THREADED FALSE)
+  endif()
+
+  # Per-interpreter internals require CPython >= 3.12
+  if ((Python_VERSION VERSION_LESS 3.12) OR
+      (NOT Python_INTERPRETER_ID STREQUAL "Python"))
+    set(ARG_SUBINTERPRETERS FALSE)
+  endif()
+
+  if (ARG_FREE_THREADED OR ARG_SUBINTERPRETERS)
+    set(ARG_STABLE_ABI FALSE)
+  endif()
+
   set(libname "nanobind")
   if (ARG_NB_STATIC)
     set(libname "${libname}-static")
@@ -317,6 +361,18 @@ function(nanobind_add_module name)
     set(libname "${libname}-abi3")
   endif()
 
+  if (ARG_FREE_THREADED)
+    set(libname "${libname}-ft")
+  endif()
+
+  if (ARG_SUBINTERPRETERS)
+    set(libname "${libname}-si")
+  endif()
+
+  if (ARG_TYPE_STATS)
+    set(libname "${libname}-stats")
+  endif()
+
   if (ARG_NB_DOMAIN AND ARG_NB_SHARED)
     set(libname ${libname}-${ARG_NB_DOMAIN})
   endif()
@@ -327,6 +383,18 @@ function(nanobind_add_module name)
     target_compile_definitions(${name} PRIVATE NB_DOMAIN=${ARG_NB_DOMAIN})
   endif()
 
+  if (ARG_FREE_THREADED)
+    target_compile_definitions(${libname} PUBLIC NB_FREE_THREADED)
+  endif()
+
+  if (ARG_SUBINTERPRETERS)
+    target_compile_definitions(${libname} PUBLIC NB_SUBINTERPRETERS)
+  endif()
+
+  if (ARG_TYPE_STATS)
+    target_compile_definitions(${libname} PUBLIC NB_TYPE_STATS)
+  endif()
+
   if (ARG_STABLE_ABI)
     target_compile_definitions(${libname} PUBLIC -DPy_LIMITED_API=0x030C0000)
     nanobind_extension_abi3(${name})
@@ -0,0 +1,333 @@
+/*
+    nanobind/arrow.h: zero-copy exchange of columnar data through the
+    Apache Arrow C data interface
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/ndarray.h>
+
+/* ABI-stable structures of the Arrow C data and stream interfaces. These
+   are guarded by the macros prescribed by the specification so that other
+   headers providing the same definitions can coexist with this one. */
+
+#if !defined(ARROW_C_DATA_INTERFACE)
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+    void (*release)(struct ArrowSchema *);
+    void *private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+    void (*release)(struct ArrowArray *);
+    void *private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
+#if !defined(ARROW_C_STREAM_INTERFACE)
+#define ARROW_C_STREAM_INTERFACE
+
+extern "C" {
+
+struct ArrowArrayStream {
+    int (*get_schema)(struct ArrowArrayStream *, struct ArrowSchema *out);
+    int (*get_next)(struct ArrowArrayStream *, struct ArrowArray *out);
+    const char *(*get_last_error)(struct ArrowArrayStream *);
+    void (*release)(struct ArrowArrayStream *);
+    void *private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_STREAM_INTERFACE
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// Schema and array moved out of an ``"arrow_schema"``/``"arrow_array"`` pair
+struct arrow_data {
+    ArrowSchema schema;
+    ArrowArray array;
+};
+
+/// Map the Arrow format string of a fixed-width primitive type to a dtype
+inline bool arrow_dtype(const char *format, dlpack::dtype &dt) {
+    if (!format || !format[0] || format[1])
+        return false;
+
+    uint8_t code = (uint8_t) dlpack::dtype_code::Int, bits;
+    switch (format[0]) {
+        case 'c': bits = 8; break;
+        case 's': bits = 16; break;
+        case 'i': bits = 32; break;
+        case 'l': bits = 64; break;
+        case 'C': bits = 8; code = (uint8_t) dlpack::dtype_code::UInt; break;
+        case 'S': bits = 16; code = (uint8_t) dlpack::dtype_code::UInt; break;
+        case 'I': bits = 32; code = (uint8_t) dlpack::dtype_code::UInt; break;
+        case 'L': bits = 64; code = (uint8_t) dlpack::dtype_code::UInt; break;
+        case 'e': bits = 16; code = (uint8_t) dlpack::dtype_code::Float; break;
+        case 'f': bits = 32; code = (uint8_t) dlpack::dtype_code::Float; break;
+        case 'g': bits = 64; code = (uint8_t) dlpack::dtype_code::Float; break;
+        default: return false;
+    }
+
+    dt = dlpack::dtype{ code, bits, 1 };
+    return true;
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Read-only view of an array imported through the Arrow C data
+ * interface
+ *
+ * The view keeps the producer's buffers alive until the last copy of it (and
+ * of any child or ndarray obtained from it) has expired.
+ */
+class arrow_array {
+public:
+    arrow_array() = default;
+
+    /// Wrap a capsule returned by ``detail::arrow_import()``
+    explicit arrow_array(capsule owner) : m_owner(std::move(owner)) {
+        detail::arrow_data *d = (detail::arrow_data *) m_owner.data();
+        m_schema = &d->schema;
+        m_array = &d->array;
+    }
+
+    bool is_valid() const { return m_array != nullptr; }
+
+    /// Arrow format string, e.g. ``"l"`` for ``int64`` or ``"+s"`` for structs
+    const char *format() const { return m_schema->format; }
+
+    /// Field name (may be empty or ``nullptr``)
+    const char *name() const { return m_schema->name; }
+
+    /// Number of entries
+    size_t size() const { return (size_t) m_array->length; }
+
+    /// Number of null entries, or ``-1`` when the producer did not compute it
+    int64_t null_count() const { return m_array->null_count; }
+
+    /// Offset of the first entry within the buffers (in entries)
+    int64_t offset() const { return m_array->offset; }
+
+    size_t n_buffers() const { return (size_t) m_array->n_buffers; }
+    size_t n_children() const { return (size_t) m_array->n_children; }
+
+    /// Return the i-th raw buffer (the validity bitmap is buffer 0)
+    const void *buffer(size_t i) const {
+        if (i >= n_buffers())
+            detail::raise("nanobind::arrow_array::buffer(): index %zu is out "
+                          "of bounds!", i);
+        return m_array->buffers[i];
+    }
+
+    /// Return the i-th child array (e.g. a column of a record batch)
+    arrow_array child(size_t i) const {
+        if (i >= n_children())
+            detail::raise("nanobind::arrow_array::child(): index %zu is out "
+                          "of bounds!", i);
+        return arrow_array(m_owner, m_schema->children[i],
+                           m_array->children[i]);
+    }
+
+    /**
+     * \brief Validity bitmap (one bit per entry, LSB first, starting at bit
+     * ``offset()``), or ``nullptr`` if all entries are valid
+     */
+    const uint8_t *validity() const {
+        return n_buffers() > 0 ? (const uint8_t *) m_array->buffers[0]
+                               : nullptr;
+    }
+
+    /// Check whether the i-th entry is null
+    bool is_null(size_t i) const {
+        const uint8_t *bitmap = validity();
+        if (!bitmap || m_array->null_count == 0)
+            return false;
+        uint64_t bit = (uint64_t) m_array->offset + i;
+        return ((bitmap[bit >> 3] >> (bit & 7)) & 1) == 0;
+    }
+
+    /**
+     * \brief Zero-copy ndarray view of the values of a fixed-width primitive
+     * array. Raises an exception when ``T`` does not match ``format()``.
+     */
+    template <typename T>
+    ndarray<const T, ndim<1>, device::cpu> values() const {
+        dlpack::dtype dt;
+        if (!detail::arrow_dtype(format(), dt) || dt != dtype<T>() ||
+            m_array->n_buffers != 2)
+            detail::raise("nanobind::arrow_array::values(): Arrow format "
+                          "\"%s\" is incompatible with the requested scalar "
+                          "type!", format());
+
+        const T *data = (const T *) m_array->buffers[1];
+        if (data)
+            data += m_array->offset;
+
+        size_t shape = size();
+        return ndarray<const T, ndim<1>, device::cpu>(data, 1, &shape,
+                                                      m_owner);
+    }
+
+    const ArrowSchema &schema() const { return *m_schema; }
+    const ArrowArray &array() const { return *m_array; }
+
+    /// Python object owning the imported buffers (shared by all children)
+    handle owner() const { return m_owner; }
+
+private:
+    arrow_array(capsule owner, const ArrowSchema *schema,
+                const ArrowArray *array)
+        : m_owner(std::move(owner)), m_schema(schema), m_array(array) { }
+
+private:
+    capsule m_owner;
+    const ArrowSchema *m_schema = nullptr;
+    const ArrowArray *m_array = nullptr;
+};
+
+/// Sequence of arrays imported through the Arrow C stream interface
+class arrow_stream {
+public:
+    arrow_stream() = default;
+
+    /// Wrap a capsule returned by ``detail::arrow_stream_import()``
+    explicit arrow_stream(capsule owner) : m_owner(std::move(owner)) { }
+
+    bool is_valid() const { return m_owner.is_valid(); }
+
+    /// Fetch the next chunk, or an invalid ``arrow_array`` after the last one
+    arrow_array next() {
+        object o = steal(detail::arrow_stream_next(m_owner.ptr()));
+        if (o.is_none())
+            return arrow_array();
+        return arrow_array(borrow<capsule>(o));
+    }
+
+    /// Python object owning the stream
+    handle owner() const { return m_owner; }
+
+private:
+    capsule m_owner;
+};
+
+/**
+ * \brief Export a contiguous 1D CPU ndarray as an Arrow primitive array
+ *
+ * Returns the ``(schema, array)`` capsule pair expected from an
+ * ``__arrow_c_array__()`` method. The optional ``validity`` bitmap must hold
+ * at least ``(values.size() + 7) / 8`` bytes. Both arrays stay alive until
+ * the consumer releases the exported data.
+ */
+template <typename... Args, typename... Args2>
+tuple arrow_export(const ndarray<Args...> &values,
+                   const ndarray<Args2...> &validity) {
+    bool has_validity = validity.is_valid();
+    if (values.ndim() != 1 || (values.shape(0) > 1 && values.stride(0) != 1) ||
+        values.device_type() != device::cpu::value ||
+        (has_validity &&
+         (validity.ndim() != 1 || validity.nbytes() < (values.size() + 7) / 8 ||
+          validity.device_type() != device::cpu::value)))
+        detail::raise("nanobind::arrow_export(): expected a contiguous 1D CPU "
+                      "array and a matching validity bitmap!");
+
+    object owner = has_validity ? make_tuple(values, validity)
+                                : make_tuple(values);
+
+    dlpack::dtype dt = values.dtype();
+    return steal<tuple>(detail::arrow_export(
+        owner.ptr(), &dt, (int64_t) values.size(),
+        has_validity ? validity.data() : nullptr, values.data()));
+}
+
+template <typename... Args>
+tuple arrow_export(const ndarray<Args...> &values) {
+    return arrow_export(values, ndarray<const uint8_t, ndim<1>>());
+}
+
+NAMESPACE_BEGIN(detail)
+
+template <> struct type_caster<arrow_array> {
+    NB_TYPE_CASTER(arrow_array, const_name("object"))
+
+    bool from_python(handle src, uint8_t, cleanup_list *) noexcept {
+        PyObject *o = arrow_import(src.ptr());
+        if (!o)
+            return false;
+        value = arrow_array(steal<capsule>(o));
+        return true;
+    }
+
+    static handle from_cpp(const arrow_array &value, rv_policy,
+                           cleanup_list *) noexcept {
+        if (!value.is_valid())
+            return none().release();
+
+        // Only top-level arrays can be passed back to Python
+        arrow_data *d = (arrow_data *) PyCapsule_GetPointer(
+            value.owner().ptr(), "nb_arrow");
+        if (&value.array() != &d->array) {
+            PyErr_SetString(PyExc_TypeError,
+                            "nanobind::arrow_array: cannot return a child "
+                            "array to Python!");
+            return handle();
+        }
+
+        return value.owner().inc_ref();
+    }
+};
+
+template <> struct type_caster<arrow_stream> {
+    NB_TYPE_CASTER(arrow_stream, const_name("object"))
+
+    bool from_python(handle src, uint8_t, cleanup_list *) noexcept {
+        PyObject *o = arrow_stream_import(src.ptr());
+        if (!o)
+            return false;
+        value = arrow_stream(steal<capsule>(o));
+        return true;
+    }
+
+    static handle from_cpp(const arrow_stream &value, rv_policy,
+                           cleanup_list *) noexcept {
+        if (!value.is_valid())
+            return none().release();
+        return value.owner().inc_ref();
+    }
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
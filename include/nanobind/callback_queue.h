@@ -0,0 +1,154 @@
+/*
+    nanobind/callback_queue.h: nb::callback_queue<..> to invoke Python
+    callbacks with events produced by C++ threads
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+
+/**
+ * \brief Collect events from arbitrary C++ threads and deliver them to a
+ * Python callable on a thread holding the GIL
+ *
+ * ``push()`` never touches the GIL. The first event of a batch schedules a
+ * flush through the interpreter's pending call mechanism, which invokes the
+ * handler for all events that accumulated in the meantime while acquiring
+ * the GIL only once. In batch mode, the handler receives a single ``list``
+ * of events per flush. Copies of a queue refer to the same set of events.
+ */
+template <typename... Args> class callback_queue {
+    static_assert(sizeof...(Args) > 0,
+                  "nanobind::callback_queue: at least one argument is required!");
+    static_assert((std::is_same_v<Args, std::decay_t<Args>> && ...),
+                  "nanobind::callback_queue: arguments must be value types!");
+    static_assert((!std::is_base_of_v<handle, Args> && ...),
+                  "nanobind::callback_queue: Python objects can't be queued "
+                  "without holding the GIL!");
+
+    using Event = std::tuple<Args...>;
+
+    struct state {
+        std::mutex mutex;
+        std::vector<Event> events;
+        PyObject *handler;
+        bool batch;
+        bool scheduled = false;
+
+        ~state() { decref_deferred(handler); }
+    };
+
+public:
+    /// Create a queue delivering events to ``handler`` (requires the GIL)
+    callback_queue(handle handler, bool batch = false)
+        : m_state(std::make_shared<state>()) {
+        m_state->handler = handler.inc_ref().ptr();
+        m_state->batch = batch;
+    }
+
+    /// Append an event. Can be called from any thread.
+    void push(Args... args) {
+        state &s = *m_state;
+        bool schedule;
+
+        {
+            std::lock_guard<std::mutex> guard(s.mutex);
+            s.events.emplace_back(std::move(args)...);
+            schedule = !s.scheduled;
+            s.scheduled = true;
+        }
+
+        if (!schedule)
+            return;
+
+        std::shared_ptr<state> *payload = new std::shared_ptr<state>(m_state);
+        if (!detail::deferred_schedule(flush_scheduled, payload)) {
+            // Unsupported (subinterpreters): wait for an explicit flush()
+            delete payload;
+            std::lock_guard<std::mutex> guard(s.mutex);
+            s.scheduled = false;
+        }
+    }
+
+    /**
+     * \brief Deliver all pending events right away (requires the GIL)
+     *
+     * Returns the number of delivered events. When the handler raises an
+     * exception, the exception propagates and the remaining events of the
+     * batch are discarded.
+     */
+    size_t flush() { return flush_impl(*m_state); }
+
+    /// Number of events waiting for delivery
+    size_t size() const {
+        std::lock_guard<std::mutex> guard(m_state->mutex);
+        return m_state->events.size();
+    }
+
+    handle handler() const { return m_state->handler; }
+
+private:
+    static size_t flush_impl(state &s) {
+        std::vector<Event> events;
+
+        {
+            std::lock_guard<std::mutex> guard(s.mutex);
+            events.swap(s.events);
+            s.scheduled = false;
+        }
+
+        handle h = s.handler;
+        if (events.empty())
+            return 0;
+
+        if (s.batch) {
+            list l;
+            for (Event &e : events) {
+                if constexpr (sizeof...(Args) == 1)
+                    l.append(std::move(std::get<0>(e)));
+                else
+                    l.append(std::apply(
+                        [](auto &...a) {
+                            return nanobind::make_tuple(std::move(a)...);
+                        }, e));
+            }
+            h(l);
+        } else {
+            for (Event &e : events)
+                std::apply([h](auto &...a) { h(std::move(a)...); }, e);
+        }
+
+        return events.size();
+    }
+
+    // Invoked by the interpreter; errors can only be reported as unraisable
+    static void flush_scheduled(void *p) noexcept {
+        std::shared_ptr<state> *s = (std::shared_ptr<state> *) p;
+
+        try {
+            flush_impl(**s);
+        } catch (python_error &e) {
+            e.discard_as_unraisable((*s)->handler);
+        } catch (const std::exception &e) {
+            PyErr_SetString(PyExc_RuntimeError, e.what());
+            PyErr_WriteUnraisable((*s)->handler);
+        }
+
+        delete s;
+    }
+
+    std::shared_ptr<state> m_state;
+};
+
+NAMESPACE_END(NB_NAMESPACE)
@@ -148,12 +148,11 @@ struct type_caster<T, enable_if_t<is_eigen_plain_v<T> &&
         return true;
     }
 
-    static handle from_cpp(T &&v, rv_policy policy, cleanup_list *cleanup) noexcept {
-        if (policy == rv_policy::automatic ||
-            policy == rv_policy::automatic_reference)
-            policy = rv_policy::move;
-
-        return from_cpp((const T &) v, policy, cleanup);
+    /* Temporaries (including evaluated expression templates) are expiring
+       anyway, so they are always moved into storage owned by the returned
+       array regardless of the requested policy. */
+    static handle from_cpp(T &&v, rv_policy, cleanup_list *cleanup) noexcept {
+        return from_cpp((const T &) v, rv_policy::move, cleanup);
     }
 
     static handle from_cpp(const T &v, rv_policy policy, cleanup_list *cleanup) noexcept {
@@ -181,21 +180,27 @@ struct type_caster<T, enable_if_t<is_eigen_plain_v<T> &&
                 policy = rv_policy::reference;
                 break;
 
-            case rv_policy::move:
-                // Don't bother moving when the data is static or occupies <1KB
-                if ((T::SizeAtCompileTime != Eigen::Dynamic ||
-                     (size_t) v.size() < (1024 / sizeof(Scalar))))
-                    policy = rv_policy::copy;
-                break;
-
             default: // leave policy unchanged
                 break;
         }
 
         object owner;
         if (policy == rv_policy::move) {
-            T *temp = new T(std::move(v));
-            owner = capsule(temp, [](void *p) noexcept { delete (T *) p; });
+            /* Transfer the storage to a heap-allocated instance that the
+               returned array references. This steals the buffer of dynamic
+               matrices, while fixed-size ones are copied once (as with any
+               move of such a matrix). */
+            T *temp = nullptr;
+            try {
+                temp = new T(std::move(const_cast<T &>(v)));
+                owner = capsule(temp, [](void *p) noexcept { delete (T *) p; });
+            } catch (...) {
+                delete temp;
+                PyErr_SetString(PyExc_RuntimeError,
+                                "nanobind: could not transfer Eigen matrix "
+                                "storage to Python!");
+                return handle();
+            }
             ptr = temp->data();
             policy = rv_policy::reference;
         } else if (policy == rv_policy::reference_internal) {
@@ -468,4 +473,29 @@ struct type_caster<Eigen::Ref<T, Options, StrideType>,
 
 NAMESPACE_END(detail)
 
+/**
+ * \brief Resize the Eigen matrix or vector 'out' to the shape of the 1D or 2D
+ * 'array' and copy its entries with the GIL released (see ndarray_copy())
+ */
+template <typename Derived, typename... Args>
+void ndarray_copy(const ndarray<Args...> &array,
+                  Eigen::PlainObjectBase<Derived> &out, size_t threads = 0) {
+    using T = Derived;
+    size_t ndim = array.ndim();
+    if (!array.is_valid() || ndim > 2)
+        detail::raise("nanobind::ndarray_copy(): expected a 1D or 2D array!");
+
+    Eigen::Index rows = ndim > 0 ? (Eigen::Index) array.shape(0) : 1,
+                 cols = ndim > 1 ? (Eigen::Index) array.shape(1) : 1;
+    if (ndim == 1 && T::RowsAtCompileTime == 1)
+        std::swap(rows, cols);
+
+    if ((T::RowsAtCompileTime != Eigen::Dynamic && rows != T::RowsAtCompileTime) ||
+        (T::ColsAtCompileTime != Eigen::Dynamic && cols != T::ColsAtCompileTime))
+        detail::raise("nanobind::ndarray_copy(): incompatible array shape!");
+
+    out.resize(rows, cols);
+    ndarray_copy(array, out.data(), T::IsRowMajor ? 'C' : 'F', threads);
+}
+
 NAMESPACE_END(NB_NAMESPACE)
@@ -27,12 +27,13 @@ template <typename T> constexpr bool is_eigen_sparse_matrix_v =
     !std::is_base_of_v<Eigen::SparseMapBase<T, Eigen::ReadOnlyAccessors>, T>;
 
 
-/// Caster for Eigen::SparseMatrix
-template <typename T> struct type_caster<T, enable_if_t<is_eigen_sparse_matrix_v<T>>> {
+/// Caster for Eigen::Map<Eigen::SparseMatrix> borrowing the arrays of a SciPy matrix
+template <typename T>
+struct type_caster<Eigen::Map<T>, enable_if_t<is_eigen_sparse_matrix_v<T>>> {
+    using Map = Eigen::Map<T>;
     using Scalar = typename T::Scalar;
     using StorageIndex = typename T::StorageIndex;
     using Index = typename T::Index;
-    using SparseMap = Eigen::Map<T>;
 
     static_assert(std::is_same_v<T, Eigen::SparseMatrix<Scalar, T::Options, StorageIndex>>,
                   "nanobind: Eigen sparse caster only implemented for matrices");
@@ -45,49 +46,140 @@ template <typename T> struct type_caster<T, enable_if_t<is_eigen_sparse_matrix_v
     using ScalarCaster = make_caster<ScalarNDArray>;
     using StorageIndexCaster = make_caster<StorageIndexNDArray>;
 
-    NB_TYPE_CASTER(T, const_name<RowMajor>("scipy.sparse.csr_matrix[",
-                                           "scipy.sparse.csc_matrix[")
-                   + make_caster<Scalar>::Name + const_name("]"))
+    static constexpr auto Name =
+        const_name<RowMajor>("scipy.sparse.csr_matrix[",
+                             "scipy.sparse.csc_matrix[") +
+        make_caster<Scalar>::Name + const_name("]");
+    template <typename T_> using Cast = Map;
 
     ScalarCaster data_caster;
     StorageIndexCaster indices_caster, indptr_caster;
+    Index rows = 0, cols = 0, nnz = 0;
 
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        // Disable implicit conversions, which would not refer to the original data
+        return from_python_(src, flags & ~(uint8_t) cast_flags::convert, cleanup);
+    }
+
+    bool from_python_(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        handle matrix_type = scipy_sparse_type(RowMajor);
+        if (!matrix_type.is_valid()) {
+            PyErr_Clear();
+            return false;
+        }
+
         object obj = borrow(src);
-        try {
-            object matrix_type = module_::import_("scipy.sparse").attr(RowMajor ? "csr_matrix" : "csc_matrix");
-            if (!obj.type().is(matrix_type))
+        if (!obj.type().is(matrix_type)) {
+            if (!(flags & (uint8_t) cast_flags::convert))
+                return false;
+            try {
                 obj = matrix_type(obj);
-        } catch (const python_error &) {
+            } catch (const python_error &) {
+                return false;
+            }
+        }
+
+        try {
+            object data_o = obj.attr("data"), indices_o = obj.attr("indices"),
+                   indptr_o = obj.attr("indptr"), shape_o = obj.attr("shape");
+
+            if (!data_caster.from_python(data_o, flags, cleanup) ||
+                !indices_caster.from_python(indices_o, flags, cleanup) ||
+                !indptr_caster.from_python(indptr_o, flags, cleanup) ||
+                len(shape_o) != 2)
+                return false;
+            rows = cast<Index>(shape_o[0]);
+            cols = cast<Index>(shape_o[1]);
+        } catch (const std::exception &) {
+            PyErr_Clear();
             return false;
         }
 
-        if (object data_o = obj.attr("data"); !data_caster.from_python(data_o, flags, cleanup))
+        // The number of nonzeros follows from the outer index array
+        const StorageIndexNDArray &indptr = indptr_caster.value;
+        size_t outer = (size_t) (RowMajor ? rows : cols);
+        if (indptr.shape(0) != outer + 1 || (outer + 1 > 1 && indptr.stride(0) != 1) ||
+            data_caster.value.stride(0) != 1 || indices_caster.value.stride(0) != 1)
             return false;
-        ScalarNDArray& values = data_caster.value;
 
-        if (object indices_o = obj.attr("indices"); !indices_caster.from_python(indices_o, flags, cleanup))
+        nnz = (Index) indptr.data()[outer];
+        if (nnz < 0 || (size_t) nnz > data_caster.value.shape(0) ||
+            (size_t) nnz > indices_caster.value.shape(0))
             return false;
-        StorageIndexNDArray& inner_indices = indices_caster.value;
 
-        if (object indptr_o = obj.attr("indptr"); !indptr_caster.from_python(indptr_o, flags, cleanup))
+        return true;
+    }
+
+    operator Map() {
+        return Map(rows, cols, nnz, indptr_caster.value.data(),
+                   indices_caster.value.data(), data_caster.value.data());
+    }
+
+    /// Create a SciPy matrix referencing the given storage, kept alive by 'owner'
+    static handle to_python(Index rows, Index cols, Index nnz,
+                            const StorageIndex *outer_ptr,
+                            const StorageIndex *inner_ptr,
+                            const Scalar *value_ptr, handle owner) noexcept {
+        handle matrix_type = scipy_sparse_type(RowMajor);
+        if (!matrix_type.is_valid())
+            return handle();
+
+        const size_t data_shape[] = { (size_t) nnz };
+        const size_t outer_shape[] = { (size_t) ((RowMajor ? rows : cols) + 1) };
+
+        try {
+            ScalarNDArray data((void *) value_ptr, 1, data_shape, owner);
+            StorageIndexNDArray outer((void *) outer_ptr, 1, outer_shape, owner);
+            StorageIndexNDArray inner((void *) inner_ptr, 1, data_shape, owner);
+
+            return matrix_type(make_tuple(std::move(data), std::move(inner),
+                                          std::move(outer)),
+                               make_tuple(rows, cols))
+                .release();
+        } catch (python_error &e) {
+            e.restore();
+            return handle();
+        } catch (const std::exception &e) {
+            PyErr_SetString(PyExc_RuntimeError, e.what());
+            return handle();
+        }
+    }
+
+    static handle from_cpp(const Map &v, rv_policy policy, cleanup_list *cleanup) noexcept {
+        if (!v.isCompressed()) {
+            PyErr_SetString(PyExc_ValueError,
+                            "nanobind: unable to return an Eigen sparse map that is not in a compressed format.");
+            return handle();
+        }
+
+        handle owner;
+        if (policy == rv_policy::reference_internal && cleanup)
+            owner = cleanup->self();
+
+        return to_python(v.rows(), v.cols(), v.nonZeros(), v.outerIndexPtr(),
+                         v.innerIndexPtr(), v.valuePtr(), owner);
+    }
+};
+
+
+/// Caster for Eigen::SparseMatrix
+template <typename T> struct type_caster<T, enable_if_t<is_eigen_sparse_matrix_v<T>>> {
+    using StorageIndex = typename T::StorageIndex;
+    using MapCaster = type_caster<Eigen::Map<T>>;
+
+    NB_TYPE_CASTER(T, MapCaster::Name)
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        MapCaster caster;
+        if (!caster.from_python_(src, flags, cleanup))
             return false;
-        StorageIndexNDArray& outer_indices = indptr_caster.value;
 
-        object shape_o = obj.attr("shape"), nnz_o = obj.attr("nnz");
-        Index rows, cols, nnz;
         try {
-            if (len(shape_o) != 2)
-                return false;
-            rows = cast<Index>(shape_o[0]);
-            cols = cast<Index>(shape_o[1]);
-            nnz = cast<Index>(nnz_o);
-        } catch (const python_error &) {
+            value = caster.operator typename MapCaster::Map();
+        } catch (const std::bad_alloc &) {
             return false;
         }
 
-        value = SparseMap(rows, cols, nnz, outer_indices.data(), inner_indices.data(), values.data());
-
         return true;
     }
 
@@ -99,7 +191,7 @@ template <typename T> struct type_caster<T, enable_if_t<is_eigen_sparse_matrix_v
         return from_cpp((const T &) v, policy, cleanup);
     }
 
-    static handle from_cpp(const T &v, rv_policy policy, cleanup_list *) noexcept {
+    static handle from_cpp(const T &v, rv_policy policy, cleanup_list *cleanup) noexcept {
         if (!v.isCompressed()) {
             PyErr_SetString(PyExc_ValueError,
                             "nanobind: unable to return an Eigen sparse matrix that is not in a compressed format. "
@@ -107,56 +199,48 @@ template <typename T> struct type_caster<T, enable_if_t<is_eigen_sparse_matrix_v
             return handle();
         }
 
-        object matrix_type;
-        try {
-            matrix_type = module_::import_("scipy.sparse").attr(RowMajor ? "csr_matrix" : "csc_matrix");
-        } catch (python_error &e) {
-            e.restore();
-            return handle();
-        }
-
-        const Index rows = v.rows(), cols = v.cols();
-        const size_t data_shape[] = { (size_t) v.nonZeros() };
-        const size_t outer_indices_shape[] = { (size_t) ((RowMajor ? rows : cols) + 1) };
-
+        /* Transfer the storage into a heap-allocated matrix owned by a
+           capsule that the returned arrays reference (this moves the matrix
+           where possible, otherwise one copy is made). References leave the
+           storage in place. */
         T *src = std::addressof(const_cast<T &>(v));
         object owner;
-        if (policy == rv_policy::move) {
-            src = new T(std::move(v));
-            owner = capsule(src, [](void *p) noexcept { delete (T *) p; });
+        switch (policy) {
+            case rv_policy::reference:
+                break;
+
+            case rv_policy::reference_internal:
+                if (cleanup)
+                    owner = borrow(cleanup->self());
+                break;
+
+            default: {
+                    T *copy = nullptr;
+                    try {
+                        copy = policy == rv_policy::move ? new T(std::move(*src))
+                                                         : new T(*src);
+                        owner = capsule(copy, [](void *p) noexcept { delete (T *) p; });
+                    } catch (python_error &e) {
+                        delete copy;
+                        e.restore();
+                        return handle();
+                    } catch (const std::exception &e) {
+                        delete copy;
+                        PyErr_SetString(PyExc_RuntimeError, e.what());
+                        return handle();
+                    }
+                    src = copy;
+                }
+                break;
         }
 
-        ScalarNDArray data(src->valuePtr(), 1, data_shape, owner);
-        StorageIndexNDArray outer_indices(src->outerIndexPtr(), 1, outer_indices_shape, owner);
-        StorageIndexNDArray inner_indices(src->innerIndexPtr(), 1, data_shape, owner);
-
-        try {
-            return matrix_type(make_tuple(
-                                   std::move(data), std::move(inner_indices), std::move(outer_indices)),
-                               make_tuple(rows, cols))
-                .release();
-        } catch (python_error &e) {
-            e.restore();
-            return handle();
-        }
+        return MapCaster::to_python(src->rows(), src->cols(), src->nonZeros(),
+                                    src->outerIndexPtr(), src->innerIndexPtr(),
+                                    src->valuePtr(), owner);
     }
 };
 
 
-/// Caster for Eigen::Map<Eigen::SparseMatrix>, still needs to be implemented.
-template <typename T>
-struct type_caster<Eigen::Map<T>, enable_if_t<is_eigen_sparse_matrix_v<T>>> {
-    using Map = Eigen::Map<T>;
-    using SparseMatrixCaster = type_caster<T>;
-    static constexpr auto Name = SparseMatrixCaster::Name;
-    template <typename T_> using Cast = Map;
-
-    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept = delete;
-
-    static handle from_cpp(const Map &v, rv_policy policy, cleanup_list *cleanup) noexcept = delete;
-};
-
-
 /// Caster for Eigen::Ref<Eigen::SparseMatrix>, still needs to be implemented
 template <typename T, int Options>
 struct type_caster<Eigen::Ref<T, Options>, enable_if_t<is_eigen_sparse_matrix_v<T>>> {
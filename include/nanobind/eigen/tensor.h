@@ -0,0 +1,205 @@
+/*
+    nanobind/eigen/tensor.h: type casters for Eigen tensors
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/ndarray.h>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/* Build the 'ndarray' matching a tensor of the given scalar type, rank,
+   and layout. Eigen's column-major tensors map to Fortran-ordered arrays
+   and row-major tensors to C-ordered arrays. */
+template <typename Scalar, int NDim, int Options>
+using array_for_eigen_tensor_t =
+    ndarray<Scalar, numpy, ndim<(size_t) NDim>,
+            std::conditional_t<(Options & Eigen::RowMajor) != 0, c_contig,
+                               f_contig>>;
+
+/// Shape and strides (in elements) of a tensor with the given dimensions
+template <bool RowMajor, typename Dimensions>
+void eigen_tensor_layout(const Dimensions &dims, size_t *shape,
+                         int64_t *strides) {
+    constexpr size_t N = (size_t) Dimensions::count;
+    int64_t stride = 1;
+    for (size_t i = 0; i < N; ++i) {
+        size_t j = RowMajor ? N - 1 - i : i;
+        shape[j] = (size_t) dims[j];
+        strides[j] = stride;
+        stride *= (int64_t) dims[j];
+    }
+}
+
+/// Caster for Eigen::Tensor (copies on input, moves storage on output)
+template <typename Scalar, int NDim, int Options, typename IndexType>
+struct type_caster<Eigen::Tensor<Scalar, NDim, Options, IndexType>,
+                   enable_if_t<is_ndarray_scalar_v<Scalar>>> {
+    using T = Eigen::Tensor<Scalar, NDim, Options, IndexType>;
+    using NDArray = array_for_eigen_tensor_t<Scalar, NDim, Options>;
+    using NDArrayCaster = make_caster<NDArray>;
+    static constexpr bool RowMajor = (Options & Eigen::RowMajor) != 0;
+
+    NB_TYPE_CASTER(T, NDArrayCaster::Name)
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        // We're in any case making a copy, so non-writable inputs are also okay
+        using NDArrayConst = array_for_eigen_tensor_t<const Scalar, NDim, Options>;
+        make_caster<NDArrayConst> caster;
+        if (!caster.from_python(src, flags, cleanup))
+            return false;
+
+        const NDArrayConst &array = caster.value;
+        Eigen::DSizes<IndexType, NDim> dims;
+        for (size_t i = 0; i < (size_t) NDim; ++i)
+            dims[i] = (IndexType) array.shape(i);
+
+        try {
+            value.resize(dims);
+        } catch (const std::bad_alloc &) {
+            return false;
+        }
+
+        // The layout is contiguous & compatible thanks to array_for_eigen_tensor_t
+        if (array.size())
+            memcpy(value.data(), array.data(), array.size() * sizeof(Scalar));
+
+        return true;
+    }
+
+    /// Temporaries are always moved into storage owned by the returned array
+    static handle from_cpp(T &&v, rv_policy, cleanup_list *cleanup) noexcept {
+        return from_cpp((const T &) v, rv_policy::move, cleanup);
+    }
+
+    static handle from_cpp(const T &v, rv_policy policy, cleanup_list *cleanup) noexcept {
+        size_t shape[NDim > 0 ? NDim : 1];
+        int64_t strides[NDim > 0 ? NDim : 1];
+        eigen_tensor_layout<RowMajor>(v.dimensions(), shape, strides);
+
+        void *ptr = (void *) v.data();
+
+        switch (policy) {
+            case rv_policy::automatic:
+                policy = rv_policy::copy;
+                break;
+
+            case rv_policy::automatic_reference:
+                policy = rv_policy::reference;
+                break;
+
+            default: // leave policy unchanged
+                break;
+        }
+
+        object owner;
+        if (policy == rv_policy::move) {
+            T *temp = nullptr;
+            try {
+                temp = new T(std::move(const_cast<T &>(v)));
+                owner = capsule(temp, [](void *p) noexcept { delete (T *) p; });
+            } catch (...) {
+                delete temp;
+                PyErr_SetString(PyExc_RuntimeError,
+                                "nanobind: could not transfer Eigen tensor "
+                                "storage to Python!");
+                return handle();
+            }
+            ptr = temp->data();
+            policy = rv_policy::reference;
+        } else if (policy == rv_policy::reference_internal) {
+            owner = borrow(cleanup->self());
+            policy = rv_policy::reference;
+        }
+
+        object o = steal(NDArrayCaster::from_cpp(
+            NDArray(ptr, (size_t) NDim, shape, owner, strides),
+            policy, cleanup));
+
+        return o.release();
+    }
+};
+
+/** \brief Type caster for ``Eigen::TensorMap<T>``
+
+  Like the ``Eigen::Map<T>`` caster of ``nanobind/eigen/dense.h``, this caster
+  refers to the memory of the caller and therefore refuses inputs that would
+  require an implicit conversion (e.g. of the dtype or memory order).
+*/
+template <typename Scalar, int NDim, int Options, typename IndexType,
+          bool Const, int MapOptions>
+struct tensor_map_caster {
+    using T = std::conditional_t<
+        Const, const Eigen::Tensor<Scalar, NDim, Options, IndexType>,
+        Eigen::Tensor<Scalar, NDim, Options, IndexType>>;
+    using Map = Eigen::TensorMap<T, MapOptions>;
+    using NDArray =
+        array_for_eigen_tensor_t<std::conditional_t<Const, const Scalar, Scalar>,
+                                 NDim, Options>;
+    using NDArrayCaster = make_caster<NDArray>;
+    static constexpr bool RowMajor = (Options & Eigen::RowMajor) != 0;
+    static constexpr auto Name = NDArrayCaster::Name;
+    template <typename T_> using Cast = Map;
+
+    NDArrayCaster caster;
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        // Disable implicit conversions
+        if (!caster.from_python(src, flags & ~(uint8_t) cast_flags::convert,
+                                cleanup))
+            return false;
+
+        // Memory allocated by Eigen is aligned, foreign memory may not be
+        if constexpr ((MapOptions & Eigen::Aligned) != 0) {
+            if ((uintptr_t) caster.value.data() % EIGEN_MAX_ALIGN_BYTES)
+                return false;
+        }
+
+        return true;
+    }
+
+    static handle from_cpp(const Map &v, rv_policy policy,
+                           cleanup_list *cleanup) noexcept {
+        size_t shape[NDim > 0 ? NDim : 1];
+        int64_t strides[NDim > 0 ? NDim : 1];
+        eigen_tensor_layout<RowMajor>(v.dimensions(), shape, strides);
+
+        if (policy != rv_policy::reference_internal)
+            policy = rv_policy::reference;
+
+        return NDArrayCaster::from_cpp(
+            NDArray((void *) v.data(), (size_t) NDim, shape, handle(), strides),
+            policy, cleanup);
+    }
+
+    operator Map() {
+        Eigen::DSizes<IndexType, NDim> dims;
+        for (size_t i = 0; i < (size_t) NDim; ++i)
+            dims[i] = (IndexType) caster.value.shape(i);
+        return Map(caster.value.data(), dims);
+    }
+};
+
+template <typename Scalar, int NDim, int Options, typename IndexType,
+          int MapOptions>
+struct type_caster<
+    Eigen::TensorMap<Eigen::Tensor<Scalar, NDim, Options, IndexType>, MapOptions>,
+    enable_if_t<is_ndarray_scalar_v<Scalar>>>
+    : tensor_map_caster<Scalar, NDim, Options, IndexType, false, MapOptions> { };
+
+template <typename Scalar, int NDim, int Options, typename IndexType,
+          int MapOptions>
+struct type_caster<
+    Eigen::TensorMap<const Eigen::Tensor<Scalar, NDim, Options, IndexType>, MapOptions>,
+    enable_if_t<is_ndarray_scalar_v<Scalar>>>
+    : tensor_map_caster<Scalar, NDim, Options, IndexType, true, MapOptions> { };
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
@@ -25,15 +25,19 @@ enum eval_mode {
     eval_statements = Py_file_input
 };
 
-template <eval_mode start = eval_expr>
-object eval(const str &expr, handle global = handle(), handle local = handle()) {
-    if (!local.is_valid())
-        local = global;
+NAMESPACE_BEGIN(detail)
 
+inline object eval_compile(const str &expr, eval_mode start) {
     // This used to be PyRun_String, but that function isn't in the stable ABI.
     object codeobj = steal(Py_CompileString(expr.c_str(), "<string>", start));
     if (!codeobj.is_valid())
         raise_python_error();
+    return codeobj;
+}
+
+inline object eval_code(handle codeobj, handle global, handle local) {
+    if (!local.is_valid())
+        local = global;
 
     PyObject *result = PyEval_EvalCode(codeobj.ptr(), global.ptr(), local.ptr());
     if (!result)
@@ -42,11 +46,21 @@ object eval(const str &expr, handle global = handle(), handle local = handle())
     return steal(result);
 }
 
+template <size_t N> str eval_source(const char (&s)[N]) {
+    // Support raw string literals by removing common leading whitespace
+    return (s[0] == '\n') ? str(module_::import_("textwrap").attr("dedent")(s)) : str(s);
+}
+
+NAMESPACE_END(detail)
+
+template <eval_mode start = eval_expr>
+object eval(const str &expr, handle global = handle(), handle local = handle()) {
+    return detail::eval_code(detail::eval_compile(expr, start), global, local);
+}
+
 template <eval_mode start = eval_expr, size_t N>
 object eval(const char (&s)[N], handle global = handle(), handle local = handle()) {
-    // Support raw string literals by removing common leading whitespace
-    str expr = (s[0] == '\n') ? str(module_::import_("textwrap").attr("dedent")(s)) : str(s);
-    return eval<start>(expr, global, local);
+    return eval<start>(detail::eval_source(s), global, local);
 }
 
 inline void exec(const str &expr, handle global = handle(), handle local = handle()) {
@@ -58,4 +72,32 @@ void exec(const char (&s)[N], handle global = handle(), handle local = handle())
     eval<eval_statements>(s, global, local);
 }
 
+/**
+ * \brief Python code that is compiled once and can then be evaluated many
+ * times, e.g., with different global/local scopes.
+ *
+ * In contrast to eval() and exec(), repeated evaluations bypass the Python
+ * compiler.
+ */
+class compiled_expr {
+public:
+    compiled_expr(const str &expr, eval_mode start = eval_expr)
+        : m_code(detail::eval_compile(expr, start)) { }
+
+    template <size_t N>
+    compiled_expr(const char (&s)[N], eval_mode start = eval_expr)
+        : compiled_expr(detail::eval_source(s), start) { }
+
+    /// Evaluate the code in the given global/local scopes
+    object operator()(handle global = handle(), handle local = handle()) const {
+        return detail::eval_code(m_code, global, local);
+    }
+
+    /// Return the underlying Python code object
+    handle code() const { return m_code; }
+
+private:
+    object m_code;
+};
+
 NAMESPACE_END(NB_NAMESPACE)
@@ -0,0 +1,270 @@
+/*
+    nanobind/generator.h: nb::generator<T> coroutines and type casters that
+    expose coroutine generators as Python iterators
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+
+#if !defined(__cpp_impl_coroutine)
+#  error "nanobind/generator.h requires C++20 coroutine support!"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <optional>
+
+#if __has_include(<generator>)
+#  include <generator>
+#endif
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+
+/**
+ * \brief Minimal coroutine generator
+ *
+ * A function returning ``nb::generator<T>`` can ``co_yield`` values of type
+ * ``T``, which are produced lazily while Python iterates over the result.
+ * This class mirrors the interface of C++23's ``std::generator<T>`` (which is
+ * also supported when available): ``begin()`` starts the coroutine, and each
+ * increment of the iterator resumes it until the next ``co_yield``.
+ */
+template <typename T> class generator {
+public:
+    using value_type = std::remove_cv_t<std::remove_reference_t<T>>;
+    using reference = std::conditional_t<std::is_reference_v<T>, T, T &&>;
+
+    struct promise_type {
+        std::add_pointer_t<reference> value = nullptr;
+        std::exception_ptr exception;
+
+        generator get_return_object() noexcept {
+            return generator(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return { }; }
+        std::suspend_always final_suspend() const noexcept { return { }; }
+
+        std::suspend_always yield_value(reference v) noexcept {
+            value = std::addressof(v);
+            return { };
+        }
+
+        // Yielding an lvalue of a value-type generator copies it into the frame
+        template <typename U = T,
+                  detail::enable_if_t<!std::is_reference_v<U>> = 0>
+        auto yield_value(const value_type &v) noexcept(
+            std::is_nothrow_copy_constructible_v<value_type>) {
+            struct awaiter {
+                value_type copy;
+                promise_type *p;
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<>) noexcept {
+                    p->value = std::addressof(copy);
+                }
+                void await_resume() const noexcept { }
+            };
+            return awaiter{ v, this };
+        }
+
+        void return_void() const noexcept { }
+        void unhandled_exception() noexcept {
+            exception = std::current_exception();
+        }
+
+        template <typename U> void await_transform(U &&) = delete;
+    };
+
+    class iterator {
+    public:
+        using value_type = generator::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator &operator++() {
+            m_handle.resume();
+            rethrow();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        reference operator*() const {
+            return static_cast<reference>(*m_handle.promise().value);
+        }
+
+        friend bool operator==(const iterator &it, std::default_sentinel_t) {
+            return it.m_handle.done();
+        }
+
+    private:
+        friend class generator;
+        explicit iterator(std::coroutine_handle<promise_type> h)
+            : m_handle(h) { }
+
+        void rethrow() const {
+            if (std::exception_ptr e = m_handle.promise().exception) {
+                m_handle.promise().exception = nullptr;
+                std::rethrow_exception(e);
+            }
+        }
+
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+    generator(generator &&g) noexcept : m_handle(g.m_handle) {
+        g.m_handle = nullptr;
+    }
+
+    generator &operator=(generator &&g) noexcept {
+        std::swap(m_handle, g.m_handle);
+        return *this;
+    }
+
+    ~generator() {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    /// Start the coroutine (may only be called once)
+    iterator begin() {
+        iterator it(m_handle);
+        m_handle.resume();
+        it.rethrow();
+        return it;
+    }
+
+    std::default_sentinel_t end() const noexcept { return { }; }
+
+private:
+    explicit generator(std::coroutine_handle<promise_type> h) noexcept
+        : m_handle(h) { }
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+NAMESPACE_BEGIN(detail)
+
+/// Python iterator state wrapping a generator of type 'Gen'
+template <typename Gen> struct generator_state {
+    using Iterator = decltype(std::declval<Gen &>().begin());
+
+    Gen gen;
+    std::optional<Iterator> it;
+    rv_policy policy;
+    bool done = false;
+
+    generator_state(Gen &&gen, rv_policy policy)
+        : gen(std::move(gen)), policy(policy) { }
+};
+
+/// 'tp_iternext' slot of the iterator type: resume the coroutine
+template <typename Gen> PyObject *generator_next(PyObject *self) noexcept {
+    using State = generator_state<Gen>;
+    using Reference = decltype(*std::declval<typename State::Iterator &>());
+    State &s = *inst_ptr<State>(self);
+
+    if (s.done)
+        return nullptr;
+
+    try {
+        if (!s.it)
+            s.it.emplace(s.gen.begin());
+        else
+            ++*s.it;
+    } catch (...) {
+        s.done = true;
+        nb_translate_exception();
+        return nullptr;
+    }
+
+    if (*s.it == s.gen.end()) {
+        s.done = true;
+        return nullptr;
+    }
+
+    cleanup_list cleanup(self);
+    PyObject *result;
+
+    try {
+        result = make_caster<Reference>::from_cpp(
+            static_cast<Reference>(**s.it), s.policy, &cleanup).ptr();
+    } catch (...) {
+        nb_translate_exception();
+        result = nullptr;
+    }
+
+    cleanup.release();
+
+    if (!result && !PyErr_Occurred())
+        PyErr_SetString(PyExc_TypeError,
+                        "nanobind::generator: could not convert a yielded "
+                        "value to a Python object!");
+    return result;
+}
+
+template <typename Gen, typename T> struct generator_caster {
+    using Caster = make_caster<T>;
+    static constexpr auto Name = const_name("collections.abc.Iterator[") +
+                                 Caster::Name + const_name("]");
+    using Value = Gen;
+
+    bool from_python(handle, uint8_t, cleanup_list *) noexcept {
+        return false;
+    }
+
+    /* Yielded values generally reside in the coroutine frame and are only
+       valid until it resumes, hence the default policy copies or moves them */
+    static handle from_cpp(Gen &&gen, rv_policy policy,
+                           cleanup_list *) noexcept {
+        using State = generator_state<Gen>;
+        using Reference = decltype(*std::declval<typename State::Iterator &>());
+
+        if (policy == rv_policy::automatic ||
+            policy == rv_policy::automatic_reference)
+            policy = std::is_lvalue_reference_v<Reference> ? rv_policy::copy
+                                                           : rv_policy::move;
+
+        try {
+            if (!type<State>().is_valid()) {
+                static PyType_Slot slots[] = {
+                    { Py_tp_iter, (void *) PyObject_SelfIter },
+                    { Py_tp_iternext, (void *) generator_next<Gen> },
+                    { 0, nullptr }
+                };
+
+                class_<State>(handle(), "generator", type_slots(slots));
+            }
+
+            return nanobind::cast(State(std::move(gen), policy),
+                                  rv_policy::move).release();
+        } catch (python_error &e) {
+            e.restore();
+        } catch (const std::exception &e) {
+            PyErr_SetString(PyExc_RuntimeError, e.what());
+        }
+
+        return handle();
+    }
+};
+
+template <typename T>
+struct type_caster<generator<T>> : generator_caster<generator<T>, T> { };
+
+#if defined(__cpp_lib_generator)
+template <typename Ref, typename V, typename Alloc>
+struct type_caster<std::generator<Ref, V, Alloc>>
+    : generator_caster<std::generator<Ref, V, Alloc>,
+                       typename std::generator<Ref, V, Alloc>::yielded> { };
+#endif
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
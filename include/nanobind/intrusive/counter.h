@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 // Override this definition to specify DLL export/import declarations
@@ -140,8 +141,7 @@ NAMESPACE_BEGIN(nanobind)
  *         Py_INCREF(o);
  *     },
  *     [](PyObject *o) noexcept {
- *         nb::gil_scoped_acquire guard;
- *         Py_DECREF(o);
+ *         nb::decref_deferred(o);
  *     });
  * ```
  *
@@ -165,6 +165,11 @@ NAMESPACE_BEGIN(nanobind)
  * } // <-- Destruction of ref<..> calls dec_ref(), deleting the instance in this example.
  * ```
  *
+ * Objects that are only ever referenced from a single thread can skip the
+ * atomic operations by calling ``set_single_threaded()``, which turns the
+ * ``inc_ref()`` and ``dec_ref()`` fast paths into plain increments and
+ * decrements while the object is owned by C++.
+ *
  * When the file ``nanobind/intrusive/ref.h`` is included following
  * ``nanobind/nanobind.h``, it also exposes a custom type caster to bind
  * functions taking or returning ``ref<T>``-typed values.
@@ -180,10 +185,23 @@ public:
     intrusive_counter &operator=(intrusive_counter &&) noexcept { return *this; }
 
     /// Increase the object's reference count
-    void inc_ref() const noexcept;
+    void inc_ref() const noexcept {
+        uintptr_t v = state();
+        if ((v & 3) == 3) // single-threaded mode, owned by C++
+            m_state = v + 4;
+        else
+            inc_ref_atomic();
+    }
 
     /// Decrease the object's reference count, return ``true`` if it should be deallocated
-    bool dec_ref() const noexcept;
+    bool dec_ref() const noexcept {
+        uintptr_t v = state();
+        if ((v & 3) == 3 && v > 7) { // single-threaded mode, not the last reference
+            m_state = v - 4;
+            return false;
+        }
+        return dec_ref_atomic();
+    }
 
     /// Return the Python object associated with this instance (or NULL)
     PyObject *self_py() const noexcept;
@@ -191,6 +209,28 @@ public:
     /// Set the Python object associated with this instance
     void set_self_py(PyObject *self) noexcept;
 
+    /**
+     * \brief Update the reference count using plain (non-atomic) operations
+     *
+     * This is only safe when the reference count of the object is exclusively
+     * modified by a single thread, and it has no effect once ownership has
+     * been transferred to Python.
+     */
+    void set_single_threaded(bool value = true) noexcept;
+
+protected:
+    /// Atomically load the state (relaxed, no ordering constraints)
+    uintptr_t state() const noexcept {
+#if defined(_MSC_VER)
+        return *((volatile const uintptr_t *) &m_state);
+#else
+        return __atomic_load_n(&m_state, __ATOMIC_RELAXED);
+#endif
+    }
+
+    void inc_ref_atomic() const noexcept;
+    bool dec_ref_atomic() const noexcept;
+
 protected:
     /**
      * \brief Mutable counter. Note that the value ``1`` actually encodes
@@ -212,12 +252,17 @@ public:
     /// Decrease the object's reference count, return ``true`` if it should be deallocated
     bool dec_ref() noexcept { return m_ref_count.dec_ref(); }
 
-    /// Return the Python object associated with this instance (or NULL)
+    /// Set the Python object associated with this instance
     void set_self_py(PyObject *self) noexcept { m_ref_count.set_self_py(self); }
 
-    /// Set the Python object associated with this instance
+    /// Return the Python object associated with this instance (or NULL)
     PyObject *self_py() const noexcept { return m_ref_count.self_py(); }
 
+    /// Use non-atomic reference counting, see ``intrusive_counter::set_single_threaded()``
+    void set_single_threaded(bool value = true) noexcept {
+        m_ref_count.set_single_threaded(value);
+    }
+
     /// Virtual destructor
     virtual ~intrusive_base() = default;
 
@@ -252,10 +297,41 @@ inline void dec_ref(intrusive_base *o) noexcept {
  *
  * Python binding code must invoke ``intrusive_init`` once to supply two
  * functions that increase and decrease the reference count of a Python object,
- * while ensuring that the GIL is held.
+ * while ensuring that the GIL is held. The optional third function decreases
+ * the reference counts of several objects at once and is used by
+ * ``intrusive_batch``.
  */
 extern NB_INTRUSIVE_EXPORT
 void intrusive_init(void (*intrusive_inc_ref_py)(PyObject *) noexcept,
-                    void (*intrusive_dec_ref_py)(PyObject *) noexcept);
+                    void (*intrusive_dec_ref_py)(PyObject *) noexcept,
+                    void (*intrusive_dec_ref_py_batch)(PyObject *const *,
+                                                       size_t) noexcept = nullptr);
+
+/**
+ * \brief Release Python references in batches
+ *
+ * While an instance of this class exists, ``dec_ref()`` calls of the current
+ * thread that would decrease the reference count of a Python object are
+ * collected instead. They are released together (using the batch handler
+ * passed to ``intrusive_init()``) once the outermost ``intrusive_batch`` goes
+ * out of scope, or earlier when many of them have accumulated. This turns
+ * the destruction of a large container of ``ref<T>`` into a few calls that
+ * each acquire the GIL only once:
+ *
+ * ```cpp
+ * {
+ *     nb::intrusive_batch batch;
+ *     cache.clear(); // e.g. std::vector<ref<MyObject>>
+ * }
+ * ```
+ */
+class NB_INTRUSIVE_EXPORT intrusive_batch {
+public:
+    intrusive_batch() noexcept;
+    ~intrusive_batch();
+
+    intrusive_batch(const intrusive_batch &) = delete;
+    intrusive_batch &operator=(const intrusive_batch &) = delete;
+};
 
 NAMESPACE_END(nanobind)
@@ -47,19 +47,88 @@ static bool nb_cmpxchg(uintptr_t *ptr, uintptr_t *cmp, uintptr_t xchg) {
 #endif
 
 static void (*intrusive_inc_ref_py)(PyObject *) noexcept = nullptr,
-            (*intrusive_dec_ref_py)(PyObject *) noexcept = nullptr;
+            (*intrusive_dec_ref_py)(PyObject *) noexcept = nullptr,
+            (*intrusive_dec_ref_py_batch)(PyObject *const *, size_t) noexcept = nullptr;
 
 void intrusive_init(void (*intrusive_inc_ref_py_)(PyObject *) noexcept,
-                    void (*intrusive_dec_ref_py_)(PyObject *) noexcept) {
+                    void (*intrusive_dec_ref_py_)(PyObject *) noexcept,
+                    void (*intrusive_dec_ref_py_batch_)(PyObject *const *,
+                                                        size_t) noexcept) {
     intrusive_inc_ref_py = intrusive_inc_ref_py_;
     intrusive_dec_ref_py = intrusive_dec_ref_py_;
+    intrusive_dec_ref_py_batch = intrusive_dec_ref_py_batch_;
+}
+
+/// Python references collected by the active 'intrusive_batch' scopes of a thread
+struct intrusive_batch_state {
+    size_t depth, size, capacity;
+    PyObject **items;
+};
+
+static thread_local intrusive_batch_state intrusive_batch_tls { 0, 0, 0, nullptr };
+
+/// Maximum number of references collected by 'intrusive_batch' before releasing them
+static constexpr size_t intrusive_batch_max = 4096;
+
+static void intrusive_batch_flush(intrusive_batch_state &s) noexcept {
+    // Releasing references may run destructors that collect further ones
+    while (s.size) {
+        PyObject **items = s.items;
+        size_t size = s.size;
+        s.items = nullptr;
+        s.size = s.capacity = 0;
+
+        if (intrusive_dec_ref_py_batch) {
+            intrusive_dec_ref_py_batch(items, size);
+        } else {
+            for (size_t i = 0; i < size; ++i)
+                intrusive_dec_ref_py(items[i]);
+        }
+
+        free(items);
+    }
+}
+
+/// Defer the release of a Python reference if the thread has an active batch
+static void intrusive_dec_ref_py_deferred(PyObject *o) noexcept {
+    intrusive_batch_state &s = intrusive_batch_tls;
+
+    if (s.depth && s.size == intrusive_batch_max)
+        intrusive_batch_flush(s);
+
+    if (s.depth && s.size == s.capacity) {
+        size_t capacity = s.capacity ? s.capacity * 2 : 64;
+        PyObject **items =
+            (PyObject **) realloc(s.items, sizeof(PyObject *) * capacity);
+        if (items) {
+            s.items = items;
+            s.capacity = capacity;
+        }
+    }
+
+    if (s.depth && s.size < s.capacity)
+        s.items[s.size++] = o;
+    else
+        intrusive_dec_ref_py(o);
+}
+
+intrusive_batch::intrusive_batch() noexcept {
+    intrusive_batch_tls.depth++;
+}
+
+intrusive_batch::~intrusive_batch() {
+    intrusive_batch_state &s = intrusive_batch_tls;
+    if (s.depth == 1)
+        intrusive_batch_flush(s);
+    s.depth--;
 }
 
 /** A few implementation details:
  *
  * The ``intrusive_counter`` constructor sets the ``m_state`` field to ``1``,
- * which indicates that the instance is owned by C++. Bits 2..63 of this
- * field are used to store the actual reference count value. The
+ * which indicates that the instance is owned by C++. Bit 2 is set in
+ * single-threaded mode, and bits 3..64 of this field are used to store the
+ * actual reference count value. The
  * ``inc_ref()`` and ``dec_ref()`` functions increment or decrement this
  * number. When ``dec_ref()`` removes the last reference, the instance
  * returns ``true`` to indicate that it should be deallocated using a
@@ -77,14 +146,18 @@ void intrusive_init(void (*intrusive_inc_ref_py_)(PyObject *) noexcept,
  * pointer to the `PyObject *`. Python instance pointers are always aligned
  * (i.e. bit 1 is zero), which disambiguates between the two possible
  * configurations.
+ *
+ * In single-threaded mode, ``inc_ref()`` and ``dec_ref()`` (defined in
+ * ``counter.h``) update ``m_state`` directly and only call the functions
+ * below for the last reference and to report errors.
  */
 
-void intrusive_counter::inc_ref() const noexcept {
+void intrusive_counter::inc_ref_atomic() const noexcept {
     uintptr_t v = NB_ATOMIC_LOAD(&m_state);
 
     while (true) {
         if (v & 1) {
-            if (!NB_ATOMIC_CMPXCHG(&m_state, &v, v + 2))
+            if (!NB_ATOMIC_CMPXCHG(&m_state, &v, v + 4))
                 continue;
         } else {
             intrusive_inc_ref_py((PyObject *) v);
@@ -94,24 +167,25 @@ void intrusive_counter::inc_ref() const noexcept {
     }
 }
 
-bool intrusive_counter::dec_ref() const noexcept {
+bool intrusive_counter::dec_ref_atomic() const noexcept {
     uintptr_t v = NB_ATOMIC_LOAD(&m_state);
 
     while (true) {
         if (v & 1) {
-            if (v == 1) {
+            uintptr_t count = v >> 2;
+            if (count == 0) {
                 fprintf(stderr,
                         "intrusive_counter::dec_ref(%p): reference count "
                         "underflow!", (void *) this);
                 abort();
-            } else if (v == 3) {
+            } else if (count == 1) {
                 return true;
             }
 
-            if (!NB_ATOMIC_CMPXCHG(&m_state, &v, v - 2))
+            if (!NB_ATOMIC_CMPXCHG(&m_state, &v, v - 4))
                 continue;
         } else {
-            intrusive_dec_ref_py((PyObject *) v);
+            intrusive_dec_ref_py_deferred((PyObject *) v);
         }
 
         return false;
@@ -122,7 +196,7 @@ void intrusive_counter::set_self_py(PyObject *o) noexcept {
     uintptr_t v = NB_ATOMIC_LOAD(&m_state);
 
     if (v & 1) {
-        v >>= 1;
+        v >>= 2;
         for (uintptr_t i = 0; i < v; ++i)
             intrusive_inc_ref_py(o);
 
@@ -135,6 +209,16 @@ void intrusive_counter::set_self_py(PyObject *o) noexcept {
     }
 }
 
+void intrusive_counter::set_single_threaded(bool value) noexcept {
+    uintptr_t v = NB_ATOMIC_LOAD(&m_state);
+
+    while (v & 1) {
+        uintptr_t v_new = value ? (v | 2) : (v & ~(uintptr_t) 2);
+        if (NB_ATOMIC_CMPXCHG(&m_state, &v, v_new))
+            break;
+    }
+}
+
 PyObject *intrusive_counter::self_py() const noexcept {
     uintptr_t v = NB_ATOMIC_LOAD(&m_state);
 
@@ -11,6 +11,7 @@
 
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/pair.h>
+#include <iterator>
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
@@ -42,6 +43,61 @@ template <typename Iterator> struct iterator_value_access {
     result_type operator()(Iterator &it) const { return (*it).second; }
 };
 
+/// Advance the iterator; returns 'false' once the end has been reached
+template <typename State> NB_INLINE bool iterator_step(State &s) {
+    if (!s.first_or_done)
+        ++s.it;
+    else
+        s.first_or_done = false;
+
+    if (s.it == s.end) {
+        s.first_or_done = true;
+        return false;
+    }
+
+    return true;
+}
+
+/* Fetch the next element of the iterator 'self' of type 'State'. Returns a
+   new reference, or nullptr with an error set, or nullptr without an error
+   at the end. This is also the 'tp_iternext' slot of the iterator type. */
+template <typename State, typename Access, rv_policy Policy,
+          typename ValueType>
+PyObject *iterator_next(PyObject *self) noexcept {
+    State &s = *inst_ptr<State>(self);
+
+    try {
+        if (!iterator_step(s))
+            return nullptr;
+
+        cleanup_list cleanup(self);
+        PyObject *result =
+            make_caster<ValueType>::from_cpp(
+                static_cast<ValueType>(Access()(s.it)), Policy, &cleanup)
+                .ptr();
+        cleanup.release();
+
+        if (!result && !PyErr_Occurred())
+            PyErr_SetString(PyExc_TypeError,
+                            "nanobind::make_iterator(): could not convert "
+                            "an element to a Python object!");
+        return result;
+    } catch (...) {
+        nb_translate_exception();
+        return nullptr;
+    }
+}
+
+template <typename It, typename = int>
+struct is_random_access_iterator : std::false_type { };
+
+template <typename It>
+struct is_random_access_iterator<
+    It, enable_if_t<std::is_base_of_v<
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<It>::iterator_category>>>
+    : std::true_type { };
+
 template <typename Access, rv_policy Policy, typename Iterator,
           typename Sentinel, typename ValueType, typename... Extra>
 iterator make_iterator_impl(handle scope, const char *name,
@@ -50,24 +106,55 @@ iterator make_iterator_impl(handle scope, const char *name,
     using State = iterator_state<Access, Policy, Iterator, Sentinel, ValueType, Extra...>;
 
     if (!type<State>().is_valid()) {
-        class_<State>(scope, name)
-            .def("__iter__", [](handle h) { return h; })
-            .def("__next__",
-                 [](State &s) -> ValueType {
-                     if (!s.first_or_done)
-                         ++s.it;
-                     else
-                         s.first_or_done = false;
-
-                     if (s.it == s.end) {
-                         s.first_or_done = true;
-                         throw stop_iteration();
-                     }
-
-                     return Access()(s.it);
-                 },
-                 std::forward<Extra>(extra)...,
-                 Policy);
+        if constexpr (sizeof...(Extra) == 0) {
+            /* Without extra annotations, the iterator protocol is implemented
+               directly through type slots instead of bound methods */
+            static PyType_Slot slots[] = {
+                { Py_tp_iter, (void *) PyObject_SelfIter },
+                { Py_tp_iternext,
+                  (void *) iterator_next<State, Access, Policy, ValueType> },
+                { 0, nullptr }
+            };
+
+            class_<State> cls(scope, name, type_slots(slots));
+
+            cls.def("next_batch", [](handle self, size_t n) {
+                list result;
+                for (size_t i = 0; i < n; ++i) {
+                    PyObject *o =
+                        iterator_next<State, Access, Policy, ValueType>(
+                            self.ptr());
+                    if (!o) {
+                        if (PyErr_Occurred())
+                            raise_python_error();
+                        break;
+                    }
+                    result.append(steal(o));
+                }
+                return result;
+            }, arg("n"));
+
+            using It = std::decay_t<Iterator>;
+            if constexpr (std::is_same_v<It, std::decay_t<Sentinel>> &&
+                          is_random_access_iterator<It>::value) {
+                cls.def("__length_hint__", [](State &s) -> size_t {
+                    if (s.it == s.end)
+                        return 0;
+                    return (size_t) (s.end - s.it) - (s.first_or_done ? 0 : 1);
+                });
+            }
+        } else {
+            class_<State>(scope, name)
+                .def("__iter__", [](handle h) { return h; })
+                .def("__next__",
+                     [](State &s) -> ValueType {
+                         if (!iterator_step(s))
+                             throw stop_iteration();
+                         return Access()(s.it);
+                     },
+                     std::forward<Extra>(extra)...,
+                     Policy);
+        }
     }
 
     return borrow<iterator>(cast(State{ std::forward<Iterator>(first),
@@ -47,14 +47,27 @@ template <typename... Ts> struct call_guard {
     using type = detail::tuple<Ts...>;
 };
 
+struct gil_release {};
 struct dynamic_attr {};
 struct is_method {};
 struct is_implicit {};
 struct is_operator {};
+struct native_slot {};
 struct is_arithmetic {};
+struct is_flag {};
 struct is_final {};
+struct no_identity {};
+template <size_t /* Capacity */> struct freelist {};
+
+template <size_t N> struct inline_attrs {
+    template <typename... Ts>
+    inline_attrs(const Ts &...names) : names{ (const char *) names... } { }
+    const char *names[N];
+};
+template <typename... Ts> inline_attrs(const Ts &...) -> inline_attrs<sizeof...(Ts)>;
 
 template <size_t /* Nurse */, size_t /* Patient */> struct keep_alive {};
+template <size_t /* Index */> struct move_arg {};
 template <typename T> struct supplement {};
 template <typename T> struct intrusive_ptr {
     intrusive_ptr(void (*set_self_py)(T *, PyObject *) noexcept)
@@ -149,7 +162,7 @@ template <size_t Size> struct func_data_prelim {
     const char *descr;
 
     /// C++ types referenced by 'descr'
-    const std::type_info **descr_types;
+    const std::type_info *const *descr_types;
 
     /// Supplementary flags
     uint32_t flags;
@@ -157,6 +170,9 @@ template <size_t Size> struct func_data_prelim {
     /// Total number of function call arguments
     uint32_t nargs;
 
+    /// Type of the callable in 'capture' if it can be invoked directly from C++
+    const std::type_info *native_type;
+
     // ------- Extra fields -------
 
     const char *name;
@@ -240,6 +256,9 @@ NB_INLINE void func_extra_apply(F &f, is_operator, size_t &) {
     f.flags |= (uint32_t) func_flags::is_operator;
 }
 
+template <typename F>
+NB_INLINE void func_extra_apply(F &, native_slot, size_t &) { }
+
 template <typename F>
 NB_INLINE void func_extra_apply(F &f, rv_policy pol, size_t &) {
     f.flags = (f.flags & ~0b111) | (uint16_t) pol;
@@ -266,14 +285,23 @@ NB_INLINE void func_extra_apply(F &f, const arg_v &a, size_t &index) {
 template <typename F, typename... Ts>
 NB_INLINE void func_extra_apply(F &, call_guard<Ts...>, size_t &) {}
 
+template <typename F>
+NB_INLINE void func_extra_apply(F &, gil_release, size_t &) {}
+
 template <typename F, size_t Nurse, size_t Patient>
 NB_INLINE void func_extra_apply(F &f, nanobind::keep_alive<Nurse, Patient>, size_t &) {
     f.flags |= (uint32_t) func_flags::has_keep_alive;
 }
 
+template <typename F, size_t Index>
+NB_INLINE void func_extra_apply(F &, nanobind::move_arg<Index>, size_t &) {}
+
 template <typename... Ts> struct func_extra_info {
     using call_guard = void;
     static constexpr bool keep_alive = false;
+    static constexpr bool gil_release = false;
+    /// Bit mask of the arguments annotated with nb::move_arg<..>
+    static constexpr uint64_t move_args = 0;
 };
 
 template <typename T, typename... Ts> struct func_extra_info<T, Ts...>
@@ -286,11 +314,24 @@ struct func_extra_info<nanobind::call_guard<Cs...>, Ts...> : func_extra_info<Ts.
     using call_guard = nanobind::call_guard<Cs...>;
 };
 
+template <typename... Ts>
+struct func_extra_info<nanobind::gil_release, Ts...> : func_extra_info<Ts...> {
+    static constexpr bool gil_release = true;
+};
+
 template <size_t Nurse, size_t Patient, typename... Ts>
 struct func_extra_info<nanobind::keep_alive<Nurse, Patient>, Ts...> : func_extra_info<Ts...> {
     static constexpr bool keep_alive = true;
 };
 
+template <size_t Index, typename... Ts>
+struct func_extra_info<nanobind::move_arg<Index>, Ts...> : func_extra_info<Ts...> {
+    static_assert(Index >= 1 && Index <= 64,
+                  "nb::move_arg<Index>: index must be in the range 1..64!");
+    static constexpr uint64_t move_args =
+        func_extra_info<Ts...>::move_args | ((uint64_t) 1 << (Index - 1));
+};
+
 template <typename T>
 NB_INLINE void process_keep_alive(PyObject **, PyObject *, T *) { }
 
@@ -57,8 +57,10 @@ NB_INLINE void call_init(PyObject **args, PyObject *kwnames, size_t &nargs,
 
     if constexpr (std::is_same_v<D, arg_v>) {
         args[kwargs_offset + nkwargs] = value.value.release().ptr();
-        NB_TUPLE_SET_ITEM(kwnames, nkwargs++,
-                         PyUnicode_InternFromString(value.name));
+        if (kwnames) // null when the names come from a cached tuple
+            NB_TUPLE_SET_ITEM(kwnames, nkwargs,
+                              PyUnicode_InternFromString(value.name));
+        nkwargs++;
     } else if constexpr (std::is_same_v<D, args_proxy>) {
         for (size_t i = 0, l = len(value); i < l; ++i)
             args[nargs++] = borrow(value[i]).release().ptr();
@@ -79,6 +81,14 @@ NB_INLINE void call_init(PyObject **args, PyObject *kwnames, size_t &nargs,
     (void) nkwargs; (void) kwargs_offset;
 }
 
+/// Implementation detail of api<T>::operator() (call operator)
+template <typename T>
+NB_INLINE void call_kwname(const char **names, size_t &nkwargs, const T &value) {
+    if constexpr (std::is_same_v<std::decay_t<T>, arg_v>)
+        names[nkwargs++] = value.name;
+    (void) names; (void) nkwargs; (void) value;
+}
+
 #define NB_DO_VECTORCALL()                                                     \
     PyObject *base, **args_p;                                                  \
     if constexpr (method_call) {                                               \
@@ -101,9 +111,35 @@ object api<Derived>::operator()(Args &&...args_) const {
         std::is_same_v<Derived, accessor<obj_attr>> ||
         std::is_same_v<Derived, accessor<str_attr>>;
 
-    if constexpr (((std::is_same_v<Args, arg_v> ||
-                    std::is_same_v<Args, args_proxy> ||
-                    std::is_same_v<Args, kwargs_proxy>) || ...)) {
+    if constexpr ((std::is_same_v<Args, arg_v> || ...) &&
+                  !((std::is_same_v<Args, args_proxy> ||
+                     std::is_same_v<Args, kwargs_proxy>) || ...)) {
+        // Keyword arguments with names known at the call site
+        constexpr size_t nkwargs = (0 + ... + std::is_same_v<Args, arg_v>);
+        const char *names[nkwargs];
+        size_t nargs = 0, nkwargs2 = 0;
+
+        (call_kwname(names, nkwargs2, (const Args &) args_), ...);
+
+        /* Reuse the kwnames tuple of the first call through this
+           instantiation for all later calls with the same names */
+#if defined(NB_SUBINTERPRETERS)
+        PyObject *kwnames = kwnames_cache_get(nullptr, names, nkwargs);
+#else
+        static void *cache = kwnames_cache_new(names, nkwargs);
+        PyObject *kwnames = kwnames_cache_get(cache, names, nkwargs);
+#endif
+
+        PyObject *args[sizeof...(Args) + 1];
+        nkwargs2 = 0;
+        (call_init<policy>(args + 1, nullptr, nargs, nkwargs2,
+                           sizeof...(Args) - nkwargs, (forward_t<Args>) args_),
+         ...);
+
+        NB_DO_VECTORCALL();
+    } else if constexpr (((std::is_same_v<Args, arg_v> ||
+                           std::is_same_v<Args, args_proxy> ||
+                           std::is_same_v<Args, kwargs_proxy>) || ...)) {
         // Complex call with keyword arguments, *args/**kwargs expansion, etc.
         size_t nargs = 0, nkwargs = 0, nargs2 = 0, nkwargs2 = 0;
 
@@ -66,6 +66,25 @@ enum cast_flags : uint8_t {
 /// Ask a type caster what flavors of a type it can actually produce -- may be different from 'T'
 template <typename T> using cast_t = typename make_caster<T>::template Cast<T>;
 
+/**
+ * Type casters may optionally provide a member function
+ *
+ *    template <typename T> bool can_cast() const noexcept;
+ *
+ * that reports whether a subsequent conversion to ``cast_t<T>`` will succeed.
+ * The function dispatcher queries it after ``from_python()`` so that it can
+ * move on to the next overload without throwing a ``nb::next_overload``
+ * exception from within the conversion operator.
+ */
+template <typename T, typename Caster>
+NB_INLINE auto caster_can_cast(const Caster &c, int) noexcept
+    -> decltype(c.template can_cast<T>()) {
+    return c.template can_cast<T>();
+}
+
+template <typename T, typename Caster>
+NB_INLINE bool caster_can_cast(const Caster &, long) noexcept { return true; }
+
 /// This is a default choice for the 'Cast' type alias described above. It
 /// prefers to return rvalue references to allow the caller to move the object.
 template <typename T>
@@ -233,6 +252,10 @@ template <> struct type_caster<char> {
         return PyUnicode_FromStringAndSize(&value, 1);
     }
 
+    template <typename T_> bool can_cast() const noexcept {
+        return is_pointer_v<T_> || (value && value[0] && value[1] == '\0');
+    }
+
     explicit operator const char *() { return value; }
 
     explicit operator char() {
@@ -277,6 +300,43 @@ template <typename T, typename X> struct type_caster<typed<T, X>> {
     }
 };
 
+template <> struct type_caster<pickle_buffer> {
+    NB_TYPE_CASTER(pickle_buffer, const_name("collections.abc.Buffer"))
+
+    bool from_python(handle src, uint8_t, cleanup_list *cleanup) noexcept {
+        const void *ptr;
+        size_t size;
+        if (!pickle_buffer_get(src.ptr(), cleanup, &ptr, &size))
+            return false;
+        value = pickle_buffer(ptr, size);
+        return true;
+    }
+
+    static handle from_cpp(const pickle_buffer &src, rv_policy,
+                           cleanup_list *cleanup) noexcept {
+        return pickle_buffer_new(cleanup ? cleanup->self() : nullptr,
+                                 src.data(), src.size());
+    }
+};
+
+template <> struct type_caster<bytes_view> {
+    NB_TYPE_CASTER(bytes_view, const_name("collections.abc.Buffer"))
+
+    bool from_python(handle src, uint8_t, cleanup_list *cleanup) noexcept {
+        const char *ptr;
+        size_t size;
+        if (!bytes_view_get(src.ptr(), cleanup, &ptr, &size))
+            return false;
+        value = bytes_view(ptr, size);
+        return true;
+    }
+
+    static handle from_cpp(const bytes_view &src, rv_policy,
+                           cleanup_list *) noexcept {
+        return PyBytes_FromStringAndSize(src.data(), (Py_ssize_t) src.size());
+    }
+};
+
 template <typename T>
 struct type_caster<T, enable_if_t<std::is_base_of_v<detail::api_tag, T>>> {
 public:
@@ -361,6 +421,10 @@ template <typename Type_> struct type_caster_base : type_caster_base_tag {
         }
     }
 
+    template <typename T> bool can_cast() const noexcept {
+        return is_pointer_v<T> || value != nullptr;
+    }
+
     operator Type*() { return value; }
 
     operator Type&() {
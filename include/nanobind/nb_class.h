@@ -49,9 +49,21 @@ enum class type_flags : uint32_t {
     /// If so, type_data::keep_shared_from_this_alive is also set.
     has_shared_from_this     = (1 << 12),
 
-    weak_py                  = (1 << 13)
-    // Five more flag bits available (14 through 18) without needing
-    // a larger reorganization
+    weak_py                  = (1 << 13),
+
+    /// Instances are recycled through type_data::freelist
+    has_freelist             = (1 << 14),
+
+    /// Instances are not registered in the C++ -> Python instance map
+    no_identity              = (1 << 15),
+
+    /// Is this type an enumeration created by nb::enum_<>?
+    is_enum                  = (1 << 16),
+
+    /// Instances store the attributes type_data::inline_attrs in the object
+    has_inline_attrs         = (1 << 17)
+    // One more flag bit available (18) without needing a larger
+    // reorganization
 };
 
 /// Flags about a type that are only relevant when it is being created.
@@ -80,6 +92,8 @@ enum class type_init_flags : uint32_t {
 
 // See internals.h
 struct nb_alias_chain;
+struct nb_type_stats;
+struct nb_trampoline_cache;
 
 /// Information about a type that persists throughout its lifetime
 struct type_data {
@@ -98,6 +112,27 @@ struct type_data {
     void (*set_self_py)(void *, PyObject *) noexcept;
     bool (*keep_shared_from_this_alive)(PyObject *) noexcept;
     void (*set_weak_py)(void *, PyObject *) noexcept;
+    void *freelist;
+    uint32_t freelist_size;
+    uint32_t freelist_capacity;
+    /// Recently requested base class typeids (see nb_type_get())
+    const std::type_info *base_cache[2];
+    /// Memoized outcomes of implicit conversions (see nb_type_get_implicit())
+    const std::type_info *implicit_hit;
+    const std::type_info *implicit_miss;
+    uint32_t implicit_py_hint;
+    /// Overrides resolved by instances of this type (see trampoline_new())
+    nb_trampoline_cache *trampolines;
+    /// Constructor overload chain used by the type's vectorcall (borrowed)
+    PyObject *init;
+    /// Attributes stored at 'inline_attr_offset' of instances
+    PyMemberDef *inline_attrs;
+    uint32_t inline_attr_count;
+    uint32_t inline_attr_offset;
+#if defined(NB_TYPE_STATS)
+    /// Instance accounting, shared with Python subclasses (see nb::type_stats())
+    nb_type_stats *stats;
+#endif
 #if defined(Py_LIMITED_API)
     size_t dictoffset;
 #endif
@@ -112,6 +147,7 @@ struct type_init_data : type_data {
     const PyType_Slot *type_slots;
     void (*type_slots_callback)(const type_init_data *d, PyType_Slot *&slots, size_t max_slots);
     size_t supplement;
+    const char *const *inline_attr_names;
 };
 
 NB_INLINE void type_extra_apply(type_init_data &t, const handle &h) {
@@ -160,6 +196,25 @@ NB_INLINE void type_extra_apply(type_init_data &t, dynamic_attr) {
     t.flags |= (uint32_t) type_flags::has_dynamic_attr;
 }
 
+NB_INLINE void type_extra_apply(type_init_data &t, no_identity) {
+    t.flags |= (uint32_t) type_flags::no_identity;
+}
+
+template <size_t N>
+NB_INLINE void type_extra_apply(type_init_data &t, freelist<N>) {
+    static_assert(N > 0 && N <= 0xFFFFFFFFu, "Invalid freelist capacity!");
+    t.flags |= (uint32_t) type_flags::has_freelist;
+    t.freelist_capacity = (uint32_t) N;
+}
+
+template <size_t N>
+NB_INLINE void type_extra_apply(type_init_data &t, const inline_attrs<N> &a) {
+    static_assert(N > 0, "nb::inline_attrs() requires at least one name!");
+    t.flags |= (uint32_t) type_flags::has_inline_attrs;
+    t.inline_attr_names = a.names;
+    t.inline_attr_count = (uint32_t) N;
+}
+
 template <typename T>
 NB_INLINE void type_extra_apply(type_init_data &t, supplement<T>) {
     static_assert(std::is_trivially_default_constructible_v<T>,
@@ -173,20 +228,28 @@ NB_INLINE void type_extra_apply(type_init_data &t, supplement<T>) {
 /// Information about an enum, stored as its type_data::supplement
 struct enum_supplement {
     bool is_signed = false;
+    bool is_flag = false;
     PyObject* entries = nullptr;
     PyObject* scope = nullptr;
+    /// Internal: hash table mapping values to entries (owned by nanobind)
+    void *values = nullptr;
 };
 
 /// Information needed to create an enum
 struct enum_init_data : type_init_data {
     bool is_signed = false;
     bool is_arithmetic = false;
+    bool is_flag = false;
 };
 
 NB_INLINE void type_extra_apply(enum_init_data &ed, is_arithmetic) {
     ed.is_arithmetic = true;
 }
 
+NB_INLINE void type_extra_apply(enum_init_data &ed, is_flag) {
+    ed.is_flag = true;
+}
+
 // Enums can't have base classes or supplements or be intrusive, and
 // are always final. They can't use type_slots_callback because that is
 // used by the enum mechanism internally, but can provide additional
@@ -200,6 +263,8 @@ void type_extra_apply(enum_init_data &, weak_py<T>) = delete;
 template <typename T>
 void type_extra_apply(enum_init_data &, supplement<T>) = delete;
 void type_extra_apply(enum_init_data &, is_final) = delete;
+template <size_t N>
+void type_extra_apply(enum_init_data &, const inline_attrs<N> &) = delete;
 void type_extra_apply(enum_init_data &, type_slots_callback) = delete;
 
 template <typename T> void wrap_copy(void *dst, const void *src) {
@@ -214,6 +279,59 @@ template <typename T> void wrap_destruct(void *value) noexcept {
     ((T *) value)->~T();
 }
 
+template <typename T> void wrap_assign(void *dst, const void *src) {
+    *(T *) dst = *(const T *) src;
+}
+
+/**
+ * Can def_rw()/def_ro() access the member 'D C::*' of 'T' without calling
+ * into nb_func? This requires a fixed offset (i.e., no virtual base classes),
+ * an arithmetic or non-polymorphic bound type, and no annotations except for
+ * docstrings.
+ */
+template <typename T, typename C, typename D, typename... Extra>
+constexpr bool member_native_v =
+    (std::is_same_v<C, T> || std::is_standard_layout_v<T>) &&
+    (is_buffer_scalar_v<std::remove_cv_t<D>> ||
+     (std::is_class_v<D> && is_base_caster_v<make_caster<D>> &&
+      !std::is_polymorphic_v<D>)) &&
+    (std::is_convertible_v<const Extra &, const char *> && ...);
+
+template <typename D> constexpr member_kind member_kind_for() {
+    if constexpr (std::is_same_v<D, bool>) {
+        return member_kind::bool_;
+    } else if constexpr (std::is_floating_point_v<D>) {
+        return sizeof(D) == 4 ? member_kind::f32 : member_kind::f64;
+    } else if constexpr (std::is_integral_v<D>) {
+        constexpr bool is_signed = std::is_signed_v<D>;
+        switch (sizeof(D)) {
+            case 1: return is_signed ? member_kind::i8 : member_kind::u8;
+            case 2: return is_signed ? member_kind::i16 : member_kind::u16;
+            case 4: return is_signed ? member_kind::i32 : member_kind::u32;
+            default: return is_signed ? member_kind::i64 : member_kind::u64;
+        }
+    } else {
+        return member_kind::type;
+    }
+}
+
+template <typename T, typename C, typename D>
+member_desc member_desc_for(D C::*p) {
+    using Value = std::remove_cv_t<D>;
+
+    // Byte offset of the member, determined without constructing a 'T'
+    alignas(T) unsigned char storage[sizeof(T)];
+    T *t = (T *) storage;
+    size_t offset =
+        (size_t) ((const unsigned char *) &(t->*p) - (const unsigned char *) t);
+
+    void (*assign)(void *, const void *) = nullptr;
+    if constexpr (std::is_copy_assignable_v<Value>)
+        assign = wrap_assign<Value>;
+
+    return { offset, member_kind_for<Value>(), &typeid(Value), assign };
+}
+
 template <typename, template <typename, typename> typename, typename...>
 struct extract;
 
@@ -365,6 +483,30 @@ private:
     }
 };
 
+/**
+ * Bind '__getstate__' and '__setstate__', along with a '__reduce_ex__'
+ * method that turns the nb::pickle_buffer entries of the state into
+ * out-of-band 'PickleBuffer' views when pickling with protocol 5.
+ */
+template <typename Get, typename Set> struct pickle {
+    template <typename T, typename... Ts> friend class class_;
+    NB_INLINE pickle(Get get, Set set)
+        : get((detail::forward_t<Get>) get), set((detail::forward_t<Set>) set) { }
+
+private:
+    template <typename Class, typename... Extra>
+    NB_INLINE void execute(Class &cl, const Extra&... extra) {
+        cl.def("__getstate__", (detail::forward_t<Get>) get, extra...);
+        cl.def("__setstate__", (detail::forward_t<Set>) set, extra...);
+        cl.def("__reduce_ex__", [](handle self, int protocol) {
+            return steal(detail::pickle_reduce_ex(self.ptr(), protocol));
+        });
+    }
+
+    Get get;
+    Set set;
+};
+
 template <typename T, typename... Ts>
 class class_ : public object {
 public:
@@ -391,6 +533,11 @@ public:
 
     template <typename... Extra>
     NB_INLINE class_(handle scope, const char *name, const Extra &... extra) {
+        static_assert(std::is_same_v<Alias, T> ||
+                          !(std::is_same_v<no_identity, Extra> || ...),
+                      "nb::no_identity() cannot be combined with trampolines, "
+                      "which must locate the Python instance of a C++ object!");
+
         detail::type_init_data d;
 
         d.flags = 0;
@@ -474,6 +621,12 @@ public:
         return *this;
     }
 
+    template <typename Get, typename Set, typename... Extra>
+    NB_INLINE class_ &def(pickle<Get, Set> &&pickle, const Extra &... extra) {
+        pickle.execute(*this, extra...);
+        return *this;
+    }
+
     template <typename Func, typename... Extra>
     NB_INLINE class_ &def_static(const char *name_, Func &&f,
                                  const Extra &... extra) {
@@ -544,10 +697,22 @@ public:
             std::conditional_t<detail::is_base_caster_v<detail::make_caster<D>>,
                                const D &, D &&>;
 
-        def_prop_rw(name,
-            [p](const T &c) -> const D & { return c.*p; },
-            [p](T &c, Q value) { c.*p = (Q) value; },
-            extra...);
+        auto getter = [p](const T &c) -> const D & { return c.*p; };
+        auto setter = [p](T &c, Q value) { c.*p = (Q) value; };
+
+        if constexpr (detail::member_native_v<T, C, D, Extra...>) {
+            object get_p = cpp_function(getter, scope(*this), is_method(),
+                                        is_getter(),
+                                        rv_policy::reference_internal,
+                                        extra...);
+            object set_p =
+                cpp_function(setter, scope(*this), is_method(), extra...);
+            detail::member_desc desc = detail::member_desc_for<T>(p);
+            detail::property_install_member(m_ptr, name, get_p.ptr(),
+                                            set_p.ptr(), &desc);
+        } else {
+            def_prop_rw(name, getter, setter, extra...);
+        }
 
         return *this;
     }
@@ -572,8 +737,19 @@ public:
         static_assert(std::is_base_of_v<C, T>,
                       "def_ro() requires a (base) class member!");
 
-        def_prop_ro(name,
-            [p](const T &c) -> const D & { return c.*p; }, extra...);
+        auto getter = [p](const T &c) -> const D & { return c.*p; };
+
+        if constexpr (detail::member_native_v<T, C, D, Extra...>) {
+            object get_p = cpp_function(getter, scope(*this), is_method(),
+                                        is_getter(),
+                                        rv_policy::reference_internal,
+                                        extra...);
+            detail::member_desc desc = detail::member_desc_for<T>(p);
+            detail::property_install_member(m_ptr, name, get_p.ptr(), nullptr,
+                                            &desc);
+        } else {
+            def_prop_ro(name, getter, extra...);
+        }
 
         return *this;
     }
@@ -587,6 +763,22 @@ public:
         return *this;
     }
 
+    template <typename V, typename... Extra>
+    NB_INLINE class_ &def_const_static(const char *name, V &&value,
+                                       const Extra &...extra) {
+        object o = nanobind::cast((detail::forward_t<V>) value,
+                                  std::is_lvalue_reference_v<V>
+                                      ? rv_policy::copy
+                                      : rv_policy::move);
+
+        object get_p = cpp_function([o](handle) -> object { return o; },
+                                    is_getter(), scope(*this), extra...);
+
+        detail::property_install_static_const(m_ptr, name, get_p.ptr(),
+                                              o.ptr());
+        return *this;
+    }
+
     template <detail::op_id id, detail::op_type ot, typename L, typename R, typename... Extra>
     class_ &def(const detail::op_<id, ot, L, R> &op, const Extra&... extra) {
         op.execute(*this, extra...);
@@ -616,7 +808,8 @@ public:
                    (uint32_t) detail::type_flags::is_copy_constructible |
                    (uint32_t) detail::type_flags::is_move_constructible |
                    (uint32_t) detail::type_flags::is_destructible |
-                   (uint32_t) detail::type_flags::is_final);
+                   (uint32_t) detail::type_flags::is_final |
+                   (uint32_t) detail::type_flags::is_enum);
         d.align = (uint8_t) alignof(T);
         d.size = (uint32_t) sizeof(T);
         d.name = name;
@@ -633,6 +826,7 @@ public:
 
         detail::enum_supplement &supp = type_supplement<detail::enum_supplement>(*this);
         supp.is_signed = d.is_signed;
+        supp.is_flag = d.is_flag;
         supp.scope = d.scope;
     }
 
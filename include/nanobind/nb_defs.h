@@ -110,12 +110,13 @@
 #  if PY_VERSION_HEX < 0x030C0000 || defined(PYPY_VERSION)
 #    error "nanobind can target Python's limited API, but this requires CPython >= 3.12"
 #  endif
-#  define NB_TUPLE_GET_SIZE PyTuple_Size
-#  define NB_TUPLE_GET_ITEM PyTuple_GetItem
-#  define NB_TUPLE_SET_ITEM PyTuple_SetItem
-#  define NB_LIST_GET_SIZE PyList_Size
-#  define NB_LIST_GET_ITEM PyList_GetItem
-#  define NB_LIST_SET_ITEM PyList_SetItem
+// Inlined unless the object layout couldn't be verified, see nb_lib.h
+#  define NB_TUPLE_GET_SIZE Py_SIZE
+#  define NB_TUPLE_GET_ITEM ::nanobind::detail::tuple_get_item
+#  define NB_TUPLE_SET_ITEM ::nanobind::detail::tuple_set_item
+#  define NB_LIST_GET_SIZE Py_SIZE
+#  define NB_LIST_GET_ITEM ::nanobind::detail::list_get_item
+#  define NB_LIST_SET_ITEM ::nanobind::detail::list_set_item
 #  define NB_DICT_GET_SIZE PyDict_Size
 #  define NB_SET_GET_SIZE PySet_Size
 #else
@@ -159,6 +160,33 @@
     extern "C" [[maybe_unused]] NB_EXPORT PyObject *PyInit_##name();           \
     extern "C" NB_EXPORT PyObject *PyInit_##name()
 
+#if defined(NB_SUBINTERPRETERS)
+/* Multi-phase initialization: the module body runs once per interpreter
+   that imports the extension */
+#define NB_MODULE(name, variable)                                              \
+    static PyModuleDef NB_CONCAT(nanobind_module_def_, name);                  \
+    static PyModuleDef_Slot NB_CONCAT(nanobind_module_slots_, name)[4];        \
+    [[maybe_unused]] static void NB_CONCAT(nanobind_init_,                     \
+                                           name)(::nanobind::module_ &);       \
+    static int NB_CONCAT(nanobind_exec_, name)(PyObject *m_) {                 \
+        nanobind::detail::init(NB_DOMAIN_STR);                                 \
+        nanobind::module_ m = nanobind::borrow<nanobind::module_>(m_);         \
+        try {                                                                  \
+            NB_CONCAT(nanobind_init_, name)(m);                                \
+            return 0;                                                          \
+        } catch (const std::exception &e) {                                    \
+            PyErr_SetString(PyExc_ImportError, e.what());                      \
+            return -1;                                                         \
+        }                                                                      \
+    }                                                                          \
+    NB_MODULE_IMPL(name) {                                                     \
+        return nanobind::detail::module_def_init(                              \
+            NB_TOSTRING(name), &NB_CONCAT(nanobind_module_def_, name),         \
+            NB_CONCAT(nanobind_module_slots_, name),                           \
+            NB_CONCAT(nanobind_exec_, name));                                  \
+    }                                                                          \
+    void NB_CONCAT(nanobind_init_, name)(::nanobind::module_ & (variable))
+#else
 #define NB_MODULE(name, variable)                                              \
     static PyModuleDef NB_CONCAT(nanobind_module_def_, name);                  \
     [[maybe_unused]] static void NB_CONCAT(nanobind_init_,                     \
@@ -177,4 +205,5 @@
         }                                                                      \
     }                                                                          \
     void NB_CONCAT(nanobind_init_, name)(::nanobind::module_ & (variable))
+#endif
 
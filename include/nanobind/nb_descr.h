@@ -26,11 +26,9 @@ struct descr {
 
     constexpr size_t type_count() const { return sizeof...(Ts); }
 
-    NB_INLINE void put_types(const std::type_info **out) const {
-        size_t ctr = 0;
-        ((out[ctr++] = &typeid(Ts)), ...);
-        out[ctr++] = nullptr;
-    }
+    /// 'nullptr'-terminated list of the types referenced by 'text'
+    static inline const std::type_info *const types[] = { &typeid(Ts)...,
+                                                          nullptr };
 };
 
 template <size_t N1, size_t N2, typename... Ts1, typename... Ts2, size_t... Is1, size_t... Is2>
@@ -128,6 +128,12 @@ inline void register_exception_translator(detail::exception_translator t,
     detail::register_exception_translator(t, payload);
 }
 
+template <typename T>
+void register_exception_translator(detail::exception_translator t,
+                                   void *payload = nullptr) {
+    detail::register_exception_translator_typed(&typeid(T), t, payload);
+}
+
 template <typename T>
 class exception : public object {
     NB_OBJECT_DEFAULT(exception, object, "Exception", PyExceptionClass_Check)
@@ -135,7 +141,8 @@ class exception : public object {
     exception(handle scope, const char *name, handle base = PyExc_Exception)
         : object(detail::exception_new(scope.ptr(), name, base.ptr()),
                  detail::steal_t()) {
-        detail::register_exception_translator(
+        detail::register_exception_translator_typed(
+            &typeid(T),
             [](const std::exception_ptr &p, void *payload) {
                 try {
                     std::rethrow_exception(p);
@@ -26,6 +26,63 @@ bool from_python_keep_alive(Caster &c, PyObject **args, uint8_t *args_flags,
     return true;
 }
 
+/// Was argument 'I' annotated with nb::move_arg<I + 1>()?
+template <typename Info>
+constexpr bool func_moves_arg(size_t i) {
+    return i < 64 && ((Info::move_args >> i) & 1) != 0;
+}
+
+/**
+ * Convert the caster of an argument into the parameter type. With
+ * nb::move_arg<..>, bound types are moved out of their Python instance
+ * instead of being copied.
+ */
+template <typename Arg, bool Move, typename Caster>
+NB_INLINE decltype(auto) func_cast_arg(Caster &c) {
+    if constexpr (Move) {
+        static_assert(is_base_caster_v<Caster> && !std::is_pointer_v<Arg> &&
+                          !std::is_lvalue_reference_v<Arg>,
+                      "nb::move_arg<Index>: the argument must be a bound type "
+                      "taken by value or rvalue reference!");
+        return c.operator intrinsic_t<Arg> &&();
+    } else {
+        return c.operator cast_t<Arg>();
+    }
+}
+
+/// Destruct a Python instance whose contents were moved by func_cast_arg()
+template <typename Arg, bool Move, typename Caster>
+NB_INLINE void func_release_arg(PyObject *o, Caster &c) noexcept {
+    if constexpr (Move) {
+        // Skip temporaries created by implicit conversions
+        void *p = c.operator intrinsic_t<Arg> *();
+        if (p && nb_type_check((PyObject *) Py_TYPE(o)) && nb_inst_ptr(o) == p)
+            nb_inst_destruct(o);
+    } else {
+        (void) o; (void) c;
+    }
+}
+
+/// Runs 'func_release_arg()' once the call returns or fails
+template <typename F> struct func_release_guard {
+    F f;
+    ~func_release_guard() { f(); }
+};
+template <typename F> func_release_guard(F) -> func_release_guard<F>;
+
+/// Detects std::function<..> (without having to include <functional>)
+template <typename T>
+using has_target_type = decltype(std::declval<const T &>().target_type());
+
+/// RAII helper that releases the GIL for the nb::gil_release annotation
+struct func_gil_release {
+    func_gil_release() noexcept : state(PyEval_SaveThread()) { }
+    ~func_gil_release() { PyEval_RestoreThread(state); }
+    func_gil_release(const func_gil_release &) = delete;
+    func_gil_release& operator=(const func_gil_release &) = delete;
+    PyThreadState *state;
+};
+
 template <bool ReturnRef, bool CheckGuard, typename Func, typename Return,
           typename... Args, size_t... Is, typename... Extra>
 NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
@@ -70,6 +127,14 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
         "nb::kwargs must be the last element of the function signature!");
     static_assert(args_pos_1 == nargs || args_pos_1 + 1 == kwargs_pos_1,
         "nb::args must follow positional arguments and precede nb::kwargs!");
+    static_assert(nargs >= 64 || (Info::move_args >> nargs) == 0,
+        "nb::move_arg<Index>: index exceeds the number of arguments!");
+    static_assert(!Info::gil_release ||
+        ((!std::is_base_of_v<object, std::decay_t<Args>> ||
+          std::is_reference_v<Args>) && ... &&
+         !std::is_base_of_v<object, std::decay_t<Return>>),
+        "nb::gil_release: Python objects can only be passed by reference and "
+        "cannot be returned, since the function runs without holding the GIL!");
 
     // Collect function signature information for the docstring
     using cast_out = make_caster<
@@ -82,10 +147,6 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
             make_caster<remove_opt_mono_t<intrinsic_t<Args>>>::Name)...) +
         const_name(") -> ") + cast_out::Name;
 
-    // std::type_info for all function arguments
-    const std::type_info* descr_types[descr.type_count() + 1];
-    descr.put_types(descr_types);
-
     // Auxiliary data structure to capture the provided function/closure
     struct capture {
         std::remove_reference_t<Func> func;
@@ -144,15 +205,41 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
                 return NB_NEXT_OVERLOAD;
         }
 
+        if ((!caster_can_cast<Args>(in.template get<Is>(), 0) || ...))
+            return NB_NEXT_OVERLOAD;
+
+        auto release = [&]() NB_INLINE_LAMBDA {
+            (func_release_arg<Args, func_moves_arg<Info>(Is)>(
+                 args[Is], in.template get<Is>()), ...);
+        };
+        func_release_guard<decltype(release)> release_guard{ release };
+        (void) release_guard;
+
         PyObject *result;
-        if constexpr (std::is_void_v<Return>) {
-            cap->func(in.template get<Is>().operator cast_t<Args>()...);
+        if constexpr (Info::gil_release) {
+            // Only release the GIL once all arguments have been converted
+            auto call = [&]() NB_INLINE_LAMBDA -> Return {
+                func_gil_release guard;
+                return cap->func(func_cast_arg<Args, func_moves_arg<Info>(Is)>(
+                    in.template get<Is>())...);
+            };
+
+            if constexpr (std::is_void_v<Return>) {
+                call();
+                result = Py_None;
+                Py_INCREF(result);
+            } else {
+                result = cast_out::from_cpp(call(), policy, cleanup).ptr();
+            }
+        } else if constexpr (std::is_void_v<Return>) {
+            cap->func(func_cast_arg<Args, func_moves_arg<Info>(Is)>(
+                in.template get<Is>())...);
             result = Py_None;
             Py_INCREF(result);
         } else {
             result = cast_out::from_cpp(
-                       cap->func((in.template get<Is>())
-                                     .operator cast_t<Args>()...),
+                       cap->func(func_cast_arg<Args, func_moves_arg<Info>(Is)>(
+                                     in.template get<Is>())...),
                        policy, cleanup).ptr();
         }
 
@@ -162,10 +249,23 @@ NB_INLINE PyObject *func_create(Func &&func, Return (*)(Args...),
         return result;
     };
 
+    // Both refer to static data that is never copied
     f.descr = descr.text;
-    f.descr_types = descr_types;
+    f.descr_types = descr.types;
     f.nargs = nargs;
 
+    /* Function pointers and std::function<..> objects passed to a
+       std::function<..> parameter can be called without a detour through
+       Python, unless an annotation requires the nanobind dispatcher */
+    using FuncT = std::remove_cv_t<std::remove_reference_t<Func>>;
+    if constexpr ((std::is_pointer_v<FuncT> ||
+                   is_detected_v<has_target_type, FuncT>) &&
+                  !Info::keep_alive && !Info::gil_release &&
+                  !Info::move_args && !is_method_det)
+        f.native_type = &typeid(FuncT);
+    else
+        f.native_type = nullptr;
+
     // Fill remaining fields of 'f'
     size_t arg_index = 0;
     (void) arg_index;
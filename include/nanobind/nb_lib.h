@@ -18,6 +18,65 @@ NAMESPACE_BEGIN(detail)
 struct ndarray_handle;
 struct ndarray_req;
 
+#if defined(Py_LIMITED_API)
+/**
+ * The limited API hides the layout of tuples and lists. libnanobind verifies
+ * the CPython layout at runtime and records the byte offsets of the item
+ * storage here, so that the NB_TUPLE_* and NB_LIST_* accessors can be
+ * inlined. The offsets are zero if the layout is unexpected, and accessors
+ * then call the corresponding API functions.
+ */
+struct seq_layout_t {
+    /// Offset of the item array of tuples
+    Py_ssize_t tuple_items;
+    /// Offset of the pointer to the item array of lists
+    Py_ssize_t list_items;
+};
+
+extern NB_CORE seq_layout_t seq_layout;
+
+NB_INLINE PyObject **tuple_items(PyObject *o) noexcept {
+    return (PyObject **) ((char *) o + seq_layout.tuple_items);
+}
+
+NB_INLINE PyObject **list_items(PyObject *o) noexcept {
+    return *(PyObject ***) ((char *) o + seq_layout.list_items);
+}
+
+NB_INLINE PyObject *tuple_get_item(PyObject *o, Py_ssize_t i) noexcept {
+    if (NB_LIKELY(seq_layout.tuple_items))
+        return tuple_items(o)[i];
+    return PyTuple_GetItem(o, i);
+}
+
+NB_INLINE PyObject *list_get_item(PyObject *o, Py_ssize_t i) noexcept {
+    if (NB_LIKELY(seq_layout.list_items))
+        return list_items(o)[i];
+    return PyList_GetItem(o, i);
+}
+
+// Like PyTuple_SetItem() and PyList_SetItem(), these steal 'v' and release the old entry
+NB_INLINE void tuple_set_item(PyObject *o, Py_ssize_t i, PyObject *v) noexcept {
+    if (NB_LIKELY(seq_layout.tuple_items)) {
+        PyObject **p = tuple_items(o) + i, *old = *p;
+        *p = v;
+        Py_XDECREF(old);
+    } else {
+        PyTuple_SetItem(o, i, v);
+    }
+}
+
+NB_INLINE void list_set_item(PyObject *o, Py_ssize_t i, PyObject *v) noexcept {
+    if (NB_LIKELY(seq_layout.list_items)) {
+        PyObject **p = list_items(o) + i, *old = *p;
+        *p = v;
+        Py_XDECREF(old);
+    } else {
+        PyList_SetItem(o, i, v);
+    }
+}
+#endif
+
 /**
  * Helper class to clean temporaries created by function dispatch.
  * The first element serves a special role: it stores the 'self'
@@ -131,6 +190,10 @@ NB_CORE PyObject *bytes_from_cstr(const char *c);
 /// Convert an UTF8 C string + size into a Python byte string
 NB_CORE PyObject *bytes_from_cstr_and_size(const char *c, size_t n);
 
+/// Access the bytes of a byte string or contiguous buffer until 'cleanup' is released
+NB_CORE bool bytes_view_get(PyObject *o, cleanup_list *cleanup,
+                            const char **ptr, size_t *size) noexcept;
+
 // ========================================================================
 
 /// Convert a Python object into a Python boolean object
@@ -150,6 +213,9 @@ NB_CORE PyObject *list_from_obj(PyObject *o);
 /// Convert a Python object into a Python tuple
 NB_CORE PyObject *tuple_from_obj(PyObject *o);
 
+/// Create an empty dictionary with space for 'size' items (nullptr on failure)
+NB_CORE PyObject *dict_new_presized(size_t size) noexcept;
+
 // ========================================================================
 
 /// Get an object attribute or raise an exception
@@ -179,6 +245,11 @@ NB_CORE void getitem_or_raise(PyObject *obj, Py_ssize_t, PyObject **out);
 NB_CORE void getitem_or_raise(PyObject *obj, const char *key, PyObject **out);
 NB_CORE void getitem_or_raise(PyObject *obj, PyObject *key, PyObject **out);
 
+/// Index into an object or return a default value if the lookup raised
+/// a 'LookupError' (i.e. 'KeyError' or 'IndexError'). Other errors propagate.
+NB_CORE PyObject *getitem(PyObject *obj, const char *key, PyObject *def);
+NB_CORE PyObject *getitem(PyObject *obj, PyObject *key, PyObject *def);
+
 /// Set an item or raise an exception
 NB_CORE void setitem(PyObject *obj, Py_ssize_t, PyObject *value);
 NB_CORE void setitem(PyObject *obj, const char *key, PyObject *value);
@@ -215,6 +286,17 @@ NB_CORE PyObject *obj_vectorcall(PyObject *base, PyObject *const *args,
                                  size_t nargsf, PyObject *kwnames,
                                  bool method_call);
 
+/// Create a cache record for the keyword argument names of a call site
+NB_CORE void *kwnames_cache_new(const char *const *names, size_t n);
+
+/**
+ * \brief Return a new reference to a tuple of interned keyword names. The
+ * tuple recorded in 'cache' is reused if it holds the same names, otherwise
+ * (or if 'cache' is null) a new one is created.
+ */
+NB_CORE PyObject *kwnames_cache_get(void *cache, const char *const *names,
+                                    size_t n);
+
 /// Create an iterator from 'o', raise an exception in case of errors
 NB_CORE PyObject *obj_iter(PyObject *o);
 
@@ -251,6 +333,53 @@ NB_CORE PyObject **seq_get_with_size(PyObject *seq, size_t size,
 NB_CORE PyObject **seq_get(PyObject *seq, size_t *size,
                            PyObject **temp) noexcept;
 
+/// Inline version of seq_get_with_size() that directly accesses the items of
+/// non-empty exact tuples and lists
+NB_INLINE PyObject **seq_get_with_size_inline(PyObject *seq, size_t size,
+                                              PyObject **temp) noexcept {
+#if !defined(PYPY_VERSION)
+    PyObject **items = nullptr;
+#  if defined(Py_LIMITED_API)
+    if (PyTuple_CheckExact(seq) && seq_layout.tuple_items)
+        items = tuple_items(seq);
+    else if (PyList_CheckExact(seq) && seq_layout.list_items)
+        items = list_items(seq);
+#  else
+    if (PyTuple_CheckExact(seq))
+        items = ((PyTupleObject *) seq)->ob_item;
+    else if (PyList_CheckExact(seq))
+        items = ((PyListObject *) seq)->ob_item;
+#  endif
+
+    if (items && size && (size_t) Py_SIZE(seq) == size) {
+        *temp = nullptr;
+        return items;
+    }
+#endif
+
+    return seq_get_with_size(seq, size, temp);
+}
+
+/* Return an iterator over the items of a sequence (excluding 'str' and
+   'bytes') and store its length hint in 'size_hint'. Returns NULL without
+   raising an error when the input is unsuitable. */
+NB_CORE PyObject *seq_iter(PyObject *seq, size_t *size_hint) noexcept;
+
+/* Fetch up to 'n' items (new references) from the iterator 'iter' into
+   'out'. A result smaller than 'n' indicates that the iterator is exhausted.
+   Returns '(size_t) -1' and clears the error state in case of a failure. */
+NB_CORE size_t iter_next_chunk(PyObject *iter, PyObject **out,
+                               size_t n) noexcept;
+
+/* Bulk-load a 1D buffer of numbers into storage returned by 'alloc' (given
+   the element count). 'kind' and 'itemsize' describe the destination type
+   ('b': bool, 'i': signed, 'u': unsigned, 'f': floating point). Returns
+   'false' without raising an error when the input is unsuitable. */
+NB_CORE bool seq_get_buffer(PyObject *seq, char kind, size_t itemsize,
+                            bool convert,
+                            void *(*alloc)(void *, size_t) noexcept,
+                            void *payload) noexcept;
+
 // ========================================================================
 
 /// Create a new capsule object with a name
@@ -262,6 +391,10 @@ NB_CORE PyObject *capsule_new(const void *ptr, const char *name,
 /// Create a Python function object for the given function record
 NB_CORE PyObject *nb_func_new(const void *data) noexcept;
 
+/* Return the 'capture' field of 'o' if it is a nanobind function with a
+   single overload wrapping a plain C++ callable of the given type */
+NB_CORE void *nb_func_native(PyObject *o, const std::type_info *type) noexcept;
+
 // ========================================================================
 
 /// Create a Python type object for the given type record
@@ -277,6 +410,16 @@ NB_CORE PyObject *nb_type_put(const std::type_info *cpp_type, void *value,
                               rv_policy rvp, cleanup_list *cleanup,
                               bool *is_new = nullptr) noexcept;
 
+/**
+ * \brief Convert an array of pointers to instances of a non-polymorphic type
+ * into a Python list, performing the type lookup only once. Null pointers
+ * map to ``None``.
+ */
+NB_CORE PyObject *nb_type_put_list(const std::type_info *cpp_type,
+                                   void *const *values, size_t size,
+                                   rv_policy rvp,
+                                   cleanup_list *cleanup) noexcept;
+
 // Special version of nb_type_put for polymorphic classes
 NB_CORE PyObject *nb_type_put_p(const std::type_info *cpp_type,
                                 const std::type_info *cpp_type_p, void *value,
@@ -379,6 +522,40 @@ NB_CORE void property_install_static(PyObject *scope, const char *name,
                                      PyObject *getter,
                                      PyObject *setter) noexcept;
 
+/**
+ * Create and install a read-only static property that returns 'value'
+ * without dispatching to 'getter', which must hold a reference to 'value'
+ */
+NB_CORE void property_install_static_const(PyObject *scope, const char *name,
+                                           PyObject *getter,
+                                           PyObject *value) noexcept;
+
+/// Storage formats of data members that def_rw()/def_ro() access directly
+enum class member_kind : uint8_t {
+    bool_, i8, u8, i16, u16, i32, u32, i64, u64, f32, f64, type
+};
+
+/// Location and format of a data member (see property_install_member())
+struct member_desc {
+    /// Offset of the field relative to the start of the C++ instance
+    size_t offset;
+
+    member_kind kind;
+
+    /// The field's bound type and a copy-assignment function (member_kind::type)
+    const std::type_info *type;
+    void (*assign)(void *dst, const void *src);
+};
+
+/**
+ * Create and install a property that reads and writes the field described
+ * by 'desc' without dispatching to 'getter' or 'setter'. The functions are
+ * still called when this isn't possible, e.g. to report conversion errors.
+ */
+NB_CORE void property_install_member(PyObject *scope, const char *name,
+                                     PyObject *getter, PyObject *setter,
+                                     const member_desc *desc) noexcept;
+
 // ========================================================================
 
 NB_CORE PyObject *get_override(void *ptr, const std::type_info *type,
@@ -393,6 +570,17 @@ NB_CORE void keep_alive(PyObject *nurse, PyObject *patient);
 NB_CORE void keep_alive(PyObject *nurse, void *payload,
                         void (*deleter)(void *) noexcept) noexcept;
 
+/**
+ * Look up the payload that was attached to the nanobind instance 'nurse'
+ * with the given 'deleter', and call 'func(&payload, arg)' while holding the
+ * lock that protects it. The payload is 'nullptr' if there is none. When
+ * 'func' sets it, the new payload is attached to 'nurse' as in keep_alive().
+ */
+NB_CORE void keep_alive_visit(PyObject *nurse,
+                              void (*deleter)(void *) noexcept,
+                              void (*func)(void **, void *) noexcept,
+                              void *arg) noexcept;
+
 
 // ========================================================================
 
@@ -427,10 +615,20 @@ NB_CORE PyObject *module_import(const char *name);
 /// Create a new extension module with the given name
 NB_CORE PyObject *module_new(const char *name, PyModuleDef *def) noexcept;
 
+#if defined(NB_SUBINTERPRETERS)
+/// Prepare a module definition for multi-phase initialization (PEP 489)
+NB_CORE PyObject *module_def_init(const char *name, PyModuleDef *def,
+                                  PyModuleDef_Slot *slots,
+                                  int (*exec)(PyObject *)) noexcept;
+#endif
+
 /// Create a submodule of an existing module
 NB_CORE PyObject *module_new_submodule(PyObject *base, const char *name,
                                        const char *doc) noexcept;
 
+/// Enable/disable deferred creation of functions bound to a module
+NB_CORE void module_lazy(PyObject *module, bool value);
+
 
 // ========================================================================
 
@@ -446,6 +644,35 @@ NB_CORE ndarray_handle *ndarray_create(void *value, size_t ndim,
                                        dlpack::dtype *dtype, bool ro,
                                        int32_t device, int32_t device_id);
 
+// Like ndarray_create(), but reserve 'payload_size' bytes within the handle
+// (returned via 'payload') for the caller to construct the owner of the data.
+// 'payload_free' destroys it when the handle expires.
+NB_CORE ndarray_handle *
+ndarray_create_payload(void *value, size_t ndim, const size_t *shape,
+                       const int64_t *strides, dlpack::dtype *dtype, bool ro,
+                       int32_t device, int32_t device_id, size_t payload_size,
+                       void (*payload_free)(void *) noexcept, void **payload);
+
+// Describe a C-contiguous ndarray backed by a private mapping of a file
+// ('advice': 0 = normal, 1 = sequential, 2 = random access)
+NB_CORE ndarray_handle *ndarray_map_file(const char *path, uint64_t offset,
+                                         size_t ndim, const size_t *shape,
+                                         dlpack::dtype *dtype,
+                                         bool copy_on_write, bool ro,
+                                         int advice);
+
+// Allocate a C-contiguous ndarray from nanobind's memory pool
+NB_CORE ndarray_handle *ndarray_alloc(size_t ndim, const size_t *shape,
+                                      dlpack::dtype *dtype, bool ro,
+                                      int32_t device, int32_t device_id);
+
+// Copy the entries of a CPU ndarray into contiguous C- or F-ordered storage of
+// the given dtype. The GIL is released while up to 'threads' threads (all
+// hardware threads if zero) perform the conversion.
+NB_CORE void ndarray_copy_to(ndarray_handle *th, void *out,
+                             const dlpack::dtype *dtype, char order,
+                             size_t threads);
+
 /// Increase the reference count of the given ndarray object; returns a pointer
 /// to the underlying DLTensor
 NB_CORE dlpack::dltensor *ndarray_inc_ref(ndarray_handle *) noexcept;
@@ -460,6 +687,76 @@ NB_CORE PyObject *ndarray_wrap(ndarray_handle *, int framework,
 /// Check if an object is a known ndarray type (NumPy, PyTorch, Tensorflow, JAX)
 NB_CORE bool ndarray_check(PyObject *o) noexcept;
 
+/// Set the stream passed to '__dlpack__()' by ndarray_import() on the current
+/// thread ('set == false' means no stream); returns the previous setting
+NB_CORE bool ndarray_set_stream(bool set, intptr_t stream,
+                                intptr_t *prev_stream) noexcept;
+
+/// Expose C-contiguous CPU data owned by 'exporter' via the buffer protocol
+/// (implements 'bf_getbuffer' of bound containers like nb::bind_vector())
+NB_CORE int ndarray_export_buffer(PyObject *exporter, void *data, size_t ndim,
+                                  const size_t *shape,
+                                  const dlpack::dtype *dtype, bool ro,
+                                  Py_buffer *view, int flags) noexcept;
+
+/**
+ * Expose a contiguous array of 'size' instances of the bound 'type' via the
+ * buffer protocol, using a struct format built from the arithmetic fields
+ * that def_rw() and def_ro() registered for the type
+ */
+NB_CORE int ndarray_export_struct_buffer(PyObject *exporter, void *data,
+                                         size_t size,
+                                         const std::type_info *type, bool ro,
+                                         Py_buffer *view, int flags) noexcept;
+
+/// Counterpart of ndarray_export_buffer() and ndarray_export_struct_buffer()
+/// ('bf_releasebuffer')
+NB_CORE void ndarray_release_buffer(PyObject *exporter,
+                                    Py_buffer *view) noexcept;
+
+/// Return the (cached) type 'scipy.sparse.csr_matrix' or 'csc_matrix' as a
+/// borrowed reference, or nullptr with an error set if it cannot be imported
+NB_CORE PyObject *scipy_sparse_type(bool csr) noexcept;
+
+// ========================================================================
+
+/// Import an object implementing '__arrow_c_array__' (returns nullptr on failure)
+NB_CORE PyObject *arrow_import(PyObject *o) noexcept;
+
+/// Import an object implementing '__arrow_c_stream__' (returns nullptr on failure)
+NB_CORE PyObject *arrow_stream_import(PyObject *o) noexcept;
+
+/// Fetch the next chunk of an imported stream, or 'None' after the last one
+NB_CORE PyObject *arrow_stream_next(PyObject *stream);
+
+/// Export a primitive array as an '(arrow_schema, arrow_array)' capsule pair
+NB_CORE PyObject *arrow_export(PyObject *owner, const dlpack::dtype *dtype,
+                               int64_t length, const void *validity,
+                               const void *values);
+
+// ========================================================================
+
+/// Type-erased state of a C++ computation exposed as an asyncio future
+struct future_state {
+    /// Event loop and asyncio future (set by future_create())
+    PyObject *loop = nullptr, *future = nullptr;
+
+    /// Next entry in the queue of completed computations
+    future_state *next = nullptr;
+
+    /// Cast the result to Python (invoked by the event loop thread)
+    PyObject *(*resolve)(future_state *) = nullptr;
+
+    /// Release the state (invoked while holding the GIL)
+    void (*release)(future_state *) noexcept = nullptr;
+};
+
+/// Create an asyncio future on the running event loop that is resolved via 'state'
+NB_CORE PyObject *future_create(future_state *state) noexcept;
+
+/// Signal completion of 'state'. May be called from any thread without the GIL
+NB_CORE void future_complete(future_state *state) noexcept;
+
 // ========================================================================
 
 /// Print to stdout using Python
@@ -472,6 +769,14 @@ typedef void (*exception_translator)(const std::exception_ptr &, void *);
 NB_CORE void register_exception_translator(exception_translator translator,
                                            void *payload);
 
+/// Like the above, but dispatch exceptions of the exact type 'type' directly
+NB_CORE void register_exception_translator_typed(const std::type_info *type,
+                                                 exception_translator translator,
+                                                 void *payload);
+
+/// Translate the currently active C++ exception into a Python error
+NB_CORE void nb_translate_exception() noexcept;
+
 NB_CORE PyObject *exception_new(PyObject *mod, const char *name,
                                 PyObject *base);
 
@@ -496,6 +801,20 @@ NB_CORE void incref_checked(PyObject *o) noexcept;
 /// Decrease the reference count of 'o', and check that the GIL is held
 NB_CORE void decref_checked(PyObject *o) noexcept;
 
+/// Decrease the reference count of 'o' from any thread, possibly at a later point
+NB_CORE void decref_deferred(PyObject *o) noexcept;
+
+/// Decrease the reference counts of 'size' objects from any thread at once
+NB_CORE void decref_deferred(PyObject *const *o, size_t size) noexcept;
+
+/**
+ * \brief Queue 'func(payload)' to run on a thread holding the GIL, at the
+ * interpreter's next opportunity. Can be called from any thread. Returns
+ * 'false' when this isn't supported (subinterpreter builds).
+ */
+NB_CORE bool deferred_schedule(void (*func)(void *) noexcept,
+                               void *payload) noexcept;
+
 // ========================================================================
 
 NB_CORE void set_leak_warnings(bool value) noexcept;
@@ -503,6 +822,35 @@ NB_CORE void set_implicit_cast_warnings(bool value) noexcept;
 
 // ========================================================================
 
+NB_CORE void set_profiling(bool value) noexcept;
+NB_CORE void profiling_reset() noexcept;
+NB_CORE PyObject *profiling_snapshot();
+NB_CORE PyObject *type_stats();
+NB_CORE PyObject *registration_stats();
+
+/// Places that acquire the GIL on behalf of C++ code (see set_gil_profiling())
+enum class gil_site : uint32_t {
+    gil_scoped_acquire, trampoline, callback, count
+};
+
+/**
+ * \brief Acquire the GIL via PyGILState_Ensure(), recording the wait time if
+ * the GIL profiler is enabled. Sets '*start' to the time of acquisition, or
+ * zero if the profiler is disabled.
+ */
+NB_CORE PyGILState_STATE gil_state_ensure(gil_site site,
+                                          uint64_t *start) noexcept;
+
+/// Counterpart of gil_state_ensure(), which also records the hold time
+NB_CORE void gil_state_release(gil_site site, PyGILState_STATE state,
+                               uint64_t start) noexcept;
+
+NB_CORE void set_gil_profiling(bool value) noexcept;
+NB_CORE void gil_profiling_reset() noexcept;
+NB_CORE PyObject *gil_profiling_snapshot();
+
+// ========================================================================
+
 NB_CORE bool iterable_check(PyObject *o) noexcept;
 
 // ========================================================================
@@ -513,6 +861,19 @@ NB_CORE void slice_compute(PyObject *slice, Py_ssize_t size,
 
 // ========================================================================
 
+/// Create a read-only buffer that references memory owned by 'owner'
+NB_CORE PyObject *pickle_buffer_new(PyObject *owner, const void *ptr,
+                                    size_t size) noexcept;
+
+/// Access the contiguous buffer of 'o' until 'cleanup' is released
+NB_CORE bool pickle_buffer_get(PyObject *o, cleanup_list *cleanup,
+                               const void **ptr, size_t *size) noexcept;
+
+/// Implementation of '__reduce_ex__' for classes bound with nb::pickle
+NB_CORE PyObject *pickle_reduce_ex(PyObject *self, int protocol);
+
+// ========================================================================
+
 NB_CORE PyObject *repr_list(PyObject *o);
 NB_CORE PyObject *repr_map(PyObject *o);
 
@@ -527,5 +888,6 @@ NAMESPACE_END(detail)
 using detail::raise;
 using detail::raise_type_error;
 using detail::raise_python_error;
+using detail::decref_deferred;
 
 NAMESPACE_END(NB_NAMESPACE)
@@ -11,12 +11,17 @@ NAMESPACE_BEGIN(NB_NAMESPACE)
 
 struct gil_scoped_acquire {
 public:
-    gil_scoped_acquire() noexcept : state(PyGILState_Ensure()) { }
-    ~gil_scoped_acquire() { PyGILState_Release(state); }
+    gil_scoped_acquire() noexcept
+        : gil_scoped_acquire(detail::gil_site::gil_scoped_acquire) { }
+    explicit gil_scoped_acquire(detail::gil_site site) noexcept
+        : site(site), state(detail::gil_state_ensure(site, &start)) { }
+    ~gil_scoped_acquire() { detail::gil_state_release(site, state, start); }
     gil_scoped_acquire(const gil_scoped_acquire &) = delete;
     gil_scoped_acquire& operator=(const gil_scoped_acquire &) = delete;
 
 private:
+    detail::gil_site site;
+    uint64_t start;
     const PyGILState_STATE state;
 };
 
@@ -39,6 +44,38 @@ inline void set_implicit_cast_warnings(bool value) noexcept {
     detail::set_implicit_cast_warnings(value);
 }
 
+inline void set_profiling(bool value) noexcept {
+    detail::set_profiling(value);
+}
+
+inline void profiling_reset() noexcept {
+    detail::profiling_reset();
+}
+
+inline dict profiling_snapshot() {
+    return steal<dict>(detail::profiling_snapshot());
+}
+
+inline void set_gil_profiling(bool value) noexcept {
+    detail::set_gil_profiling(value);
+}
+
+inline void gil_profiling_reset() noexcept {
+    detail::gil_profiling_reset();
+}
+
+inline dict gil_profiling_snapshot() {
+    return steal<dict>(detail::gil_profiling_snapshot());
+}
+
+inline dict type_stats() {
+    return steal<dict>(detail::type_stats());
+}
+
+inline dict registration_stats() {
+    return steal<dict>(detail::registration_stats());
+}
+
 inline dict globals() {
     PyObject *p = PyEval_GetGlobals();
     if (!p)
@@ -50,4 +87,34 @@ inline bool is_alive() noexcept {
     return detail::is_alive();
 }
 
+NAMESPACE_BEGIN(detail)
+
+/// Create an interned string (new reference), or raise an exception
+NB_NOINLINE inline PyObject *str_intern(const char *s) {
+    PyObject *result = PyUnicode_InternFromString(s);
+    if (!result)
+        raise_python_error();
+    return result;
+}
+
+NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
+
+/**
+ * \brief Return an interned Python ``str`` for the string literal ``s``
+ *
+ * The string is created once when a call site first executes, which avoids
+ * creating a temporary string for each ``.attr()`` or ``[]`` access, e.g.
+ * ``obj.attr(NB_INTERN("name"))``. Subinterpreter builds can't share objects
+ * between interpreters and create the string each time instead.
+ */
+#if !defined(NB_SUBINTERPRETERS)
+#  define NB_INTERN(s)                                                         \
+    ([]() -> ::nanobind::str {                                                 \
+        static PyObject *nb_interned_ = ::nanobind::detail::str_intern(s);    \
+        return ::nanobind::borrow<::nanobind::str>(nb_interned_);              \
+    }())
+#else
+#  define NB_INTERN(s)                                                         \
+    ::nanobind::steal<::nanobind::str>(::nanobind::detail::str_intern(s))
+#endif
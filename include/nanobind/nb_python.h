@@ -59,3 +59,12 @@
 #if PY_VERSION_HEX < 0x03080000
 #  error The nanobind library requires Python 3.8 (or newer)
 #endif
+
+#if defined(NB_SUBINTERPRETERS) &&                                             \
+    (PY_VERSION_HEX < 0x030C0000 || defined(Py_LIMITED_API) || defined(PYPY_VERSION))
+#  error NB_SUBINTERPRETERS requires CPython 3.12 (or newer) and is incompatible with the stable ABI
+#endif
+
+#if defined(NB_FREE_THREADED) && !defined(Py_GIL_DISABLED)
+#  error NB_FREE_THREADED requires a free-threaded Python build (3.13 or newer)
+#endif
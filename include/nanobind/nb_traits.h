@@ -66,6 +66,18 @@ constexpr bool is_std_char_v =
     || std::is_same_v<T, char16_t> ||
     std::is_same_v<T, char32_t> || std::is_same_v<T, wchar_t>;
 
+/// Arithmetic types that the STL casters can bulk-load from buffer objects
+template <typename T>
+constexpr bool is_buffer_scalar_v =
+    std::is_arithmetic_v<T> && !is_std_char_v<T> && sizeof(T) <= 8;
+
+/// Element kind passed to seq_get_buffer() for the given arithmetic type
+template <typename T>
+constexpr char buffer_kind_v = std::is_same_v<T, bool>     ? 'b'
+                               : std::is_floating_point_v<T> ? 'f'
+                               : std::is_signed_v<T>         ? 'i'
+                                                             : 'u';
+
 template <bool V> using enable_if_t = std::enable_if_t<V, int>;
 
 /// Check if a function is a lambda function
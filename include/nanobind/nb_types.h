@@ -294,6 +294,14 @@ inline object getattr(handle h, handle key, handle value) noexcept {
     return steal(detail::getattr(h.ptr(), key.ptr(), value.ptr()));
 }
 
+inline object getitem(handle h, const char *key, handle def) {
+    return steal(detail::getitem(h.ptr(), key, def.ptr()));
+}
+
+inline object getitem(handle h, handle key, handle def) {
+    return steal(detail::getitem(h.ptr(), key.ptr(), def.ptr()));
+}
+
 inline void setattr(handle h, const char *key, handle value) {
     detail::setattr(h.ptr(), key, value.ptr());
 }
@@ -327,6 +335,15 @@ public:
                                     const char *doc = nullptr) {
         return borrow<module_>(detail::module_new_submodule(m_ptr, name, doc));
     }
+
+    /**
+     * \brief Defer the creation of functions bound via def() until their
+     * first attribute access (or until lazy mode is disabled again)
+     */
+    NB_INLINE module_ &lazy(bool value = true) {
+        detail::module_lazy(m_ptr, value);
+        return *this;
+    }
 };
 
 class capsule : public object {
@@ -691,6 +708,50 @@ template <typename T> struct pointer_and_handle {
     handle h;
 };
 
+/**
+ * Contiguous memory region that is part of the pickled state of an object
+ * (see nb::pickle). Returned from ``__getstate__``, it becomes a view that
+ * references memory of the instance. Passed to ``__setstate__``, it refers to
+ * the memory of the received buffer object until the call returns.
+ */
+class pickle_buffer {
+public:
+    pickle_buffer() = default;
+    pickle_buffer(const void *data, size_t size) : m_data(data), m_size(size) { }
+
+    const void *data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const void *m_data = nullptr;
+    size_t m_size = 0;
+};
+
+/**
+ * Read-only view of the contents of a ``bytes`` object or another contiguous
+ * buffer (``bytearray``, ``memoryview``, NumPy arrays, ...). When used as a
+ * function parameter, it refers to the memory of the argument without making
+ * a copy. The view remains valid until the call returns.
+ */
+class bytes_view {
+public:
+    bytes_view() = default;
+    bytes_view(const char *data, size_t size) : m_data(data), m_size(size) { }
+
+    const char *data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    const char *begin() const { return m_data; }
+    const char *end() const { return m_data + m_size; }
+
+    char operator[](size_t i) const { return m_data[i]; }
+
+private:
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+};
+
 NAMESPACE_BEGIN(detail)
 template <typename Derived> NB_INLINE api<Derived>::operator handle() const {
     return derived().ptr();
@@ -13,7 +13,21 @@
 #pragma once
 
 #include <nanobind/nanobind.h>
+#include <nanobind/stl/detail/nb_list.h>
+#include <nanobind/stl/detail/nb_array.h>
 #include <initializer_list>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <vector>
+#include <array>
+
+#if defined(__has_include)
+#  if __has_include(<stdfloat>)
+#    include <stdfloat>
+#  endif
+#endif
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 
@@ -80,12 +94,21 @@ template <size_t... Is> struct shape {
 struct c_contig { };
 struct f_contig { };
 struct any_contig { };
+
+/// Require the data pointer to be aligned to a multiple of 'N' bytes
+template <size_t N> struct align {
+    static_assert(N > 0 && (N & (N - 1)) == 0 && N <= 64,
+                  "nanobind::align<N>: N must be a power of two <= 64!");
+};
 struct numpy { };
 struct tensorflow { };
 struct pytorch { };
 struct jax { };
 struct ro { };
 
+/// Expected access pattern of a memory-mapped array (see ndarray::map_file())
+enum class mmap_advice { normal, sequential, random };
+
 template <typename T> struct ndarray_traits {
     static constexpr bool is_complex = detail::is_complex<T>::value;
     static constexpr bool is_float   = std::is_floating_point_v<T>;
@@ -94,12 +117,44 @@ template <typename T> struct ndarray_traits {
     static constexpr bool is_signed  = std::is_signed_v<T>;
 };
 
+#if defined(__FLT16_MAX__) && (!defined(__GNUC__) || defined(__clang__) || __GNUC__ >= 12)
+#  define NB_HAS_FLOAT16 // _Float16, which is also the type behind std::float16_t
+template <> struct ndarray_traits<_Float16> {
+    static constexpr bool is_complex = false;
+    static constexpr bool is_float   = true;
+    static constexpr bool is_bool    = false;
+    static constexpr bool is_int     = false;
+    static constexpr bool is_signed  = true;
+};
+#endif
+
+#if defined(__STDCPP_BFLOAT16_T__)
+template <> struct ndarray_traits<std::bfloat16_t> {
+    static constexpr bool is_complex = false;
+    static constexpr bool is_float   = true;
+    static constexpr bool is_bfloat  = true;
+    static constexpr bool is_bool    = false;
+    static constexpr bool is_int     = false;
+    static constexpr bool is_signed  = true;
+};
+#endif
+
 NAMESPACE_BEGIN(detail)
 
+/// Floating point types can declare the bfloat16 format via 'is_bfloat'
+template <typename T, typename = int>
+struct ndarray_is_bfloat : std::false_type { };
+
+template <typename T>
+struct ndarray_is_bfloat<T, enable_if_t<ndarray_traits<std::remove_cv_t<T>>::is_bfloat>>
+    : std::true_type { };
+
 template <typename T>
 constexpr bool is_ndarray_scalar_v =
-    ndarray_traits<T>::is_float || ndarray_traits<T>::is_int ||
-    ndarray_traits<T>::is_bool || ndarray_traits<T>::is_complex;
+    ndarray_traits<std::remove_cv_t<T>>::is_float ||
+    ndarray_traits<std::remove_cv_t<T>>::is_int ||
+    ndarray_traits<std::remove_cv_t<T>>::is_bool ||
+    ndarray_traits<std::remove_cv_t<T>>::is_complex;
 
 template <typename> struct ndim_shape;
 template <size_t... S> struct ndim_shape<std::index_sequence<S...>> {
@@ -116,13 +171,16 @@ template <typename T> constexpr dlpack::dtype dtype() {
         "nanobind::dtype<T>: T must be a floating point or integer variable!"
     );
 
+    using Traits = ndarray_traits<std::remove_cv_t<T>>;
     dlpack::dtype result;
 
-    if constexpr (ndarray_traits<T>::is_float)
+    if constexpr (detail::ndarray_is_bfloat<T>::value)
+        result.code = (uint8_t) dlpack::dtype_code::Bfloat;
+    else if constexpr (Traits::is_float)
         result.code = (uint8_t) dlpack::dtype_code::Float;
-    else if constexpr (ndarray_traits<T>::is_complex)
+    else if constexpr (Traits::is_complex)
         result.code = (uint8_t) dlpack::dtype_code::Complex;
-    else if constexpr (ndarray_traits<T>::is_signed)
+    else if constexpr (Traits::is_signed)
         result.code = (uint8_t) dlpack::dtype_code::Int;
     else if constexpr (std::is_same_v<std::remove_cv_t<T>, bool>)
         result.code = (uint8_t) dlpack::dtype_code::Bool;
@@ -149,6 +207,7 @@ struct ndarray_req {
     bool req_ro = false;
     char req_order = '\0';
     uint8_t req_device = 0;
+    uint8_t req_align = 0;
 };
 
 template <typename T, typename = int> struct ndarray_arg {
@@ -157,11 +216,11 @@ template <typename T, typename = int> struct ndarray_arg {
     static void apply(ndarray_req &) { }
 };
 
-template <typename T> struct ndarray_arg<T, enable_if_t<ndarray_traits<T>::is_float>> {
+template <typename T> struct ndarray_arg<T, enable_if_t<ndarray_traits<std::remove_cv_t<T>>::is_float>> {
     static constexpr size_t size = 0;
 
     static constexpr auto name =
-        const_name("dtype=float") +
+        const_name<ndarray_is_bfloat<T>::value>("dtype=bfloat", "dtype=float") +
         const_name<sizeof(T) * 8>() +
         const_name<std::is_const_v<T>>(", writable=False", "");
 
@@ -172,7 +231,7 @@ template <typename T> struct ndarray_arg<T, enable_if_t<ndarray_traits<T>::is_fl
     }
 };
 
-template <typename T> struct ndarray_arg<T, enable_if_t<ndarray_traits<T>::is_complex>> {
+template <typename T> struct ndarray_arg<T, enable_if_t<ndarray_traits<std::remove_cv_t<T>>::is_complex>> {
     static constexpr size_t size = 0;
 
     static constexpr auto name =
@@ -187,7 +246,7 @@ template <typename T> struct ndarray_arg<T, enable_if_t<ndarray_traits<T>::is_co
     }
 };
 
-template <typename T> struct ndarray_arg<T, enable_if_t<ndarray_traits<T>::is_int>> {
+template <typename T> struct ndarray_arg<T, enable_if_t<ndarray_traits<std::remove_cv_t<T>>::is_int>> {
     static constexpr size_t size = 0;
 
     static constexpr auto name =
@@ -203,7 +262,7 @@ template <typename T> struct ndarray_arg<T, enable_if_t<ndarray_traits<T>::is_in
     }
 };
 
-template <typename T> struct ndarray_arg<T, enable_if_t<ndarray_traits<T>::is_bool>> {
+template <typename T> struct ndarray_arg<T, enable_if_t<ndarray_traits<std::remove_cv_t<T>>::is_bool>> {
     static constexpr size_t size = 0;
 
     static constexpr auto name =
@@ -260,6 +319,12 @@ template <> struct ndarray_arg<any_contig> {
     static void apply(ndarray_req &tr) { tr.req_order = '\0'; }
 };
 
+template <size_t N> struct ndarray_arg<align<N>> {
+    static constexpr size_t size = 0;
+    static constexpr auto name = const_name("align=") + const_name<N>();
+    static void apply(ndarray_req &tr) { tr.req_align = (uint8_t) N; }
+};
+
 template <typename T> struct ndarray_arg<T, enable_if_t<T::is_device>> {
     static constexpr size_t size = 0;
     static constexpr auto name = const_name("device='") + T::name + const_name('\'');
@@ -272,13 +337,13 @@ template <typename... Ts> struct ndarray_info {
     constexpr static auto name = const_name("ndarray");
     constexpr static ndarray_framework framework = ndarray_framework::none;
     constexpr static char order = '\0';
+    constexpr static size_t align = 0;
 };
 
 template <typename T, typename... Ts> struct ndarray_info<T, Ts...>  : ndarray_info<Ts...> {
     using scalar_type =
-        std::conditional_t<ndarray_traits<T>::is_float || ndarray_traits<T>::is_int ||
-                           ndarray_traits<T>::is_bool || ndarray_traits<T>::is_complex,
-                           T, typename ndarray_info<Ts...>::scalar_type>;
+        std::conditional_t<is_ndarray_scalar_v<T>, T,
+                           typename ndarray_info<Ts...>::scalar_type>;
 };
 
 template <size_t... Is, typename... Ts> struct ndarray_info<shape<Is...>, Ts...> : ndarray_info<Ts...> {
@@ -293,6 +358,10 @@ template <typename... Ts> struct ndarray_info<f_contig, Ts...> : ndarray_info<Ts
     constexpr static char order = 'F';
 };
 
+template <size_t N, typename... Ts> struct ndarray_info<align<N>, Ts...> : ndarray_info<Ts...> {
+    constexpr static size_t align = N;
+};
+
 template <typename... Ts> struct ndarray_info<numpy, Ts...> : ndarray_info<Ts...> {
     constexpr static auto name = const_name("numpy.ndarray");
     constexpr static ndarray_framework framework = ndarray_framework::numpy;
@@ -314,10 +383,132 @@ template <typename... Ts> struct ndarray_info<jax, Ts...> : ndarray_info<Ts...>
 };
 
 
+/// Shape of the sub-arrays along the outer dimension of an array
+template <typename Shape> struct shape_tail { using type = shape<>; };
+template <size_t I0, size_t... Is> struct shape_tail<shape<I0, Is...>> {
+    using type = shape<Is...>;
+    using block = shape<any, Is...>;
+};
+
+/**
+ * Evaluate 'run(start, end)' over chunks of the range [0, size) using up to
+ * 'workers' threads (including the calling one). The first exception raised
+ * by any chunk is propagated once all threads have finished.
+ */
+template <typename Func>
+void parallel_run(size_t size, size_t workers, const Func &run) {
+    if (workers > size)
+        workers = size;
+
+    if (workers <= 1) {
+        run((size_t) 0, size);
+        return;
+    }
+
+    std::vector<std::thread> pool;
+    std::vector<std::exception_ptr> errors(workers);
+    size_t chunk = (size + workers - 1) / workers;
+
+    for (size_t w = 1; w < workers; ++w) {
+        size_t start = w * chunk,
+               end = start + chunk < size ? start + chunk : size;
+        if (start >= end)
+            break;
+        pool.emplace_back([&, w, start, end] {
+            try {
+                run(start, end);
+            } catch (...) {
+                errors[w] = std::current_exception();
+            }
+        });
+    }
+
+    try {
+        run((size_t) 0, chunk);
+    } catch (...) {
+        errors[0] = std::current_exception();
+    }
+
+    for (std::thread &t : pool)
+        t.join();
+
+    for (std::exception_ptr &e : errors) {
+        if (e)
+            std::rethrow_exception(e);
+    }
+}
+
+/// Inform the compiler that 'p' is a multiple of 'Align' bytes
+template <size_t Align, typename T> NB_INLINE T *assume_aligned(T *p) {
+    if constexpr (Align > 1) {
+#if defined(__GNUC__) || defined(__clang__)
+        return (T *) __builtin_assume_aligned(p, Align);
+#elif defined(_MSC_VER)
+        __assume(((uintptr_t) p & (Align - 1)) == 0);
+#endif
+    }
+    return p;
+}
+
+/// Range over the rows or tiles of an ndarray_view
+template <typename View, bool Tiles> struct ndarray_view_range {
+    struct iterator {
+        const ndarray_view_range *range;
+        size_t index;
+
+        NB_INLINE decltype(auto) operator*() const {
+            if constexpr (Tiles) {
+                size_t count = range->view.shape(0) - index;
+                return range->view.block(
+                    index, count < range->step ? count : range->step);
+            } else {
+                return range->view.row(index);
+            }
+        }
+
+        NB_INLINE iterator &operator++() {
+            size_t size = range->view.shape(0);
+            index = (Tiles && size - index > range->step) ? index + range->step
+                    : Tiles                               ? size
+                                                          : index + 1;
+            return *this;
+        }
+
+        NB_INLINE bool operator==(const iterator &o) const { return index == o.index; }
+        NB_INLINE bool operator!=(const iterator &o) const { return index != o.index; }
+    };
+
+    NB_INLINE iterator begin() const { return { this, 0 }; }
+    NB_INLINE iterator end() const { return { this, view.shape(0) }; }
+
+    View view;
+    size_t step;
+};
+
 NAMESPACE_END(detail)
 
-template <typename Scalar, typename Shape, char Order> struct ndarray_view {
+/// Contiguous range of array entries (see ndarray_view::flat())
+template <typename Scalar> struct ndarray_span {
+    Scalar *ptr = nullptr;
+    size_t count = 0;
+
+    Scalar *data() const { return ptr; }
+    size_t size() const { return count; }
+    Scalar *begin() const { return ptr; }
+    Scalar *end() const { return ptr + count; }
+    Scalar &operator[](size_t i) const { return ptr[i]; }
+};
+
+/**
+ * \brief Lightweight view of an ndarray with a compile-time scalar type and
+ * shape. When 'Align' is nonzero, the data pointer is known to be a multiple
+ * of 'Align' bytes (see nb::align<N>), so that compilers can emit aligned
+ * SIMD loads and stores.
+ */
+template <typename Scalar, typename Shape, char Order, size_t Align = 0>
+struct ndarray_view {
     static constexpr size_t Dim = Shape::size;
+    static constexpr size_t Alignment = Align;
 
     ndarray_view() = default;
     ndarray_view(const ndarray_view &) = default;
@@ -336,16 +527,131 @@ template <typename Scalar, typename Shape, char Order> struct ndarray_view {
         for (size_t i = 0; i < Dim; ++i)
             offset += indices_i64[i] * m_strides[i];
 
-        return *(m_data + offset);
+        return *(data() + offset);
     }
 
     size_t ndim() const { return Dim; }
     size_t shape(size_t i) const { return m_shape[i]; }
     int64_t stride(size_t i) const { return m_strides[i]; }
-    Scalar *data() const { return m_data; }
+    Scalar *data() const { return detail::assume_aligned<Align>(m_data); }
+
+    /// Total number of entries
+    size_t size() const {
+        size_t ret = 1;
+        for (size_t i = 0; i < Dim; ++i)
+            ret *= (size_t) m_shape[i];
+        return ret;
+    }
+
+    /// Check if the entries occupy a dense C- or F-ordered block of memory
+    bool is_contiguous() const {
+        if constexpr (Order == 'C' || Order == 'F' || Dim == 0) {
+            return true;
+        } else {
+            bool c_contig = true, f_contig = true;
+            int64_t c_accum = 1, f_accum = 1;
+            for (size_t i = 0; i < Dim; ++i) {
+                size_t j = Dim - 1 - i;
+                if (m_shape[j] != 1 && m_strides[j] != c_accum)
+                    c_contig = false;
+                if (m_shape[i] != 1 && m_strides[i] != f_accum)
+                    f_contig = false;
+                c_accum *= m_shape[j];
+                f_accum *= m_shape[i];
+            }
+            return c_contig || f_contig;
+        }
+    }
+
+    /// Return the entries in memory order if contiguous, and an empty span otherwise
+    ndarray_span<Scalar> flat() const {
+        if (!is_contiguous())
+            return { };
+        return { data(), size() };
+    }
+
+    /**
+     * \brief Return the i-th entry along the outer dimension: a reference for
+     * 1D views, and a view with one dimension less otherwise
+     */
+    NB_INLINE decltype(auto) row(size_t i) const {
+        static_assert(Dim > 0, "ndarray_view::row(): expected an array!");
+        if constexpr (Dim == 1) {
+            return (m_data[(int64_t) i * m_strides[0]]);
+        } else {
+            using Row = ndarray_view<Scalar, typename detail::shape_tail<Shape>::type,
+                                     Order == 'C' ? 'C' : '\0'>;
+            return Row(m_data + (int64_t) i * m_strides[0], m_shape + 1,
+                       m_strides + 1);
+        }
+    }
+
+    /// Return the view of 'count' consecutive entries along the outer dimension
+    NB_INLINE auto block(size_t start, size_t count) const {
+        static_assert(Dim > 0, "ndarray_view::block(): expected an array!");
+        using Block = ndarray_view<Scalar, typename detail::shape_tail<Shape>::block,
+                                   Order == 'C' ? 'C' : '\0'>;
+        Block result(m_data + (int64_t) start * m_strides[0], m_shape,
+                     m_strides);
+        result.m_shape[0] = (int64_t) count;
+        return result;
+    }
+
+    /// Iterate over the rows along the outer dimension (see row())
+    auto rows() const {
+        return detail::ndarray_view_range<ndarray_view, false>{ *this, 1 };
+    }
+
+    /// Iterate over blocks of up to 'count' rows (see block())
+    auto tiles(size_t count) const {
+        return detail::ndarray_view_range<ndarray_view, true>{
+            *this, count ? count : 1 };
+    }
+
+    /**
+     * \brief Call 'f(entry)' for every entry. Contiguous views are traversed
+     * in memory order using a single flat loop.
+     */
+    template <typename Func> NB_INLINE void for_each(Func &&f) const {
+        if (is_contiguous()) {
+            Scalar *ptr = data();
+            size_t n = size();
+            for (size_t i = 0; i < n; ++i)
+                f(ptr[i]);
+        } else {
+            for_each_dim<0>(m_data, f);
+        }
+    }
+
+    /**
+     * \brief Call 'f(row(i))' for every index 'i' along the outer dimension
+     * using up to 'threads' threads (all hardware threads if zero). The GIL is
+     * released during the computation, hence 'f' must not access Python
+     * objects. This function must be called while holding the GIL.
+     */
+    template <typename Func>
+    void parallel_for_each(Func &&f, size_t threads = 0) const {
+        static_assert(Dim > 0, "ndarray_view::parallel_for_each(): expected an array!");
+
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+
+        // Don't bother with workers unless each one has some real work
+        size_t total = size();
+        if (threads > total / 1024)
+            threads = total / 1024;
+
+        gil_scoped_release release;
+        detail::parallel_run((size_t) m_shape[0], threads,
+                             [&](size_t start, size_t end) {
+                                 for (size_t i = start; i < end; ++i)
+                                     f(row(i));
+                             });
+    }
 
 private:
     template <typename...> friend class ndarray;
+    template <typename, typename, char, size_t> friend struct ndarray_view;
 
     template <size_t... I1, size_t... I2>
     ndarray_view(Scalar *data, const int64_t *shape, const int64_t *strides,
@@ -368,6 +674,26 @@ private:
         }
     }
 
+    /// Sub-view constructor (shape and strides are already consistent)
+    ndarray_view(Scalar *data, const int64_t *shape, const int64_t *strides)
+        : m_data(data) {
+        for (size_t i = 0; i < Dim; ++i) {
+            m_shape[i] = shape[i];
+            m_strides[i] = strides[i];
+        }
+    }
+
+    template <size_t D, typename Func>
+    NB_INLINE void for_each_dim(Scalar *ptr, Func &f) const {
+        int64_t n = m_shape[D], s = m_strides[D];
+        for (int64_t i = 0; i < n; ++i) {
+            if constexpr (D + 1 == Dim)
+                f(ptr[i * s]);
+            else
+                for_each_dim<D + 1>(ptr + i * s, f);
+        }
+    }
+
     Scalar *m_data = nullptr;
     int64_t m_shape[Dim] { };
     int64_t m_strides[Dim] { };
@@ -377,6 +703,7 @@ private:
 template <typename... Args> class ndarray {
 public:
     template <typename...> friend class ndarray;
+    template <typename, typename> friend struct detail::type_caster;
 
     using Info = detail::ndarray_info<Args...>;
     using Scalar = typename Info::scalar_type;
@@ -424,6 +751,76 @@ public:
         m_dltensor = *detail::ndarray_inc_ref(m_handle);
     }
 
+    /// Create a 1D array that takes ownership of a moved ``std::vector<T>``
+    template <typename Vector> static ndarray from_vector(Vector &&vec) {
+        size_t size = vec.size();
+        return from_container(std::forward<Vector>(vec), vec.data(), 1, &size,
+                              nullptr, device::cpu::value, 0);
+    }
+
+    /// Create an array that takes ownership of a moved ``std::vector<T>``
+    template <typename Vector>
+    static ndarray from_vector(Vector &&vec,
+                               std::initializer_list<size_t> shape,
+                               std::initializer_list<int64_t> strides = { }) {
+        if (strides.size() != 0 && strides.size() != shape.size())
+            detail::fail("ndarray::from_vector(): shape and strides have "
+                         "incompatible size!");
+        return from_container(std::forward<Vector>(vec), vec.data(),
+                              shape.size(), shape.begin(),
+                              strides.size() ? strides.begin() : nullptr,
+                              device::cpu::value, 0);
+    }
+
+    /// Create an array that takes ownership of a moved ``std::unique_ptr<T[]>``
+    template <typename Ptr>
+    static ndarray from_unique_ptr(Ptr &&ptr,
+                                   std::initializer_list<size_t> shape,
+                                   std::initializer_list<int64_t> strides = { },
+                                   int32_t device_type = device::cpu::value,
+                                   int32_t device_id = 0) {
+        if (strides.size() != 0 && strides.size() != shape.size())
+            detail::fail("ndarray::from_unique_ptr(): shape and strides have "
+                         "incompatible size!");
+        return from_container(std::forward<Ptr>(ptr), ptr.get(), shape.size(),
+                              shape.begin(),
+                              strides.size() ? strides.begin() : nullptr,
+                              device_type, device_id);
+    }
+
+    /**
+     * Create a C-contiguous CPU array backed by a private mapping of the file
+     * at 'path', starting 'offset' bytes into it. Its pages are loaded
+     * on demand, and the file is unmapped when the last reference expires.
+     * Writes to copy-on-write mappings are not propagated to the file.
+     */
+    static ndarray map_file(const char *path, size_t ndim, const size_t *shape,
+                            uint64_t offset = 0,
+                            bool copy_on_write = !std::is_const_v<Scalar>,
+                            mmap_advice advice = mmap_advice::normal,
+                            dlpack::dtype dtype = nanobind::dtype<Scalar>()) {
+        if (!copy_on_write && !std::is_const_v<Scalar>)
+            detail::raise("ndarray::map_file(): read-only mappings require a "
+                          "const scalar type!");
+
+        ndarray result;
+        result.m_handle = detail::ndarray_map_file(
+            path, offset, ndim, shape, &dtype, copy_on_write,
+            std::is_const_v<Scalar> || !copy_on_write, (int) advice);
+        result.m_dltensor = *detail::ndarray_inc_ref(result.m_handle);
+        return result;
+    }
+
+    static ndarray map_file(const char *path,
+                            std::initializer_list<size_t> shape,
+                            uint64_t offset = 0,
+                            bool copy_on_write = !std::is_const_v<Scalar>,
+                            mmap_advice advice = mmap_advice::normal,
+                            dlpack::dtype dtype = nanobind::dtype<Scalar>()) {
+        return map_file(path, shape.size(), shape.begin(), offset,
+                        copy_on_write, advice, dtype);
+    }
+
     ~ndarray() {
         detail::ndarray_dec_ref(m_handle);
     }
@@ -516,7 +913,7 @@ public:
             "ndarray, or to the call to .view<..>()");
 
         if constexpr (has_scalar && has_shape) {
-            return ndarray_view<Scalar2, Shape2, Info2::order>(
+            return ndarray_view<Scalar2, Shape2, Info2::order, Info2::align>(
                 (Scalar2 *) data(), shape_ptr(), stride_ptr(),
                 std::make_index_sequence<Shape2::size>(), Shape2());
         } else {
@@ -525,6 +922,30 @@ public:
     }
 
 private:
+    /// Move 'container' into the handle, so that no owner object is needed
+    template <typename Container, typename T>
+    static ndarray from_container(Container &&container, T *value, size_t ndim,
+                                  const size_t *shape, const int64_t *strides,
+                                  int32_t device_type, int32_t device_id) {
+        using C = std::decay_t<Container>;
+        static_assert(!std::is_lvalue_reference_v<Container>,
+                      "ndarray: the container must be moved (std::move())!");
+        static_assert(alignof(C) <= alignof(std::max_align_t),
+                      "ndarray: over-aligned containers are unsupported!");
+
+        dlpack::dtype dtype = nanobind::dtype<std::remove_cv_t<T>>();
+        void *payload;
+        ndarray result;
+        result.m_handle = detail::ndarray_create_payload(
+            (void *) value, ndim, shape, strides, &dtype,
+            std::is_const_v<Scalar> || std::is_const_v<T>, device_type,
+            device_id, sizeof(C), [](void *p) noexcept { ((C *) p)->~C(); },
+            &payload);
+        new (payload) C(std::move(container));
+        result.m_dltensor = *detail::ndarray_inc_ref(result.m_handle);
+        return result;
+    }
+
     template <typename... Ts>
     NB_INLINE int64_t byte_offset(Ts... indices) const {
         constexpr bool has_scalar = !std::is_same_v<Scalar, void>,
@@ -558,6 +979,81 @@ private:
 
 inline bool ndarray_check(handle h) { return detail::ndarray_check(h.ptr()); }
 
+/**
+ * Allocate a C-contiguous array from nanobind's memory pool. The storage is
+ * 64-byte aligned, uninitialized, and returned to the pool once the last
+ * reference to the array expires.
+ */
+template <typename... Args>
+ndarray<Args...> ndarray_alloc(
+        size_t ndim, const size_t *shape,
+        dlpack::dtype dtype = nanobind::dtype<typename ndarray<Args...>::Scalar>(),
+        int32_t device_type = device::cpu::value, int32_t device_id = 0) {
+    using Scalar = typename ndarray<Args...>::Scalar;
+    return ndarray<Args...>(detail::ndarray_alloc(
+        ndim, shape, &dtype, std::is_const_v<Scalar>, device_type, device_id));
+}
+
+template <typename... Args>
+ndarray<Args...> ndarray_alloc(
+        std::initializer_list<size_t> shape,
+        dlpack::dtype dtype = nanobind::dtype<typename ndarray<Args...>::Scalar>(),
+        int32_t device_type = device::cpu::value, int32_t device_id = 0) {
+    return ndarray_alloc<Args...>(shape.size(), shape.begin(), dtype,
+                                  device_type, device_id);
+}
+
+/**
+ * \brief Copy the entries of a CPU array into contiguous C- or F-ordered
+ * storage with space for ``array.size()`` entries, converting them to ``T``
+ *
+ * The GIL is released during the copy, which uses up to ``threads`` threads
+ * (all hardware threads if zero). This function must be called while holding
+ * the GIL.
+ */
+template <typename T, typename... Args>
+void ndarray_copy(const ndarray<Args...> &array, T *out, char order = 'C',
+                  size_t threads = 0) {
+    static_assert(detail::is_ndarray_scalar_v<T>,
+                  "nanobind::ndarray_copy(): unsupported output type!");
+    if (!array.is_valid())
+        detail::raise("nanobind::ndarray_copy(): invalid array!");
+    dlpack::dtype dt = nanobind::dtype<std::remove_cv_t<T>>();
+    detail::ndarray_copy_to(array.handle(), (void *) out, &dt, order, threads);
+}
+
+/// Resize 'out' to the size of 'array' and copy its entries in C order
+template <typename T, typename Alloc, typename... Args>
+void ndarray_copy(const ndarray<Args...> &array, std::vector<T, Alloc> &out,
+                  size_t threads = 0) {
+    out.resize(array.size());
+    ndarray_copy(array, out.data(), 'C', threads);
+}
+
+/**
+ * While this RAII helper is alive, ndarrays that are imported on the current
+ * thread from device memory receive 'stream' in the '__dlpack__(stream=...)'
+ * call, letting the producer order its work with respect to that stream
+ * instead of synchronizing.
+ */
+class ndarray_stream {
+public:
+    explicit ndarray_stream(intptr_t stream) {
+        m_prev_set = detail::ndarray_set_stream(true, stream, &m_prev);
+    }
+
+    ~ndarray_stream() {
+        detail::ndarray_set_stream(m_prev_set, m_prev, nullptr);
+    }
+
+    ndarray_stream(const ndarray_stream &) = delete;
+    ndarray_stream &operator=(const ndarray_stream &) = delete;
+
+private:
+    bool m_prev_set;
+    intptr_t m_prev = 0;
+};
+
 NAMESPACE_BEGIN(detail)
 
 template <typename... Args> struct type_caster<ndarray<Args...>> {
@@ -582,5 +1078,187 @@ template <typename... Args> struct type_caster<ndarray<Args...>> {
     }
 };
 
+/// Entries of a 'vector_array': numbers, or rows of numbers with 'cols' columns
+template <typename T> struct vector_array_row {
+    using Scalar = T;
+    static constexpr size_t ndim = 1, cols = any;
+};
+
+template <typename T, size_t N> struct vector_array_row<std::array<T, N>> {
+    static_assert(sizeof(std::array<T, N>) == sizeof(T) * N,
+                  "nanobind::vector_array<T>: std::array rows must be packed!");
+    using Scalar = T;
+    using Caster = array_caster<std::array<T, N>, T, N>;
+    static constexpr size_t ndim = 2, cols = N;
+};
+
+template <typename T, typename Alloc>
+struct vector_array_row<std::vector<T, Alloc>> {
+    using Scalar = T;
+    using Caster = list_caster<std::vector<T, Alloc>, T>;
+    static constexpr size_t ndim = 2, cols = any;
+};
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief ``std::vector<T>`` of numbers that is returned to Python as an array
+ *
+ * The ``std::vector<T>`` caster converts every entry into a Python object.
+ * Returning a ``vector_array<T>`` instead moves the vector into the owner
+ * of a 1D array of the given ``Framework`` without copying its contents.
+ * Function arguments of this type accept the same inputs as ``std::vector<T>``.
+ *
+ * The entries may also be rows of type ``std::array<T, N>`` or
+ * ``std::vector<T>``, which map to 2D arrays. Vectors of ``std::array<T, N>``
+ * are moved since their storage is contiguous, while nested vectors are
+ * copied into a single buffer and must have rows of equal size.
+ */
+template <typename T, typename Framework = numpy,
+          typename Alloc = std::allocator<T>>
+class vector_array : public std::vector<T, Alloc> {
+    using Row = detail::vector_array_row<T>;
+    static_assert(detail::is_ndarray_scalar_v<typename Row::Scalar> &&
+                      !std::is_same_v<typename Row::Scalar, bool>,
+                  "nanobind::vector_array<T>: T must be an arithmetic type "
+                  "other than bool, or a std::array/std::vector thereof!");
+
+public:
+    using Vector = std::vector<T, Alloc>;
+    using Vector::Vector;
+
+    vector_array() = default;
+    vector_array(const Vector &v) : Vector(v) { }
+    vector_array(Vector &&v) : Vector(std::move(v)) { }
+};
+
+NAMESPACE_BEGIN(detail)
+
+template <typename T, typename Framework, typename Alloc>
+struct type_caster<vector_array<T, Framework, Alloc>> {
+    using Row = vector_array_row<T>;
+    using Scalar = typename Row::Scalar;
+    using Vector = std::vector<T, Alloc>;
+    using NDArray = std::conditional_t<
+        Row::ndim == 1, ndarray<Framework, Scalar, ndim<1>, device::cpu>,
+        ndarray<Framework, Scalar, shape<any, Row::cols>, device::cpu>>;
+    using NDArrayCaster = make_caster<NDArray>;
+    using Array = vector_array<T, Framework, Alloc>;
+
+    NB_TYPE_CASTER(Array, NDArrayCaster::Name)
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        // Copy the rows of 2D arrays without creating Python objects
+        if constexpr (Row::ndim == 2) {
+            using Input = ndarray<const Scalar, shape<any, Row::cols>,
+                                  c_contig, device::cpu>;
+            make_caster<Input> caster;
+            if (caster.from_python(src, flags, cleanup))
+                return load_rows(caster.value);
+            return load_seq(src, flags, cleanup);
+        } else {
+            list_caster<Value, T> caster;
+            if (!caster.from_python(src, flags, cleanup))
+                return false;
+            value = std::move(caster.value);
+            return true;
+        }
+    }
+
+    /// Load a sequence of rows (e.g., a list of lists)
+    bool load_seq(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        size_t size;
+        PyObject *temp;
+        PyObject **o = seq_get(src.ptr(), &size, &temp);
+
+        typename Row::Caster caster;
+        bool success = o != nullptr;
+
+        try {
+            value.clear();
+            value.reserve(size);
+            for (size_t i = 0; success && i < size; ++i) {
+                success = caster.from_python(o[i], flags, cleanup);
+                if (success)
+                    value.push_back(std::move(caster.value));
+            }
+        } catch (const std::bad_alloc &) {
+            success = false;
+        }
+
+        Py_XDECREF(temp);
+        return success;
+    }
+
+    template <typename Input> bool load_rows(const Input &array) noexcept {
+        size_t rows = array.shape(0), cols = array.shape(1);
+        const Scalar *data = array.data();
+
+        try {
+            value.clear();
+            value.resize(rows);
+            if constexpr (Row::cols != any) {
+                if (rows)
+                    memcpy((void *) value.data(), data,
+                           rows * cols * sizeof(Scalar));
+            } else {
+                for (size_t i = 0; i < rows; ++i, data += cols)
+                    value[i].assign(data, data + cols);
+            }
+        } catch (const std::bad_alloc &) {
+            return false;
+        }
+
+        return true;
+    }
+
+    static handle from_cpp(Value &&v, rv_policy, cleanup_list *cleanup) noexcept {
+        try {
+            NDArray array;
+            if constexpr (Row::ndim == 1) {
+                array = NDArray::from_vector(std::move((Vector &) v));
+            } else if constexpr (Row::cols != any) {
+                size_t shape[2] = { v.size(), Row::cols };
+                Scalar *data = (Scalar *) v.data();
+                array = NDArray::from_container(std::move((Vector &) v), data,
+                                                2, shape, nullptr,
+                                                device::cpu::value, 0);
+            } else {
+                size_t rows = v.size(), cols = rows ? v[0].size() : 0;
+                std::vector<Scalar> flat;
+                flat.reserve(rows * cols);
+                for (const T &row : v) {
+                    if (row.size() != cols) {
+                        PyErr_SetString(PyExc_ValueError,
+                                        "nanobind::vector_array: all rows "
+                                        "must have the same size!");
+                        return handle();
+                    }
+                    flat.insert(flat.end(), row.begin(), row.end());
+                }
+                array = NDArray::from_vector(std::move(flat), { rows, cols });
+            }
+            return NDArrayCaster::from_cpp(array, rv_policy::reference, cleanup);
+        } catch (python_error &e) {
+            e.restore();
+        } catch (const std::exception &e) {
+            PyErr_SetString(PyExc_RuntimeError, e.what());
+        }
+        return handle();
+    }
+
+    static handle from_cpp(const Value &v, rv_policy policy,
+                           cleanup_list *cleanup) noexcept {
+        Value copy;
+        try {
+            copy = v;
+        } catch (const std::bad_alloc &) {
+            PyErr_NoMemory();
+            return handle();
+        }
+        return from_cpp(std::move(copy), policy, cleanup);
+    }
+};
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
@@ -0,0 +1,299 @@
+/*
+    nanobind/ndarray_chunks.h: nb::ndarray_chunks<..>, a Python iterator over
+    arrays that a background thread fills using a ring of reusable buffers
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/ndarray.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+
+/**
+ * \brief Stream of arrays produced by a C++ function on a background thread
+ *
+ * The producer ``size_t fill(T *buffer, size_t capacity)`` writes up to
+ * ``capacity`` rows of the chunk shape into ``buffer`` and returns the
+ * number of rows that it produced, where zero marks the end of the stream.
+ * It runs without holding the GIL and must not access Python objects.
+ *
+ * At most ``ring_size`` buffers are allocated. A buffer is refilled once the
+ * last reference to the array wrapping it expires, which throttles the
+ * producer when the consumer falls behind. Returned to Python, the stream is
+ * an iterator producing ``ndarray<T, Args..., device::cpu>`` instances.
+ */
+template <typename T, typename... Args> class ndarray_chunks {
+    static_assert(detail::is_ndarray_scalar_v<T> && !std::is_const_v<T>,
+                  "nanobind::ndarray_chunks<T>: T must be a (non-const) "
+                  "arithmetic type!");
+
+    struct state {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<std::unique_ptr<T[]>> buffers;
+        std::vector<size_t> free;              // Buffers awaiting a refill
+        std::deque<std::pair<size_t, size_t>> ready; // (buffer, rows)
+        std::vector<size_t> shape;
+        std::exception_ptr error;
+        size_t held = 0; // Buffers referenced by arrays
+        bool done = false, stop = false;
+    };
+
+    // Owns the producer thread, which is shut down with the last copy
+    struct worker {
+        std::shared_ptr<state> s;
+        std::thread thread;
+
+        ~worker() {
+            {
+                std::lock_guard<std::mutex> guard(s->mutex);
+                s->stop = true;
+            }
+            s->cv.notify_all();
+            if (thread.joinable())
+                thread.join();
+        }
+    };
+
+    // Stored within the handle of each array, returns the buffer upon expiry
+    struct lease {
+        std::shared_ptr<state> s;
+        size_t index;
+
+        ~lease() {
+            {
+                std::lock_guard<std::mutex> guard(s->mutex);
+                s->free.push_back(index);
+                s->held--;
+            }
+            s->cv.notify_all();
+        }
+    };
+
+    static constexpr size_t MaxDim = 32;
+
+public:
+    using Array = ndarray<T, Args..., device::cpu>;
+    using Producer = std::function<size_t(T *, size_t)>;
+
+    /**
+     * Start producing chunks of the given shape, whose first entry specifies
+     * the maximum number of rows per chunk. Requires the GIL.
+     */
+    ndarray_chunks(size_t ring_size, std::initializer_list<size_t> shape,
+                   Producer fill) {
+        auto s = std::make_shared<state>();
+        s->shape.assign(shape.begin(), shape.end());
+        if (ring_size == 0 || s->shape.empty() || s->shape[0] == 0 ||
+            s->shape.size() > MaxDim)
+            detail::raise("nanobind::ndarray_chunks(): invalid ring size or "
+                          "chunk shape!");
+
+        size_t row_size = 1;
+        for (size_t i = 1; i < s->shape.size(); ++i)
+            row_size *= s->shape[i];
+
+        for (size_t i = 0; i < ring_size; ++i) {
+            s->buffers.emplace_back(new T[s->shape[0] * row_size]);
+            s->free.push_back(ring_size - 1 - i);
+        }
+
+        m_worker = std::make_shared<worker>();
+        m_worker->s = s;
+        m_worker->thread = std::thread(run, s, std::move(fill));
+    }
+
+    /**
+     * \brief Return the next chunk, or an invalid array at the end of the
+     * stream (requires the GIL)
+     *
+     * The GIL is released while waiting for the producer. Exceptions raised
+     * by the producer propagate once the preceding chunks have been consumed.
+     */
+    Array next() {
+        state &s = *m_worker->s;
+        std::pair<size_t, size_t> item;
+        std::exception_ptr error;
+        bool found, done;
+
+        {
+            gil_scoped_release release;
+            std::unique_lock<std::mutex> lock(s.mutex);
+            s.cv.wait(lock, [&] {
+                return !s.ready.empty() || s.done ||
+                       s.held == s.buffers.size();
+            });
+
+            found = !s.ready.empty();
+            done = s.done;
+            if (found) {
+                item = s.ready.front();
+                s.ready.pop_front();
+                s.held++;
+            } else {
+                std::swap(error, s.error);
+            }
+        }
+
+        if (!found) {
+            if (error)
+                std::rethrow_exception(error);
+            if (done)
+                return Array();
+            detail::raise("nanobind::ndarray_chunks::next(): all %zu buffers "
+                          "are referenced by arrays that are still alive!",
+                          s.buffers.size());
+        }
+
+        size_t shape[MaxDim], ndim = s.shape.size();
+        for (size_t i = 0; i < ndim; ++i)
+            shape[i] = s.shape[i];
+        shape[0] = item.second;
+
+        dlpack::dtype dtype = nanobind::dtype<T>();
+        void *payload;
+        detail::ndarray_handle *th;
+
+        try {
+            th = detail::ndarray_create_payload(
+                s.buffers[item.first].get(), ndim, shape, nullptr, &dtype,
+                false, device::cpu::value, 0, sizeof(lease),
+                [](void *p) noexcept { ((lease *) p)->~lease(); }, &payload);
+        } catch (...) {
+            (void) lease{ m_worker->s, item.first }; // Return the buffer
+            throw;
+        }
+
+        new (payload) lease{ m_worker->s, item.first };
+        return Array(th);
+    }
+
+private:
+    static void run(std::shared_ptr<state> s, Producer fill) {
+        size_t capacity = s->shape[0];
+
+        while (true) {
+            size_t index;
+            {
+                std::unique_lock<std::mutex> lock(s->mutex);
+                s->cv.wait(lock, [&] { return s->stop || !s->free.empty(); });
+                if (s->stop)
+                    return;
+                index = s->free.back();
+                s->free.pop_back();
+            }
+
+            size_t rows = 0;
+            std::exception_ptr error;
+            try {
+                rows = fill(s->buffers[index].get(), capacity);
+                if (rows > capacity)
+                    throw std::out_of_range(
+                        "nanobind::ndarray_chunks: the producer returned "
+                        "too many rows!");
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(s->mutex);
+                if (rows && !error)
+                    s->ready.emplace_back(index, rows);
+                else
+                    s->free.push_back(index);
+                s->error = error;
+                s->done = rows == 0 || error;
+            }
+            s->cv.notify_all();
+
+            if (rows == 0 || error)
+                return;
+        }
+    }
+
+    std::shared_ptr<worker> m_worker;
+};
+
+NAMESPACE_BEGIN(detail)
+
+/// Python iterator state wrapping an ndarray_chunks instance
+template <typename Chunks> struct ndarray_chunks_state {
+    Chunks chunks;
+    rv_policy policy;
+};
+
+template <typename Chunks>
+PyObject *ndarray_chunks_next(PyObject *self) noexcept {
+    ndarray_chunks_state<Chunks> &s = *inst_ptr<ndarray_chunks_state<Chunks>>(self);
+
+    try {
+        typename Chunks::Array a = s.chunks.next();
+        if (!a.is_valid())
+            return nullptr;
+        return make_caster<typename Chunks::Array>::from_cpp(a, s.policy, nullptr)
+            .ptr();
+    } catch (python_error &e) {
+        e.restore();
+    } catch (...) {
+        nb_translate_exception();
+    }
+
+    return nullptr;
+}
+
+template <typename T, typename... Args>
+struct type_caster<ndarray_chunks<T, Args...>> {
+    using Chunks = ndarray_chunks<T, Args...>;
+    using State = ndarray_chunks_state<Chunks>;
+    using Value = Chunks;
+    static constexpr auto Name =
+        const_name("collections.abc.Iterator[") +
+        make_caster<typename Chunks::Array>::Name + const_name("]");
+    template <typename T_> using Cast = Chunks;
+
+    bool from_python(handle, uint8_t, cleanup_list *) noexcept {
+        return false;
+    }
+
+    static handle from_cpp(const Chunks &chunks, rv_policy policy,
+                           cleanup_list *) noexcept {
+        // Arrays reference the buffers, which are kept alive by their handle
+        if (policy != rv_policy::reference_internal)
+            policy = rv_policy::reference;
+
+        try {
+            if (!type<State>().is_valid()) {
+                static PyType_Slot slots[] = {
+                    { Py_tp_iter, (void *) PyObject_SelfIter },
+                    { Py_tp_iternext, (void *) ndarray_chunks_next<Chunks> },
+                    { 0, nullptr }
+                };
+
+                class_<State>(handle(), "ndarray_chunks", type_slots(slots));
+            }
+
+            return nanobind::cast(State{ chunks, policy }, rv_policy::move)
+                .release();
+        } catch (python_error &e) {
+            e.restore();
+        } catch (const std::exception &e) {
+            PyErr_SetString(PyExc_RuntimeError, e.what());
+        }
+
+        return handle();
+    }
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
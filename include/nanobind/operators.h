@@ -38,6 +38,276 @@ struct undefined_t { };
 /// base template of operator implementations
 template <op_id, op_type, typename B, typename L, typename R> struct op_impl { };
 
+/// Kinds of type slots that can natively implement an operator
+enum class op_slot_kind { none, binary, inplace, unary, boolean, hash, compare };
+
+/// Type slot that implements an operator (see ``nb::native_slot``)
+template <op_id, op_type> struct op_slot {
+    static constexpr op_slot_kind kind = op_slot_kind::none;
+    using Func = void *;
+};
+
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+#define NB_OP_SLOT(id, ot, kind_, func, field)                                 \
+template <> struct op_slot<op_##id, ot> {                                      \
+    static constexpr op_slot_kind kind = op_slot_kind::kind_;                  \
+    static constexpr int cmp = 0;                                              \
+    using Func = func;                                                         \
+    static Func &get(PyTypeObject *tp) { return tp->field; }                   \
+};
+
+#define NB_OP_SLOT_BINARY_1(id, ot, field)                                     \
+template <> struct op_slot<op_##id, ot> {                                      \
+    static constexpr op_slot_kind kind = op_slot_kind::binary;                 \
+    static constexpr int cmp = 0;                                              \
+    static constexpr const char *name = "__" #id "__", *rname = "__r" #id "__";\
+    using Func = binaryfunc;                                                   \
+    static Func &get(PyTypeObject *tp) { return tp->tp_as_number->field; }     \
+};
+
+#define NB_OP_SLOT_BINARY(id, field)                                           \
+    NB_OP_SLOT_BINARY_1(id, op_l, field)                                       \
+    NB_OP_SLOT_BINARY_1(id, op_r, field)
+
+#define NB_OP_SLOT_INPLACE(id, field)                                          \
+    NB_OP_SLOT(id, op_l, inplace, binaryfunc, tp_as_number->field)
+
+#define NB_OP_SLOT_COMPARE(id, cmp_)                                           \
+template <> struct op_slot<op_##id, op_l> {                                    \
+    static constexpr op_slot_kind kind = op_slot_kind::compare;                \
+    static constexpr int cmp = cmp_;                                           \
+    using Func = richcmpfunc;                                                  \
+    static Func &get(PyTypeObject *tp) { return tp->tp_richcompare; }          \
+};
+
+NB_OP_SLOT_BINARY(sub, nb_subtract)
+NB_OP_SLOT_BINARY(add, nb_add)
+NB_OP_SLOT_BINARY(mul, nb_multiply)
+NB_OP_SLOT_BINARY(truediv, nb_true_divide)
+NB_OP_SLOT_BINARY(mod, nb_remainder)
+NB_OP_SLOT_BINARY(lshift, nb_lshift)
+NB_OP_SLOT_BINARY(rshift, nb_rshift)
+NB_OP_SLOT_BINARY(and, nb_and)
+NB_OP_SLOT_BINARY(xor, nb_xor)
+NB_OP_SLOT_BINARY(or, nb_or)
+NB_OP_SLOT_COMPARE(gt, Py_GT)
+NB_OP_SLOT_COMPARE(ge, Py_GE)
+NB_OP_SLOT_COMPARE(lt, Py_LT)
+NB_OP_SLOT_COMPARE(le, Py_LE)
+NB_OP_SLOT_COMPARE(eq, Py_EQ)
+NB_OP_SLOT_COMPARE(ne, Py_NE)
+NB_OP_SLOT_INPLACE(iadd, nb_inplace_add)
+NB_OP_SLOT_INPLACE(isub, nb_inplace_subtract)
+NB_OP_SLOT_INPLACE(imul, nb_inplace_multiply)
+NB_OP_SLOT_INPLACE(itruediv, nb_inplace_true_divide)
+NB_OP_SLOT_INPLACE(imod, nb_inplace_remainder)
+NB_OP_SLOT_INPLACE(ilshift, nb_inplace_lshift)
+NB_OP_SLOT_INPLACE(irshift, nb_inplace_rshift)
+NB_OP_SLOT_INPLACE(iand, nb_inplace_and)
+NB_OP_SLOT_INPLACE(ixor, nb_inplace_xor)
+NB_OP_SLOT_INPLACE(ior, nb_inplace_or)
+NB_OP_SLOT(neg, op_u, unary, unaryfunc, tp_as_number->nb_negative)
+NB_OP_SLOT(pos, op_u, unary, unaryfunc, tp_as_number->nb_positive)
+NB_OP_SLOT(invert, op_u, unary, unaryfunc, tp_as_number->nb_invert)
+NB_OP_SLOT(abs, op_u, unary, unaryfunc, tp_as_number->nb_absolute)
+NB_OP_SLOT(bool, op_u, boolean, inquiry, tp_as_number->nb_bool)
+NB_OP_SLOT(hash, op_u, hash, hashfunc, tp_hash)
+
+#undef NB_OP_SLOT_COMPARE
+#undef NB_OP_SLOT_INPLACE
+#undef NB_OP_SLOT_BINARY
+#undef NB_OP_SLOT_BINARY_1
+#undef NB_OP_SLOT
+
+/**
+ * Native type slot implementation of the operator 'Op'. The operands are
+ * converted without implicit conversions. When this fails, the slot forwards
+ * the call to the previously installed slot function, which dispatches to the
+ * overloads bound via nb_func (e.g. other operand types or reflected calls).
+ * 'L' and 'R' are the operand types in the order of the Python slot.
+ *
+ * CPython's generic binary slot functions refuse to run once they no longer
+ * occupy the slot, hence binary operators emulate them in 'dispatch()'.
+ */
+template <op_id id, op_type ot, typename Op, typename L, typename R, bool Cast>
+struct op_native {
+    using Slot = op_slot<id, ot>;
+    using Func = typename Slot::Func;
+    static inline Func fallback = nullptr;
+
+    template <typename... Ts> static decltype(auto) call(Ts &&...ts) {
+        if constexpr (Cast)
+            return Op::execute_cast((forward_t<Ts>) ts...);
+        else
+            return Op::execute((forward_t<Ts>) ts...);
+    }
+
+    template <typename T> static PyObject *ret(T &&value) {
+        using Ret = std::remove_cv_t<std::remove_reference_t<T>>;
+        return make_caster<Ret>::from_cpp((forward_t<T>) value,
+                                          rv_policy::move, nullptr).ptr();
+    }
+
+    /// Call the method 'name' of the type of 'self'
+    static PyObject *dispatch_1(PyObject *self, const char *name,
+                                PyObject *other) noexcept {
+        PyObject *func =
+            PyObject_GetAttrString((PyObject *) Py_TYPE(self), name);
+        if (!func) {
+            PyErr_Clear();
+            Py_RETURN_NOTIMPLEMENTED;
+        }
+        PyObject *args[2] = { self, other };
+        PyObject *result = NB_VECTORCALL(func, args, 2, nullptr);
+        Py_DECREF(func);
+        return result;
+    }
+
+    static PyObject *dispatch(PyObject *a, PyObject *b) noexcept {
+        PyTypeObject *ta = Py_TYPE(a), *tb = Py_TYPE(b);
+        bool do_b = ta != tb && tb->tp_as_number && Slot::get(tb) == binary;
+
+        if (ta->tp_as_number && Slot::get(ta) == binary) {
+            if (do_b && PyType_IsSubtype(tb, ta)) {
+                PyObject *r = dispatch_1(b, Slot::rname, a);
+                if (r != Py_NotImplemented)
+                    return r;
+                Py_DECREF(r);
+                do_b = false;
+            }
+
+            PyObject *r = dispatch_1(a, Slot::name, b);
+            if (r != Py_NotImplemented || ta == tb)
+                return r;
+            Py_DECREF(r);
+        }
+
+        if (do_b)
+            return dispatch_1(b, Slot::rname, a);
+
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+
+    static PyObject *binary(PyObject *a, PyObject *b) noexcept {
+        make_caster<L> ca;
+        make_caster<R> cb;
+        if (!ca.from_python(a, 0, nullptr) || !cb.from_python(b, 0, nullptr))
+            return dispatch(a, b);
+
+        try {
+            if constexpr (ot == op_l)
+                return ret(call(ca.operator cast_t<const L &>(),
+                                cb.operator cast_t<const R &>()));
+            else
+                return ret(call(cb.operator cast_t<const R &>(),
+                                ca.operator cast_t<const L &>()));
+        } catch (...) {
+            nb_translate_exception();
+            return nullptr;
+        }
+    }
+
+    static PyObject *inplace(PyObject *a, PyObject *b) noexcept {
+        make_caster<L> ca;
+        make_caster<R> cb;
+        if (!ca.from_python(a, 0, nullptr) || !cb.from_python(b, 0, nullptr))
+            return fallback(a, b);
+
+        try {
+            call(ca.operator cast_t<L &>(), cb.operator cast_t<const R &>());
+        } catch (...) {
+            nb_translate_exception();
+            return nullptr;
+        }
+
+        Py_INCREF(a);
+        return a;
+    }
+
+    static PyObject *compare(PyObject *a, PyObject *b, int op) noexcept {
+        make_caster<L> ca;
+        make_caster<R> cb;
+        if (op != Slot::cmp || !ca.from_python(a, 0, nullptr) ||
+            !cb.from_python(b, 0, nullptr))
+            return fallback(a, b, op);
+
+        try {
+            return ret(call(ca.operator cast_t<const L &>(),
+                            cb.operator cast_t<const R &>()));
+        } catch (...) {
+            nb_translate_exception();
+            return nullptr;
+        }
+    }
+
+    static PyObject *unary(PyObject *a) noexcept {
+        make_caster<L> ca;
+        if (!ca.from_python(a, 0, nullptr))
+            return fallback(a);
+
+        try {
+            return ret(call(ca.operator cast_t<const L &>()));
+        } catch (...) {
+            nb_translate_exception();
+            return nullptr;
+        }
+    }
+
+    static int boolean(PyObject *a) noexcept {
+        make_caster<L> ca;
+        if (!ca.from_python(a, 0, nullptr))
+            return fallback(a);
+
+        try {
+            return call(ca.operator cast_t<const L &>()) ? 1 : 0;
+        } catch (...) {
+            nb_translate_exception();
+            return -1;
+        }
+    }
+
+    static Py_hash_t hash(PyObject *a) noexcept {
+        make_caster<L> ca;
+        if (!ca.from_python(a, 0, nullptr))
+            return fallback(a);
+
+        try {
+            Py_hash_t h = (Py_hash_t) call(ca.operator cast_t<const L &>());
+            return h == -1 ? -2 : h; // -1 signals an error
+        } catch (...) {
+            nb_translate_exception();
+            return -1;
+        }
+    }
+
+    /// Replace the slot installed by the preceding nb_func binding
+    static void install(PyTypeObject *tp) {
+        constexpr op_slot_kind kind = Slot::kind;
+        if constexpr (kind != op_slot_kind::none) {
+            Func &slot = Slot::get(tp);
+            if (!slot)
+                return;
+            fallback = slot;
+
+            if constexpr (kind == op_slot_kind::binary)
+                slot = binary;
+            else if constexpr (kind == op_slot_kind::inplace)
+                slot = inplace;
+            else if constexpr (kind == op_slot_kind::compare)
+                slot = compare;
+            else if constexpr (kind == op_slot_kind::unary)
+                slot = unary;
+            else if constexpr (kind == op_slot_kind::boolean)
+                slot = boolean;
+            else
+                slot = hash;
+        } else {
+            (void) tp;
+        }
+    }
+};
+#endif
+
 /// Operator implementation generator
 template <op_id id, op_type ot, typename L, typename R> struct op_ {
     template <typename Class, typename... Extra> void execute(Class &cl, const Extra&... extra) const {
@@ -46,6 +316,10 @@ template <op_id id, op_type ot, typename L, typename R> struct op_ {
         using Rt = std::conditional_t<std::is_same_v<R, self_t>, Type, R>;
         using Op = op_impl<id, ot, Type, Lt, Rt>;
         cl.def(Op::name(), &Op::execute, is_operator(), extra...);
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+        if constexpr ((std::is_same_v<Extra, native_slot> || ...))
+            op_native<id, ot, Op, Lt, Rt, false>::install((PyTypeObject *) cl.ptr());
+#endif
     }
 
     template <typename Class, typename... Extra> void execute_cast(Class &cl, const Extra&... extra) const {
@@ -54,6 +328,10 @@ template <op_id id, op_type ot, typename L, typename R> struct op_ {
         using Rt = std::conditional_t<std::is_same_v<R, self_t>, Type, R>;
         using Op = op_impl<id, ot, Type, Lt, Rt>;
         cl.def(Op::name(), &Op::execute_cast, is_operator(), extra...);
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+        if constexpr ((std::is_same_v<Extra, native_slot> || ...))
+            op_native<id, ot, Op, Lt, Rt, true>::install((PyTypeObject *) cl.ptr());
+#endif
     }
 };
 
@@ -0,0 +1,147 @@
+/*
+    nanobind/sequence_view.h: nb::sequence_view<T>, which converts the
+    elements of a Python sequence argument on demand
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <iterator>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+
+/**
+ * \brief Function parameter type that refers to a Python ``list`` or
+ * ``tuple`` and converts its elements to ``T`` when they are accessed
+ *
+ * Unlike ``std::vector<T>``, binding a ``sequence_view<T>`` costs the same
+ * regardless of the size of the input. Elements that cannot be converted
+ * raise a ``TypeError`` upon access. Other sequences (except ``str`` and
+ * ``bytes``) are first copied into a ``tuple``. Views must only be used while
+ * holding the GIL.
+ */
+template <typename T> class sequence_view {
+    template <typename, typename> friend struct detail::type_caster;
+
+public:
+    using value_type = T;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = Py_ssize_t;
+        using pointer = void;
+        using reference = T;
+
+        T operator*() const { return (*m_view)[m_index]; }
+        iterator &operator++() { ++m_index; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++m_index; return tmp; }
+
+        /* Compare against the current size, since lists may shrink or grow
+           while they are being traversed */
+        bool operator==(const iterator &it) const { return done() == it.done(); }
+        bool operator!=(const iterator &it) const { return done() != it.done(); }
+
+    private:
+        friend class sequence_view;
+        iterator(const sequence_view *view, size_t index)
+            : m_view(view), m_index(index) { }
+        bool done() const { return !m_view || m_index >= m_view->size(); }
+
+        const sequence_view *m_view;
+        size_t m_index;
+    };
+
+    sequence_view() = default;
+
+    /// Number of elements
+    size_t size() const {
+        if (!m_seq.is_valid())
+            return 0;
+        return (size_t) (m_list ? NB_LIST_GET_SIZE(m_seq.ptr())
+                                : NB_TUPLE_GET_SIZE(m_seq.ptr()));
+    }
+
+    bool empty() const { return size() == 0; }
+
+    /// Convert and return the i-th element
+    T operator[](size_t i) const {
+        if (i >= size())
+            throw index_error();
+
+        object item = borrow(m_list ? NB_LIST_GET_ITEM(m_seq.ptr(), i)
+                                    : NB_TUPLE_GET_ITEM(m_seq.ptr(), i));
+
+        using Caster = detail::make_caster<T>;
+        uint8_t flags = (uint8_t) detail::cast_flags::convert;
+        if constexpr (detail::is_base_caster_v<Caster> && !std::is_pointer_v<T>)
+            flags |= (uint8_t) detail::cast_flags::none_disallowed;
+
+        Caster caster;
+        detail::cleanup_list cleanup(nullptr);
+        if (!caster.from_python(item, flags, &cleanup)) {
+            cleanup.release();
+            detail::raise_type_error(
+                "nanobind::sequence_view: could not convert element %zu!", i);
+        }
+
+        // Copy the result before releasing temporaries of implicit conversions
+        struct release_guard {
+            detail::cleanup_list &c;
+            ~release_guard() { c.release(); }
+        } guard { cleanup };
+
+        return caster.operator detail::cast_t<T>();
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(nullptr, 0); }
+
+    /// The underlying ``list`` or ``tuple``
+    handle seq() const { return m_seq; }
+
+private:
+    object m_seq;
+    bool m_list = false;
+};
+
+NAMESPACE_BEGIN(detail)
+
+template <typename T> struct type_caster<sequence_view<T>> {
+    NB_TYPE_CASTER(sequence_view<T>, const_name("collections.abc.Sequence[") +
+                                         make_caster<T>::Name + const_name("]"))
+
+    bool from_python(handle src, uint8_t, cleanup_list *) noexcept {
+        PyObject *o = src.ptr();
+
+        if (PyList_Check(o) || PyTuple_Check(o)) {
+            value.m_seq = borrow(src);
+        } else if (PySequence_Check(o) && !PyUnicode_Check(o) &&
+                   !PyBytes_Check(o)) {
+            value.m_seq = steal(PySequence_Tuple(o));
+            if (!value.m_seq.is_valid()) {
+                PyErr_Clear();
+                return false;
+            }
+        } else {
+            return false;
+        }
+
+        value.m_list = PyList_Check(value.m_seq.ptr());
+        return true;
+    }
+
+    static handle from_cpp(const sequence_view<T> &v, rv_policy,
+                           cleanup_list *) noexcept {
+        return v.seq().inc_ref();
+    }
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
@@ -11,6 +11,7 @@
 #include <nanobind/make_iterator.h>
 #include <nanobind/operators.h>
 #include <nanobind/stl/detail/traits.h>
+#include <vector>
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
@@ -35,6 +36,31 @@ inline void map_set(Map &m, const Key &k, const Value &v) {
     }
 }
 
+template <typename T> using has_map_reserve =
+    decltype(std::declval<T &>().reserve(0));
+
+/// Insert the contents of a dictionary into 'm', leaving 'm' unchanged on failure
+template <typename Map, typename Key, typename Value>
+void map_update(Map &m, handle d) {
+    // Convert all entries before touching the map
+    std::vector<std::pair<Key, Value>> entries;
+    entries.reserve((size_t) len(d));
+    for (auto [k, v] : borrow<dict>(d)) {
+        try {
+            entries.emplace_back(cast<Key>(k), cast<Value>(v));
+        } catch (const cast_error &) {
+            raise_type_error("Could not convert the entry with key '%s'!",
+                             str(k).c_str());
+        }
+    }
+
+    if constexpr (is_detected_v<has_map_reserve, Map>)
+        m.reserve(m.size() + entries.size());
+
+    for (auto &kv : entries)
+        map_set<Map, Key, Value>(m, kv.first, kv.second);
+}
+
 NAMESPACE_END(detail)
 
 template <typename Map, typename... Args>
@@ -104,8 +130,15 @@ class_<Map> bind_map(handle scope, const char *name, Args &&...args) {
 
         cl.def("__init__", [](Map *m, typed<dict, detail::dict_type_id<Key, Value>> &d) {
             new (m) Map();
-            for (auto [k, v] : d.value)
-                m->emplace(cast<Key>(k), cast<Value>(v));
+            if constexpr (is_detected_v<detail::has_map_reserve, Map>)
+                m->reserve((size_t) len(d.value));
+            try {
+                for (auto [k, v] : d.value)
+                    m->emplace(cast<Key>(k), cast<Value>(v));
+            } catch (...) {
+                m->~Map();
+                throw;
+            }
         }, "Construct from a dictionary");
 
         implicitly_convertible<dict, Map>();
@@ -123,6 +156,11 @@ class_<Map> bind_map(handle scope, const char *name, Args &&...args) {
                 detail::map_set<Map, Key, Value>(m, kv.first, kv.second);
         },
         "Update the map with element from `arg`");
+
+        cl.def("update", [](Map &m, typed<dict, detail::dict_type_id<Key, Value>> &d) {
+            detail::map_update<Map, Key, Value>(m, d.value);
+        },
+        "Update the map with element from `arg`");
     }
 
     if constexpr (detail::is_equality_comparable_v<Map>) {
@@ -12,6 +12,7 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/operators.h>
 #include <nanobind/make_iterator.h>
+#include <nanobind/ndarray.h>
 #include <nanobind/stl/detail/traits.h>
 #include <vector>
 #include <algorithm>
@@ -40,6 +41,84 @@ template <typename Value> struct iterable_type_id {
                                  const_name("]");
 };
 
+/// Vectors of scalars with a DLPack dtype expose their storage to Python
+template <typename Vector, typename Value>
+constexpr bool vector_exports_buffer_v =
+    is_ndarray_scalar_v<Value> && !std::is_same_v<Vector, std::vector<bool>>;
+
+/// Vectors of trivially copyable bound types expose their storage as an array
+/// of structs, whose fields are the def_rw()/def_ro() members of the type
+template <typename Vector, typename Value>
+constexpr bool vector_exports_struct_buffer_v =
+    std::is_class_v<Value> && std::is_trivially_copyable_v<Value> &&
+    !std::is_polymorphic_v<Value> && is_base_caster_v<make_caster<Value>> &&
+    std::is_same_v<typename Vector::value_type, Value>;
+
+template <typename Vector>
+int vector_getbuffer(PyObject *self, Py_buffer *view, int flags) {
+    using Value = typename Vector::value_type;
+
+    if (!inst_ready(self)) {
+        PyErr_SetString(PyExc_BufferError, "The vector is uninitialized!");
+        return -1;
+    }
+
+    Vector *v = inst_ptr<Vector>(self);
+    size_t size = v->size();
+
+    if constexpr (vector_exports_struct_buffer_v<Vector, Value>) {
+        return ndarray_export_struct_buffer(self, (void *) v->data(), size,
+                                            &typeid(Value), false, view, flags);
+    } else {
+        dlpack::dtype dt = dtype<Value>();
+        return ndarray_export_buffer(self, (void *) v->data(), 1, &size, &dt,
+                                     false, view, flags);
+    }
+}
+
+/// Append the contents of 'src' to 'v', leaving 'v' unchanged on failure
+template <typename Vector, typename Value>
+void vector_extend(Vector &v, handle src) {
+    size_t size = v.size();
+
+    if constexpr (vector_exports_buffer_v<Vector, Value> &&
+                  is_buffer_scalar_v<Value>) {
+        // Fast path for NumPy arrays, array.array, etc.
+        struct payload { Vector &v; size_t size; } p { v, size };
+        if (seq_get_buffer(src.ptr(), buffer_kind_v<Value>, sizeof(Value), true,
+                           [](void *p_, size_t n) noexcept -> void * {
+                               payload &p = *(payload *) p_;
+                               try {
+                                   p.v.resize(p.size + n);
+                               } catch (...) {
+                                   return nullptr;
+                               }
+                               return p.v.data() + p.size;
+                           }, &p))
+            return;
+        v.resize(size);
+    }
+
+    // Reserve space without defeating the geometric growth of 'v'
+    size_t hint = len_hint(src);
+    if (size + hint > v.capacity())
+        v.reserve(std::max(size + hint, 2 * v.capacity()));
+
+    try {
+        for (handle h : src) {
+            try {
+                v.push_back(cast<Value>(h));
+            } catch (const cast_error &) {
+                raise_type_error("Could not convert an element of type '%s'!",
+                                 type_name(h.type()).c_str());
+            }
+        }
+    } catch (...) {
+        v.erase(v.begin() + (ptrdiff_t) size, v.end());
+        throw;
+    }
+}
+
 NAMESPACE_END(detail)
 
 
@@ -54,7 +133,27 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
         return borrow<class_<Vector>>(cl_cur);
     }
 
-    auto cl = class_<Vector>(scope, name, std::forward<Args>(args)...)
+    /* Vectors of scalars and of plain bound structs support the buffer
+       protocol, unless the caller provides its own type slots */
+    constexpr bool ExportBuffer =
+        (detail::vector_exports_buffer_v<Vector, Value> ||
+         detail::vector_exports_struct_buffer_v<Vector, Value>) &&
+        !(std::is_same_v<std::decay_t<Args>, type_slots> || ...) &&
+        !(std::is_same_v<std::decay_t<Args>, type_slots_callback> || ...);
+
+    auto cl = [&] {
+        if constexpr (ExportBuffer) {
+            static PyType_Slot slots[] = {
+                { Py_bf_getbuffer, (void *) detail::vector_getbuffer<Vector> },
+                { Py_bf_releasebuffer, (void *) detail::ndarray_release_buffer },
+                { 0, nullptr }
+            };
+            return class_<Vector>(scope, name, type_slots(slots),
+                                  std::forward<Args>(args)...);
+        } else {
+            return class_<Vector>(scope, name, std::forward<Args>(args)...);
+        }
+    }()
         .def(init<>(), "Default constructor")
 
         .def("__len__", [](const Vector &v) { return v.size(); })
@@ -89,9 +188,12 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
 
         cl.def("__init__", [](Vector *v, typed<iterable, detail::iterable_type_id<Value>> &seq) {
             new (v) Vector();
-            v->reserve(len_hint(seq.value));
-            for (handle h : seq.value)
-                v->push_back(cast<Value>(h));
+            try {
+                detail::vector_extend<Vector, Value>(*v, seq.value);
+            } catch (...) {
+                v->~Vector();
+                throw;
+            }
         }, "Construct from an iterable object");
 
         implicitly_convertible<iterable, Vector>();
@@ -126,6 +228,12 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
                },
                "Extend `self` by appending elements from `arg`.")
 
+          .def("extend",
+               [](Vector &v, typed<iterable, detail::iterable_type_id<Value>> &seq) {
+                   detail::vector_extend<Vector, Value>(v, seq.value);
+               },
+               "Extend `self` by appending elements from `arg`.")
+
           .def("__setitem__",
                [](Vector &v, Py_ssize_t i, const Value &value) {
                    v[detail::wrap(i, v.size())] = value;
@@ -139,6 +247,10 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
           .def("__getitem__",
                [](const Vector &v, const slice &slice) -> Vector * {
                    auto [start, stop, step, length] = slice.compute(v.size());
+                   if (step == 1)
+                       return new Vector(v.begin() + (ptrdiff_t) start,
+                                         v.begin() + (ptrdiff_t) (start + length));
+
                    auto *seq = new Vector();
                    seq->reserve(length);
 
@@ -159,6 +271,13 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
                            "The left and right hand side of the slice "
                            "assignment have mismatched sizes!");
 
+                   if (step == 1) {
+                       if (&v != &value)
+                           std::copy(value.begin(), value.end(),
+                                     v.begin() + (ptrdiff_t) start);
+                       return;
+                   }
+
                    for (size_t i = 0; i < length; ++i) {
                        v[start] = value[i];
                        start += step;
@@ -188,6 +307,21 @@ class_<Vector> bind_vector(handle scope, const char *name, Args &&...args) {
                });
     }
 
+    // DLPack has no notion of structured dtypes
+    if constexpr (ExportBuffer && detail::vector_exports_buffer_v<Vector, Value>) {
+        cl.def("__dlpack__",
+               [](handle_t<Vector> self, kwargs) {
+                   Vector &v = cast<Vector &>(self);
+                   size_t size = v.size();
+                   return ndarray<Value, ndim<1>, device::cpu>(v.data(), 1, &size, self);
+               },
+               "Export the contents via the DLPack protocol (without copying).")
+
+          .def("__dlpack_device__", [](handle) {
+              return make_tuple(device::cpu::value, 0);
+          });
+    }
+
     if constexpr (detail::is_equality_comparable_v<Value>) {
         cl.def(self == self)
           .def(self != self)
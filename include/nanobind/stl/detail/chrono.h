@@ -69,10 +69,14 @@ struct datetime_types_t {
     handle date;
     handle timedelta;
 
-    // Ensure that the above four handles point to valid Python objects.
+    // Interned names of the attributes read by unpack_*()
+    handle year, month, day, hour, minute, second, microsecond;
+    handle days, seconds, microseconds;
+
+    // Ensure that the above handles point to valid Python objects.
     // If unable, throw nb::python_error.
     void ensure_ready() {
-        if (datetime.is_valid())
+        if (NB_LIKELY(microseconds.is_valid()))
             return;
 
         object mod = module_::import_("datetime");
@@ -81,16 +85,32 @@ struct datetime_types_t {
         object date_o = mod.attr("date");
         object timedelta_o = mod.attr("timedelta");
 
-        // Leak references to these datetime types. We could improve upon
-        // this by storing them in the internals structure and decref'ing
-        // in internals_cleanup(), but it doesn't seem worthwhile for
-        // something this fundamental. We can't store nb::object in this
-        // structure because it might be destroyed after the Python
-        // interpreter has finalized.
+        handle *attrs[] = { &year,   &month,  &day,         &hour,
+                            &minute, &second, &microsecond, &days,
+                            &seconds, &microseconds };
+        const char *attr_names[] = { "year",   "month",  "day",
+                                     "hour",   "minute", "second",
+                                     "microsecond", "days", "seconds",
+                                     "microseconds" };
+        object names[10];
+        for (size_t i = 0; i < 10; ++i) {
+            names[i] = steal(PyUnicode_InternFromString(attr_names[i]));
+            if (!names[i].is_valid())
+                raise_python_error();
+        }
+
+        // Leak references to these datetime types and attribute names. We
+        // could improve upon this by storing them in the internals
+        // structure and decref'ing in internals_cleanup(), but it doesn't
+        // seem worthwhile for something this fundamental. We can't store
+        // nb::object in this structure because it might be destroyed after
+        // the Python interpreter has finalized.
         datetime = datetime_o.release();
         time = time_o.release();
         date = date_o.release();
         timedelta = timedelta_o.release();
+        for (size_t i = 0; i < 10; ++i)
+            *attrs[i] = names[i].release();
     }
 };
 
@@ -101,8 +121,8 @@ inline datetime_types_t datetime_types;
 // The attribute value must be a Python integer object; other types
 // of numbers are not supported.
 NB_NOINLINE inline bool set_from_int_attr(int *dest, PyObject *o,
-                                          const char *name) noexcept {
-    PyObject *value = PyObject_GetAttrString(o, name);
+                                          handle name) noexcept {
+    PyObject *value = PyObject_GetAttr(o, name.ptr());
     if (!value)
         return false;
     long lval = PyLong_AsLong(value);
@@ -113,8 +133,8 @@ NB_NOINLINE inline bool set_from_int_attr(int *dest, PyObject *o,
     if (lval < std::numeric_limits<int>::min() ||
         lval > std::numeric_limits<int>::max()) {
         PyErr_Format(PyExc_OverflowError,
-                     "%R attribute '%s' (%R) does not fit in an int",
-                     o, name, value);
+                     "%R attribute '%U' (%R) does not fit in an int",
+                     o, name.ptr(), value);
         Py_DECREF(value);
         return false;
     }
@@ -125,12 +145,12 @@ NB_NOINLINE inline bool set_from_int_attr(int *dest, PyObject *o,
 
 NB_NOINLINE inline bool unpack_timedelta(PyObject *o, int *days,
                                          int *secs, int *usecs) {
-    datetime_types.ensure_ready();
-    if (PyType_IsSubtype(Py_TYPE(o),
-                         (PyTypeObject *) datetime_types.timedelta.ptr())) {
-        if (!set_from_int_attr(days, o, "days") ||
-            !set_from_int_attr(secs, o, "seconds") ||
-            !set_from_int_attr(usecs, o, "microseconds")) {
+    datetime_types_t &dt = datetime_types;
+    dt.ensure_ready();
+    if (PyType_IsSubtype(Py_TYPE(o), (PyTypeObject *) dt.timedelta.ptr())) {
+        if (!set_from_int_attr(days, o, dt.days) ||
+            !set_from_int_attr(secs, o, dt.seconds) ||
+            !set_from_int_attr(usecs, o, dt.microseconds)) {
             raise_python_error();
         }
         return true;
@@ -142,39 +162,37 @@ NB_NOINLINE inline bool unpack_datetime(PyObject *o,
                                         int *year, int *month, int *day,
                                         int *hour, int *minute, int *second,
                                         int *usec) {
-    datetime_types.ensure_ready();
-    if (PyType_IsSubtype(Py_TYPE(o),
-                         (PyTypeObject *) datetime_types.datetime.ptr())) {
-        if (!set_from_int_attr(usec, o, "microsecond") ||
-            !set_from_int_attr(second, o, "second") ||
-            !set_from_int_attr(minute, o, "minute") ||
-            !set_from_int_attr(hour, o, "hour") ||
-            !set_from_int_attr(day, o, "day") ||
-            !set_from_int_attr(month, o, "month") ||
-            !set_from_int_attr(year, o, "year")) {
+    datetime_types_t &dt = datetime_types;
+    dt.ensure_ready();
+    if (PyType_IsSubtype(Py_TYPE(o), (PyTypeObject *) dt.datetime.ptr())) {
+        if (!set_from_int_attr(usec, o, dt.microsecond) ||
+            !set_from_int_attr(second, o, dt.second) ||
+            !set_from_int_attr(minute, o, dt.minute) ||
+            !set_from_int_attr(hour, o, dt.hour) ||
+            !set_from_int_attr(day, o, dt.day) ||
+            !set_from_int_attr(month, o, dt.month) ||
+            !set_from_int_attr(year, o, dt.year)) {
             raise_python_error();
         }
         return true;
     }
-    if (PyType_IsSubtype(Py_TYPE(o),
-                         (PyTypeObject *) datetime_types.date.ptr())) {
+    if (PyType_IsSubtype(Py_TYPE(o), (PyTypeObject *) dt.date.ptr())) {
         *usec = *second = *minute = *hour = 0;
-        if (!set_from_int_attr(day, o, "day") ||
-            !set_from_int_attr(month, o, "month") ||
-            !set_from_int_attr(year, o, "year")) {
+        if (!set_from_int_attr(day, o, dt.day) ||
+            !set_from_int_attr(month, o, dt.month) ||
+            !set_from_int_attr(year, o, dt.year)) {
             raise_python_error();
         }
         return true;
     }
-    if (PyType_IsSubtype(Py_TYPE(o),
-                         (PyTypeObject *) datetime_types.time.ptr())) {
+    if (PyType_IsSubtype(Py_TYPE(o), (PyTypeObject *) dt.time.ptr())) {
         *day = 1;
         *month = 1;
         *year = 1970;
-        if (!set_from_int_attr(usec, o, "microsecond") ||
-            !set_from_int_attr(second, o, "second") ||
-            !set_from_int_attr(minute, o, "minute") ||
-            !set_from_int_attr(hour, o, "hour")) {
+        if (!set_from_int_attr(usec, o, dt.microsecond) ||
+            !set_from_int_attr(second, o, dt.second) ||
+            !set_from_int_attr(minute, o, dt.minute) ||
+            !set_from_int_attr(hour, o, dt.hour)) {
             raise_python_error();
         }
         return true;
@@ -12,10 +12,21 @@ template <typename Array, typename Entry, size_t Size> struct array_caster {
     using Caster = make_caster<Entry>;
 
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        if constexpr (is_buffer_scalar_v<Entry>) {
+            // Fast path for NumPy arrays, array.array, etc.
+            if (seq_get_buffer(src.ptr(), buffer_kind_v<Entry>, sizeof(Entry),
+                               flags & (uint8_t) cast_flags::convert,
+                               [](void *p, size_t size) noexcept -> void * {
+                                   return size == Size ? ((Array *) p)->data()
+                                                       : nullptr;
+                               }, &value))
+                return true;
+        }
+
         PyObject *temp;
 
         /* Will initialize 'temp' (NULL in the case of a failure.) */
-        PyObject **o = seq_get_with_size(src.ptr(), Size, &temp);
+        PyObject **o = seq_get_with_size_inline(src.ptr(), Size, &temp);
 
         Caster caster;
         bool success = o != nullptr;
@@ -22,9 +22,45 @@ template <typename Dict, typename Key, typename Val> struct dict_caster {
     using KeyCaster = make_caster<Key>;
     using ValCaster = make_caster<Val>;
 
+    template <typename T> using has_reserve = decltype(std::declval<T>().reserve(0));
+
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
         value.clear();
 
+        uint8_t flags_key = flags, flags_val = flags;
+
+        if constexpr (is_base_caster_v<KeyCaster> && !std::is_pointer_v<Key>)
+            flags_key |= (uint8_t) cast_flags::none_disallowed;
+        if constexpr (is_base_caster_v<ValCaster> && !std::is_pointer_v<Val>)
+            flags_val |= (uint8_t) cast_flags::none_disallowed;
+
+        KeyCaster key_caster;
+        ValCaster val_caster;
+
+#if !defined(NB_FREE_THREADED)
+        /* Walk dictionaries in place instead of materializing the list
+           returned by PyMapping_Items() */
+        if (PyDict_CheckExact(src.ptr())) {
+            reserve(NB_DICT_GET_SIZE(src.ptr()));
+
+            PyObject *key, *val;
+            Py_ssize_t pos = 0;
+            bool success = true;
+
+            while (success && PyDict_Next(src.ptr(), &pos, &key, &val)) {
+                // Conversions may run arbitrary code that modifies the dict
+                Py_INCREF(key);
+                Py_INCREF(val);
+                success = load_item(key_caster, val_caster, key, val,
+                                    flags_key, flags_val, cleanup);
+                Py_DECREF(val);
+                Py_DECREF(key);
+            }
+
+            return success;
+        }
+#endif
+
         PyObject *items = PyMapping_Items(src.ptr());
         if (items == nullptr) {
             PyErr_Clear();
@@ -34,32 +70,19 @@ template <typename Dict, typename Key, typename Val> struct dict_caster {
         Py_ssize_t size = NB_LIST_GET_SIZE(items);
         bool success = size >= 0;
 
-        uint8_t flags_key = flags, flags_val = flags;
+        if (success)
+            reserve((size_t) size);
 
-        if constexpr (is_base_caster_v<KeyCaster> && !std::is_pointer_v<Key>)
-            flags_key |= (uint8_t) cast_flags::none_disallowed;
-        if constexpr (is_base_caster_v<ValCaster> && !std::is_pointer_v<Val>)
-            flags_val |= (uint8_t) cast_flags::none_disallowed;
-
-        KeyCaster key_caster;
-        ValCaster val_caster;
         for (Py_ssize_t i = 0; i < size; ++i) {
             PyObject *item = NB_LIST_GET_ITEM(items, i);
             PyObject *key = NB_TUPLE_GET_ITEM(item, 0);
             PyObject *val = NB_TUPLE_GET_ITEM(item, 1);
 
-            if (!key_caster.from_python(key, flags_key, cleanup)) {
-                success = false;
-                break;
-            }
-
-            if (!val_caster.from_python(val, flags_val, cleanup)) {
+            if (!load_item(key_caster, val_caster, key, val, flags_key,
+                           flags_val, cleanup)) {
                 success = false;
                 break;
             }
-
-            value.emplace(key_caster.operator cast_t<Key>(),
-                          val_caster.operator cast_t<Val>());
         }
 
         Py_DECREF(items);
@@ -67,9 +90,31 @@ template <typename Dict, typename Key, typename Val> struct dict_caster {
         return success;
     }
 
+    void reserve(size_t size) noexcept {
+        if constexpr (is_detected_v<has_reserve, Dict>) {
+            try {
+                value.reserve(size);
+            } catch (...) { }
+        }
+        (void) size;
+    }
+
+    bool load_item(KeyCaster &key_caster, ValCaster &val_caster,
+                   PyObject *key, PyObject *val, uint8_t flags_key,
+                   uint8_t flags_val, cleanup_list *cleanup) noexcept {
+        if (!key_caster.from_python(key, flags_key, cleanup) ||
+            !val_caster.from_python(val, flags_val, cleanup))
+            return false;
+
+        value.emplace(key_caster.operator cast_t<Key>(),
+                      val_caster.operator cast_t<Val>());
+        return true;
+    }
+
     template <typename T>
     static handle from_cpp(T &&src, rv_policy policy, cleanup_list *cleanup) {
-        dict ret;
+        // Avoid rehashing while inserting the items
+        object ret = steal(dict_new_presized(src.size()));
 
         if (ret.is_valid()) {
             for (auto &item : src) {
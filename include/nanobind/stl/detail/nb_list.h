@@ -21,8 +21,46 @@ template <typename List, typename Entry> struct list_caster {
     using Caster = make_caster<Entry>;
 
     template <typename T> using has_reserve = decltype(std::declval<T>().reserve(0));
+    template <typename T> using has_data = decltype(std::declval<T &>().data());
+
+    /// Contiguous lists of numbers (e.g. ``std::vector<double>``) can be bulk-loaded
+    static constexpr bool BulkLoad =
+        is_buffer_scalar_v<Entry> && is_detected_v<has_data, List>;
+
+    /// Contiguous lists of pointers to bound non-polymorphic types (e.g.
+    /// ``std::vector<Node *>``) are converted with a single type lookup
+    static constexpr bool BulkStore =
+        std::is_pointer_v<Entry> && is_detected_v<has_data, List> &&
+        is_base_caster_v<Caster> && !std::is_polymorphic_v<intrinsic_t<Entry>> &&
+        std::is_base_of_v<std::false_type, type_hook<intrinsic_t<Entry>>>;
 
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        if constexpr (BulkLoad) {
+            // Fast path for NumPy arrays, array.array, etc.
+            if (seq_get_buffer(src.ptr(), buffer_kind_v<Entry>, sizeof(Entry),
+                               flags & (uint8_t) cast_flags::convert,
+                               [](void *p, size_t size) noexcept -> void * {
+                                   List &list = *(List *) p;
+                                   try {
+                                       list.resize(size);
+                                   } catch (...) {
+                                       return nullptr;
+                                   }
+                                   return list.data();
+                               }, &value))
+                return true;
+        }
+
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+        // Lists and tuples expose their contents without a temporary
+        if (PyList_CheckExact(src.ptr()) || PyTuple_CheckExact(src.ptr()))
+            return from_seq(src, flags, cleanup);
+#endif
+
+        return from_iter(src, flags, cleanup);
+    }
+
+    bool from_seq(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
         size_t size;
         PyObject *temp;
 
@@ -55,8 +93,61 @@ template <typename List, typename Entry> struct list_caster {
         return success;
     }
 
+    /// Stream the items of other sequences in chunks (e.g. ``range``)
+    bool from_iter(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        size_t size_hint;
+        PyObject *iter = seq_iter(src.ptr(), &size_hint);
+
+        value.clear();
+
+        if (!iter)
+            return false;
+
+        if constexpr (is_detected_v<has_reserve, List>) {
+            try {
+                value.reserve(size_hint);
+            } catch (...) { }
+        }
+
+        Caster caster;
+        bool success = true;
+
+        if constexpr (is_base_caster_v<Caster> && !std::is_pointer_v<Entry>)
+            flags |= (uint8_t) cast_flags::none_disallowed;
+
+        constexpr size_t ChunkSize = 32;
+        PyObject *chunk[ChunkSize];
+        size_t n;
+
+        do {
+            n = iter_next_chunk(iter, chunk, ChunkSize);
+            if (n == (size_t) -1) {
+                success = false;
+                break;
+            }
+
+            for (size_t i = 0; i < n; ++i) {
+                if (success) {
+                    success = caster.from_python(chunk[i], flags, cleanup);
+                    if (success)
+                        value.push_back(caster.operator cast_t<Entry>());
+                }
+                Py_DECREF(chunk[i]);
+            }
+        } while (success && n == ChunkSize);
+
+        Py_DECREF(iter);
+
+        return success;
+    }
+
     template <typename T>
     static handle from_cpp(T &&src, rv_policy policy, cleanup_list *cleanup) {
+        if constexpr (BulkStore)
+            return nb_type_put_list(&typeid(intrinsic_t<Entry>),
+                                    (void *const *) src.data(), src.size(),
+                                    infer_policy<Entry>(policy), cleanup);
+
         object ret = steal(PyList_New(src.size()));
 
         if (ret.is_valid()) {
@@ -19,36 +19,50 @@ template <typename Set, typename Key> struct set_caster {
 
     using Caster = make_caster<Key>;
 
+    template <typename T> using has_reserve = decltype(std::declval<T>().reserve(0));
+
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
         value.clear();
 
-        PyObject* iter = obj_iter(src.ptr());
+        PyObject *iter = PyObject_GetIter(src.ptr());
         if (!iter) {
             PyErr_Clear();
             return false;
         }
 
+        if constexpr (is_detected_v<has_reserve, Set>) {
+            try {
+                value.reserve(obj_len_hint(src.ptr()));
+            } catch (...) { }
+        }
+
         bool success = true;
         Caster key_caster;
-        PyObject *key;
 
         if constexpr (is_base_caster_v<Caster> && !std::is_pointer_v<Key>)
             flags |= (uint8_t) cast_flags::none_disallowed;
 
-        while ((key = PyIter_Next(iter)) != nullptr) {
-            success &= key_caster.from_python(key, flags, cleanup);
-            Py_DECREF(key);
+        // Consume the iterator in chunks
+        constexpr size_t ChunkSize = 32;
+        PyObject *chunk[ChunkSize];
+        size_t n;
 
-            if (!success)
+        do {
+            n = iter_next_chunk(iter, chunk, ChunkSize);
+            if (n == (size_t) -1) {
+                success = false;
                 break;
+            }
 
-            value.emplace(key_caster.operator cast_t<Key>());
-        }
-
-        if (PyErr_Occurred()) {
-            PyErr_Clear();
-            success = false;
-        }
+            for (size_t i = 0; i < n; ++i) {
+                if (success) {
+                    success = key_caster.from_python(chunk[i], flags, cleanup);
+                    if (success)
+                        value.emplace(key_caster.operator cast_t<Key>());
+                }
+                Py_DECREF(chunk[i]);
+            }
+        } while (success && n == ChunkSize);
 
         Py_DECREF(iter);
 
@@ -12,26 +12,65 @@
 
 #include <filesystem>
 #include <string>
+#include <string_view>
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
+
+/**
+ * \brief Path that is returned to Python as a ``str`` instead of a
+ * ``pathlib.Path``, which avoids the cost of creating the latter
+ */
+struct path_str : std::filesystem::path {
+    using std::filesystem::path::path;
+    path_str() = default;
+    path_str(const std::filesystem::path &p) : std::filesystem::path(p) { }
+    path_str(std::filesystem::path &&p) : std::filesystem::path(std::move(p)) { }
+};
+
 NAMESPACE_BEGIN(detail)
 
+/// 'pathlib.Path' type (new reference, or nullptr with an error set)
+NB_NOINLINE inline PyObject *pathlib_path_type() noexcept {
+#if !defined(NB_SUBINTERPRETERS)
+    // Leaked intentionally, like the 'datetime' types of <stl/chrono.h>
+    static PyObject *path_type = nullptr;
+    if (path_type) {
+        Py_INCREF(path_type);
+        return path_type;
+    }
+#endif
+
+    PyObject *mod = PyImport_ImportModule("pathlib");
+    if (!mod)
+        return nullptr;
+    PyObject *result = PyObject_GetAttrString(mod, "Path");
+    Py_DECREF(mod);
+
+#if !defined(NB_SUBINTERPRETERS)
+    if (result) {
+        Py_INCREF(result);
+        path_type = result;
+    }
+#endif
+
+    return result;
+}
+
 template <>
 struct type_caster<std::filesystem::path> {
 
     static handle from_cpp(const std::filesystem::path &path, rv_policy,
                            cleanup_list *) noexcept {
         str py_str = to_py_str(path.native());
-        if (py_str.is_valid()) {
-            try {
-                return module_::import_("pathlib")
-                    .attr("Path")(py_str)
-                    .release();
-            } catch (python_error &e) {
-                e.restore();
-            }
-        }
-        return handle();
+        if (!py_str.is_valid())
+            return handle();
+
+        object path_type = steal(pathlib_path_type());
+        if (!path_type.is_valid())
+            return handle();
+
+        return PyObject_CallFunctionObjArgs(path_type.ptr(), py_str.ptr(),
+                                            nullptr);
     }
 
     template <typename Char = typename std::filesystem::path::value_type>
@@ -40,14 +79,23 @@ struct type_caster<std::filesystem::path> {
 
         /* PyUnicode_FSConverter and PyUnicode_FSDecoder normally take care of
            calling PyOS_FSPath themselves, but that's broken on PyPy (see PyPy
-           issue #3168) so we do it ourselves instead. */
-        PyObject *buf = PyOS_FSPath(src.ptr());
+           issue #3168) so we do it ourselves instead. Strings don't need to
+           go through the protocol. */
+        PyObject *buf;
+        if (PyUnicode_Check(src.ptr()))
+            buf = src.inc_ref().ptr();
+        else
+            buf = PyOS_FSPath(src.ptr());
+
         if (buf) {
             PyObject *native = nullptr;
             if constexpr (std::is_same_v<Char, char>) {
                 if (PyUnicode_FSConverter(buf, &native)) {
-                    if (char* s = PyBytes_AsString(native)) {
-                        value = s; // Points to internal buffer, no need to free
+                    char *s = nullptr;
+                    Py_ssize_t size = 0;
+                    if (PyBytes_AsStringAndSize(native, &s, &size) == 0) {
+                        // Points to internal buffer, no need to free
+                        value = std::string_view(s, (size_t) size);
                         success = true;
                     }
                 }
@@ -73,7 +121,7 @@ struct type_caster<std::filesystem::path> {
 
     NB_TYPE_CASTER(std::filesystem::path, const_name("os.PathLike"))
 
-private:
+protected:
     static str to_py_str(const std::string &s) {
         return steal<str>(
             PyUnicode_DecodeFSDefaultAndSize(s.c_str(), (Py_ssize_t) s.size()));
@@ -85,5 +133,23 @@ private:
     }
 };
 
+template <>
+struct type_caster<path_str> : type_caster<std::filesystem::path> {
+    NB_TYPE_CASTER(path_str, const_name("str"))
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        type_caster<std::filesystem::path> caster;
+        if (!caster.from_python(src, flags, cleanup))
+            return false;
+        value = std::move(caster.value);
+        return true;
+    }
+
+    static handle from_cpp(const std::filesystem::path &path, rv_policy,
+                           cleanup_list *) noexcept {
+        return to_py_str(path.native()).release();
+    }
+};
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
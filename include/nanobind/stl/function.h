@@ -11,32 +11,37 @@
 
 #include <nanobind/nanobind.h>
 #include <functional>
+#include <atomic>
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
+/* Python callable referenced by a std::function<..>. Copies share a separate
+   atomic reference count, so that they can be created and destroyed on any
+   thread without acquiring the GIL. Only the last copy releases the Python
+   object (see decref_deferred()). */
 struct pyfunc_wrapper {
     PyObject *f;
+    std::atomic<size_t> *refs;
 
-    explicit pyfunc_wrapper(PyObject *f) : f(f) {
+    explicit pyfunc_wrapper(PyObject *f) : f(f), refs(new std::atomic<size_t>(1)) {
         Py_INCREF(f);
     }
 
-    pyfunc_wrapper(pyfunc_wrapper &&w) noexcept : f(w.f) {
+    pyfunc_wrapper(pyfunc_wrapper &&w) noexcept : f(w.f), refs(w.refs) {
         w.f = nullptr;
+        w.refs = nullptr;
     }
 
-    pyfunc_wrapper(const pyfunc_wrapper &w) : f(w.f) {
-        if (f) {
-            gil_scoped_acquire acq;
-            Py_INCREF(f);
-        }
+    pyfunc_wrapper(const pyfunc_wrapper &w) noexcept : f(w.f), refs(w.refs) {
+        if (refs)
+            refs->fetch_add(1, std::memory_order_relaxed);
     }
 
     ~pyfunc_wrapper() {
-        if (f) {
-            gil_scoped_acquire acq;
-            Py_DECREF(f);
+        if (refs && refs->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete refs;
+            decref_deferred(f);
         }
     }
 
@@ -58,7 +63,7 @@ struct type_caster<std::function<Return(Args...)>> {
         using pyfunc_wrapper::pyfunc_wrapper;
 
         Return operator()(Args... args) const {
-            gil_scoped_acquire acq;
+            gil_scoped_acquire acq(gil_site::callback);
             return cast<Return>(handle(f)((forward_t<Args>) args...));
         }
     };
@@ -70,7 +75,30 @@ struct type_caster<std::function<Return(Args...)>> {
         if (!PyCallable_Check(src.ptr()))
             return false;
 
-        value = pyfunc_wrapper_t(src.ptr());
+        // Call C++ functions bound by nanobind directly
+        using FuncPtr = Return (*)(Args...);
+        if (void *p = nb_func_native(src.ptr(), &typeid(FuncPtr))) {
+            value = *(FuncPtr *) p;
+            return true;
+        }
+
+        if (void *p = nb_func_native(src.ptr(), &typeid(Value))) {
+            // Large callables are stored on the heap (see func_create())
+            if constexpr (sizeof(Value) > sizeof(func_data_prelim<0>::capture))
+                p = *(void **) p;
+            try {
+                value = *(const Value *) p;
+            } catch (...) {
+                return false;
+            }
+            return true;
+        }
+
+        try {
+            value = pyfunc_wrapper_t(src.ptr());
+        } catch (...) {
+            return false;
+        }
 
         return true;
     }
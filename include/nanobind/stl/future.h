@@ -0,0 +1,91 @@
+/*
+    nanobind/stl/future.h: type caster that exposes std::future<...> as an
+    awaitable asyncio future
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <future>
+#include <thread>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+template <typename T> struct future_payload : future_state {
+    std::future<T> value;
+    rv_policy policy;
+};
+
+template <typename T> struct type_caster<std::future<T>> {
+    using Caster = make_caster<std::conditional_t<std::is_void_v<T>, void_type, T>>;
+    using Payload = future_payload<T>;
+
+    NB_TYPE_CASTER(std::future<T>, const_name("Awaitable[") + Caster::Name +
+                                       const_name("]"))
+
+    bool from_python(handle, uint8_t, cleanup_list *) noexcept { return false; }
+
+    static handle from_cpp(Value &&value, rv_policy policy,
+                           cleanup_list *) noexcept {
+        if (!value.valid()) {
+            PyErr_SetString(PyExc_RuntimeError,
+                            "nanobind::detail::type_caster<std::future<T>>: "
+                            "the future has no shared state!");
+            return handle();
+        }
+
+        Payload *p = new Payload();
+        p->value = std::move(value);
+
+        // The result is a temporary unless the future yields a reference
+        p->policy = std::is_reference_v<T> ? policy : rv_policy::move;
+
+        p->resolve = [](future_state *s) -> PyObject * {
+            Payload *p2 = (Payload *) s;
+            if constexpr (std::is_void_v<T>) {
+                p2->value.get();
+                return none().release().ptr();
+            } else {
+                return Caster::from_cpp(p2->value.get(), p2->policy, nullptr)
+                    .ptr();
+            }
+        };
+
+        p->release = [](future_state *s) noexcept { delete (Payload *) s; };
+
+        PyObject *future = future_create(p);
+        if (!future) {
+            delete p;
+            return handle();
+        }
+
+        /* std::future does not support continuations, so a helper thread
+           waits for the result without holding the GIL */
+        try {
+            std::thread([p] {
+                p->value.wait();
+                future_complete(p);
+            }).detach();
+        } catch (const std::exception &e) {
+            Py_DECREF(p->future);
+            Py_DECREF(p->loop);
+            Py_DECREF(future);
+            delete p;
+            PyErr_Format(PyExc_RuntimeError,
+                         "nanobind::detail::type_caster<std::future<T>>: "
+                         "could not create a thread: %s", e.what());
+            return handle();
+        }
+
+        return future;
+    }
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
@@ -36,7 +36,7 @@ template <typename T1, typename T2> struct type_caster<std::pair<T1, T2>> {
     bool from_python(handle src, uint8_t flags,
                      cleanup_list *cleanup) noexcept {
         PyObject *temp; // always initialized by the following line
-        PyObject **o = seq_get_with_size(src.ptr(), 2, &temp);
+        PyObject **o = seq_get_with_size_inline(src.ptr(), 2, &temp);
 
         bool success = o &&
                        caster1.from_python(o[0], flags, cleanup) &&
@@ -57,19 +57,25 @@ template <typename T1, typename T2> struct type_caster<std::pair<T1, T2>> {
     template <typename T>
     static handle from_cpp(T &&value, rv_policy policy,
                            cleanup_list *cleanup) noexcept {
-        object o1 = steal(
-            Caster1::from_cpp(forward_like<T>(value.first), policy, cleanup));
-        if (!o1.is_valid())
+        PyObject *r = PyTuple_New(2);
+        if (!r)
             return {};
 
-        object o2 = steal(
-            Caster2::from_cpp(forward_like<T>(value.second), policy, cleanup));
-        if (!o2.is_valid())
+        // Convert directly into the tuple, which releases partial results
+        PyObject *o = Caster1::from_cpp(forward_like<T>(value.first), policy,
+                                        cleanup).ptr();
+        if (o) {
+            NB_TUPLE_SET_ITEM(r, 0, o);
+            o = Caster2::from_cpp(forward_like<T>(value.second), policy,
+                                  cleanup).ptr();
+        }
+
+        if (!o) {
+            Py_DECREF(r);
             return {};
+        }
 
-        PyObject *r = PyTuple_New(2);
-        NB_TUPLE_SET_ITEM(r, 0, o1.release().ptr());
-        NB_TUPLE_SET_ITEM(r, 1, o2.release().ptr());
+        NB_TUPLE_SET_ITEM(r, 1, o);
         return r;
     }
 
@@ -21,8 +21,7 @@ struct py_deleter {
         // Don't run the deleter if the interpreter has been shut down
         if (!Py_IsInitialized())
             return;
-        gil_scoped_acquire guard;
-        Py_DECREF(o);
+        decref_deferred(o);
     }
 
     PyObject *o;
@@ -51,6 +50,56 @@ shared_from_python(T *ptr, handle h) noexcept {
         return std::shared_ptr<T>(nullptr);
 }
 
+/* Non-owning reference to the last shared_ptr that shared_from_python_cached()
+   created for an instance. New conversions reuse its control block as long
+   as C++ code keeps a shared_ptr to the instance alive. */
+inline void shared_ptr_cache_delete(void *p) noexcept {
+    delete (std::weak_ptr<void> *) p;
+}
+
+struct shared_ptr_cache_args {
+    void *ptr;
+    PyObject *o;
+    std::shared_ptr<void> result;
+};
+
+inline NB_NOINLINE void shared_ptr_cache_visit(void **payload,
+                                               void *arg) noexcept {
+    std::weak_ptr<void> *cache = (std::weak_ptr<void> *) *payload;
+    shared_ptr_cache_args &a = *(shared_ptr_cache_args *) arg;
+
+    if (cache)
+        a.result = cache->lock();
+
+    /* The instance pointer may differ from the cached one (e.g. when
+       converting to a base class), hence the aliasing constructor below */
+    if (a.result) {
+        a.result = std::shared_ptr<void>(std::move(a.result), a.ptr);
+        return;
+    }
+
+    a.result = shared_from_python(a.ptr, a.o);
+
+    try {
+        if (cache)
+            *cache = a.result;
+        else
+            *payload = new std::weak_ptr<void>(a.result);
+    } catch (...) { }
+}
+
+/// Like shared_from_python(), but reuse the control block of live shared_ptrs
+inline NB_NOINLINE std::shared_ptr<void>
+shared_from_python_cached(void *ptr, handle h) noexcept {
+    if (!ptr)
+        return std::shared_ptr<void>(nullptr);
+
+    shared_ptr_cache_args args{ ptr, h.ptr(), { } };
+    keep_alive_visit(h.ptr(), shared_ptr_cache_delete, shared_ptr_cache_visit,
+                     &args);
+    return std::move(args.result);
+}
+
 inline NB_NOINLINE void shared_from_cpp(std::shared_ptr<void> &&ptr,
                                         PyObject *o) noexcept {
     keep_alive(o, new std::shared_ptr<void>(std::move(ptr)),
@@ -91,7 +140,7 @@ template <typename T> struct type_caster<std::shared_ptr<T>> {
             value = shared_from_python(ptr, src);
         } else {
             value = std::static_pointer_cast<T>(
-                shared_from_python(static_cast<void *>(ptr), src));
+                shared_from_python_cached(static_cast<void *>(ptr), src));
         }
         return true;
     }
@@ -18,14 +18,27 @@ NAMESPACE_BEGIN(detail)
 template <> struct type_caster<std::string_view> {
     NB_TYPE_CASTER(std::string_view, const_name("str"))
 
-    bool from_python(handle src, uint8_t, cleanup_list *) noexcept {
-        Py_ssize_t size;
-        const char *str = PyUnicode_AsUTF8AndSize(src.ptr(), &size);
-        if (!str) {
-            PyErr_Clear();
-            return false;
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        if (PyUnicode_Check(src.ptr())) {
+            Py_ssize_t size;
+            const char *str = PyUnicode_AsUTF8AndSize(src.ptr(), &size);
+            if (!str) {
+                PyErr_Clear();
+                return false;
+            }
+            value = std::string_view(str, (size_t) size);
+            return true;
         }
-        value = std::string_view(str, (size_t) size);
+
+        // Byte strings and other buffers reference their contents implicitly
+        if (!(flags & (uint8_t) cast_flags::convert))
+            return false;
+
+        const char *ptr;
+        size_t size;
+        if (!bytes_view_get(src.ptr(), cleanup, &ptr, &size))
+            return false;
+        value = std::string_view(ptr, size);
         return true;
     }
 
@@ -16,8 +16,7 @@ NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
 template <typename... Ts> struct type_caster<std::tuple<Ts...>> {
-    static constexpr size_t N  = sizeof...(Ts),
-                            N1 = N > 0 ? N : 1;
+    static constexpr size_t N = sizeof...(Ts);
 
     using Value = std::tuple<Ts...>;
     using Indices = std::make_index_sequence<N>;
@@ -44,7 +43,7 @@ template <typename... Ts> struct type_caster<std::tuple<Ts...>> {
         (void) src; (void) flags; (void) cleanup;
 
         PyObject *temp; // always initialized by the following line
-        PyObject **o = seq_get_with_size(src.ptr(), N, &temp);
+        PyObject **o = seq_get_with_size_inline(src.ptr(), N, &temp);
 
         bool success =
             (o && ... &&
@@ -73,22 +72,31 @@ template <typename... Ts> struct type_caster<std::tuple<Ts...>> {
                                           cleanup_list *cleanup,
                                           std::index_sequence<Is...>) noexcept {
         (void) value; (void) policy; (void) cleanup;
-        object o[N1];
 
+        PyObject *r = PyTuple_New(N);
+        if (!r)
+            return handle();
+
+        // Convert directly into the tuple, which releases partial results
         bool success =
-            (... &&
-             ((o[Is] = steal(make_caster<Ts>::from_cpp(
-                   forward_like<T>(std::get<Is>(value)), policy, cleanup))),
-              o[Is].is_valid()));
+            (... && set_item(r, Is, make_caster<Ts>::from_cpp(
+                   forward_like<T>(std::get<Is>(value)), policy, cleanup)));
 
-        if (!success)
+        if (!success) {
+            Py_DECREF(r);
             return handle();
+        }
 
-        PyObject *r = PyTuple_New(N);
-        (NB_TUPLE_SET_ITEM(r, Is, o[Is].release().ptr()), ...);
         return r;
     }
 
+    static bool set_item(PyObject *r, size_t i, handle h) noexcept {
+        if (!h.is_valid())
+            return false;
+        NB_TUPLE_SET_ITEM(r, (Py_ssize_t) i, h.ptr());
+        return true;
+    }
+
     explicit operator Value() { return cast_impl(Indices{}); }
 
     template <size_t... Is> Value cast_impl(std::index_sequence<Is...>) {
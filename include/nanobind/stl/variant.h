@@ -66,6 +66,14 @@ template <typename... Ts> struct type_caster<std::variant<Ts...>> {
     }
 
     bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        /* Like the function dispatcher, look for an exact match among all
+           alternatives before permitting implicit conversions */
+        if (flags & (uint8_t) cast_flags::convert) {
+            uint8_t noconvert = flags & ~(uint8_t) cast_flags::convert;
+            if ((try_variant<Ts>(src, noconvert, cleanup) || ...))
+                return true;
+        }
+
         return (try_variant<Ts>(src, flags, cleanup) || ...);
     }
 
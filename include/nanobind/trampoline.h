@@ -37,6 +37,7 @@ struct ticket {
     handle key;
     ticket *prev{};
     PyGILState_STATE state{};
+    uint64_t gil_start{};
 
     template <size_t Size>
     NB_INLINE ticket(const trampoline<Size> &t, const char *name, bool pure) {
@@ -0,0 +1,261 @@
+/*
+    nanobind/vectorize.h: nb::vectorize() to apply scalar functions
+    elementwise over n-dimensional arrays
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <nanobind/ndarray.h>
+#include <vector>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// Parameter of a vectorized function: a CPU array or a single scalar
+template <typename T> struct vectorize_arg {
+    using Array = ndarray<const T, device::cpu>;
+
+    Array array;
+    T scalar { };
+};
+
+template <typename T> struct type_caster<vectorize_arg<T>> {
+    using Array = typename vectorize_arg<T>::Array;
+    using Scalar = make_caster<T>;
+
+    NB_TYPE_CASTER(vectorize_arg<T>, Scalar::Name + const_name(" | ") +
+                                         make_caster<Array>::Name)
+
+    bool from_python(handle src, uint8_t flags, cleanup_list *cleanup) noexcept {
+        /* Try an exact scalar match first (cheap), then an array, and only
+           then fall back to implicitly converting the scalar */
+        Scalar sc;
+        if (sc.from_python(src, flags & ~(uint8_t) cast_flags::convert, cleanup)) {
+            value.scalar = sc.value;
+            return true;
+        }
+
+        make_caster<Array> ac;
+        if (ac.from_python(src, flags, cleanup)) {
+            value.array = std::move(ac.value);
+            return true;
+        }
+
+        if ((flags & (uint8_t) cast_flags::convert) &&
+            sc.from_python(src, flags, cleanup)) {
+            value.scalar = sc.value;
+            return true;
+        }
+
+        return false;
+    }
+
+    static handle from_cpp(const vectorize_arg<T> &v, rv_policy policy,
+                           cleanup_list *cleanup) noexcept {
+        if (v.array.is_valid())
+            return make_caster<Array>::from_cpp(v.array, policy, cleanup);
+        return Scalar::from_cpp(v.scalar, policy, cleanup);
+    }
+};
+
+template <typename Arg>
+constexpr bool is_vectorized_v = std::is_arithmetic_v<std::decay_t<Arg>>;
+
+template <typename Arg>
+using vectorize_param_t =
+    std::conditional_t<is_vectorized_v<Arg>, vectorize_arg<std::decay_t<Arg>>, Arg>;
+
+/// Memory layout of one (possibly broadcast) operand
+struct vectorize_operand {
+    const uint8_t *data = nullptr;
+    size_t ndim = 0;
+    const int64_t *shape = nullptr;
+    const int64_t *strides = nullptr;
+    size_t itemsize = 0;
+};
+
+template <typename Arg>
+vectorize_operand vectorize_describe(const vectorize_param_t<Arg> &arg) {
+    vectorize_operand op;
+    if constexpr (is_vectorized_v<Arg>) {
+        op.itemsize = sizeof(std::decay_t<Arg>);
+        if (arg.array.is_valid()) {
+            op.data = (const uint8_t *) arg.array.data();
+            op.ndim = arg.array.ndim();
+            op.shape = arg.array.shape_ptr();
+            op.strides = arg.array.stride_ptr();
+        } else {
+            op.data = (const uint8_t *) &arg.scalar;
+        }
+    }
+    return op;
+}
+
+template <typename Arg>
+NB_INLINE decltype(auto) vectorize_fetch(vectorize_param_t<Arg> &arg,
+                                         const uint8_t *ptr) {
+    if constexpr (is_vectorized_v<Arg>)
+        return *(const std::decay_t<Arg> *) ptr;
+    else
+        return (forward_t<Arg>) arg;
+}
+
+/**
+ * Broadcast the operands against each other following the NumPy rules.
+ * Returns the output shape and writes 'n * shape.size()' byte strides (0 along
+ * broadcast dimensions) to 'strides'. 0-dimensional outputs are represented
+ * by a single dimension of size 1 so that the loop always has an inner axis.
+ */
+inline std::vector<size_t> vectorize_broadcast(const vectorize_operand *op,
+                                               size_t n,
+                                               std::vector<int64_t> &strides) {
+    size_t ndim = 1;
+    for (size_t k = 0; k < n; ++k)
+        ndim = op[k].ndim > ndim ? op[k].ndim : ndim;
+
+    std::vector<size_t> shape(ndim, 1);
+    for (size_t k = 0; k < n; ++k) {
+        for (size_t i = 0; i < op[k].ndim; ++i) {
+            size_t value = (size_t) op[k].shape[i],
+                   &target = shape[ndim - op[k].ndim + i];
+            if (value == target || value == 1)
+                continue;
+            else if (target == 1)
+                target = value;
+            else
+                throw value_error(
+                    "nanobind::vectorize(): operands could not be broadcast "
+                    "together!");
+        }
+    }
+
+    strides.assign(n * ndim, 0);
+    for (size_t k = 0; k < n; ++k) {
+        size_t offset = ndim - op[k].ndim;
+        for (size_t i = 0; i < op[k].ndim; ++i) {
+            if ((size_t) op[k].shape[i] != 1)
+                strides[k * ndim + offset + i] =
+                    op[k].strides[i] * (int64_t) op[k].itemsize;
+        }
+    }
+
+    return shape;
+}
+
+template <typename... Ts, typename Func, typename Return, typename... Args,
+          size_t... Is>
+auto vectorize_impl(Func &&f, Return (*)(Args...), size_t threads,
+                    std::index_sequence<Is...>) {
+    static_assert(std::is_arithmetic_v<Return>,
+                  "nb::vectorize(): the function must return an arithmetic type!");
+    static_assert((is_vectorized_v<Args> || ...),
+                  "nb::vectorize(): the function must take at least one "
+                  "arithmetic parameter!");
+
+    using Result = ndarray<Ts..., Return>;
+
+    return [f = (std::decay_t<Func>) f, threads](vectorize_param_t<Args>... args) -> Result {
+        constexpr size_t N = sizeof...(Args);
+
+        vectorize_operand op[N] { vectorize_describe<Args>(args)... };
+        std::vector<int64_t> strides;
+        std::vector<size_t> shape = vectorize_broadcast(op, N, strides);
+
+        size_t ndim = shape.size(), size = 1;
+        for (size_t i = 0; i < ndim; ++i)
+            size *= shape[i];
+
+        bool is_scalar = true;
+        for (size_t k = 0; k < N; ++k)
+            is_scalar &= op[k].ndim == 0;
+
+        Return *out = new Return[size ? size : 1];
+        capsule owner(out, [](void *p) noexcept { delete[] (Return *) p; });
+
+        // Evaluate output entries [start, end) in C order
+        auto run = [&](size_t start, size_t end) {
+            std::vector<size_t> index(ndim, 0);
+            for (size_t i = ndim, pos = start; i-- > 0; ) {
+                index[i] = pos % shape[i];
+                pos /= shape[i];
+            }
+
+            const size_t inner = shape[ndim - 1];
+            const int64_t step[N] { strides[Is * ndim + ndim - 1]... };
+
+            for (size_t pos = start; pos < end; ) {
+                const uint8_t *ptr[N] { op[Is].data... };
+                for (size_t k = 0; k < N; ++k) {
+                    if (!ptr[k])
+                        continue;
+                    for (size_t i = 0; i < ndim; ++i)
+                        ptr[k] += (int64_t) index[i] * strides[k * ndim + i];
+                }
+
+                size_t count = inner - index[ndim - 1];
+                if (count > end - pos)
+                    count = end - pos;
+
+                for (size_t j = 0; j < count; ++j)
+                    out[pos + j] = (Return) f(vectorize_fetch<Args>(
+                        args, ptr[Is] + (int64_t) j * step[Is])...);
+
+                pos += count;
+                index[ndim - 1] += count;
+                for (size_t i = ndim - 1; i > 0 && index[i] == shape[i]; --i) {
+                    index[i] = 0;
+                    index[i - 1]++;
+                }
+            }
+        };
+
+        {
+            gil_scoped_release release;
+
+            // Don't bother with workers unless each one has some real work
+            size_t workers = threads;
+            if (workers > size / 1024)
+                workers = size / 1024;
+
+            parallel_run(size, workers, run);
+        }
+
+        size_t out_shape_0 = 1;
+        const size_t *out_shape = is_scalar ? &out_shape_0 : shape.data();
+        return Result(out, is_scalar ? 0 : ndim, out_shape, owner);
+    };
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * Turn a function taking arithmetic arguments into one that also accepts
+ * broadcastable CPU arrays in their place and evaluates the original function
+ * elementwise with the GIL released. The optional template arguments are
+ * annotations of the returned ndarray (e.g. ``nb::numpy``). When ``threads``
+ * exceeds 1, large outputs are split into chunks that are evaluated in
+ * parallel, which requires the function to be thread-safe.
+ */
+template <typename... Ts, typename Return, typename... Args>
+auto vectorize(Return (*f)(Args...), size_t threads = 1) {
+    return detail::vectorize_impl<Ts...>(
+        f, (Return(*)(Args...)) nullptr, threads,
+        std::make_index_sequence<sizeof...(Args)>());
+}
+
+template <
+    typename... Ts, typename Func,
+    detail::enable_if_t<detail::is_lambda_v<std::remove_reference_t<Func>>> = 0>
+auto vectorize(Func &&f, size_t threads = 1) {
+    using am = detail::analyze_method<decltype(&std::remove_reference_t<Func>::operator())>;
+    return detail::vectorize_impl<Ts...>(
+        (detail::forward_t<Func>) f, (typename am::func *) nullptr, threads,
+        std::make_index_sequence<am::argc>());
+}
+
+NAMESPACE_END(NB_NAMESPACE)
@@ -115,23 +115,72 @@ void raise_cast_error() {
 
 // ========================================================================
 
+/* Per-thread arena backing scratch_alloc(). The storage is allocated on
+   first use and released when the thread exits. */
+static thread_local struct scratch_arena {
+    static constexpr size_t Size = 16384, Align = 16;
+
+    char *base = nullptr;
+    size_t top = 0, live = 0;
+
+    ~scratch_arena() {
+        if (live == 0) {
+            free(base);
+            base = nullptr;
+        }
+    }
+} scratch;
+
+void *scratch_alloc(size_t size) noexcept {
+    scratch_arena &a = scratch;
+    size_t align = scratch_arena::Align;
+    size = size ? (size + align - 1) & ~(align - 1) : align;
+
+    if (NB_UNLIKELY(!a.base)) {
+        a.base = (char *) malloc(scratch_arena::Size);
+        if (!a.base)
+            return malloc(size);
+    }
+
+    if (NB_UNLIKELY(size > scratch_arena::Size - a.top))
+        return malloc(size);
+
+    void *ptr = a.base + a.top;
+    a.top += size;
+    a.live++;
+    return ptr;
+}
+
+void scratch_free(void *ptr) noexcept {
+    scratch_arena &a = scratch;
+
+    if (ptr >= (void *) a.base && ptr < (void *) (a.base + scratch_arena::Size)) {
+        // Rewind once the outermost call has returned all of its blocks
+        if (--a.live == 0)
+            a.top = 0;
+    } else {
+        free(ptr);
+    }
+}
+
 void cleanup_list::release() noexcept {
     /* Don't decrease the reference count of the first
        element, it stores the 'self' element. */
     for (size_t i = 1; i < m_size; ++i)
         Py_DECREF(m_data[i]);
     if (m_capacity != Small)
-        free(m_data);
+        scratch_free(m_data);
     m_data = nullptr;
 }
 
 void cleanup_list::expand() noexcept {
     uint32_t new_capacity = m_capacity * 2;
-    PyObject **new_data = (PyObject **) malloc(new_capacity * sizeof(PyObject *));
+    PyObject **new_data =
+        (PyObject **) scratch_alloc(new_capacity * sizeof(PyObject *));
     check(new_data, "nanobind::detail::cleanup_list::expand(): out of memory!");
     memcpy(new_data, m_data, m_size * sizeof(PyObject *));
     if (m_capacity != Small)
-        free(m_data);
+        scratch_free(m_data);
     m_data = new_data;
     m_capacity = new_capacity;
 }
@@ -144,9 +193,33 @@ PyObject *module_new(const char *name, PyModuleDef *def) noexcept {
     def->m_size = -1;
     PyObject *m = PyModule_Create(def);
     check(m, "nanobind::detail::module_new(): allocation failed!");
+#if defined(NB_FREE_THREADED)
+    PyUnstable_Module_SetGIL(m, Py_MOD_GIL_NOT_USED);
+#endif
     return m;
 }
 
+#if defined(NB_SUBINTERPRETERS)
+PyObject *module_def_init(const char *name, PyModuleDef *def,
+                          PyModuleDef_Slot *slots,
+                          int (*exec)(PyObject *)) noexcept {
+    size_t i = 0;
+    slots[i++] = { Py_mod_exec, (void *) exec };
+    slots[i++] = { Py_mod_multiple_interpreters,
+                   Py_MOD_PER_INTERPRETER_GIL_SUPPORTED };
+#if defined(NB_FREE_THREADED)
+    slots[i++] = { Py_mod_gil, Py_MOD_GIL_NOT_USED };
+#endif
+    slots[i] = { 0, nullptr };
+
+    memset(def, 0, sizeof(PyModuleDef));
+    def->m_name = name;
+    def->m_size = 0;
+    def->m_slots = slots;
+    return PyModuleDef_Init(def);
+}
+#endif
+
 PyObject *module_import(const char *name) {
     PyObject *res = PyImport_ImportModule(name);
     if (!res)
@@ -325,6 +398,78 @@ end:
     return res;
 }
 
+/* Cache record: the kwnames tuple followed by a copy of the names (a call
+   site may pass names that don't outlive the call, so a pointer comparison
+   would not be safe) */
+struct kwnames_cache_rec {
+    PyObject *tuple;
+    char names[1];
+};
+
+static PyObject *kwnames_new(const char *const *names, size_t n) {
+    PyObject *result = PyTuple_New((Py_ssize_t) n);
+    if (!result)
+        raise_python_error();
+
+    for (size_t i = 0; i < n; ++i) {
+        PyObject *name = PyUnicode_InternFromString(names[i]);
+        if (!name) {
+            Py_DECREF(result);
+            raise_python_error();
+        }
+        NB_TUPLE_SET_ITEM(result, i, name);
+    }
+
+    return result;
+}
+
+void *kwnames_cache_new(const char *const *names, size_t n) {
+    size_t size = sizeof(kwnames_cache_rec);
+    for (size_t i = 0; i < n; ++i)
+        size += strlen(names[i]) + 1;
+
+    kwnames_cache_rec *rec = (kwnames_cache_rec *) malloc(size);
+    if (!rec)
+        fail("nanobind::detail::kwnames_cache_new(): out of memory!");
+
+    try {
+        rec->tuple = kwnames_new(names, n);
+    } catch (...) {
+        free(rec);
+        throw;
+    }
+
+    char *p = rec->names;
+    for (size_t i = 0; i < n; ++i) {
+        size_t len = strlen(names[i]) + 1;
+        memcpy(p, names[i], len);
+        p += len;
+    }
+
+    // Intentionally leaked: the record lives as long as the call site
+    return rec;
+}
+
+PyObject *kwnames_cache_get(void *cache, const char *const *names, size_t n) {
+    kwnames_cache_rec *rec = (kwnames_cache_rec *) cache;
+
+    if (rec) {
+        const char *p = rec->names;
+        size_t i = 0;
+        for (; i < n; ++i) {
+            if (strcmp(p, names[i]) != 0)
+                break;
+            p += strlen(p) + 1;
+        }
+
+        if (i == n) {
+            Py_INCREF(rec->tuple);
+            return rec->tuple;
+        }
+    }
+
+    return kwnames_new(names, n);
+}
 
 PyObject *obj_iter(PyObject *o) {
     PyObject *result = PyObject_GetIter(o);
@@ -464,6 +609,45 @@ void getitem_or_raise(PyObject *obj, PyObject *key, PyObject **out) {
     *out = res;
 }
 
+PyObject *getitem(PyObject *obj, PyObject *key, PyObject *def) {
+    PyObject *res;
+
+    if (PyDict_CheckExact(obj)) {
+        // Dictionary lookups can report a missing key without an exception
+#if defined(NB_FREE_THREADED)
+        if (PyDict_GetItemRef(obj, key, &res) < 0)
+            raise_python_error();
+#else
+        res = PyDict_GetItemWithError(obj, key);
+        if (res)
+            Py_INCREF(res);
+        else if (PyErr_Occurred())
+            raise_python_error();
+#endif
+    } else {
+        res = PyObject_GetItem(obj, key);
+        if (!res) {
+            if (!PyErr_ExceptionMatches(PyExc_LookupError))
+                raise_python_error();
+            PyErr_Clear();
+        }
+    }
+
+    if (!res) {
+        Py_XINCREF(def);
+        res = def;
+    }
+
+    return res;
+}
+
+PyObject *getitem(PyObject *obj, const char *key_, PyObject *def) {
+    object key = steal(PyUnicode_FromString(key_));
+    if (!key.is_valid())
+        raise_python_error();
+    return getitem(obj, key.ptr(), def);
+}
+
 void setitem(PyObject *obj, Py_ssize_t key, PyObject *value) {
     int rv = PySequence_SetItem(obj, key, value);
     if (rv)
@@ -564,6 +748,26 @@ PyObject *bytes_from_cstr_and_size(const char *str, size_t size) {
     return result;
 }
 
+bool bytes_view_get(PyObject *o, cleanup_list *cleanup, const char **ptr,
+                    size_t *size) noexcept {
+    // Byte strings are immutable and outlive the call, reference them directly
+    if (PyBytes_Check(o)) {
+        char *data;
+        Py_ssize_t len;
+        if (PyBytes_AsStringAndSize(o, &data, &len)) {
+            PyErr_Clear();
+            return false;
+        }
+        *ptr = data;
+        *size = (size_t) len;
+        return true;
+    }
+
+    // Other contiguous buffers (bytearray, memoryview, ...) are locked
+    return !PyUnicode_Check(o) &&
+           pickle_buffer_get(o, cleanup, (const void **) ptr, size);
+}
+
 // ========================================================================
 
 PyObject *bool_from_obj(PyObject *o) {
@@ -603,8 +807,85 @@ PyObject *list_from_obj(PyObject *o) {
     return result;
 }
 
+PyObject *dict_new_presized(size_t size) noexcept {
+#if defined(Py_LIMITED_API) || defined(PYPY_VERSION)
+    (void) size;
+    return PyDict_New();
+#else
+    return _PyDict_NewPresized((Py_ssize_t) size);
+#endif
+}
+
 // ========================================================================
 
+#if defined(Py_LIMITED_API)
+seq_layout_t seq_layout { 0, 0 };
+
+/// Verify the tuple and list layout of the running interpreter (see nb_lib.h)
+void seq_layout_init() noexcept {
+    if (seq_layout.tuple_items || seq_layout.list_items)
+        return;
+
+    // Tuples store their items inline, following the fixed-size part
+    Py_ssize_t tuple_items = 0, list_items = 0;
+    PyObject *size = PyObject_GetAttrString((PyObject *) &PyTuple_Type,
+                                            "__basicsize__");
+    if (size) {
+        tuple_items = PyLong_AsSsize_t(size);
+        Py_DECREF(size);
+    }
+
+    // Lists reference an array stored right after the PyVarObject header
+    size = PyObject_GetAttrString((PyObject *) &PyList_Type, "__basicsize__");
+    if (size) {
+        if (PyLong_AsSsize_t(size) ==
+            (Py_ssize_t) (sizeof(PyVarObject) + 2 * sizeof(void *)))
+            list_items = (Py_ssize_t) sizeof(PyVarObject);
+        Py_DECREF(size);
+    }
+    PyErr_Clear();
+
+    PyObject *t = PyTuple_Pack(2, Py_None, Py_True),
+             *l = PyList_New(2);
+
+    if (t && tuple_items >= (Py_ssize_t) sizeof(PyVarObject)) {
+        PyObject **items = (PyObject **) ((char *) t + tuple_items);
+        if (Py_SIZE(t) == 2 && items[0] == Py_None && items[1] == Py_True)
+            seq_layout.tuple_items = tuple_items;
+    }
+
+    if (l && list_items) {
+        Py_INCREF(Py_None);
+        Py_INCREF(Py_True);
+        PyList_SetItem(l, 0, Py_None);
+        PyList_SetItem(l, 1, Py_True);
+        PyObject **items = *(PyObject ***) ((char *) l + list_items);
+        if (Py_SIZE(l) == 2 && items[0] == Py_None && items[1] == Py_True)
+            seq_layout.list_items = list_items;
+    }
+
+    Py_XDECREF(t);
+    Py_XDECREF(l);
+    PyErr_Clear();
+}
+#endif
+
+#if defined(Py_LIMITED_API)
+/// Item array of an exact tuple or list (nullptr if unavailable, see seq_get())
+static PyObject **seq_items_limited(PyObject *seq, size_t *size) noexcept {
+    PyObject **items;
+    if (seq_layout.tuple_items && PyTuple_CheckExact(seq))
+        items = tuple_items(seq);
+    else if (seq_layout.list_items && PyList_CheckExact(seq))
+        items = list_items(seq);
+    else
+        return nullptr;
+
+    *size = (size_t) Py_SIZE(seq);
+    return *size ? items : (PyObject **) 1;
+}
+#endif
+
 PyObject **seq_get(PyObject *seq, size_t *size_out, PyObject **temp_out) noexcept {
     PyObject *temp = nullptr;
     size_t size = 0;
@@ -644,8 +925,17 @@ PyObject **seq_get(PyObject *seq, size_t *size_out, PyObject **temp_out) noexcep
             PyErr_Clear();
     }
 #else
-    /* There isn't a nice way to get a PyObject** in Py_LIMITED_API. This
-       is going to be slow, but hopefully also very future-proof.. */
+#  if defined(Py_LIMITED_API)
+    if ((result = seq_items_limited(seq, &size)) != nullptr) {
+        *temp_out = nullptr;
+        *size_out = size;
+        return result;
+    }
+#  endif
+
+    /* There isn't a nice way to get a PyObject** from other sequences in
+       Py_LIMITED_API. This is going to be slow, but hopefully also very
+       future-proof.. */
     if (PySequence_Check(seq)) {
         Py_ssize_t size_seq = PySequence_Length(seq);
 
@@ -739,6 +1029,14 @@ PyObject **seq_get_with_size(PyObject *seq, size_t size,
             PyErr_Clear();
     }
 #else
+#  if defined(Py_LIMITED_API)
+    size_t size_seq_fast;
+    if ((result = seq_items_limited(seq, &size_seq_fast)) != nullptr) {
+        *temp_out = nullptr;
+        return size == size_seq_fast ? result : nullptr;
+    }
+#  endif
+
     /* There isn't a nice way to get a PyObject** in Py_LIMITED_API. This
        is going to be slow, but hopefully also very future-proof.. */
     if (PySequence_Check(seq)) {
@@ -794,11 +1092,225 @@ PyObject **seq_get_with_size(PyObject *seq, size_t size,
     return result;
 }
 
+/// Convert 'size' strided values of type 'Src' into 'Dst' (fails if inexact)
+template <typename Dst, typename Src>
+static bool seq_cast_buffer(const uint8_t *src, Py_ssize_t stride,
+                            size_t size, void *dst_) noexcept {
+    Dst *dst = (Dst *) dst_;
+    for (size_t i = 0; i < size; ++i) {
+        Src v;
+        memcpy(&v, src + (Py_ssize_t) i * stride, sizeof(Src));
+        Dst d = (Dst) v;
+        if constexpr (std::is_integral_v<Dst> && !std::is_same_v<Dst, bool>) {
+            bool d_neg = false, v_neg = false;
+            if constexpr (std::is_signed_v<Dst>)
+                d_neg = d < 0;
+            if constexpr (std::is_signed_v<Src>)
+                v_neg = v < 0;
+            if ((Src) d != v || d_neg != v_neg)
+                return false;
+        }
+        dst[i] = d;
+    }
+    return true;
+}
+
+template <typename Dst>
+static bool seq_cast_buffer(char kind, size_t itemsize, const uint8_t *src,
+                            Py_ssize_t stride, size_t size, void *dst) noexcept {
+    switch (kind) {
+        case 'b':
+            return seq_cast_buffer<Dst, uint8_t>(src, stride, size, dst);
+
+        case 'i':
+            switch (itemsize) {
+                case 1: return seq_cast_buffer<Dst, int8_t>(src, stride, size, dst);
+                case 2: return seq_cast_buffer<Dst, int16_t>(src, stride, size, dst);
+                case 4: return seq_cast_buffer<Dst, int32_t>(src, stride, size, dst);
+                case 8: return seq_cast_buffer<Dst, int64_t>(src, stride, size, dst);
+            }
+            break;
+
+        case 'u':
+            switch (itemsize) {
+                case 1: return seq_cast_buffer<Dst, uint8_t>(src, stride, size, dst);
+                case 2: return seq_cast_buffer<Dst, uint16_t>(src, stride, size, dst);
+                case 4: return seq_cast_buffer<Dst, uint32_t>(src, stride, size, dst);
+                case 8: return seq_cast_buffer<Dst, uint64_t>(src, stride, size, dst);
+            }
+            break;
+
+        case 'f':
+            switch (itemsize) {
+                case 4: return seq_cast_buffer<Dst, float>(src, stride, size, dst);
+                case 8: return seq_cast_buffer<Dst, double>(src, stride, size, dst);
+            }
+            break;
+    }
+
+    return false;
+}
+
+/// Return the kind ('b', 'i', 'u', 'f') of a native buffer format, if supported
+static char seq_buffer_kind(const char *format) noexcept {
+    if (!format)
+        return 'u'; // unsigned bytes
+
+    int32_t num = 1;
+    bool little_endian = *(uint8_t *) &num == 1;
+    switch (*format) {
+        case '@': case '=': ++format; break;
+        case '<': if (!little_endian) return 0; ++format; break;
+        case '>': case '!': if (little_endian) return 0; ++format; break;
+    }
+
+    if (!format[0] || format[1])
+        return 0;
+
+    switch (format[0]) {
+        case 'b': case 'h': case 'i': case 'l': case 'q': case 'n': return 'i';
+        case 'B': case 'H': case 'I': case 'L': case 'Q': case 'N': return 'u';
+        case 'f': case 'd': return 'f';
+        case '?': return 'b';
+        default: return 0;
+    }
+}
+
+PyObject *seq_iter(PyObject *seq, size_t *size_hint) noexcept {
+    *size_hint = 0;
+
+    if (PyUnicode_CheckExact(seq) || PyBytes_CheckExact(seq) ||
+        !PySequence_Check(seq))
+        return nullptr;
+
+    PyObject *iter = PyObject_GetIter(seq);
+    if (!iter) {
+        PyErr_Clear();
+        return nullptr;
+    }
+
+    *size_hint = obj_len_hint(seq);
+    return iter;
+}
+
+size_t iter_next_chunk(PyObject *iter, PyObject **out, size_t n) noexcept {
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+    iternextfunc next = Py_TYPE(iter)->tp_iternext;
+#endif
+
+    for (size_t i = 0; i < n; ++i) {
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+        PyObject *o = next(iter);
+#else
+        PyObject *o = PyIter_Next(iter);
+#endif
+
+        if (!o) {
+            if (PyErr_Occurred()) {
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+                if (PyErr_ExceptionMatches(PyExc_StopIteration)) {
+                    PyErr_Clear();
+                    return i;
+                }
+#endif
+                PyErr_Clear();
+                for (size_t j = 0; j < i; ++j)
+                    Py_DECREF(out[j]);
+                return (size_t) -1;
+            }
+            return i;
+        }
+
+        out[i] = o;
+    }
+
+    return n;
+}
+
+bool seq_get_buffer(PyObject *seq, char kind, size_t itemsize, bool convert,
+                    void *(*alloc)(void *, size_t) noexcept,
+                    void *payload) noexcept {
+    // Strings and bytes are not considered to be sequences of numbers
+    if (PyUnicode_CheckExact(seq) || PyBytes_CheckExact(seq) ||
+        PyList_CheckExact(seq) || PyTuple_CheckExact(seq) ||
+        !PyObject_CheckBuffer(seq))
+        return false;
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(seq, &view, PyBUF_RECORDS_RO)) {
+        PyErr_Clear();
+        return false;
+    }
+
+    char src_kind = view.ndim == 1 ? seq_buffer_kind(view.format) : 0;
+    bool compatible;
+    switch (kind) {
+        case 'b': compatible = src_kind == 'b'; break;
+        case 'i':
+        case 'u': compatible = src_kind == 'i' || src_kind == 'u'; break;
+        case 'f': compatible = src_kind == 'f' || (convert && src_kind != 0 &&
+                                                    src_kind != 'b'); break;
+        default: compatible = false; break;
+    }
+
+    bool success = false;
+    if (compatible) {
+        size_t size = (size_t) view.shape[0],
+               src_itemsize = (size_t) view.itemsize;
+        Py_ssize_t stride = view.strides[0];
+        void *dst = alloc(payload, size);
+
+        if (dst && size == 0) {
+            success = true;
+        } else if (dst && src_kind == kind && src_itemsize == itemsize &&
+                   stride == (Py_ssize_t) itemsize) {
+            memcpy(dst, view.buf, size * itemsize);
+            success = true;
+        } else if (dst) {
+            const uint8_t *src = (const uint8_t *) view.buf;
+            switch (kind) {
+                case 'b':
+                    success = seq_cast_buffer<bool>(src_kind, src_itemsize,
+                                                    src, stride, size, dst);
+                    break;
+
+                case 'i':
+                    switch (itemsize) {
+                        case 1: success = seq_cast_buffer<int8_t>(src_kind, src_itemsize, src, stride, size, dst); break;
+                        case 2: success = seq_cast_buffer<int16_t>(src_kind, src_itemsize, src, stride, size, dst); break;
+                        case 4: success = seq_cast_buffer<int32_t>(src_kind, src_itemsize, src, stride, size, dst); break;
+                        case 8: success = seq_cast_buffer<int64_t>(src_kind, src_itemsize, src, stride, size, dst); break;
+                    }
+                    break;
+
+                case 'u':
+                    switch (itemsize) {
+                        case 1: success = seq_cast_buffer<uint8_t>(src_kind, src_itemsize, src, stride, size, dst); break;
+                        case 2: success = seq_cast_buffer<uint16_t>(src_kind, src_itemsize, src, stride, size, dst); break;
+                        case 4: success = seq_cast_buffer<uint32_t>(src_kind, src_itemsize, src, stride, size, dst); break;
+                        case 8: success = seq_cast_buffer<uint64_t>(src_kind, src_itemsize, src, stride, size, dst); break;
+                    }
+                    break;
+
+                case 'f':
+                    switch (itemsize) {
+                        case 4: success = seq_cast_buffer<float>(src_kind, src_itemsize, src, stride, size, dst); break;
+                        case 8: success = seq_cast_buffer<double>(src_kind, src_itemsize, src, stride, size, dst); break;
+                    }
+                    break;
+            }
+        }
+    }
+
+    PyBuffer_Release(&view);
+    return success;
+}
+
 // ========================================================================
 
-static void property_install_impl(PyTypeObject *tp, PyObject *scope,
-                                  const char *name, PyObject *getter,
-                                  PyObject *setter) {
+static object property_install_impl(PyTypeObject *tp, PyObject *scope,
+                                    const char *name, PyObject *getter,
+                                    PyObject *setter) {
     PyObject *m = getter ? getter : setter;
     object doc = none();
 
@@ -809,12 +1321,15 @@ static void property_install_impl(PyTypeObject *tp, PyObject *scope,
             doc = str(f->doc);
     }
 
-    handle(scope).attr(name) = handle(tp)(
+    object prop = handle(tp)(
         getter ? handle(getter) : handle(Py_None),
         setter ? handle(setter) : handle(Py_None),
         handle(Py_None), // deleter
         doc
     );
+
+    handle(scope).attr(name) = prop;
+    return prop;
 }
 
 void property_install(PyObject *scope, const char *name, PyObject *getter,
@@ -828,6 +1343,13 @@ void property_install_static(PyObject *scope, const char *name,
                           setter);
 }
 
+void property_install_static_const(PyObject *scope, const char *name,
+                                   PyObject *getter, PyObject *value) noexcept {
+    object prop = property_install_impl(nb_static_property_tp(), scope, name,
+                                        getter, nullptr);
+    nb_static_property_set_const(prop.ptr(), value);
+}
+
 // ========================================================================
 
 void tuple_check(PyObject *tuple, size_t nargs) {
@@ -858,6 +1380,40 @@ void print(PyObject *value, PyObject *end, PyObject *file) {
 
 // ========================================================================
 
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+/* NumPy scalars (e.g. 'numpy.float32' or 'numpy.int64') aren't instances of
+   the builtin 'int' and 'float' types, but they expose their value via a
+   0-dimensional buffer. Read it directly so that the first (noconvert) pass
+   of overload resolution accepts scalars of a matching kind. */
+template <typename T>
+static bool load_numpy_scalar(PyObject *o, uint8_t flags, T *out) noexcept {
+    PyTypeObject *tp = Py_TYPE(o);
+    if (!tp->tp_as_buffer || (tp->tp_flags & Py_TPFLAGS_HEAPTYPE) ||
+        strncmp(tp->tp_name, "numpy.", 6) != 0 ||
+        strcmp(tp->tp_name + 6, "ndarray") == 0)
+        return false;
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(o, &view, PyBUF_FORMAT)) {
+        PyErr_Clear();
+        return false;
+    }
+
+    char kind = view.ndim == 0 ? seq_buffer_kind(view.format) : 0;
+    bool compatible = kind == 'i' || kind == 'u';
+    if constexpr (std::is_floating_point_v<T>)
+        compatible = kind == 'f' ||
+                     (compatible && (flags & (uint8_t) cast_flags::convert));
+
+    bool success = compatible &&
+                   seq_cast_buffer<T>(kind, (size_t) view.itemsize,
+                                      (const uint8_t *) view.buf, 0, 1, out);
+
+    PyBuffer_Release(&view);
+    return success;
+}
+#endif
+
 bool load_f64(PyObject *o, uint8_t flags, double *out) noexcept {
     bool is_float = PyFloat_CheckExact(o);
 
@@ -870,6 +1426,11 @@ bool load_f64(PyObject *o, uint8_t flags, double *out) noexcept {
     is_float = false;
 #endif
 
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+    if (load_numpy_scalar(o, flags, out))
+        return true;
+#endif
+
     if (is_float || (flags & (uint8_t) cast_flags::convert)) {
         double result = PyFloat_AsDouble(o);
 
@@ -896,6 +1457,11 @@ bool load_f32(PyObject *o, uint8_t flags, float *out) noexcept {
     is_float = false;
 #endif
 
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+    if (load_numpy_scalar(o, flags, out))
+        return true;
+#endif
+
     if (is_float || (flags & (uint8_t) cast_flags::convert)) {
         double result = PyFloat_AsDouble(o);
 
@@ -972,6 +1538,11 @@ NB_INLINE bool load_int(PyObject *o, uint32_t flags, T *out) noexcept {
     }
 
     if constexpr (Recurse) {
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+        if (load_numpy_scalar(o, (uint8_t) flags, out))
+            return true;
+#endif
+
         if ((flags & (uint8_t) cast_flags::convert) && !PyFloat_Check(o)) {
             PyObject* temp = PyNumber_Long(o);
             if (temp) {
@@ -1043,6 +1614,117 @@ void decref_checked(PyObject *o) noexcept {
     Py_DECREF(o);
 }
 
+/* Pending calls always run in the main interpreter, hence subinterpreter
+   builds don't defer operations. */
+#if !defined(NB_SUBINTERPRETERS)
+static int deferred_pending(void *) {
+    deferred_drain();
+    return 0;
+}
+#endif
+
+bool deferred_schedule(void (*func)(void *) noexcept, void *payload) noexcept {
+#if !defined(NB_SUBINTERPRETERS)
+    nb_deferred *d = (nb_deferred *) malloc(sizeof(nb_deferred));
+    if (!d)
+        return false;
+
+    d->func = func;
+    d->payload = payload;
+
+    std::atomic<nb_deferred *> &head = internals->deferred;
+    nb_deferred *next = head.load(std::memory_order_relaxed);
+    do {
+        d->next = next;
+    } while (!head.compare_exchange_weak(next, d, std::memory_order_release,
+                                         std::memory_order_relaxed));
+
+    /* The first entry asks the interpreter to drain the queue. If that fails,
+       the next dispatcher call will take care of it. */
+    if (!next)
+        Py_AddPendingCall(deferred_pending, nullptr);
+
+    return true;
+#else
+    (void) func; (void) payload;
+    return false;
+#endif
+}
+
+// PyGILState_Check() is unavailable in the stable ABI
+bool defer_call(void (*func)(void *) noexcept, void *payload) noexcept {
+#if !defined(Py_LIMITED_API)
+    if (PyGILState_Check())
+        return false;
+    return deferred_schedule(func, payload);
+#else
+    (void) func; (void) payload;
+    return false;
+#endif
+}
+
+void deferred_drain() noexcept {
+    nb_deferred *d =
+        internals->deferred.exchange(nullptr, std::memory_order_acquire);
+
+    while (d) {
+        nb_deferred *next = d->next;
+        d->func(d->payload);
+        free(d);
+        d = next;
+    }
+}
+
+static void decref_func(void *o) noexcept { Py_DECREF((PyObject *) o); }
+
+void decref_deferred(PyObject *o) noexcept {
+    if (!o || defer_call(decref_func, o))
+        return;
+
+    PyGILState_STATE state = PyGILState_Ensure();
+    Py_DECREF(o);
+    PyGILState_Release(state);
+}
+
+#if !defined(Py_LIMITED_API)
+/// A batch of references released by a single deferred call
+struct nb_decref_batch {
+    size_t size;
+    PyObject *items[1];
+};
+
+static void decref_batch_func(void *p) noexcept {
+    nb_decref_batch *b = (nb_decref_batch *) p;
+    for (size_t i = 0; i < b->size; ++i)
+        Py_XDECREF(b->items[i]);
+    free(b);
+}
+#endif
+
+void decref_deferred(PyObject *const *o, size_t size) noexcept {
+    if (size == 0)
+        return;
+
+#if !defined(Py_LIMITED_API)
+    if (!PyGILState_Check()) {
+        nb_decref_batch *b = (nb_decref_batch *) malloc(
+            sizeof(nb_decref_batch) + sizeof(PyObject *) * (size - 1));
+        if (b) {
+            b->size = size;
+            memcpy(b->items, o, sizeof(PyObject *) * size);
+            if (deferred_schedule(decref_batch_func, b))
+                return;
+            free(b);
+        }
+    }
+#endif
+
+    PyGILState_STATE state = PyGILState_Ensure();
+    for (size_t i = 0; i < size; ++i)
+        Py_XDECREF(o[i]);
+    PyGILState_Release(state);
+}
+
 // ========================================================================
 
 void set_leak_warnings(bool value) noexcept {
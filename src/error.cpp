@@ -214,12 +214,33 @@ builtin_exception::~builtin_exception() { }
 
 NAMESPACE_BEGIN(detail)
 
-void register_exception_translator(exception_translator t, void *payload) {
+static void register_exception_translator_impl(const std::type_info *type,
+                                               exception_translator t,
+                                               void *payload) {
+    lock_internals guard(internals);
     nb_translator_seq *cur  = &internals->translators,
                       *next = new nb_translator_seq(*cur);
     cur->next = next;
     cur->payload = payload;
     cur->translator = t;
+
+    /* An untyped translator could handle any exception and must be tried
+       before all older ones. Typed entries are still reachable through the
+       chain of translators. */
+    if (type)
+        internals->translators_typed[type] = nb_translator{ t, payload };
+    else
+        internals->translators_typed.clear();
+}
+
+void register_exception_translator(exception_translator t, void *payload) {
+    register_exception_translator_impl(nullptr, t, payload);
+}
+
+void register_exception_translator_typed(const std::type_info *type,
+                                         exception_translator t,
+                                         void *payload) {
+    register_exception_translator_impl(type, t, payload);
 }
 
 NB_CORE PyObject *exception_new(PyObject *scope, const char *name,
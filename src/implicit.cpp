@@ -19,6 +19,8 @@ void implicitly_convertible(const std::type_info *src,
     check(t, "nanobind::detail::implicitly_convertible(src=%s, dst=%s): "
              "destination type unknown!", type_name(src), type_name(dst));
 
+    lock_internals guard(internals);
+
     size_t size = 0;
 
     if (t->flags & (uint32_t) type_flags::has_implicit_conversions) {
@@ -38,6 +40,7 @@ void implicitly_convertible(const std::type_info *src,
     data[size + 1] = nullptr;
     free(t->implicit);
     t->implicit = (decltype(t->implicit)) data;
+    t->implicit_miss = nullptr;
 }
 
 void implicitly_convertible(bool (*predicate)(PyTypeObject *, PyObject *,
@@ -47,6 +50,8 @@ void implicitly_convertible(bool (*predicate)(PyTypeObject *, PyObject *,
     check(t, "nanobind::detail::implicitly_convertible(src=<predicate>, dst=%s): "
              "destination type unknown!", type_name(dst));
 
+    lock_internals guard(internals);
+
     size_t size = 0;
 
     if (t->flags & (uint32_t) type_flags::has_implicit_conversions) {
@@ -0,0 +1,328 @@
+/*
+    src/nb_arrow.cpp: import and export of columnar data through the
+    Apache Arrow C data interface (PyCapsule protocol)
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include <nanobind/arrow.h>
+#include "nb_internals.h"
+#include <stdlib.h>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/* The capsules returned by '__arrow_c_array__()' and '__arrow_c_stream__()'
+   keep ownership of their contents until a consumer moves them out and sets
+   the 'release' callback of the original structure to nullptr. Imports
+   below move the data into capsules named "nb_arrow" and "nb_arrow_stream",
+   whose destructors call the producer's release callbacks. */
+
+static void arrow_data_destructor(PyObject *o) {
+    error_scope scope; // temporarily save any existing errors
+    arrow_data *d = (arrow_data *) PyCapsule_GetPointer(o, "nb_arrow");
+    if (!d) {
+        PyErr_Clear();
+        return;
+    }
+    if (d->array.release)
+        d->array.release(&d->array);
+    if (d->schema.release)
+        d->schema.release(&d->schema);
+    PyMem_Free(d);
+}
+
+static void arrow_stream_destructor(PyObject *o) {
+    error_scope scope; // temporarily save any existing errors
+    ArrowArrayStream *s =
+        (ArrowArrayStream *) PyCapsule_GetPointer(o, "nb_arrow_stream");
+    if (!s) {
+        PyErr_Clear();
+        return;
+    }
+    if (s->release)
+        s->release(s);
+    PyMem_Free(s);
+}
+
+/// Create an empty "nb_arrow" capsule (new reference, nullptr on failure)
+static PyObject *arrow_data_new(arrow_data **out) noexcept {
+    arrow_data *d = (arrow_data *) PyMem_Calloc(1, sizeof(arrow_data));
+    if (!d)
+        return nullptr;
+
+    PyObject *result = PyCapsule_New(d, "nb_arrow", arrow_data_destructor);
+    if (!result)
+        PyMem_Free(d);
+    else
+        *out = d;
+    return result;
+}
+
+/// Check whether 'o' is capsule named 'name' (without raising an exception)
+static bool arrow_capsule_check(PyObject *o, const char *name) noexcept {
+    if (!PyCapsule_CheckExact(o))
+        return false;
+    const char *o_name = PyCapsule_GetName(o);
+    return o_name && strcmp(o_name, name) == 0;
+}
+
+PyObject *arrow_import(PyObject *o) noexcept {
+    // Arrays that were previously imported and returned by a binding
+    if (arrow_capsule_check(o, "nb_arrow")) {
+        Py_INCREF(o);
+        return o;
+    }
+
+    PyObject *pair = PyObject_CallMethod(o, "__arrow_c_array__", nullptr);
+    if (!pair) {
+        PyErr_Clear();
+        return nullptr;
+    }
+
+    ArrowSchema *schema = nullptr;
+    ArrowArray *array = nullptr;
+
+    if (PyTuple_Check(pair) && PyTuple_Size(pair) == 2) {
+        PyObject *schema_o = PyTuple_GetItem(pair, 0),
+                 *array_o = PyTuple_GetItem(pair, 1);
+
+        if (arrow_capsule_check(schema_o, "arrow_schema") &&
+            arrow_capsule_check(array_o, "arrow_array")) {
+            schema = (ArrowSchema *) PyCapsule_GetPointer(schema_o, "arrow_schema");
+            array = (ArrowArray *) PyCapsule_GetPointer(array_o, "arrow_array");
+        }
+    }
+
+    PyObject *result = nullptr;
+    arrow_data *d = nullptr;
+
+    // Refuse structures that were already consumed
+    if (schema && array && schema->release && array->release)
+        result = arrow_data_new(&d);
+
+    if (result) {
+        memcpy(&d->schema, schema, sizeof(ArrowSchema));
+        memcpy(&d->array, array, sizeof(ArrowArray));
+        schema->release = nullptr;
+        array->release = nullptr;
+    } else {
+        PyErr_Clear();
+    }
+
+    Py_DECREF(pair);
+    return result;
+}
+
+PyObject *arrow_stream_import(PyObject *o) noexcept {
+    if (arrow_capsule_check(o, "nb_arrow_stream")) {
+        Py_INCREF(o);
+        return o;
+    }
+
+    PyObject *capsule = PyObject_CallMethod(o, "__arrow_c_stream__", nullptr);
+    if (!capsule) {
+        PyErr_Clear();
+        return nullptr;
+    }
+
+    ArrowArrayStream *stream = nullptr;
+    if (arrow_capsule_check(capsule, "arrow_array_stream"))
+        stream = (ArrowArrayStream *) PyCapsule_GetPointer(capsule,
+                                                           "arrow_array_stream");
+
+    PyObject *result = nullptr;
+    ArrowArrayStream *s = nullptr;
+
+    if (stream && stream->release) {
+        s = (ArrowArrayStream *) PyMem_Malloc(sizeof(ArrowArrayStream));
+        if (s) {
+            result = PyCapsule_New(s, "nb_arrow_stream", arrow_stream_destructor);
+            if (!result)
+                PyMem_Free(s);
+        }
+    }
+
+    if (result) {
+        memcpy(s, stream, sizeof(ArrowArrayStream));
+        stream->release = nullptr;
+    } else {
+        PyErr_Clear();
+    }
+
+    Py_DECREF(capsule);
+    return result;
+}
+
+PyObject *arrow_stream_next(PyObject *stream) {
+    ArrowArrayStream *s =
+        (ArrowArrayStream *) PyCapsule_GetPointer(stream, "nb_arrow_stream");
+    if (!s)
+        raise_python_error();
+    if (!s->release)
+        raise("nanobind::arrow_stream::next(): the stream was released!");
+
+    arrow_data *d = nullptr;
+    object result = steal(arrow_data_new(&d));
+    if (!result.is_valid())
+        raise_python_error();
+
+    int rv = s->get_next(s, &d->array);
+    if (rv == 0 && !d->array.release)
+        return none().release().ptr(); // end of stream
+
+    if (rv == 0)
+        rv = s->get_schema(s, &d->schema);
+
+    if (rv != 0) {
+        const char *msg = s->get_last_error ? s->get_last_error(s) : nullptr;
+        raise("nanobind::arrow_stream::next(): could not fetch the next array "
+              "(%s)!", msg ? msg : strerror(rv));
+    }
+
+    return result.release().ptr();
+}
+
+/// Private data of arrays created by arrow_export()
+struct arrow_export_state {
+    PyObject *owner;
+    const void *buffers[2];
+};
+
+static void arrow_export_release_schema(ArrowSchema *s) {
+    s->release = nullptr;
+}
+
+// May be invoked by the consumer on any thread
+static void arrow_export_release_array(ArrowArray *a) {
+    arrow_export_state *st = (arrow_export_state *) a->private_data;
+    PyGILState_STATE state = PyGILState_Ensure();
+    Py_DECREF(st->owner);
+    PyGILState_Release(state);
+    free(st);
+    a->release = nullptr;
+}
+
+static void arrow_export_free_schema(PyObject *o) {
+    error_scope scope; // temporarily save any existing errors
+    ArrowSchema *s = (ArrowSchema *) PyCapsule_GetPointer(o, "arrow_schema");
+    if (!s) {
+        PyErr_Clear();
+        return;
+    }
+    if (s->release)
+        s->release(s);
+    free(s);
+}
+
+static void arrow_export_free_array(PyObject *o) {
+    error_scope scope; // temporarily save any existing errors
+    ArrowArray *a = (ArrowArray *) PyCapsule_GetPointer(o, "arrow_array");
+    if (!a) {
+        PyErr_Clear();
+        return;
+    }
+    if (a->release)
+        a->release(a);
+    free(a);
+}
+
+/// Arrow format string of a primitive dtype, or nullptr if there is none
+static const char *arrow_format(const dlpack::dtype &dt) {
+    if (dt.lanes != 1)
+        return nullptr;
+
+    switch ((dlpack::dtype_code) dt.code) {
+        case dlpack::dtype_code::Int:
+            switch (dt.bits) {
+                case 8: return "c";
+                case 16: return "s";
+                case 32: return "i";
+                case 64: return "l";
+            }
+            break;
+
+        case dlpack::dtype_code::UInt:
+            switch (dt.bits) {
+                case 8: return "C";
+                case 16: return "S";
+                case 32: return "I";
+                case 64: return "L";
+            }
+            break;
+
+        case dlpack::dtype_code::Float:
+            switch (dt.bits) {
+                case 16: return "e";
+                case 32: return "f";
+                case 64: return "g";
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
+PyObject *arrow_export(PyObject *owner, const dlpack::dtype *dtype,
+                       int64_t length, const void *validity,
+                       const void *values) {
+    const char *format = arrow_format(*dtype);
+    if (!format)
+        raise("nanobind::arrow_export(): the array dtype has no Arrow "
+              "equivalent!");
+
+    ArrowSchema *schema = (ArrowSchema *) calloc(1, sizeof(ArrowSchema));
+    ArrowArray *array = (ArrowArray *) calloc(1, sizeof(ArrowArray));
+    arrow_export_state *st =
+        (arrow_export_state *) malloc(sizeof(arrow_export_state));
+
+    object schema_o, array_o;
+    if (schema)
+        schema_o = steal(
+            PyCapsule_New(schema, "arrow_schema", arrow_export_free_schema));
+    if (array)
+        array_o = steal(
+            PyCapsule_New(array, "arrow_array", arrow_export_free_array));
+
+    if (!schema_o.is_valid() || !array_o.is_valid() || !st) {
+        if (!schema_o.is_valid())
+            free(schema);
+        if (!array_o.is_valid())
+            free(array);
+        free(st);
+        if (!PyErr_Occurred())
+            PyErr_NoMemory();
+        raise_python_error();
+    }
+
+    schema->format = format;
+    schema->name = "";
+    schema->flags = validity ? ARROW_FLAG_NULLABLE : 0;
+    schema->release = arrow_export_release_schema;
+
+    Py_INCREF(owner);
+    st->owner = owner;
+    st->buffers[0] = validity;
+    st->buffers[1] = values;
+
+    array->length = length;
+    array->null_count = validity ? -1 : 0;
+    array->n_buffers = 2;
+    array->buffers = st->buffers;
+    array->release = arrow_export_release_array;
+    array->private_data = st;
+
+    PyObject *result = PyTuple_Pack(2, schema_o.ptr(), array_o.ptr());
+    if (!result)
+        raise_python_error();
+    return result;
+}
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
@@ -17,50 +17,205 @@ NB_INLINE enum_supplement &nb_enum_supplement(PyTypeObject *type) {
     return type_supplement<enum_supplement>(type);
 }
 
-static PyObject *nb_enum_int_signed(PyObject *o);
-static PyObject *nb_enum_int_unsigned(PyObject *o);
+/// Read an enumerator value, sign- or zero-extended to 64 bit
+NB_INLINE uint64_t nb_enum_read(const void *p, uint32_t size, bool is_signed) {
+    switch (size) {
+        case 1: return is_signed ? (uint64_t) *(const int8_t *) p
+                                 : (uint64_t) *(const uint8_t *) p;
+        case 2: return is_signed ? (uint64_t) *(const int16_t *) p
+                                 : (uint64_t) *(const uint16_t *) p;
+        case 4: return is_signed ? (uint64_t) *(const int32_t *) p
+                                 : (uint64_t) *(const uint32_t *) p;
+        default: return *(const uint64_t *) p;
+    }
+}
+
+/// Store the low 'size' bytes of an enumerator value
+NB_INLINE void nb_enum_write(void *p, uint32_t size, uint64_t value) {
+    switch (size) {
+        case 1: *(uint8_t *) p = (uint8_t) value; break;
+        case 2: *(uint16_t *) p = (uint16_t) value; break;
+        case 4: *(uint32_t *) p = (uint32_t) value; break;
+        default: *(uint64_t *) p = value; break;
+    }
+}
+
+/// Can 'value' be represented by the enumeration's underlying type?
+NB_INLINE bool nb_enum_fits(uint64_t value, uint32_t size, bool is_signed) {
+    uint64_t tmp = 0;
+    nb_enum_write(&tmp, size, value);
+    return nb_enum_read(&tmp, size, is_signed) == value;
+}
+
+NB_INLINE uint64_t nb_enum_value(PyObject *o, bool is_signed) {
+    return nb_enum_read(inst_ptr((nb_inst *) o),
+                        nb_type_data(Py_TYPE(o))->size, is_signed);
+}
+
+/// Convert a Python 'int' into an enumerator value
+static bool nb_enum_from_long(PyObject *o, bool is_signed, uint64_t &value) {
+    if (is_signed) {
+        long long v = PyLong_AsLongLong(o);
+        value = (uint64_t) v;
+        if (v == -1 && PyErr_Occurred()) {
+            PyErr_Clear();
+            return false;
+        }
+    } else {
+        unsigned long long v = PyLong_AsUnsignedLongLong(o);
+        value = (uint64_t) v;
+        if (v == (unsigned long long) -1 && PyErr_Occurred()) {
+            PyErr_Clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Find the '(name, doc, instance)' entry of a value, returns a borrowed reference
+NB_INLINE PyObject *nb_enum_find(enum_supplement &supp, uint64_t value) {
+    nb_enum_map *values = (nb_enum_map *) supp.values;
+    if (!values)
+        return nullptr;
+    nb_enum_map::iterator it = values->find(value);
+    return it != values->end() ? it->second : nullptr;
+}
+
+/// Return the instance representing 'value', creating one if none exists
+static PyObject *nb_enum_from_value(PyTypeObject *tp, enum_supplement &supp,
+                                    uint64_t value) {
+    PyObject *rec = nb_enum_find(supp, value);
+    if (rec) {
+        PyObject *result = NB_TUPLE_GET_ITEM(rec, 2);
+        Py_INCREF(result);
+        return result;
+    }
+
+    // Composite value (e.g. a combination of flags) without a name
+    nb_inst *inst = (nb_inst *) inst_new_int(tp);
+    if (!inst)
+        return nullptr;
+
+    nb_enum_write(inst_ptr(inst), nb_type_data(tp)->size, value);
+    inst->destruct = false;
+    inst->cpp_delete = false;
+    inst->ready = true;
+
+    return (PyObject *) inst;
+}
+
+PyObject *nb_enum_get(type_data *t, const void *value) noexcept {
+    enum_supplement &supp = nb_enum_supplement(t->type_py);
+    PyObject *rec =
+        nb_enum_find(supp, nb_enum_read(value, t->size, supp.is_signed));
+    if (!rec)
+        return nullptr;
+
+    PyObject *result = NB_TUPLE_GET_ITEM(rec, 2);
+    Py_INCREF(result);
+    return result;
+}
+
+void nb_enum_free(PyTypeObject *tp) noexcept {
+    enum_supplement &supp = nb_enum_supplement(tp);
+    delete (nb_enum_map *) supp.values;
+    supp.values = nullptr;
+}
 
 /// Map to unique representative enum instance, returns a borrowed reference
 static PyObject *nb_enum_lookup(PyObject *self) {
     enum_supplement &supp = nb_enum_supplement(Py_TYPE(self));
-    PyObject *int_val = supp.is_signed ? nb_enum_int_signed(self)
-                                       : nb_enum_int_unsigned(self);
-    PyObject *rec = nullptr;
-    if (int_val && supp.entries)
-        rec = (PyObject *) PyDict_GetItem(supp.entries, int_val);
+    PyObject *rec = nb_enum_find(supp, nb_enum_value(self, supp.is_signed));
+    if (!rec)
+        PyErr_SetString(PyExc_RuntimeError, "nb_enum: could not find entry!");
+    return rec;
+}
 
-    Py_XDECREF(int_val);
+/**
+ * Name of a flag combination without its own entry, e.g. "Read|Write".
+ * Returns a new reference, or 'nullptr' (without an error) if no named flag
+ * contributes to the value.
+ */
+static PyObject *nb_enum_flag_name(PyObject *self) {
+    enum_supplement &supp = nb_enum_supplement(Py_TYPE(self));
+    uint64_t value = nb_enum_value(self, supp.is_signed), remainder = value;
+    if (!supp.entries || value == 0)
+        return nullptr;
 
-    if (rec && PyTuple_CheckExact(rec) && NB_TUPLE_GET_SIZE(rec) == 3) {
-        return rec;
-    } else {
-        PyErr_Clear();
-        PyErr_SetString(PyExc_RuntimeError, "nb_enum: could not find entry!");
+    PyObject *names = PyList_New(0), *key, *rec;
+    if (!names)
         return nullptr;
+
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(supp.entries, &pos, &key, &rec)) {
+        uint64_t flag = nb_enum_value(NB_TUPLE_GET_ITEM(rec, 2), supp.is_signed);
+        if (flag == 0 || (value & flag) != flag || (remainder & flag) == 0)
+            continue;
+        remainder &= ~flag;
+        if (PyList_Append(names, NB_TUPLE_GET_ITEM(rec, 0))) {
+            Py_DECREF(names);
+            return nullptr;
+        }
     }
+
+    PyObject *result = nullptr;
+    if (remainder != value) {
+        if (remainder) {
+            char buf[20];
+            snprintf(buf, sizeof(buf), "0x%llx", (unsigned long long) remainder);
+            PyObject *rest = PyUnicode_FromString(buf);
+            if (!rest || PyList_Append(names, rest)) {
+                Py_XDECREF(rest);
+                Py_DECREF(names);
+                return nullptr;
+            }
+            Py_DECREF(rest);
+        }
+
+        PyObject *sep = PyUnicode_FromString("|");
+        if (sep)
+            result = PyUnicode_Join(sep, names);
+        Py_XDECREF(sep);
+    }
+
+    Py_DECREF(names);
+    return result;
 }
 
-static PyObject *nb_enum_repr(PyObject *self) {
+/// Name of an enumerator (including flag combinations), new reference
+static PyObject *nb_enum_name(PyObject *self) {
     PyObject *entry = nb_enum_lookup(self);
-    if (!entry)
+    if (entry) {
+        PyObject *result = NB_TUPLE_GET_ITEM(entry, 0);
+        Py_INCREF(result);
+        return result;
+    }
+
+    if (!nb_enum_supplement(Py_TYPE(self)).is_flag)
+        return nullptr;
+
+    PyErr_Clear();
+    PyObject *result = nb_enum_flag_name(self);
+    if (!result && !PyErr_Occurred())
+        PyErr_SetString(PyExc_RuntimeError, "nb_enum: could not find entry!");
+    return result;
+}
+
+static PyObject *nb_enum_repr(PyObject *self) {
+    PyObject *entry_name = nb_enum_name(self);
+    if (!entry_name)
         return nullptr;
 
     PyObject *name = nb_inst_name(self);
-    PyObject *result =
-        PyUnicode_FromFormat("%U.%U", name, NB_TUPLE_GET_ITEM(entry, 0));
+    PyObject *result = PyUnicode_FromFormat("%U.%U", name, entry_name);
     Py_DECREF(name);
+    Py_DECREF(entry_name);
 
     return result;
 }
 
 static PyObject *nb_enum_get_name(PyObject *self, void *) {
-    PyObject *entry = nb_enum_lookup(self);
-    if (!entry)
-        return nullptr;
-
-    PyObject *result = NB_TUPLE_GET_ITEM(entry, 0);
-    Py_INCREF(result);
-    return result;
+    return nb_enum_name(self);
 }
 
 static PyObject *nb_enum_get_doc(PyObject *self, void *) {
@@ -73,34 +228,13 @@ static PyObject *nb_enum_get_doc(PyObject *self, void *) {
     return result;
 }
 
-NB_NOINLINE static PyObject *nb_enum_int_signed(PyObject *o) {
-    type_data *t = nb_type_data(Py_TYPE(o));
-    const void *p = inst_ptr((nb_inst *) o);
-    long long value;
-    switch (t->size) {
-        case 1: value = (long long) *(const int8_t *)  p; break;
-        case 2: value = (long long) *(const int16_t *) p; break;
-        case 4: value = (long long) *(const int32_t *) p; break;
-        case 8: value = (long long) *(const int64_t *) p; break;
-        default: PyErr_SetString(PyExc_TypeError, "nb_enum: invalid type size!");
-                 return nullptr;
-    }
-    return PyLong_FromLongLong(value);
-}
-
-NB_NOINLINE static PyObject *nb_enum_int_unsigned(PyObject *o) {
-    type_data *t = nb_type_data(Py_TYPE(o));
-    const void *p = inst_ptr((nb_inst *) o);
-    unsigned long long value;
-    switch (t->size) {
-        case 1: value = (unsigned long long) *(const uint8_t *)  p; break;
-        case 2: value = (unsigned long long) *(const uint16_t *) p; break;
-        case 4: value = (unsigned long long) *(const uint32_t *) p; break;
-        case 8: value = (unsigned long long) *(const uint64_t *) p; break;
-        default: PyErr_SetString(PyExc_TypeError, "nb_enum: invalid type size!");
-                 return nullptr;
-    }
-    return PyLong_FromUnsignedLongLong(value);
+static PyObject *nb_enum_int_signed(PyObject *o) {
+    return PyLong_FromLongLong((long long) nb_enum_value(o, true));
+}
+
+static PyObject *nb_enum_int_unsigned(PyObject *o) {
+    return PyLong_FromUnsignedLongLong(
+        (unsigned long long) nb_enum_value(o, false));
 }
 
 static PyObject *nb_enum_init(PyObject *, PyObject *, PyObject *) {
@@ -116,15 +250,21 @@ static PyObject *nb_enum_new(PyTypeObject *subtype, PyObject *args, PyObject *kw
     arg = NB_TUPLE_GET_ITEM(args, 0);
     if (PyLong_Check(arg)) {
         enum_supplement &supp = nb_enum_supplement(subtype);
-        if (!supp.entries)
+        uint64_t value;
+        if (!nb_enum_from_long(arg, supp.is_signed, value))
             goto error;
 
-        PyObject *item = PyDict_GetItem(supp.entries, arg);
-        if (item && PyTuple_CheckExact(item) && NB_TUPLE_GET_SIZE(item) == 3) {
+        PyObject *item = nb_enum_find(supp, value);
+        if (item) {
             item = NB_TUPLE_GET_ITEM(item, 2);
             Py_INCREF(item);
             return item;
         }
+
+        // Flag enumerations also represent combinations of their values
+        if (supp.is_flag &&
+            nb_enum_fits(value, nb_type_data(subtype)->size, supp.is_signed))
+            return nb_enum_from_value(subtype, supp, value);
     } else if (Py_TYPE(arg) == subtype) {
         Py_INCREF(arg);
         return arg;
@@ -263,6 +403,78 @@ NB_ENUM_UNOP(neg, PyNumber_Negative)
 NB_ENUM_UNOP(inv, PyNumber_Invert)
 NB_ENUM_UNOP(abs, PyNumber_Absolute)
 
+/// Is 'o' an instance of a flag enumeration? (sets 'supp' if so)
+static bool nb_enum_is_flag(PyObject *o, enum_supplement *&supp) {
+    PyTypeObject *tp = Py_TYPE(o);
+    if (!nb_type_check((PyObject *) tp) ||
+        !(nb_type_data(tp)->flags & (uint32_t) type_flags::is_enum))
+        return false;
+    supp = &nb_enum_supplement(tp);
+    return supp->is_flag;
+}
+
+// Bitwise operations on flags are computed on the underlying integers and
+// produce another enumerator. Other combinations (e.g. with a different
+// enumeration) fall back to the integer semantics of nb_enum_binop().
+NB_NOINLINE PyObject *nb_enum_flag_binop(PyObject *a, PyObject *b, char op,
+                                         PyObject* (*fallback)(PyObject*, PyObject*)) {
+    enum_supplement *supp = nullptr;
+    PyObject *self = nb_enum_is_flag(a, supp) ? a : b,
+             *other = self == a ? b : a;
+    PyTypeObject *tp = Py_TYPE(self);
+
+    if (!supp && !nb_enum_is_flag(self, supp))
+        return nb_enum_binop(a, b, fallback);
+
+    uint32_t size = nb_type_data(tp)->size;
+    bool is_signed = supp->is_signed;
+    uint64_t va = nb_enum_value(self, is_signed), vb;
+
+    if (Py_TYPE(other) == tp) {
+        vb = nb_enum_value(other, is_signed);
+    } else if (PyLong_Check(other) &&
+               nb_enum_from_long(other, is_signed, vb) &&
+               nb_enum_fits(vb, size, is_signed)) {
+        // Plain integer operand that is representable by the enumeration
+    } else {
+        return nb_enum_binop(a, b, fallback);
+    }
+
+    uint64_t result;
+    switch (op) {
+        case '&': result = va & vb; break;
+        case '|': result = va | vb; break;
+        default:  result = va ^ vb; break;
+    }
+
+    return nb_enum_from_value(tp, *supp, result);
+}
+
+#define NB_ENUM_FLAG_BINOP(name, op, fallback)                                 \
+    PyObject *nb_enum_flag_##name(PyObject *a, PyObject *b) {                  \
+        return nb_enum_flag_binop(a, b, op, fallback);                         \
+    }
+
+NB_ENUM_FLAG_BINOP(and, '&', PyNumber_And)
+NB_ENUM_FLAG_BINOP(or, '|', PyNumber_Or)
+NB_ENUM_FLAG_BINOP(xor, '^', PyNumber_Xor)
+
+PyObject *nb_enum_flag_inv(PyObject *a) {
+    enum_supplement &supp = nb_enum_supplement(Py_TYPE(a));
+    uint32_t size = nb_type_data(Py_TYPE(a))->size;
+
+    // Invert all bits of the underlying type, like the C++ '~' operator
+    uint64_t value = 0;
+    nb_enum_write(&value, size, ~nb_enum_value(a, supp.is_signed));
+
+    return nb_enum_from_value(Py_TYPE(a), supp,
+                              nb_enum_read(&value, size, supp.is_signed));
+}
+
+int nb_enum_flag_bool(PyObject *a) {
+    return nb_enum_value(a, false) != 0;
+}
+
 int nb_enum_clear(PyObject *) {
     return 0;
 }
@@ -273,18 +485,7 @@ int nb_enum_traverse(PyObject *o, visitproc visit, void *arg) {
 }
 
 Py_hash_t nb_enum_hash(PyObject *o) {
-    Py_hash_t value = 0;
-    type_data *t = nb_type_data(Py_TYPE(o));
-    const void *p = inst_ptr((nb_inst *) o);
-    switch (t->size) {
-        case 1: value = *(const int8_t *)  p; break;
-        case 2: value = *(const int16_t *) p; break;
-        case 4: value = *(const int32_t *) p; break;
-        case 8: value = (Py_hash_t) * (const int64_t*)p; break;
-        default:
-            PyErr_SetString(PyExc_TypeError, "nb_enum: invalid type size!");
-            return -1;
-    }
+    Py_hash_t value = (Py_hash_t) nb_enum_value(o, true);
 
     // Hash functions should return -1 when an error occurred.
     // Return -2 that case, since hash(-1) also yields -2.
@@ -295,11 +496,14 @@ Py_hash_t nb_enum_hash(PyObject *o) {
 
 void nb_enum_prepare(const type_init_data *td,
                      PyType_Slot *&t, size_t max_slots) noexcept {
-    /* 22 is the number of slot assignments below. Update it if you add more.
-       These built-in slots are added before any user-defined ones. */
-    check(max_slots >= 22,
+    /* 23 is the maximum number of slot assignments below. Update it if you
+       add more. These built-in slots are added before any user-defined ones. */
+    check(max_slots >= 23,
           "nanobind::detail::nb_enum_prepare(\"%s\"): ran out of "
           "type slots!", td->name);
+    check(td->size == 1 || td->size == 2 || td->size == 4 || td->size == 8,
+          "nanobind::detail::nb_enum_prepare(\"%s\"): invalid type size!",
+          td->name);
 
     const enum_init_data *ed = static_cast<const enum_init_data *>(td);
     auto int_fn = ed->is_signed ? nb_enum_int_signed : nb_enum_int_unsigned;
@@ -320,21 +524,32 @@ void nb_enum_prepare(const type_init_data *td,
         *t++ = { Py_nb_subtract, (void *) nb_enum_sub };
         *t++ = { Py_nb_multiply, (void *) nb_enum_mul };
         *t++ = { Py_nb_floor_divide, (void *) nb_enum_div };
-        *t++ = { Py_nb_or, (void *) nb_enum_or };
-        *t++ = { Py_nb_xor, (void *) nb_enum_xor };
-        *t++ = { Py_nb_and, (void *) nb_enum_and };
         *t++ = { Py_nb_rshift, (void *) nb_enum_rshift };
         *t++ = { Py_nb_lshift, (void *) nb_enum_lshift };
         *t++ = { Py_nb_negative, (void *) nb_enum_neg };
-        *t++ = { Py_nb_invert, (void *) nb_enum_inv };
         *t++ = { Py_nb_absolute, (void *) nb_enum_abs };
     }
+
+    if (ed->is_flag) {
+        *t++ = { Py_nb_or, (void *) nb_enum_flag_or };
+        *t++ = { Py_nb_xor, (void *) nb_enum_flag_xor };
+        *t++ = { Py_nb_and, (void *) nb_enum_flag_and };
+        *t++ = { Py_nb_invert, (void *) nb_enum_flag_inv };
+        *t++ = { Py_nb_bool, (void *) nb_enum_flag_bool };
+    } else if (ed->is_arithmetic) {
+        *t++ = { Py_nb_or, (void *) nb_enum_or };
+        *t++ = { Py_nb_xor, (void *) nb_enum_xor };
+        *t++ = { Py_nb_and, (void *) nb_enum_and };
+        *t++ = { Py_nb_invert, (void *) nb_enum_inv };
+    }
 }
 
 void nb_enum_put(PyObject *type, const char *name, const void *value,
                  const char *doc) noexcept {
     PyObject *doc_obj, *rec, *int_val;
     enum_supplement &supp = nb_enum_supplement((PyTypeObject *) type);
+    uint64_t start = nb_time_ns();
+    size_t bytes;
 
     PyObject *name_obj = PyUnicode_InternFromString(name);
     if (doc) {
@@ -386,9 +601,21 @@ void nb_enum_put(PyObject *type, const char *name, const void *value,
     if (PyDict_SetItem(supp.entries, int_val, rec))
         goto error;
 
+    if (!supp.values)
+        supp.values = new nb_enum_map();
+
+    // Later entries with the same value replace earlier ones, like above
+    (*(nb_enum_map *) supp.values)[nb_enum_value((PyObject *) inst,
+                                                 supp.is_signed)] = rec;
+
     Py_DECREF(int_val);
     Py_DECREF(rec);
 
+    // Approximate footprint of the entry (excluding the dictionaries)
+    bytes = sizeof(nb_inst) + nb_type_data((PyTypeObject *) type)->size +
+            strlen(name) + 1 + (doc ? strlen(doc) + 1 : 0);
+    nb_reg_record(type, nb_reg_kind::enum_value, start, bytes);
+
     return;
 
 error:
@@ -9,14 +9,32 @@
 
 #include "nb_internals.h"
 #include "buffer.h"
-
-/// Maximum number of arguments supported by 'nb_vectorcall_simple'
-#define NB_MAXARGS_SIMPLE 8
+#include <chrono>
 
 #if defined(__GNUG__)
 #  include <cxxabi.h>
 #endif
 
+/* Optional USDT (SystemTap/perf/bpftrace) probes for function entry/exit,
+   rejected overloads, and exception translation. Define NB_USDT while
+   compiling libnanobind on Linux to enable them. Each probe is guarded by a
+   semaphore so that the qualified function name is only computed while a
+   tracer is attached. Without NB_USDT, the probes compile to nothing. */
+#if defined(NB_USDT)
+#  define _SDT_HAS_SEMAPHORES 1
+#  include <sys/sdt.h>
+#  define NB_PROBE_SEMAPHORE(name)                                             \
+       extern "C" {                                                           \
+           __attribute__((section(".probes"), used))                          \
+           unsigned short nanobind_##name##_semaphore = 0;                    \
+       }
+#  define NB_PROBE(name, self, arg)                                            \
+       if (NB_UNLIKELY(nanobind_##name##_semaphore))                          \
+           nb_func_probe_##name(self, arg)
+#else
+#  define NB_PROBE(name, self, arg)
+#endif
+
 #if defined(_MSC_VER)
 #  pragma warning(disable: 4706) // assignment within conditional expression
 #  pragma warning(disable: 6255) // _alloca indicates failure by raising a stack overflow exception
@@ -33,6 +51,55 @@ static PyObject *nb_func_vectorcall_simple(PyObject *, PyObject *const *,
 static PyObject *nb_func_vectorcall_complex(PyObject *, PyObject *const *,
                                             size_t, PyObject *) noexcept;
 static void nb_func_render_signature(const func_data *f) noexcept;
+static PyObject *nb_func_get_qualname(PyObject *self);
+
+#if defined(NB_USDT)
+/// Fire a probe with the function's qualified name and an integer argument
+#  define NB_PROBE_DEFINE(probe)                                               \
+       NB_PROBE_SEMAPHORE(probe)                                              \
+       static NB_NOINLINE void nb_func_probe_##probe(PyObject *self,          \
+                                                    long arg) noexcept {      \
+           PyObject *exc_type, *exc_value, *exc_tb;                           \
+           PyErr_Fetch(&exc_type, &exc_value, &exc_tb);                       \
+           PyObject *qualname = nb_func_get_qualname(self);                   \
+           const char *qualname_c = nullptr;                                  \
+           if (qualname && qualname != Py_None)                               \
+               qualname_c = PyUnicode_AsUTF8AndSize(qualname, nullptr);       \
+           if (!qualname_c)                                                   \
+               qualname_c = nb_func_data(self)->name;                         \
+           STAP_PROBE2(nanobind, probe, qualname_c, arg);                     \
+           Py_XDECREF(qualname);                                              \
+           PyErr_Clear();                                                     \
+           PyErr_Restore(exc_type, exc_value, exc_tb);                        \
+       }
+
+NB_PROBE_DEFINE(func_entry)     // arg: number of positional arguments
+NB_PROBE_DEFINE(func_exit)      // arg: 1 if the call succeeded, 0 otherwise
+NB_PROBE_DEFINE(overload_fail)  // arg: index of the rejected overload
+NB_PROBE_DEFINE(exception)      // arg: unused (0)
+#endif
+
+/// Monotonic clock used by the function call and registration profilers
+uint64_t nb_time_ns() noexcept {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// Adds the time elapsed during its lifetime to a profiling counter (if set)
+struct nb_profile_timer {
+    NB_INLINE nb_profile_timer(uint64_t *target) : target(target) {
+        if (NB_UNLIKELY(target))
+            start = nb_time_ns();
+    }
+
+    NB_INLINE ~nb_profile_timer() {
+        if (NB_UNLIKELY(target))
+            nb_counter_add(*target, nb_time_ns() - start);
+    }
+
+    uint64_t *target;
+    uint64_t start = 0;
+};
 
 int nb_func_traverse(PyObject *self, visitproc visit, void *arg) {
     size_t size = (size_t) Py_SIZE(self);
@@ -81,13 +148,18 @@ void nb_func_dealloc(PyObject *self) {
         func_data *f = nb_func_data(self);
 
         // Delete from registered function list
-        auto &funcs = internals->funcs;
-        auto it = funcs.find(self);
-        check(it != funcs.end(),
-              "nanobind::detail::nb_func_dealloc(\"%s\"): function not found!",
-              ((f->flags & (uint32_t) func_flags::has_name) ? f->name
-                                                            : "<anonymous>"));
-        funcs.erase(it);
+        {
+            lock_internals guard(internals);
+            auto &funcs = internals->funcs;
+            auto it = funcs.find(self);
+            check(it != funcs.end(),
+                  "nanobind::detail::nb_func_dealloc(\"%s\"): function not found!",
+                  ((f->flags & (uint32_t) func_flags::has_name) ? f->name
+                                                                : "<anonymous>"));
+            funcs.erase(it);
+        }
+
+        free(((nb_func *) self)->profile);
 
         for (size_t i = 0; i < size; ++i) {
             if (f->flags & (uint32_t) func_flags::has_free)
@@ -103,10 +175,10 @@ void nb_func_dealloc(PyObject *self) {
             if (f->flags & (uint32_t) func_flags::has_doc)
                 free((char *) f->doc);
 
-            free((char *) f->name);
+            // Overloads share the name of the first entry
+            if (i == 0)
+                free((char *) f->name);
             free(f->args);
-            free((char *) f->descr);
-            free(f->descr_types);
             ++f;
         }
     }
@@ -133,9 +205,31 @@ void nb_bound_method_dealloc(PyObject *self) {
     PyObject_GC_UnTrack(self);
     Py_DECREF((PyObject *) mb->func);
     Py_DECREF(mb->self);
+
+#if NB_BOUND_METHOD_FREELIST > 0
+    nb_internals *internals_ = internals;
+    if (internals_->bound_method_freelist_size < NB_BOUND_METHOD_FREELIST) {
+        mb->self = (PyObject *) internals_->bound_method_freelist;
+        internals_->bound_method_freelist = mb;
+        internals_->bound_method_freelist_size++;
+        return;
+    }
+#endif
+
     PyObject_GC_Del(self);
 }
 
+void nb_bound_method_freelist_clear(nb_internals *p) noexcept {
+    nb_bound_method *mb = p->bound_method_freelist;
+    while (mb) {
+        nb_bound_method *next = (nb_bound_method *) mb->self;
+        PyObject_GC_Del(mb);
+        mb = next;
+    }
+    p->bound_method_freelist = nullptr;
+    p->bound_method_freelist_size = 0;
+}
+
 static arg_data method_args[2] = {
     { "self", nullptr, nullptr, false, false },
     { nullptr, nullptr, nullptr, false, false }
@@ -188,8 +282,13 @@ char *strdup_check(const char *s) {
  *
  * This is an implementation detail of nanobind::cpp_function.
  */
-PyObject *nb_func_new(const void *in_) noexcept {
-    func_data_prelim<0> *f = (func_data_prelim<0> *) in_;
+/**
+ * Create a function object. 'deferred' indicates that the binding was
+ * recorded by nb_func_defer() and is now materialized by the module's
+ * __getattr__, which mustn't run again while looking for previous overloads.
+ */
+static PyObject *nb_func_create(func_data_prelim<0> *f,
+                                bool deferred) noexcept {
     arg_data *args_in = std::launder((arg_data *) f->args);
 
     bool has_scope      = f->flags & (uint32_t) func_flags::has_scope,
@@ -212,7 +311,19 @@ PyObject *nb_func_new(const void *in_) noexcept {
         name = PyUnicode_FromString(f->name);
         check(name, "nb::detail::nb_func_new(\"%s\"): invalid name.", f->name);
 
-        func_prev = PyObject_GetAttr(f->scope, name);
+        if (deferred) {
+            PyObject *dict = PyModule_GetDict(f->scope);
+#if defined(NB_FREE_THREADED)
+            if (PyDict_GetItemRef(dict, name, &func_prev) < 0)
+                func_prev = nullptr;
+#else
+            func_prev = PyDict_GetItemWithError(dict, name);
+            Py_XINCREF(func_prev);
+#endif
+        } else {
+            func_prev = PyObject_GetAttr(f->scope, name);
+        }
+
         if (func_prev) {
             if (Py_TYPE(func_prev) == internals->nb_func ||
                 Py_TYPE(func_prev) == internals->nb_method) {
@@ -258,17 +369,31 @@ PyObject *nb_func_new(const void *in_) noexcept {
     }
 
     // Create a new function and destroy the old one
-    Py_ssize_t to_copy = func_prev ? Py_SIZE(func_prev) : 0;
+    Py_ssize_t to_copy = func_prev ? Py_SIZE(func_prev) : 0,
+               key_items = (Py_ssize_t) ((sizeof(func_key) * (to_copy + 1) +
+                                          sizeof(func_data) - 1) / sizeof(func_data));
+
+    // Allocate extra items for the trailing 'func_key' array
     nb_func *func = (nb_func *) PyType_GenericAlloc(
-        is_method ? internals->nb_method : internals->nb_func, to_copy + 1);
+        is_method ? internals->nb_method : internals->nb_func,
+        to_copy + 1 + key_items);
     check(func, "nb::detail::nb_func_new(\"%s\"): alloc. failed (1).",
           has_name ? f->name : "<anonymous>");
+    ((PyVarObject *) func)->ob_size = to_copy + 1;
 
+    /* Functions with nb::arg() annotations can use the simple dispatcher when
+       called with positional arguments only (it forwards other calls) */
     func->max_nargs_pos = f->nargs;
-    func->complex_call = has_args || has_var_args || has_var_kwargs || has_keep_alive;
+    func->complex_call = has_var_args || has_var_kwargs || has_keep_alive;
+    func->has_defaults = false;
+    if (has_args) {
+        for (size_t i = is_method; i < f->nargs; ++i)
+            func->has_defaults |= args_in[i - is_method].value != nullptr;
+    }
 
     if (func_prev) {
         func->complex_call |= ((nb_func *) func_prev)->complex_call;
+        func->has_defaults |= ((nb_func *) func_prev)->has_defaults;
         func->max_nargs_pos = std::max(func->max_nargs_pos,
                                        ((nb_func *) func_prev)->max_nargs_pos);
 
@@ -280,21 +405,26 @@ PyObject *nb_func_new(const void *in_) noexcept {
 
         ((PyVarObject *) func_prev)->ob_size = 0;
 
+        lock_internals guard(internals);
         auto it = internals->funcs.find(func_prev);
         check(it != internals->funcs.end(),
               "nanobind::detail::nb_func_new(): internal update failed (1)!");
         internals->funcs.erase(it);
     }
 
-    func->complex_call |= func->max_nargs_pos >= NB_MAXARGS_SIMPLE;
-
     func->vectorcall = func->complex_call ? nb_func_vectorcall_complex
                                           : nb_func_vectorcall_simple;
 
+    if (internals->profiling)
+        func->profile = (nb_func_profile *) calloc(1, sizeof(nb_func_profile));
+
     // Register the function
-    auto [it, success] = internals->funcs.try_emplace(func, nullptr);
-    check(success,
-          "nanobind::detail::nb_func_new(): internal update failed (2)!");
+    {
+        lock_internals guard(internals);
+        auto [it, success] = internals->funcs.try_emplace(func, nullptr);
+        check(success,
+              "nanobind::detail::nb_func_new(): internal update failed (2)!");
+    }
 
     func_data *fc = nb_func_data(func) + to_copy;
     memcpy(fc, f, sizeof(func_data_prelim<0>));
@@ -310,9 +440,15 @@ PyObject *nb_func_new(const void *in_) noexcept {
     if (has_args)
         fc->flags |= (uint32_t) func_flags::has_args;
 
-    if (!has_name)
-        fc->name = "";
-    fc->name = strdup_check(fc->name);
+    func_data *fd = nb_func_data(func);
+    func_key *keys = nb_func_keys(func, (size_t) to_copy + 1);
+    for (Py_ssize_t k = 0; k <= to_copy; ++k)
+        keys[k] = func_key{ fd[k].flags, fd[k].nargs };
+
+    if (to_copy)
+        fc->name = nb_func_data(func)->name;
+    else
+        fc->name = strdup_check(has_name ? fc->name : "");
 
     if (is_implicit) {
         check(fc->flags & (uint32_t) func_flags::is_constructor,
@@ -328,24 +464,6 @@ PyObject *nb_func_new(const void *in_) noexcept {
             implicitly_convertible(f->descr_types[1], f->descr_types[0]);
     }
 
-    for (size_t i = 0;; ++i) {
-        if (!f->descr[i]) {
-            fc->descr = (char *) malloc_check(sizeof(char) * (i + 1));
-            memcpy((char *) fc->descr, f->descr, (i + 1) * sizeof(char));
-            break;
-        }
-    }
-
-    for (size_t i = 0;; ++i) {
-        if (!f->descr_types[i]) {
-            fc->descr_types = (const std::type_info **)
-                malloc_check(sizeof(const std::type_info *) * (i + 1));
-            memcpy(fc->descr_types, f->descr_types,
-                        (i + 1) * sizeof(const std::type_info *));
-            break;
-        }
-    }
-
     if (has_args) {
         fc->args = (arg_data *) malloc_check(sizeof(arg_data) * f->nargs);
 
@@ -381,6 +499,314 @@ PyObject *nb_func_new(const void *in_) noexcept {
     }
 }
 
+/// Function binding whose creation was deferred by nb::module_::lazy()
+struct nb_lazy_func {
+    nb_lazy_func *next;
+    func_data_prelim<0> f; // followed by 'f.nargs' argument records
+};
+
+using nb_lazy_map = tsl::robin_map<std::string_view, nb_lazy_func *,
+                                   std::hash<std::string_view>>;
+
+/// State of a module in lazy mode, owned by its __getattr__ function
+struct nb_lazy_module {
+    PyObject *module;
+    bool enabled = true;
+
+    /// Pending overload chains (most recent binding first)
+    nb_lazy_map pending;
+
+#if defined(NB_FREE_THREADED)
+    PyMutex mutex { };
+#endif
+};
+
+struct lock_lazy {
+#if defined(NB_FREE_THREADED)
+    NB_INLINE lock_lazy(nb_lazy_module *m) : m(m) { PyMutex_Lock(&m->mutex); }
+    NB_INLINE ~lock_lazy() { PyMutex_Unlock(&m->mutex); }
+    nb_lazy_module *m;
+#else
+    NB_INLINE lock_lazy(nb_lazy_module *) { }
+#endif
+};
+
+/// Release a deferred binding, 'owned' specifies whether it still owns its capture
+static void nb_lazy_func_free(nb_lazy_func *l, bool owned) noexcept {
+    func_data_prelim<0> &f = l->f;
+
+    if (owned && (f.flags & (uint32_t) func_flags::has_free))
+        f.free_capture(f.capture);
+
+    if (f.flags & (uint32_t) func_flags::has_args) {
+        for (size_t i = 0; i < f.nargs; ++i)
+            Py_XDECREF(f.args[i].value);
+    }
+
+    if (f.flags & (uint32_t) func_flags::has_doc)
+        free((char *) f.doc);
+
+    free((char *) f.name);
+    free(l);
+}
+
+/**
+ * Record a module-level function binding instead of creating it when the
+ * module is in lazy mode. Returns 'false' if the function must be created
+ * right away.
+ */
+static bool nb_func_defer(func_data_prelim<0> *f) noexcept {
+    nb_internals *internals_ = internals;
+    nb_lazy_module *lm;
+
+    {
+        lock_internals guard(internals_);
+        nb_ptr_map &lazy_modules = internals_->lazy_modules;
+        if (lazy_modules.empty())
+            return false;
+        nb_ptr_map::iterator it = lazy_modules.find(f->scope);
+        if (it == lazy_modules.end())
+            return false;
+        lm = (nb_lazy_module *) it->second;
+    }
+
+    if (!lm->enabled)
+        return false;
+
+    size_t nargs = (f->flags & (uint32_t) func_flags::has_args) ? f->nargs : 0;
+
+    nb_lazy_func *l = (nb_lazy_func *) malloc_check(
+        sizeof(nb_lazy_func) + sizeof(arg_data) * nargs);
+
+    /* The capture is relocated with memcpy(), just like in nb_func_create().
+       'descr' and 'descr_types' refer to static data. */
+    memcpy(&l->f, f, sizeof(func_data_prelim<0>));
+    l->next = nullptr;
+    l->f.name = strdup_check(f->name);
+    if (f->flags & (uint32_t) func_flags::has_doc)
+        l->f.doc = strdup_check(f->doc);
+    for (size_t i = 0; i < nargs; ++i) {
+        l->f.args[i] = f->args[i];
+        Py_XINCREF(l->f.args[i].value);
+    }
+
+    lock_lazy guard(lm);
+    auto [it, success] = lm->pending.try_emplace(l->f.name, l);
+
+    if (success) {
+        // Overloads of an existing attribute can't be deferred
+        if (PyDict_GetItemString(PyModule_GetDict(lm->module), f->name)) {
+            lm->pending.erase(it);
+            nb_lazy_func_free(l, false);
+            return false;
+        }
+    } else {
+        l->next = it->second;
+        it.value() = l;
+    }
+
+    return true;
+}
+
+/// Create the function objects of a pending name (if any)
+static void nb_lazy_materialize(nb_lazy_module *lm, std::string_view name) {
+    nb_lazy_map::iterator it = lm->pending.find(name);
+    if (it == lm->pending.end())
+        return;
+
+    // Restore the definition order of the overload chain
+    nb_lazy_func *l = it->second, *prev = nullptr;
+    lm->pending.erase(it);
+    while (l) {
+        nb_lazy_func *next = l->next;
+        l->next = prev;
+        prev = l;
+        l = next;
+    }
+
+    for (l = prev; l; ) {
+        nb_lazy_func *next = l->next;
+        nb_func_create(&l->f, true);
+        nb_lazy_func_free(l, false);
+        l = next;
+    }
+}
+
+static void nb_lazy_module_free(PyObject *o) noexcept {
+    nb_lazy_module *lm =
+        (nb_lazy_module *) PyCapsule_GetPointer(o, "nb_lazy_module");
+
+    for (auto [name, l] : lm->pending) {
+        while (l) {
+            nb_lazy_func *next = l->next;
+            nb_lazy_func_free(l, true);
+            l = next;
+        }
+    }
+
+    if (internals) {
+        lock_internals guard(internals);
+        internals->lazy_modules.erase(lm->module);
+    }
+
+    delete lm;
+}
+
+static PyObject *nb_lazy_getattr(PyObject *self, PyObject *name) {
+    nb_lazy_module *lm =
+        (nb_lazy_module *) PyCapsule_GetPointer(self, "nb_lazy_module");
+    Py_ssize_t size;
+    const char *s = lm ? PyUnicode_AsUTF8AndSize(name, &size) : nullptr;
+    if (!s)
+        return nullptr;
+
+    {
+        lock_lazy guard(lm);
+        nb_lazy_materialize(lm, std::string_view(s, (size_t) size));
+    }
+
+    PyObject *dict = PyModule_GetDict(lm->module), *result;
+#if defined(NB_FREE_THREADED)
+    if (PyDict_GetItemRef(dict, name, &result) < 0)
+        return nullptr;
+#else
+    result = PyDict_GetItemWithError(dict, name);
+    Py_XINCREF(result);
+#endif
+
+    if (!result && !PyErr_Occurred()) {
+        PyObject *mod_name = PyModule_GetNameObject(lm->module);
+        if (mod_name) {
+            PyErr_Format(PyExc_AttributeError,
+                         "module '%U' has no attribute '%U'", mod_name, name);
+            Py_DECREF(mod_name);
+        }
+    }
+
+    return result;
+}
+
+static PyObject *nb_lazy_dir(PyObject *self, PyObject *) {
+    nb_lazy_module *lm =
+        (nb_lazy_module *) PyCapsule_GetPointer(self, "nb_lazy_module");
+    PyObject *result = lm ? PyDict_Keys(PyModule_GetDict(lm->module)) : nullptr;
+    if (!result)
+        return nullptr;
+
+    lock_lazy guard(lm);
+    for (const auto &[name, l] : lm->pending) {
+        PyObject *o = PyUnicode_FromStringAndSize(name.data(),
+                                                  (Py_ssize_t) name.size());
+        if (!o || PyList_Append(result, o)) {
+            Py_XDECREF(o);
+            Py_DECREF(result);
+            return nullptr;
+        }
+        Py_DECREF(o);
+    }
+
+    return result;
+}
+
+static PyMethodDef nb_lazy_getattr_def = {
+    "__getattr__", nb_lazy_getattr, METH_O, nullptr
+};
+
+static PyMethodDef nb_lazy_dir_def = {
+    "__dir__", nb_lazy_dir, METH_NOARGS, nullptr
+};
+
+void module_lazy(PyObject *m, bool value) {
+    nb_internals *internals_ = internals;
+    nb_lazy_module *lm = nullptr;
+
+    {
+        lock_internals guard(internals_);
+        nb_ptr_map::iterator it = internals_->lazy_modules.find(m);
+        if (it != internals_->lazy_modules.end())
+            lm = (nb_lazy_module *) it->second;
+    }
+
+    if (!lm) {
+        if (!value)
+            return;
+
+        if (PyDict_GetItemString(PyModule_GetDict(m), "__getattr__"))
+            raise("nanobind::module_::lazy(): the module already defines a "
+                  "__getattr__ function!");
+
+        lm = new nb_lazy_module();
+        lm->module = m;
+
+        // The module owns the state through its __getattr__/__dir__ functions
+        object owner = steal(
+            PyCapsule_New(lm, "nb_lazy_module", nb_lazy_module_free));
+        if (!owner.is_valid()) {
+            delete lm;
+            raise_python_error();
+        }
+
+        {
+            lock_internals guard(internals_);
+            internals_->lazy_modules[m] = lm;
+        }
+
+        object getattr_fn =
+            steal(PyCFunction_New(&nb_lazy_getattr_def, owner.ptr()));
+        object dir_fn = steal(PyCFunction_New(&nb_lazy_dir_def, owner.ptr()));
+        if (!getattr_fn.is_valid() || !dir_fn.is_valid())
+            raise_python_error();
+
+        setattr(m, "__getattr__", getattr_fn);
+        setattr(m, "__dir__", dir_fn);
+    }
+
+    lm->enabled = value;
+}
+
+PyObject *nb_func_new(const void *in_) noexcept {
+    func_data_prelim<0> *f = (func_data_prelim<0> *) in_;
+    uint64_t start = nb_time_ns();
+
+    // Approximate footprint of the overload (excluding the function object)
+    size_t bytes = sizeof(func_data);
+    if (f->flags & (uint32_t) func_flags::has_name)
+        bytes += strlen(f->name) + 1;
+    if (f->flags & (uint32_t) func_flags::has_doc)
+        bytes += strlen(f->doc) + 1;
+    if (f->flags & (uint32_t) func_flags::has_args)
+        bytes += sizeof(arg_data) * f->nargs;
+
+    PyObject *scope =
+        (f->flags & (uint32_t) func_flags::has_scope) ? f->scope : nullptr;
+
+    // Module-level functions, whose object isn't returned, may be deferred
+    constexpr uint32_t mask = (uint32_t) func_flags::has_scope |
+                              (uint32_t) func_flags::has_name |
+                              (uint32_t) func_flags::is_method |
+                              (uint32_t) func_flags::return_ref,
+                       match = (uint32_t) func_flags::has_scope |
+                               (uint32_t) func_flags::has_name;
+
+    PyObject *result = nullptr;
+    if ((f->flags & mask) != match || !nb_func_defer(f))
+        result = nb_func_create(f, false);
+
+    nb_reg_record(scope, nb_reg_kind::function, start, bytes);
+    return result;
+}
+
+void *nb_func_native(PyObject *o, const std::type_info *type) noexcept {
+    if (Py_TYPE(o) != internals->nb_func || Py_SIZE(o) != 1)
+        return nullptr;
+
+    func_data *f = nb_func_data(o);
+    if (!f->native_type || !(*f->native_type == *type))
+        return nullptr;
+
+    return f->capture;
+}
+
 /// Used by nb_func_vectorcall: generate an error when overload resolution fails
 static NB_NOINLINE PyObject *
 nb_func_error_overload(PyObject *self, PyObject *const *args_in,
@@ -452,10 +878,47 @@ static NB_NOINLINE PyObject *nb_func_error_noconvert(PyObject *self,
     return nullptr;
 }
 
+/// Return the dynamic type of the exception that is currently being handled
+static const std::type_info *nb_current_exception_type() noexcept {
+#if defined(__GNUG__)
+    return abi::__cxa_current_exception_type();
+#else
+    try {
+        throw;
+    } catch (const std::exception &e) {
+        return &typeid(e);
+    } catch (...) {
+        return nullptr;
+    }
+#endif
+}
+
 /// Used by nb_func_vectorcall: convert a C++ exception into a Python error
-static NB_NOINLINE void nb_func_convert_cpp_exception() noexcept {
+void nb_translate_exception() noexcept {
     std::exception_ptr e = std::current_exception();
 
+    // Dispatch to a translator registered for the exact exception type
+    nb_translator typed { nullptr, nullptr };
+    if (!internals->translators_typed.empty()) {
+        const std::type_info *type = nb_current_exception_type();
+        if (type) {
+            lock_internals guard(internals);
+            nb_translator_map::iterator it =
+                internals->translators_typed.find(type);
+            if (it != internals->translators_typed.end())
+                typed = it->second;
+        }
+    }
+
+    if (typed.translator) {
+        try {
+            typed.translator(e, typed.payload);
+            return;
+        } catch (...) {
+            e = std::current_exception();
+        }
+    }
+
     for (nb_translator_seq *cur = &internals->translators; cur;
          cur = cur->next) {
         try {
@@ -472,6 +935,57 @@ static NB_NOINLINE void nb_func_convert_cpp_exception() noexcept {
                     "could not be translated!");
 }
 
+static NB_NOINLINE void nb_func_convert_cpp_exception(PyObject *self) noexcept {
+    NB_PROBE(exception, self, 0);
+    (void) self;
+    nb_translate_exception();
+}
+
+/// Check if the overload resolution cache applies to the given arguments
+static NB_INLINE bool nb_func_cache_match(const nb_func_cache &c,
+                                          PyObject *const *args_in,
+                                          size_t nargs_in) noexcept {
+    if (c.nargs != nargs_in)
+        return false;
+
+    for (size_t i = 0; i < nargs_in; ++i) {
+        if (Py_TYPE(args_in[i]) != c.types[i])
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Record the overload that resolved a call in the cache
+ *
+ * The cache is only populated when all positional arguments are instances of
+ * bound types. Whether such an argument is accepted by an overload (in either
+ * pass) depends on its type and not on its value. A repeated call with the
+ * same argument types can therefore skip the overloads (and passes) that are
+ * known to have failed, while still producing the same overload resolution.
+ */
+static NB_NOINLINE void nb_func_cache_store(nb_func_cache &c,
+                                            PyObject *const *args_in,
+                                            size_t nargs_in, int pass,
+                                            size_t index) noexcept {
+    c.nargs = 0;
+
+    if (nargs_in == 0 || nargs_in > NB_MAXARGS_SIMPLE)
+        return;
+
+    for (size_t i = 0; i < nargs_in; ++i) {
+        PyTypeObject *tp = Py_TYPE(args_in[i]);
+        if (!nb_type_check((PyObject *) tp))
+            return;
+        c.types[i] = tp;
+    }
+
+    c.index = (uint32_t) index;
+    c.pass = (uint32_t) pass;
+    c.nargs = (uint32_t) nargs_in;
+}
+
 /// Dispatch loop that is used to invoke functions created by nb_func_new
 static PyObject *nb_func_vectorcall_complex(PyObject *self,
                                             PyObject *const *args_in,
@@ -482,6 +996,8 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
                  nkwargs_in = kwargs_in ? (size_t) NB_TUPLE_GET_SIZE(kwargs_in) : 0;
 
     func_data *fr = nb_func_data(self);
+    const func_key *keys = nb_func_keys(self, count);
+    deferred_check();
 
     const bool is_method      = fr->flags & (uint32_t) func_flags::is_method,
                is_constructor = fr->flags & (uint32_t) func_flags::is_constructor;
@@ -489,6 +1005,15 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
     PyObject *result = nullptr,
              *self_arg = (is_method && nargs_in > 0) ? args_in[0] : nullptr;
 
+    nb_func_profile *prof = ((nb_func *) self)->profile;
+    nb_profile_timer prof_timer(prof ? &prof->time_total : nullptr);
+    uint64_t prof_implicit = 0;
+    if (NB_UNLIKELY(prof)) {
+        nb_counter_add(prof->calls, 1);
+        prof_implicit = nb_counter_load(internals->implicit_count);
+    }
+    NB_PROBE(func_entry, self, (long) nargs_in);
+
     /* The following lines allocate memory on the stack, which is very efficient
        but also potentially dangerous since it can be used to generate stack
        overflows. We refuse unrealistically large number of 'kwargs' (the
@@ -513,6 +1038,30 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
     uint8_t *args_flags = (uint8_t *) alloca(max_nargs_pos * sizeof(uint8_t));
     bool *kwarg_used = (bool *) alloca(nkwargs_in * sizeof(bool));
 
+    /* Keyword names are usually interned strings, in which case a pointer
+       comparison against the interned 'arg_data::name_py' suffices. Other
+       keys (e.g. produced by **kwargs unpacking) are compared by value. */
+    bool kw_compare = false;
+    #if defined(PYPY_VERSION) || defined(Py_LIMITED_API)
+        kw_compare = nkwargs_in > 0;
+    #else
+        for (size_t j = 0; j < nkwargs_in; ++j)
+            kw_compare |= !PyUnicode_CHECK_INTERNED(NB_TUPLE_GET_ITEM(kwargs_in, j));
+    #endif
+
+    // Consult the overload resolution cache to skip known failures
+    nb_func_cache &cache = ((nb_func *) self)->cache;
+    int pass_start = (count > 1) ? 0 : 1;
+    size_t k_start = 0;
+    bool cache_hit = false,
+         cacheable = NB_FUNC_CACHE && count > 1 && !kwargs_in;
+
+    if (cacheable && nb_func_cache_match(cache, args_in, nargs_in)) {
+        pass_start = (int) cache.pass;
+        k_start = cache.index;
+        cache_hit = true;
+    }
+
     /*  The logic below tries to find a suitable overload using two passes
         of the overload chain (or 1, if there are no overloads). The first pass
         is strict and permits no implicit conversions, while the second pass
@@ -540,16 +1089,16 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
         until we get a result other than NB_NEXT_OVERLOAD.
     */
 
-    for (int pass = (count > 1) ? 0 : 1; pass < 2; ++pass) {
-        for (size_t k = 0; k < count; ++k) {
-            const func_data *f = fr + k;
+    for (int pass = pass_start; pass < 2; ++pass) {
+        for (size_t k = (pass == pass_start) ? k_start : 0; k < count; ++k) {
+            const func_key key = keys[k];
 
-            const bool has_args       = f->flags & (uint32_t) func_flags::has_args,
-                       has_var_args   = f->flags & (uint32_t) func_flags::has_var_args,
-                       has_var_kwargs = f->flags & (uint32_t) func_flags::has_var_kwargs;
+            const bool has_args       = key.flags & (uint32_t) func_flags::has_args,
+                       has_var_args   = key.flags & (uint32_t) func_flags::has_var_args,
+                       has_var_kwargs = key.flags & (uint32_t) func_flags::has_var_kwargs;
 
             /// Number of positional arguments
-            size_t nargs_pos = f->nargs - has_var_args - has_var_kwargs;
+            size_t nargs_pos = key.nargs - has_var_args - has_var_kwargs;
 
             if (nargs_in > nargs_pos && !has_var_args)
                 continue; // Too many positional arguments given for this overload
@@ -558,8 +1107,14 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
                 continue; // Not enough positional arguments, insufficient
                           // keyword/default arguments to fill in the blanks
 
+            const func_data *f = fr + k;
+
             memset(kwarg_used, 0, nkwargs_in * sizeof(bool));
 
+            /* Keyword search starts after the previous match, which makes the
+               common case of keywords given in declaration order cheap */
+            size_t kw_next = 0;
+
             // 1. Copy positional arguments, potentially substitute kwargs/defaults
             size_t i = 0;
             for (; i < nargs_pos; ++i) {
@@ -575,20 +1130,35 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
 
                     if (kwargs_in && ad.name_py) {
                         PyObject *hit = nullptr;
-                        for (size_t j = 0; j < nkwargs_in; ++j) {
-                            PyObject *key = NB_TUPLE_GET_ITEM(kwargs_in, j);
-                            #if defined(PYPY_VERSION)
-                                bool match = PyUnicode_Compare(key, ad.name_py) == 0;
-                            #else
-                                bool match = (key == ad.name_py);
-                            #endif
-                            if (match) {
-                                hit = args_in[nargs_in + j];
-                                kwarg_used[j] = true;
+                        size_t j = nkwargs_in;
+
+                        for (size_t l = 0; l < nkwargs_in; ++l) {
+                            size_t jl = kw_next + l;
+                            if (jl >= nkwargs_in)
+                                jl -= nkwargs_in;
+                            if (NB_TUPLE_GET_ITEM(kwargs_in, jl) == ad.name_py) {
+                                j = jl;
                                 break;
                             }
                         }
 
+                        if (j == nkwargs_in && kw_compare) {
+                            for (size_t l = 0; l < nkwargs_in; ++l) {
+                                PyObject *key = NB_TUPLE_GET_ITEM(kwargs_in, l);
+                                if (key != ad.name_py &&
+                                    PyUnicode_Compare(key, ad.name_py) == 0) {
+                                    j = l;
+                                    break;
+                                }
+                            }
+                        }
+
+                        if (j != nkwargs_in) {
+                            hit = args_in[nargs_in + j];
+                            kwarg_used[j] = true;
+                            kw_next = j + 1;
+                        }
+
                         if (hit) {
                             if (arg)
                                 break; // conflict between keyword and positional arg.
@@ -654,6 +1224,8 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
                 args_flags[0] = (uint8_t) cast_flags::construct;
 
             try {
+                nb_profile_timer prof_timer_impl(prof ? &prof->time_impl : nullptr);
+
                 // Found a suitable overload, let's try calling it
                 result = f->impl((void *) f->capture, args, args_flags,
                                  (rv_policy) (f->flags & 0b111), &cleanup);
@@ -667,14 +1239,16 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
                     result = nullptr;
                     goto done;
                 } else {
+                    // Value-dependent rejection, don't cache this resolution
                     result = NB_NEXT_OVERLOAD;
+                    cacheable = false;
                 }
             } catch (python_error &e) {
                 e.restore();
                 result = nullptr;
                 goto done;
             } catch (...) {
-                nb_func_convert_cpp_exception();
+                nb_func_convert_cpp_exception(self);
                 result = nullptr;
                 goto done;
             }
@@ -692,8 +1266,18 @@ static PyObject *nb_func_vectorcall_complex(PyObject *self,
                             ->set_weak_py(weak_py_ptr(self_arg_nb), self_arg);
                 }
 
+                if (cacheable && !(cache_hit && pass == pass_start && k == k_start))
+                    nb_func_cache_store(cache, args_in, nargs_in, pass, k);
+
+                if (NB_UNLIKELY(prof) && pass == 1 && count > 1)
+                    nb_counter_add(prof->convert_hits, 1);
+
                 goto done;
             }
+
+            if (NB_UNLIKELY(prof))
+                nb_counter_add(prof->overload_failures, 1);
+            NB_PROBE(overload_fail, self, (long) k);
         }
     }
 
@@ -703,22 +1287,42 @@ done:
     if (NB_UNLIKELY(cleanup.used()))
         cleanup.release();
 
+    if (NB_UNLIKELY(prof))
+        nb_counter_add(prof->implicit_hits,
+                       nb_counter_load(internals->implicit_count) - prof_implicit);
+
     if (NB_UNLIKELY(error_handler))
         result = error_handler(self, args_in, nargs_in, kwargs_in);
 
+    NB_PROBE(func_exit, self, result ? 1L : 0L);
+
     return result;
 }
 
-/// Simplified nb_func_vectorcall variant for functions w/o keyword arguments
+/// Simplified nb_func_vectorcall variant for calls w/o keyword arguments
 static PyObject *nb_func_vectorcall_simple(PyObject *self,
                                            PyObject *const *args_in,
                                            size_t nargsf,
                                            PyObject *kwargs_in) noexcept {
-    uint8_t args_flags[NB_MAXARGS_SIMPLE];
+    uint8_t args_flags_small[NB_MAXARGS_SIMPLE];
     func_data *fr = nb_func_data(self);
+    deferred_check();
 
     const size_t count         = (size_t) Py_SIZE(self),
                  nargs_in      = (size_t) NB_VECTORCALL_NARGS(nargsf);
+    const func_key *keys = nb_func_keys(self, count);
+
+    /* Keyword arguments and calls that may need default arguments are
+       handled by the complex dispatcher */
+    if (kwargs_in || (((nb_func *) self)->has_defaults &&
+                      nargs_in < ((nb_func *) self)->max_nargs_pos))
+        return nb_func_vectorcall_complex(self, args_in, nargsf, kwargs_in);
+
+    // Argument flags, functions with many parameters allocate them via alloca()
+    size_t max_nargs_pos = ((nb_func *) self)->max_nargs_pos;
+    uint8_t *args_flags = args_flags_small;
+    if (NB_UNLIKELY(max_nargs_pos > NB_MAXARGS_SIMPLE))
+        args_flags = (uint8_t *) alloca(max_nargs_pos * sizeof(uint8_t));
 
     const bool is_method      = fr->flags & (uint32_t) func_flags::is_method,
                is_constructor = fr->flags & (uint32_t) func_flags::is_constructor;
@@ -733,30 +1337,70 @@ static PyObject *nb_func_vectorcall_simple(PyObject *self,
     PyObject *(*error_handler)(PyObject *, PyObject *const *, size_t,
                                PyObject *) noexcept = nullptr;
 
-    bool fail = kwargs_in != nullptr;
+    nb_func_profile *prof = ((nb_func *) self)->profile;
+    nb_profile_timer prof_timer(prof ? &prof->time_total : nullptr);
+    uint64_t prof_implicit = 0;
+    if (NB_UNLIKELY(prof)) {
+        nb_counter_add(prof->calls, 1);
+        prof_implicit = nb_counter_load(internals->implicit_count);
+    }
+    NB_PROBE(func_entry, self, (long) nargs_in);
+
+    // Overload resolution cache (see nb_func_cache_store)
+    nb_func_cache &cache = ((nb_func *) self)->cache;
+    int pass_start = (count > 1) ? 0 : 1;
+    size_t k_start = 0;
+    bool cache_hit = false,
+         cacheable = NB_FUNC_CACHE && count > 1;
+
+    bool has_none = false;
     PyObject *none_ptr = Py_None;
     for (size_t i = 0; i < nargs_in; ++i)
-        fail |= args_in[i] == none_ptr;
+        has_none |= args_in[i] == none_ptr;
 
-    if (fail) { // keyword/None arguments unsupported in simple vectorcall
-        error_handler = nb_func_error_overload;
-        goto done;
+    if (cacheable && nb_func_cache_match(cache, args_in, nargs_in)) {
+        pass_start = (int) cache.pass;
+        k_start = cache.index;
+        cache_hit = true;
     }
 
-    for (int pass = (count > 1) ? 0 : 1; pass < 2; ++pass) {
-        for (int i = 0; i < NB_MAXARGS_SIMPLE; ++i)
-            args_flags[i] = (uint8_t) pass;
+    for (int pass = pass_start; pass < 2; ++pass) {
+        for (size_t k = (pass == pass_start) ? k_start : 0; k < count; ++k) {
+            const func_key key = keys[k];
 
-        if (is_constructor)
-            args_flags[0] = (uint8_t) cast_flags::construct;
+            if (nargs_in != key.nargs)
+                continue;
 
-        for (size_t k = 0; k < count; ++k) {
             const func_data *f = fr + k;
 
-            if (nargs_in != f->nargs)
-                continue;
+            if (key.flags & (uint32_t) func_flags::has_args) {
+                // Per-argument None/conversion flags from nb::arg()
+                size_t i = 0;
+                for (; i < nargs_in; ++i) {
+                    const arg_data &ad = f->args[i];
+                    if (args_in[i] == none_ptr && !ad.none)
+                        break;
+                    args_flags[i] = (pass && ad.convert)
+                                        ? (uint8_t) cast_flags::convert
+                                        : (uint8_t) 0;
+                }
+
+                if (i != nargs_in)
+                    continue;
+            } else {
+                if (has_none)
+                    continue;
+
+                for (size_t i = 0; i < nargs_in; ++i)
+                    args_flags[i] = (uint8_t) pass;
+            }
+
+            if (is_constructor)
+                args_flags[0] = (uint8_t) cast_flags::construct;
 
             try {
+                nb_profile_timer prof_timer_impl(prof ? &prof->time_impl : nullptr);
+
                 // Found a suitable overload, let's try calling it
                 result = f->impl((void *) f->capture, (PyObject **) args_in,
                                  args_flags, (rv_policy) (f->flags & 0b111),
@@ -771,14 +1415,16 @@ static PyObject *nb_func_vectorcall_simple(PyObject *self,
                     result = nullptr;
                     goto done;
                 } else {
+                    // Value-dependent rejection, don't cache this resolution
                     result = NB_NEXT_OVERLOAD;
+                    cacheable = false;
                 }
             } catch (python_error &e) {
                 e.restore();
                 result = nullptr;
                 goto done;
             } catch (...) {
-                nb_func_convert_cpp_exception();
+                nb_func_convert_cpp_exception(self);
                 result = nullptr;
                 goto done;
             }
@@ -796,8 +1442,18 @@ static PyObject *nb_func_vectorcall_simple(PyObject *self,
                             ->set_weak_py(weak_py_ptr(self_arg_nb), self_arg);
                 }
 
+                if (cacheable && !(cache_hit && pass == pass_start && k == k_start))
+                    nb_func_cache_store(cache, args_in, nargs_in, pass, k);
+
+                if (NB_UNLIKELY(prof) && pass == 1 && count > 1)
+                    nb_counter_add(prof->convert_hits, 1);
+
                 goto done;
             }
+
+            if (NB_UNLIKELY(prof))
+                nb_counter_add(prof->overload_failures, 1);
+            NB_PROBE(overload_fail, self, (long) k);
         }
     }
 
@@ -807,9 +1463,15 @@ done:
     if (NB_UNLIKELY(cleanup.used()))
         cleanup.release();
 
+    if (NB_UNLIKELY(prof))
+        nb_counter_add(prof->implicit_hits,
+                       nb_counter_load(internals->implicit_count) - prof_implicit);
+
     if (NB_UNLIKELY(error_handler))
         result = error_handler(self, args_in, nargs_in, kwargs_in);
 
+    NB_PROBE(func_exit, self, result ? 1L : 0L);
+
     return result;
 }
 
@@ -848,8 +1510,25 @@ PyObject *nb_method_descr_get(PyObject *self, PyObject *inst, PyObject *) {
            'CALL_METHOD' opcode and vector calls. Pytest rewrites the bytecode
            in a way that breaks this optimization :-/ */
 
-        nb_bound_method *mb =
-            PyObject_GC_New(nb_bound_method, internals->nb_bound_method);
+        nb_internals *internals_ = internals;
+        nb_bound_method *mb;
+
+#if NB_BOUND_METHOD_FREELIST > 0
+        mb = internals_->bound_method_freelist;
+        if (NB_LIKELY(mb)) {
+            internals_->bound_method_freelist = (nb_bound_method *) mb->self;
+            internals_->bound_method_freelist_size--;
+            PyObject_Init((PyObject *) mb, internals_->nb_bound_method);
+        } else {
+            mb = PyObject_GC_New(nb_bound_method, internals_->nb_bound_method);
+        }
+#else
+        mb = PyObject_GC_New(nb_bound_method, internals_->nb_bound_method);
+#endif
+
+        if (NB_UNLIKELY(!mb))
+            return nullptr;
+
         mb->func = (nb_func *) self;
         mb->self = inst;
         mb->vectorcall = nb_bound_method_vectorcall;
@@ -865,6 +1544,266 @@ PyObject *nb_method_descr_get(PyObject *self, PyObject *inst, PyObject *) {
 }
 
 
+void set_profiling(bool value) noexcept {
+    lock_internals guard(internals);
+    internals->profiling = value;
+
+    for (auto [f, p] : internals->funcs) {
+        nb_func *func = (nb_func *) f;
+        if (value && !func->profile) {
+            func->profile =
+                (nb_func_profile *) calloc(1, sizeof(nb_func_profile));
+            check(func->profile, "nanobind::detail::set_profiling(): "
+                                 "out of memory!");
+        } else if (!value) {
+            free(func->profile);
+            func->profile = nullptr;
+        }
+    }
+}
+
+void profiling_reset() noexcept {
+    lock_internals guard(internals);
+    for (auto [f, p] : internals->funcs) {
+        nb_func *func = (nb_func *) f;
+        if (func->profile)
+            memset(func->profile, 0, sizeof(nb_func_profile));
+    }
+}
+
+PyObject *profiling_snapshot() {
+    dict result;
+
+    for (auto [f, p] : internals->funcs) {
+        const nb_func_profile *prof = ((nb_func *) f)->profile;
+        if (!prof || !prof->calls)
+            continue;
+
+        dict entry;
+        entry["calls"] = prof->calls;
+        entry["overload_failures"] = prof->overload_failures;
+        entry["convert_hits"] = prof->convert_hits;
+        entry["implicit_hits"] = prof->implicit_hits;
+        entry["time_total"] = prof->time_total;
+        entry["time_impl"] = prof->time_impl;
+        result[handle((PyObject *) f)] = entry;
+    }
+
+    return result.release().ptr();
+}
+
+PyGILState_STATE gil_state_ensure(gil_site site, uint64_t *start) noexcept {
+    nb_internals *internals_ = internals;
+    if (NB_LIKELY(!internals_ ||
+                  !internals_->gil_profiling.load(std::memory_order_relaxed))) {
+        *start = 0;
+        return PyGILState_Ensure();
+    }
+
+    uint64_t before = nb_time_ns();
+    PyGILState_STATE state = PyGILState_Ensure();
+    uint64_t now = nb_time_ns(), wait = now - before;
+
+    size_t bucket = 0;
+    for (uint64_t w = wait; w && bucket < NB_GIL_HIST_SIZE - 1; w >>= 1)
+        bucket++;
+
+    nb_gil_profile &p = internals_->gil_profile[(size_t) site];
+    nb_counter_add(p.acquisitions, 1);
+    nb_counter_add(p.wait_time, wait);
+    nb_counter_add(p.wait_hist[bucket], 1);
+
+    *start = now;
+    return state;
+}
+
+void gil_state_release(gil_site site, PyGILState_STATE state,
+                       uint64_t start) noexcept {
+    if (NB_UNLIKELY(start))
+        nb_counter_add(internals->gil_profile[(size_t) site].hold_time,
+                       nb_time_ns() - start);
+    PyGILState_Release(state);
+}
+
+void set_gil_profiling(bool value) noexcept {
+    internals->gil_profiling.store(value, std::memory_order_relaxed);
+}
+
+void gil_profiling_reset() noexcept {
+    lock_internals guard(internals);
+    memset(internals->gil_profile, 0, sizeof(internals->gil_profile));
+}
+
+PyObject *gil_profiling_snapshot() {
+    static const char *site_names[] = { "gil_scoped_acquire", "trampoline",
+                                        "callback" };
+    dict result;
+
+    for (size_t i = 0; i < (size_t) gil_site::count; ++i) {
+        const nb_gil_profile &p = internals->gil_profile[i];
+        if (!nb_counter_load(p.acquisitions))
+            continue;
+
+        list hist;
+        for (size_t j = 0; j < NB_GIL_HIST_SIZE; ++j)
+            hist.append(nb_counter_load(p.wait_hist[j]));
+
+        dict entry;
+        entry["acquisitions"] = nb_counter_load(p.acquisitions);
+        entry["wait_time"] = nb_counter_load(p.wait_time);
+        entry["hold_time"] = nb_counter_load(p.hold_time);
+        entry["wait_histogram"] = hist;
+        result[site_names[i]] = entry;
+    }
+
+    return result.release().ptr();
+}
+
+/// Name under which registrations performed in 'scope' are reported
+static char *nb_reg_scope_name(PyObject *scope) noexcept {
+    if (!scope)
+        return strdup_check("");
+
+    PyObject *name;
+    if (PyModule_Check(scope))
+        name = PyModule_GetNameObject(scope);
+    else if (PyType_Check(scope))
+        name = nb_type_name(scope);
+    else
+        name = PyObject_Repr(scope);
+
+    const char *s = name ? PyUnicode_AsUTF8AndSize(name, nullptr) : nullptr;
+    char *result = strdup_check(s ? s : "<unknown>");
+    if (!s)
+        PyErr_Clear();
+    Py_XDECREF(name);
+    return result;
+}
+
+void nb_reg_record(PyObject *scope, nb_reg_kind kind, uint64_t start,
+                   size_t bytes) noexcept {
+    uint64_t time = nb_time_ns() - start;
+    char *name = nb_reg_scope_name(scope);
+
+    nb_internals *internals_ = internals;
+    lock_internals guard(internals_);
+    nb_reg_map &reg_stats = internals_->reg_stats;
+    nb_reg_map::iterator it = reg_stats.find(name);
+
+    nb_reg_stats *stats;
+    if (it == reg_stats.end()) {
+        stats = (nb_reg_stats *) calloc(1, sizeof(nb_reg_stats));
+        check(stats, "nanobind::detail::nb_reg_record(): out of memory!");
+        stats->name = name;
+        reg_stats.try_emplace(stats->name, stats);
+    } else {
+        stats = it->second;
+        free(name);
+    }
+
+    switch (kind) {
+        case nb_reg_kind::type: stats->types++; break;
+        case nb_reg_kind::function: stats->functions++; break;
+        case nb_reg_kind::enum_value: stats->enum_values++; break;
+    }
+
+    stats->time += time;
+    stats->bytes += bytes;
+}
+
+PyObject *registration_stats() {
+    // Copy the counters first, the dictionary can't be built with the lock held
+    nb_reg_stats *entries;
+    size_t size = 0;
+    {
+        lock_internals guard(internals);
+        nb_reg_map &reg_stats = internals->reg_stats;
+        entries = (nb_reg_stats *) malloc(sizeof(nb_reg_stats) *
+                                          (reg_stats.size() + 1));
+        check(entries, "nanobind::detail::registration_stats(): out of memory!");
+        for (auto [name, stats] : reg_stats)
+            entries[size++] = *stats;
+    }
+
+    // Entry names remain valid, they are never freed before shutdown
+    dict result;
+    try {
+        for (size_t i = 0; i < size; ++i) {
+            const nb_reg_stats &s = entries[i];
+            dict value;
+            value["types"] = s.types;
+            value["functions"] = s.functions;
+            value["enum_values"] = s.enum_values;
+            value["time"] = s.time;
+            value["bytes"] = s.bytes;
+            if (s.name[0])
+                result[s.name] = value;
+            else
+                result[none()] = value;
+        }
+    } catch (...) {
+        free(entries);
+        throw;
+    }
+
+    free(entries);
+    return result.release().ptr();
+}
+
+/// Python interface of the profiler, installed in the internal nanobind module
+PyObject *nb_module_set_profiling(PyObject *, PyObject *arg) {
+    int value = PyObject_IsTrue(arg);
+    if (value < 0)
+        return nullptr;
+    set_profiling(value != 0);
+    Py_RETURN_NONE;
+}
+
+PyObject *nb_module_profiling_reset(PyObject *, PyObject *) {
+    profiling_reset();
+    Py_RETURN_NONE;
+}
+
+PyObject *nb_module_profiling_snapshot(PyObject *, PyObject *) {
+    try {
+        return profiling_snapshot();
+    } catch (python_error &e) {
+        e.restore();
+        return nullptr;
+    }
+}
+
+PyObject *nb_module_set_gil_profiling(PyObject *, PyObject *arg) {
+    int value = PyObject_IsTrue(arg);
+    if (value < 0)
+        return nullptr;
+    set_gil_profiling(value != 0);
+    Py_RETURN_NONE;
+}
+
+PyObject *nb_module_gil_profiling_reset(PyObject *, PyObject *) {
+    gil_profiling_reset();
+    Py_RETURN_NONE;
+}
+
+PyObject *nb_module_gil_profiling_snapshot(PyObject *, PyObject *) {
+    try {
+        return gil_profiling_snapshot();
+    } catch (python_error &e) {
+        e.restore();
+        return nullptr;
+    }
+}
+
+PyObject *nb_module_registration_stats(PyObject *, PyObject *) {
+    try {
+        return registration_stats();
+    } catch (python_error &e) {
+        e.restore();
+        return nullptr;
+    }
+}
+
 /// Render the function signature of a single function
 static void nb_func_render_signature(const func_data *f) noexcept {
     const bool is_method      = f->flags & (uint32_t) func_flags::is_method,
@@ -872,7 +1811,7 @@ static void nb_func_render_signature(const func_data *f) noexcept {
                has_var_args   = f->flags & (uint32_t) func_flags::has_var_args,
                has_var_kwargs = f->flags & (uint32_t) func_flags::has_var_kwargs;
 
-    const std::type_info **descr_type = f->descr_types;
+    const std::type_info *const *descr_type = f->descr_types;
 
     uint32_t arg_index = 0;
     buf.put_dstr(f->name);
@@ -969,10 +1908,16 @@ static void nb_func_render_signature(const func_data *f) noexcept {
                       "nb::detail::nb_func_render_signature(): missing type!");
 
                 if (!(is_method && arg_index == 0)) {
-                    auto it = internals->type_c2p_slow.find(*descr_type);
+                    PyTypeObject *type_py = nullptr;
+                    {
+                        lock_internals guard(internals);
+                        auto it = internals->type_c2p_slow.find(*descr_type);
+                        if (it != internals->type_c2p_slow.end() && it->second)
+                            type_py = it->second->type_py;
+                    }
 
-                    if (it != internals->type_c2p_slow.end()) {
-                        handle th((PyObject *) it->second->type_py);
+                    if (type_py) {
+                        handle th((PyObject *) type_py);
                         buf.put_dstr((borrow<str>(th.attr("__module__"))).c_str());
                         buf.put('.');
                         buf.put_dstr((borrow<str>(th.attr("__qualname__"))).c_str());
@@ -0,0 +1,209 @@
+/*
+    src/nb_future.cpp: asyncio futures that are resolved by C++ code
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include "nb_internals.h"
+#include <mutex>
+#include <vector>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/* Completed computations are queued per event loop. Only the computation that
+   turns an empty queue into a non-empty one acquires the GIL to schedule a
+   'future_drain' callback via loop.call_soon_threadsafe(). Further completions
+   that arrive before the callback runs are batched and don't touch the GIL. */
+struct future_queue {
+    PyObject *loop;
+    future_state *head;
+};
+
+static std::mutex future_mutex;
+static std::vector<future_queue> future_queues;
+
+/// Remove and return the queue of completed computations of 'loop'
+static future_state *future_take(PyObject *loop) noexcept {
+    std::lock_guard<std::mutex> guard(future_mutex);
+
+    for (size_t i = 0; i < future_queues.size(); ++i) {
+        if (future_queues[i].loop == loop) {
+            future_state *head = future_queues[i].head;
+            future_queues[i] = future_queues.back();
+            future_queues.pop_back();
+
+            // Reverse to process entries in order of completion
+            future_state *prev = nullptr;
+            while (head) {
+                future_state *next = head->next;
+                head->next = prev;
+                prev = head;
+                head = next;
+            }
+            return prev;
+        }
+    }
+
+    return nullptr;
+}
+
+static void future_release(future_state *s) noexcept {
+    PyObject *loop = s->loop, *future = s->future;
+    s->release(s);
+    Py_DECREF(future);
+    Py_DECREF(loop);
+}
+
+static void future_resolve(future_state *s) noexcept {
+    PyObject *cancelled = PyObject_CallMethod(s->future, "cancelled", nullptr);
+    if (!cancelled) {
+        PyErr_WriteUnraisable(s->future);
+        return;
+    }
+
+    bool skip = cancelled == Py_True;
+    Py_DECREF(cancelled);
+    if (skip)
+        return;
+
+    PyObject *value = nullptr;
+    try {
+        value = s->resolve(s);
+    } catch (...) {
+        nb_translate_exception();
+    }
+
+    PyObject *result;
+    if (value) {
+        result = PyObject_CallMethod(s->future, "set_result", "O", value);
+        Py_DECREF(value);
+    } else {
+        if (!PyErr_Occurred())
+            PyErr_SetString(PyExc_TypeError,
+                            "nanobind::detail::future_resolve(): unable to "
+                            "convert the result to Python!");
+
+#if PY_VERSION_HEX >= 0x030C0000
+        PyObject *exc = PyErr_GetRaisedException();
+#else
+        PyObject *type, *exc, *trace;
+        PyErr_Fetch(&type, &exc, &trace);
+        PyErr_NormalizeException(&type, &exc, &trace);
+        if (trace) {
+            PyException_SetTraceback(exc, trace);
+            Py_DECREF(trace);
+        }
+        Py_DECREF(type);
+#endif
+
+        result = PyObject_CallMethod(s->future, "set_exception", "O", exc);
+        Py_DECREF(exc);
+    }
+
+    if (result)
+        Py_DECREF(result);
+    else
+        PyErr_WriteUnraisable(s->future);
+}
+
+static PyObject *future_drain(PyObject *, PyObject *loop) {
+    future_state *s = future_take(loop);
+
+    while (s) {
+        future_state *next = s->next;
+        future_resolve(s);
+        future_release(s);
+        s = next;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef future_drain_def = {
+    "_future_drain", (PyCFunction) future_drain, METH_O, nullptr
+};
+
+PyObject *future_create(future_state *s) noexcept {
+    nb_internals *internals_ = internals;
+
+    if (!internals_->future_drain) {
+        internals_->future_drain = PyCFunction_New(&future_drain_def, nullptr);
+        if (!internals_->future_drain)
+            return nullptr;
+    }
+
+    PyObject *asyncio = PyImport_ImportModule("asyncio");
+    if (!asyncio)
+        return nullptr;
+
+    PyObject *loop = PyObject_CallMethod(asyncio, "get_running_loop", nullptr);
+    Py_DECREF(asyncio);
+    if (!loop)
+        return nullptr;
+
+    PyObject *future = PyObject_CallMethod(loop, "create_future", nullptr);
+    if (!future) {
+        Py_DECREF(loop);
+        return nullptr;
+    }
+
+    s->loop = loop;
+    s->future = future;
+    s->next = nullptr;
+
+    Py_INCREF(future);
+    return future;
+}
+
+void future_complete(future_state *s) noexcept {
+    PyObject *loop = s->loop;
+    bool schedule = true;
+
+    {
+        std::lock_guard<std::mutex> guard(future_mutex);
+
+        for (future_queue &q : future_queues) {
+            if (q.loop == loop) {
+                s->next = q.head;
+                q.head = s;
+                schedule = false;
+                break;
+            }
+        }
+
+        if (schedule) {
+            s->next = nullptr;
+            future_queues.push_back(future_queue{ loop, s });
+        }
+    }
+
+    if (!schedule)
+        return;
+
+    /* No drain callback is pending for this loop, hence 's' (and the reference
+       to 'loop' that it holds) remain valid until the callback below runs. */
+    gil_scoped_acquire guard;
+
+    PyObject *result = PyObject_CallMethod(
+        loop, "call_soon_threadsafe", "OO", internals->future_drain, loop);
+
+    if (result) {
+        Py_DECREF(result);
+    } else {
+        // The event loop was likely closed, discard the pending computations
+        PyErr_WriteUnraisable(loop);
+        s = future_take(loop);
+        while (s) {
+            future_state *next = s->next;
+            future_release(s);
+            s = next;
+        }
+    }
+}
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
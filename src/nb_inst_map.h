@@ -0,0 +1,329 @@
+/*
+    src/nb_inst_map.h: hash table mapping C++ instance addresses to Python
+    instances (internals->inst_c2p)
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "hash.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define NB_INST_MAP_SSE2
+#endif
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/**
+ * Open addressing hash table in the style of a Swiss table: slots are
+ * organized in aligned groups of 16, and each slot has a control byte that
+ * either marks it as empty/deleted, or stores 7 bits of the key's hash. A
+ * lookup compares all control bytes of a group at once (using SSE2 when
+ * available) and only inspects keys whose hash bits match. Each entry costs
+ * 17 bytes at a maximum load factor of 7/8.
+ *
+ * This map can grow to tens of millions of entries. To avoid long pauses, it
+ * never rehashes all entries at once: growing allocates a new table, and
+ * subsequent insertions and deletions migrate a few groups of the old table
+ * at a time. Lookups check both tables until the migration is complete.
+ *
+ * Iterators are invalidated by insertions and deletions.
+ */
+class nb_inst_map {
+public:
+    struct entry {
+        void *first;
+        void *second;
+    };
+
+private:
+    static constexpr uint8_t ctrl_empty = 0x80;
+    static constexpr uint8_t ctrl_deleted = 0xFE;
+    static constexpr size_t group_size = 16;
+
+    /// Number of old groups migrated by each insertion/deletion
+    static constexpr size_t migrate_groups = 2;
+
+    struct table {
+        uint8_t *ctrl = nullptr;
+        entry *entries = nullptr;
+        size_t capacity = 0; // power of two, at least 'group_size'
+        size_t used = 0;     // number of non-empty (full + deleted) slots
+    };
+
+public:
+    class iterator {
+    public:
+        iterator() = default;
+        iterator(const nb_inst_map *m, const table *t, size_t i)
+            : m(m), t(t), i(i) { }
+
+        entry &operator*() const { return t->entries[i]; }
+        entry *operator->() const { return t->entries + i; }
+        void *&value() const { return t->entries[i].second; }
+
+        bool operator==(const iterator &o) const { return t == o.t && i == o.i; }
+        bool operator!=(const iterator &o) const { return !operator==(o); }
+
+        iterator &operator++() {
+            i++;
+            while (t) {
+                for (; i < t->capacity; ++i) {
+                    if (is_full(t->ctrl[i]))
+                        return *this;
+                }
+
+                t = t == &m->cur && m->old.capacity ? &m->old : nullptr;
+                i = 0;
+            }
+            return *this;
+        }
+
+    private:
+        friend class nb_inst_map;
+        const nb_inst_map *m = nullptr;
+        const table *t = nullptr;
+        size_t i = 0;
+    };
+
+    nb_inst_map() = default;
+    nb_inst_map(const nb_inst_map &) = delete;
+    nb_inst_map &operator=(const nb_inst_map &) = delete;
+
+    ~nb_inst_map() {
+        release(cur);
+        release(old);
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    iterator end() const { return iterator(); }
+
+    iterator begin() const {
+        const table *t = cur.capacity ? &cur : nullptr;
+        iterator it(this, t, 0);
+        if (t && !is_full(t->ctrl[0]))
+            ++it;
+        return it;
+    }
+
+    iterator find(const void *key) const {
+        size_t h = hash(key), index;
+
+        if (NB_LIKELY(lookup(cur, key, h, index)))
+            return iterator(this, &cur, index);
+
+        if (NB_UNLIKELY(old.capacity) && lookup(old, key, h, index))
+            return iterator(this, &old, index);
+
+        return end();
+    }
+
+    std::pair<iterator, bool> try_emplace(void *key, void *value) {
+        if (NB_UNLIKELY(old.capacity))
+            migrate(migrate_groups);
+
+        iterator it = find(key);
+        if (it != end())
+            return { it, false };
+
+        // Keep the load factor (including deleted slots) below 7/8
+        if (NB_UNLIKELY((cur.used + 1) * 8 > cur.capacity * 7))
+            grow();
+
+        size_t index = insert(cur, key, value, hash(key));
+        m_size++;
+
+        return { iterator(this, &cur, index), true };
+    }
+
+    void erase(iterator it) {
+        table &t = it.t == &cur ? cur : old;
+        size_t index = it.i, group = index & ~(group_size - 1);
+
+        /* A probe sequence never continues past a group with an empty slot,
+           in which case the slot can be marked empty instead of deleted */
+        if (match(t.ctrl + group, ctrl_empty)) {
+            t.ctrl[index] = ctrl_empty;
+            t.used--;
+        } else {
+            t.ctrl[index] = ctrl_deleted;
+        }
+
+        m_size--;
+
+        if (NB_UNLIKELY(old.capacity))
+            migrate(migrate_groups);
+    }
+
+private:
+    static size_t hash(const void *p) {
+        if constexpr (sizeof(void *) == 4)
+            return (size_t) fmix32((uint32_t) (uintptr_t) p);
+        else
+            return (size_t) fmix64((uint64_t) (uintptr_t) p);
+    }
+
+    static bool is_full(uint8_t c) { return (c & 0x80) == 0; }
+
+    static uint32_t ctz(uint32_t v) {
+#if defined(_MSC_VER)
+        unsigned long i;
+        _BitScanForward(&i, v);
+        return (uint32_t) i;
+#else
+        return (uint32_t) __builtin_ctz(v);
+#endif
+    }
+
+    /// Bit mask of the slots in a group whose control byte equals 'value'
+    static uint32_t match(const uint8_t *group, uint8_t value) {
+#if defined(NB_INST_MAP_SSE2)
+        __m128i ctrl = _mm_loadu_si128((const __m128i *) group);
+        return (uint32_t) _mm_movemask_epi8(
+            _mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char) value)));
+#else
+        uint32_t result = 0;
+        for (size_t i = 0; i < group_size; ++i)
+            result |= (uint32_t) (group[i] == value) << i;
+        return result;
+#endif
+    }
+
+    /// Bit mask of the empty or deleted slots in a group
+    static uint32_t match_free(const uint8_t *group) {
+#if defined(NB_INST_MAP_SSE2)
+        return (uint32_t) _mm_movemask_epi8(
+            _mm_loadu_si128((const __m128i *) group));
+#else
+        uint32_t result = 0;
+        for (size_t i = 0; i < group_size; ++i)
+            result |= (uint32_t) (group[i] >> 7) << i;
+        return result;
+#endif
+    }
+
+    /* Groups are visited in triangular order (g, g+1, g+3, g+6, ..), which
+       covers all groups when their count is a power of two */
+    static bool lookup(const table &t, const void *key, size_t h,
+                       size_t &index) {
+        if (!t.capacity)
+            return false;
+
+        size_t gmask = t.capacity / group_size - 1,
+               g = (h >> 7) & gmask;
+        uint8_t h2 = (uint8_t) (h & 0x7F);
+
+        for (size_t step = 1; ; ++step) {
+            const uint8_t *ctrl = t.ctrl + g * group_size;
+
+            for (uint32_t m = match(ctrl, h2); m; m &= m - 1) {
+                size_t i = g * group_size + ctz(m);
+                if (NB_LIKELY(t.entries[i].first == key)) {
+                    index = i;
+                    return true;
+                }
+            }
+
+            if (NB_LIKELY(match(ctrl, ctrl_empty)))
+                return false;
+
+            g = (g + step) & gmask;
+        }
+    }
+
+    /// Insert a key that is known not to be present
+    static size_t insert(table &t, void *key, void *value, size_t h) {
+        size_t gmask = t.capacity / group_size - 1,
+               g = (h >> 7) & gmask;
+
+        for (size_t step = 1; ; ++step) {
+            uint8_t *ctrl = t.ctrl + g * group_size;
+            uint32_t m = match_free(ctrl);
+
+            if (m) {
+                size_t i = g * group_size + ctz(m);
+                if (t.ctrl[i] == ctrl_empty)
+                    t.used++;
+                t.ctrl[i] = (uint8_t) (h & 0x7F);
+                t.entries[i] = entry{ key, value };
+                return i;
+            }
+
+            g = (g + step) & gmask;
+        }
+    }
+
+    static void release(table &t) {
+        free(t.ctrl);
+        free(t.entries);
+        t = table();
+    }
+
+    NB_NOINLINE void grow() {
+        // Finish an ongoing migration first (rarely needed)
+        if (old.capacity)
+            migrate((size_t) -1);
+
+        size_t capacity = cur.capacity;
+        if (capacity == 0)
+            capacity = 64;
+        else if (m_size * 2 >= capacity)
+            capacity *= 2; // otherwise, only compact deleted slots
+
+        table t;
+        t.ctrl = (uint8_t *) malloc(capacity);
+        t.entries = (entry *) malloc(capacity * sizeof(entry));
+        if (!t.ctrl || !t.entries)
+            fail("nanobind::detail::nb_inst_map::grow(): out of memory!");
+        memset(t.ctrl, ctrl_empty, capacity);
+        t.capacity = capacity;
+
+        old = cur;
+        cur = t;
+        m_migrate_pos = 0;
+
+        if (!old.capacity)
+            release(old);
+    }
+
+    /// Move the entries of up to 'groups' groups from the old to the new table
+    NB_NOINLINE void migrate(size_t groups) {
+        size_t end = old.capacity;
+        if (groups < (end - m_migrate_pos) / group_size)
+            end = m_migrate_pos + groups * group_size;
+
+        for (size_t i = m_migrate_pos; i < end; ++i) {
+            if (is_full(old.ctrl[i])) {
+                entry &e = old.entries[i];
+                insert(cur, e.first, e.second, hash(e.first));
+                old.ctrl[i] = ctrl_deleted;
+            }
+        }
+
+        m_migrate_pos = end;
+        if (end == old.capacity)
+            release(old);
+    }
+
+    table cur, old;
+    size_t m_size = 0;
+    size_t m_migrate_pos = 0;
+};
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
@@ -11,13 +11,17 @@
 #include <structmember.h>
 #include "nb_internals.h"
 
+#if defined(NB_FREE_THREADED)
+#  include <thread>
+#endif
+
 #if defined(__GNUC__) && !defined(__clang__)
 #  pragma GCC diagnostic ignored "-Wmissing-field-initializers"
 #endif
 
 /// Tracks the ABI of nanobind
 #ifndef NB_INTERNALS_VERSION
-#  define NB_INTERNALS_VERSION 12
+#  define NB_INTERNALS_VERSION 14
 #endif
 
 /// On MSVC, debug and release builds are not ABI-compatible!
@@ -72,9 +76,31 @@
 #  define NB_STABLE_ABI ""
 #endif
 
+// Free-threaded and regular extensions use different internals data structures
+#if defined(NB_FREE_THREADED)
+#  define NB_FREE_THREADED_ABI "_ft"
+#else
+#  define NB_FREE_THREADED_ABI ""
+#endif
+
+// Per-interpreter internals are released differently, keep them apart as well
+#if defined(NB_SUBINTERPRETERS)
+#  define NB_SUBINTERPRETERS_ABI "_si"
+#else
+#  define NB_SUBINTERPRETERS_ABI ""
+#endif
+
+// Instance accounting changes the layout of 'type_data'
+#if defined(NB_TYPE_STATS)
+#  define NB_TYPE_STATS_ABI "_stats"
+#else
+#  define NB_TYPE_STATS_ABI ""
+#endif
+
 #define NB_INTERNALS_ID                                                        \
     "v" NB_TOSTRING(NB_INTERNALS_VERSION)                                      \
-        NB_COMPILER_TYPE NB_STDLIB NB_BUILD_ABI NB_BUILD_TYPE NB_STABLE_ABI
+        NB_COMPILER_TYPE NB_STDLIB NB_BUILD_ABI NB_BUILD_TYPE NB_STABLE_ABI    \
+        NB_FREE_THREADED_ABI NB_SUBINTERPRETERS_ABI NB_TYPE_STATS_ABI
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
@@ -89,6 +115,14 @@ extern int nb_bound_method_traverse(PyObject *, visitproc, void *);
 extern int nb_bound_method_clear(PyObject *);
 extern void nb_bound_method_dealloc(PyObject *);
 extern PyObject *nb_method_descr_get(PyObject *, PyObject *, PyObject *);
+extern PyObject *nb_module_set_profiling(PyObject *, PyObject *);
+extern PyObject *nb_module_profiling_reset(PyObject *, PyObject *);
+extern PyObject *nb_module_profiling_snapshot(PyObject *, PyObject *);
+extern PyObject *nb_module_set_gil_profiling(PyObject *, PyObject *);
+extern PyObject *nb_module_gil_profiling_reset(PyObject *, PyObject *);
+extern PyObject *nb_module_gil_profiling_snapshot(PyObject *, PyObject *);
+extern PyObject *nb_module_type_stats(PyObject *, PyObject *);
+extern PyObject *nb_module_registration_stats(PyObject *, PyObject *);
 
 #if PY_VERSION_HEX >= 0x03090000
 #  define NB_HAVE_VECTORCALL_PY39_OR_NEWER NB_HAVE_VECTORCALL
@@ -195,6 +229,26 @@ static PyType_Spec nb_bound_method_spec = {
     /* .slots = */ nb_bound_method_slots
 };
 
+static PyMethodDef nb_module_methods[] = {
+    { "set_profiling", nb_module_set_profiling, METH_O,
+      "Enable or disable the function call profiler." },
+    { "profiling_reset", nb_module_profiling_reset, METH_NOARGS,
+      "Reset the counters of the function call profiler." },
+    { "profiling_snapshot", nb_module_profiling_snapshot, METH_NOARGS,
+      "Return a dictionary mapping functions to their profiling counters." },
+    { "set_gil_profiling", nb_module_set_gil_profiling, METH_O,
+      "Enable or disable the GIL acquisition profiler." },
+    { "gil_profiling_reset", nb_module_gil_profiling_reset, METH_NOARGS,
+      "Reset the counters of the GIL acquisition profiler." },
+    { "gil_profiling_snapshot", nb_module_gil_profiling_snapshot, METH_NOARGS,
+      "Return a dictionary mapping call sites to their GIL wait and hold times." },
+    { "type_stats", nb_module_type_stats, METH_NOARGS,
+      "Return a dictionary mapping bound types to their instance counters." },
+    { "registration_stats", nb_module_registration_stats, METH_NOARGS,
+      "Return a dictionary mapping scopes to the cost of their registrations." },
+    { nullptr, nullptr, 0, nullptr }
+};
+
 void default_exception_translator(const std::exception_ptr &p, void *) {
     try {
         std::rethrow_exception(p);
@@ -217,43 +271,85 @@ void default_exception_translator(const std::exception_ptr &p, void *) {
     }
 }
 
+#if defined(NB_SUBINTERPRETERS)
+NB_THREAD_LOCAL nb_internals_cache internals_cache { nullptr, nullptr };
+
+/// Key of the internals capsule in the interpreter state dictionary
+static char internals_key[128];
+
+nb_internals *internals_fetch() noexcept {
+    PyInterpreterState *interp = PyInterpreterState_Get();
+    PyObject *dict = PyInterpreterState_GetDict(interp), *capsule = nullptr;
+    if (dict)
+        capsule = PyDict_GetItemString(dict, internals_key);
+
+    nb_internals *p = nullptr;
+    if (capsule)
+        p = (nb_internals *) PyCapsule_GetPointer(capsule, "nb_internals");
+
+    // Don't cache failed lookups, the internals may not be created yet
+    internals_cache = nb_internals_cache{ p ? interp : nullptr, p };
+    return p;
+}
+#else
 nb_internals *internals = nullptr;
 PyTypeObject *nb_meta_cache = nullptr;
+#endif
 
+/* With NB_SUBINTERPRETERS, this flag tracks the state of the main
+   interpreter. Sub-interpreters don't set 'nb_internals::is_alive_ptr'. */
 static bool is_alive_value = false;
 static bool *is_alive_ptr = &is_alive_value;
 bool is_alive() noexcept { return *is_alive_ptr; }
 
-static void internals_cleanup() {
-    if (!internals)
-        return;
+/// Make 'p' the internals of the current interpreter
+static void internals_activate(nb_internals *p) {
+#if defined(NB_SUBINTERPRETERS)
+    internals_cache = nb_internals_cache{ PyInterpreterState_Get(), p };
+#else
+    internals = p;
+    nb_meta_cache = p->nb_meta;
+#endif
+    if (p->is_alive_ptr)
+        is_alive_ptr = p->is_alive_ptr;
+}
 
-    *is_alive_ptr = false;
+/// Check for leaks and free 'p' unless there were any
+static bool internals_release(nb_internals *p) {
+    if (p->is_alive_ptr)
+        *p->is_alive_ptr = false;
 
 #if !defined(PYPY_VERSION)
     /* The memory leak checker is unsupported on PyPy, see
        see https://foss.heptapod.net/pypy/pypy/-/issues/3855 */
 
-    bool leak = false, print_leak_warnings = internals->print_leak_warnings;
+    bool leak = false, print_leak_warnings = p->print_leak_warnings;
 
-    if (!internals->inst_c2p.empty()) {
+    size_t inst_leaks = 0, keep_alive_leaks = 0;
+    for (size_t i = 0; i < p->shard_count; ++i) {
+        inst_leaks += p->shards[i].inst_c2p.size();
+        keep_alive_leaks += p->shards[i].keep_alive.size();
+    }
+
+    if (inst_leaks) {
         if (print_leak_warnings) {
-            fprintf(stderr, "nanobind: leaked %zu instances!\n",
-                    internals->inst_c2p.size());
+            fprintf(stderr, "nanobind: leaked %zu instances!\n", inst_leaks);
             #if !defined(Py_LIMITED_API)
-                for (auto [k, v]: internals->inst_c2p) {
-                    PyTypeObject *tp = Py_TYPE(v);
-                    fprintf(stderr, " - leaked instance %p of type \"%s\"\n", k, tp->tp_name);
+                for (size_t i = 0; i < p->shard_count; ++i) {
+                    for (auto [k, v]: p->shards[i].inst_c2p) {
+                        PyTypeObject *tp = Py_TYPE(v);
+                        fprintf(stderr, " - leaked instance %p of type \"%s\"\n", k, tp->tp_name);
+                    }
                 }
             #endif
         }
         leak = true;
     }
 
-    if (!internals->keep_alive.empty()) {
+    if (keep_alive_leaks) {
         if (print_leak_warnings) {
             fprintf(stderr, "nanobind: leaked %zu keep_alive records!\n",
-                    internals->keep_alive.size());
+                    keep_alive_leaks);
         }
         leak = true;
     }
@@ -262,13 +358,13 @@ static void internals_cleanup() {
     if (!leak)
         print_leak_warnings = false;
 
-    if (!internals->type_c2p_slow.empty() ||
-        !internals->type_c2p_fast.empty()) {
+    if (!p->type_c2p_slow.empty() ||
+        !p->type_c2p_fast.empty()) {
         if (print_leak_warnings) {
             fprintf(stderr, "nanobind: leaked %zu types!\n",
-                    internals->type_c2p_slow.size());
+                    p->type_c2p_slow.size());
             int ctr = 0;
-            for (const auto &kv : internals->type_c2p_slow) {
+            for (const auto &kv : p->type_c2p_slow) {
                 fprintf(stderr, " - leaked type \"%s\"\n", kv.second->name);
                 if (ctr++ == 10) {
                     fprintf(stderr, " - ... skipped remainder\n");
@@ -279,12 +375,12 @@ static void internals_cleanup() {
         leak = true;
     }
 
-    if (!internals->funcs.empty()) {
+    if (!p->funcs.empty()) {
         if (print_leak_warnings) {
             fprintf(stderr, "nanobind: leaked %zu functions!\n",
-                    internals->funcs.size());
+                    p->funcs.size());
             int ctr = 0;
-            for (auto [f, p] : internals->funcs) {
+            for (auto [f, unused] : p->funcs) {
                 fprintf(stderr, " - leaked function \"%s\"\n",
                         nb_func_data(f)->name);
                 if (ctr++ == 10) {
@@ -297,9 +393,15 @@ static void internals_cleanup() {
     }
 
     if (!leak) {
-        delete internals;
-        internals = nullptr;
-        nb_meta_cache = nullptr;
+#if defined(NB_FREE_THREADED)
+        delete[] p->shards;
+#endif
+        for (auto [name, stats] : p->reg_stats) {
+            free(stats->name);
+            free(stats);
+        }
+        delete p;
+        return true;
     } else {
         if (print_leak_warnings) {
             fprintf(stderr, "nanobind: this is likely caused by a reference "
@@ -311,11 +413,60 @@ static void internals_cleanup() {
         #endif
     }
 #endif
+    return false;
+}
+
+#if defined(NB_SUBINTERPRETERS)
+static void internals_capsule_free(PyObject *capsule) {
+    nb_internals *p =
+        (nb_internals *) PyCapsule_GetPointer(capsule, "nb_internals");
+    if (internals_cache.ptr == p)
+        internals_cache = nb_internals_cache{ nullptr, nullptr };
+    if (!p)
+        return;
+
+    // The interpreter is still alive, release cached framework objects
+    Py_CLEAR(p->ndarray_dlpack_str);
+    Py_CLEAR(p->ndarray_dlpack_kwargs);
+    Py_CLEAR(p->ndarray_copy_kwnames);
+    for (PyObject *&o : p->ndarray_to_dlpack)
+        Py_CLEAR(o);
+    for (PyObject *&o : p->ndarray_from_dlpack)
+        Py_CLEAR(o);
+    for (PyObject *&o : p->scipy_sparse_types)
+        Py_CLEAR(o);
+    nb_bound_method_freelist_clear(p);
+
+    internals_release(p);
+}
+#else
+static void internals_cleanup() {
+    if (!internals)
+        return;
+
+    if (internals_release(internals)) {
+        internals = nullptr;
+        nb_meta_cache = nullptr;
+    }
 }
+#endif
 
 NB_NOINLINE void init(const char *name) {
+#if defined(Py_LIMITED_API)
+    seq_layout_init();
+#endif
+
+#if defined(NB_SUBINTERPRETERS)
+    snprintf(internals_key, sizeof(internals_key), "__nb_internals_%s_%s__",
+             NB_INTERNALS_ID, name ? name : "");
+    if (nb_internals *p = internals_fetch(); p) {
+        internals_activate(p);
+        return;
+    }
+#else
     if (internals)
         return;
+#endif
 
 #if defined(PYPY_VERSION)
     PyObject *dict = PyEval_GetBuiltins();
@@ -333,28 +484,44 @@ NB_NOINLINE void init(const char *name) {
     PyObject *capsule = PyDict_GetItem(dict, key);
     if (capsule) {
         Py_DECREF(key);
-        internals = (nb_internals *) PyCapsule_GetPointer(capsule, "nb_internals");
-        check(internals,
-              "nanobind::detail::internals_fetch(): capsule pointer is NULL!");
-        nb_meta_cache = internals->nb_meta;
-        is_alive_ptr = internals->is_alive_ptr;
+        nb_internals *p =
+            (nb_internals *) PyCapsule_GetPointer(capsule, "nb_internals");
+        check(p, "nanobind::detail::internals_fetch(): capsule pointer is NULL!");
+        internals_activate(p);
         return;
     }
 
     nb_internals *p = new nb_internals();
 
+#if defined(NB_FREE_THREADED)
+    /* Use a power-of-two number of shards that comfortably exceeds the number
+       of hardware threads, so that concurrent instance registrations rarely
+       contend for the same lock */
+    size_t shard_count = 2, shard_max = 256,
+           shard_min = 2 * (size_t) std::thread::hardware_concurrency();
+    uint32_t shard_log2 = 1;
+    while (shard_count < shard_min && shard_count < shard_max) {
+        shard_count *= 2;
+        shard_log2++;
+    }
+    p->shards = new nb_shard[shard_count];
+    p->shard_count = shard_count;
+    p->shard_shift = 64 - shard_log2;
+#endif
+
     str nb_name("nanobind");
     p->nb_module = PyModule_NewObject(nb_name.ptr());
 
     nb_meta_slots[0].pfunc = (PyObject *) &PyType_Type;
-    nb_meta_cache = p->nb_meta = (PyTypeObject *) PyType_FromSpec(&nb_meta_spec);
+    p->nb_meta = (PyTypeObject *) PyType_FromSpec(&nb_meta_spec);
     p->nb_type_dict = PyDict_New();
     p->nb_func = (PyTypeObject *) PyType_FromSpec(&nb_func_spec);
     p->nb_method = (PyTypeObject *) PyType_FromSpec(&nb_method_spec);
     p->nb_bound_method = (PyTypeObject *) PyType_FromSpec(&nb_bound_method_spec);
 
     check(p->nb_module && p->nb_meta && p->nb_type_dict && p->nb_func &&
-              p->nb_method && p->nb_bound_method,
+              p->nb_method && p->nb_bound_method &&
+              PyModule_AddFunctions(p->nb_module, nb_module_methods) == 0,
           "nanobind::detail::init(): initialization failed!");
 
 #if PY_VERSION_HEX < 0x03090000
@@ -381,9 +548,14 @@ NB_NOINLINE void init(const char *name) {
 #endif
 
     p->translators = { default_exception_translator, nullptr, nullptr };
-    is_alive_value = true;
-    is_alive_ptr = &is_alive_value;
-    p->is_alive_ptr = is_alive_ptr;
+#if defined(NB_SUBINTERPRETERS)
+    if (PyInterpreterState_Get() == PyInterpreterState_Main())
+#endif
+    {
+        is_alive_value = true;
+        is_alive_ptr = &is_alive_value;
+        p->is_alive_ptr = is_alive_ptr;
+    }
 
 #if PY_VERSION_HEX < 0x030C0000 && !defined(PYPY_VERSION)
     /* The implementation of typing.py on CPython <3.12 tends to introduce
@@ -419,6 +591,10 @@ NB_NOINLINE void init(const char *name) {
     }
 #endif
 
+#if defined(NB_SUBINTERPRETERS)
+    // Release the internals when the interpreter state dictionary is cleared
+    capsule = PyCapsule_New(p, "nb_internals", internals_capsule_free);
+#else
     if (Py_AtExit(internals_cleanup))
         fprintf(stderr,
                 "Warning: could not install the nanobind cleanup handler! This "
@@ -428,12 +604,13 @@ NB_NOINLINE void init(const char *name) {
                 "python extension library, you can ignore this warning.");
 
     capsule = PyCapsule_New(p, "nb_internals", nullptr);
+#endif
     int rv = PyDict_SetItem(dict, key, capsule);
     check(!rv && capsule,
           "nanobind::detail::init(): capsule creation failed!");
     Py_DECREF(capsule);
     Py_DECREF(key);
-    internals = p;
+    internals_activate(p);
 }
 
 #if defined(NB_COMPACT_ASSERTIONS)
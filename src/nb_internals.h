@@ -13,10 +13,16 @@
 
 #include <nanobind/nanobind.h>
 #include <tsl/robin_map.h>
+#include <atomic>
 #include <cstring>
 #include <string_view>
 #include <functional>
 #include "hash.h"
+#include "nb_inst_map.h"
+
+#if defined(NB_FREE_THREADED)
+#  include <atomic>
+#endif
 
 #if defined(_MSC_VER)
 #  define NB_THREAD_LOCAL __declspec(thread)
@@ -39,6 +45,16 @@ struct func_data : func_data_prelim<0> {
     arg_data *args;
 };
 
+/**
+ * Fields that the dispatcher consults to reject an overload. 'nb_func' stores
+ * them in a dense array following its 'func_data' records, which means that
+ * scanning a long overload chain only touches a few cache lines.
+ */
+struct func_key {
+    uint32_t flags;
+    uint32_t nargs;
+};
+
 /// Python object representing an instance of a bound C++ type
 struct nb_inst { // usually: 24 bytes
     PyObject_HEAD
@@ -52,40 +68,143 @@ struct nb_inst { // usually: 24 bytes
      * relative offset to a pointer that must be dereferenced to get to the
      * instance data. 'direct' is 'true' in the former case.
      */
-    uint32_t direct : 1;
+    uint8_t direct : 1;
 
     /// Is the instance data co-located with the Python object?
-    uint32_t internal : 1;
+    uint8_t internal : 1;
 
     /// Is the instance properly initialized?
-    uint32_t ready : 1;
+    uint8_t ready : 1;
 
     /// Should the destructor be called when this instance is GCed?
-    uint32_t destruct : 1;
+    uint8_t destruct : 1;
 
     /// Should nanobind call 'operator delete' when this instance is GCed?
-    uint32_t cpp_delete : 1;
-
-    /// Does this instance hold reference to others? (via internals.keep_alive)
-    uint32_t clear_keep_alive : 1;
+    uint8_t cpp_delete : 1;
 
     /// Does this instance use intrusive reference counting?
-    uint32_t intrusive : 1;
+    uint8_t intrusive : 1;
+
+    /* The remaining flags can change while other threads use the instance.
+       They are stored in separate bytes (i.e., separate memory locations),
+       so that updating them doesn't race with accesses to the flags above
+       in free-threaded builds. */
+    uint8_t : 0;
 
-    uint32_t weak_py : 1;
-    uint32_t destroyed : 1;
+    /// Does this instance hold reference to others? (via nb_shard::keep_alive)
+    uint8_t clear_keep_alive : 1;
 
-    uint32_t unused: 23;
+    uint8_t : 0;
+    uint8_t weak_py : 1;
+
+    /// Was the C++ object destroyed? Such instances are no longer in 'inst_c2p'
+    uint8_t destroyed : 1;
 };
 
 static_assert(sizeof(nb_inst) == sizeof(PyObject) + sizeof(uint32_t) * 2);
 
+/// Number of arguments handled by 'nb_func_vectorcall_simple' without alloca()
+/// and maximum number of arguments recorded by the overload resolution cache
+#define NB_MAXARGS_SIMPLE 8
+
+/**
+ * Overload resolution cache of an 'nb_func' (only used when there are
+ * multiple overloads). It records the overload index and dispatch pass that
+ * resolved the last call whose positional arguments were all nanobind
+ * instances, along with the types of those arguments.
+ */
+struct nb_func_cache {
+    /// Types of the positional arguments, only the first 'nargs' are valid
+    PyTypeObject *types[NB_MAXARGS_SIMPLE];
+
+    /// Number of positional arguments (0 == empty cache)
+    uint32_t nargs;
+
+    /// Overload index and pass (0: noconvert, 1: convert) of the last match
+    uint32_t index : 31;
+    uint32_t pass : 1;
+};
+
+/// The overload resolution cache relies on the GIL to serialize its updates
+#if defined(NB_FREE_THREADED)
+#  define NB_FUNC_CACHE 0
+#else
+#  define NB_FUNC_CACHE 1
+#endif
+
+/// Capacity of the bound method freelist, which also relies on the GIL
+#if defined(NB_FREE_THREADED) || defined(PYPY_VERSION)
+#  define NB_BOUND_METHOD_FREELIST 0
+#else
+#  define NB_BOUND_METHOD_FREELIST 16
+#endif
+
+/// Per-function counters collected while profiling is enabled
+struct nb_func_profile {
+    /// Number of calls
+    uint64_t calls;
+
+    /// Number of overloads that were tried and rejected the arguments
+    uint64_t overload_failures;
+
+    /// Number of calls of overloaded functions resolved in the convert pass
+    uint64_t convert_hits;
+
+    /// Number of implicit conversions performed during argument casting
+    uint64_t implicit_hits;
+
+    /// Cumulative time (in nanoseconds) spent in the dispatcher and impl()
+    uint64_t time_total;
+    uint64_t time_impl;
+};
+
+/// Number of buckets of the GIL wait time histograms
+#define NB_GIL_HIST_SIZE 32
+
+/// Per-site counters collected while the GIL profiler is enabled
+struct nb_gil_profile {
+    /// Number of GIL acquisitions
+    uint64_t acquisitions;
+
+    /// Cumulative time (in nanoseconds) spent waiting for and holding the GIL
+    uint64_t wait_time;
+    uint64_t hold_time;
+
+    /// Entry 'i > 0' counts waits in the range [2^(i-1), 2^i) nanoseconds,
+    /// the last one also includes all longer waits
+    uint64_t wait_hist[NB_GIL_HIST_SIZE];
+};
+
+/// What a registration recorded in 'nb_reg_stats' created
+enum class nb_reg_kind { type, function, enum_value };
+
+/// Cost of the registrations performed in a scope, see nb::registration_stats()
+struct nb_reg_stats {
+    /// Name of the scope (empty for registrations without a scope)
+    char *name;
+
+    /// Number of created types, function overloads, and enumeration entries
+    uint64_t types, functions, enum_values;
+
+    /// Cumulative time (in nanoseconds) and approximate memory footprint
+    uint64_t time, bytes;
+};
+
+/// Maps scope names to registration counters (keys refer to 'nb_reg_stats::name')
+using nb_reg_map = tsl::robin_map<std::string_view, nb_reg_stats *,
+                                  std::hash<std::string_view>>;
+
 /// Python object representing a bound C++ function
 struct nb_func {
     PyObject_VAR_HEAD
     PyObject* (*vectorcall)(PyObject *, PyObject * const*, size_t, PyObject *);
     uint32_t max_nargs_pos;
     bool complex_call;
+    /// Does any overload specify default argument values?
+    bool has_defaults;
+    nb_func_cache cache;
+    /// Profiling counters (only allocated while profiling is enabled)
+    nb_func_profile *profile;
 };
 
 /// Python object representing a `nb_ndarray` (which wraps a DLPack ndarray)
@@ -168,14 +287,27 @@ struct std_typeinfo_eq {
 };
 
 using nb_type_map_fast = tsl::robin_map<const std::type_info *, type_data *, ptr_hash>;
-using nb_type_map_slow = tsl::robin_map<const std::type_info *, type_data *,
-                                        std_typeinfo_hash, std_typeinfo_eq>;
+/* The slow map stores each entry's hash so that probing past other entries
+   only compares integers instead of calling strcmp() on the type names */
+using nb_type_map_slow =
+    tsl::robin_map<const std::type_info *, type_data *, std_typeinfo_hash,
+                   std_typeinfo_eq,
+                   std::allocator<std::pair<const std::type_info *, type_data *>>,
+                   /* StoreHash = */ true>;
+
+struct enum_hash {
+    size_t operator()(uint64_t v) const { return (size_t) fmix64(v); }
+};
+
+/// Maps enumerator values (sign- or zero-extended to 64 bit) to their
+/// '(name, doc, instance)' entry, see 'enum_supplement::values'
+using nb_enum_map = tsl::robin_map<uint64_t, PyObject *, enum_hash>;
 
 /// A simple pointer-to-pointer map that is reused a few times below (even if
 /// not 100% ideal) to avoid template code generation bloat.
 using nb_ptr_map  = tsl::robin_map<void *, void*, ptr_hash>;
 
-/// Convenience functions to deal with the pointer encoding in 'internals.inst_c2p'
+/// Convenience functions to deal with the pointer encoding in 'nb_shard::inst_c2p'
 
 /// Does this entry store a linked list of instances?
 NB_INLINE bool         nb_is_seq(void *p)   { return ((uintptr_t) p) & 1; }
@@ -186,12 +318,117 @@ NB_INLINE void*        nb_mark_seq(void *p) { return (void *) (((uintptr_t) p) |
 /// Retrieve the nb_inst_seq* pointer from an 'inst_c2p' value
 NB_INLINE nb_inst_seq* nb_get_seq(void *p)  { return (nb_inst_seq *) (((uintptr_t) p) ^ 1); }
 
+/// Retrieve the nb_weakref_seq* pointer from a tagged 'nb_shard::keep_alive' value
+NB_INLINE nb_weakref_seq* nb_get_weakref_seq(void *p) { return (nb_weakref_seq *) (((uintptr_t) p) ^ 1); }
+
+#if defined(NB_TYPE_STATS)
+/// Instance counters of a bound type and its Python subclasses
+struct nb_type_stats {
+    uint64_t created;
+    uint64_t destroyed;
+
+    /// Current footprint of live instances (Python object and C++ data)
+    uint64_t bytes;
+};
+#endif
+
+/**
+ * Overrides of virtual functions resolved by the trampolines of a type. The
+ * 'data' array uses the layout of 'trampoline<Size>::data' (without the
+ * leading instance pointer) so that new instances can simply copy it. The
+ * entries are discarded when 'epoch' no longer matches
+ * 'nb_internals::trampoline_epoch'.
+ */
+struct nb_trampoline_cache {
+    size_t epoch;
+    size_t size;
+    void *data[1];
+};
+
+/// Ways of obtaining a DLPack capsule (memoized per type by ndarray_import())
+enum class ndarray_source : uintptr_t {
+    unknown = 0,
+    numpy,      // numpy.ndarray, imported without a DLPack capsule
+    method,     // o.__dlpack__(max_version=...)
+    method_legacy, // o.__dlpack__() for producers predating DLPack 1.0
+    tensorflow, // {tensorflow,torch,jax}.*.to_dlpack(o)
+    pytorch,
+    jax,
+    buffer      // Python buffer protocol
+};
+
+/// Operation queued to run once the GIL is held (see deferred_schedule())
+struct nb_deferred {
+    void (*func)(void *) noexcept;
+    void *payload;
+    nb_deferred *next;
+};
+
+/**
+ * Free lists of the ndarray_alloc() memory pool. Blocks are grouped into
+ * power-of-two size classes from 64 bytes to 4 MiB, and each class caches at
+ * most 'budget' bytes of released blocks. Larger arrays are
+ * allocated and released directly.
+ */
+struct nb_ndarray_pool {
+    static constexpr uint32_t min_shift = 6, classes = 17;
+    static constexpr size_t budget = (size_t) 16 << 20;
+
+    void *free_list[classes] { };
+    size_t free_count[classes] { };
+
+#if defined(NB_FREE_THREADED)
+    PyMutex mutex { };
+#endif
+};
+
 struct nb_translator_seq {
     exception_translator translator;
     void *payload;
     nb_translator_seq *next = nullptr;
 };
 
+struct nb_translator {
+    exception_translator translator;
+    void *payload;
+};
+
+/// Typed exception translators, see register_exception_translator_typed()
+using nb_translator_map = tsl::robin_map<const std::type_info *, nb_translator,
+                                         std_typeinfo_hash, std_typeinfo_eq>;
+
+/**
+ * Maps that are updated whenever instances are created or destroyed. In
+ * free-threaded builds, these are split into several shards (see
+ * nb_internals::shard()), each protected by its own mutex, so that threads
+ * working with unrelated instances rarely contend.
+ */
+struct alignas(64) nb_shard {
+    /**
+     * C++ -> Python instance map
+     *
+     * This associative data structure maps a C++ instance pointer onto its
+     * associated PyObject* (if bit 0 of the map value is zero) or a linked
+     * list of type `nb_inst_seq*` (if bit 0 is set---it must be cleared before
+     * interpreting the pointer in this case).
+     *
+     * The latter case occurs when several distinct Python objects reference
+     * the same memory address (e.g. a struct and its first member).
+     */
+    nb_inst_map inst_c2p;
+
+    /**
+     * Dictionary storing keep_alive references. A nurse that keeps a single
+     * Python object alive maps onto it directly (if bit 0 of the map value is
+     * zero). Otherwise, the value is a tagged list of type `nb_weakref_seq*`.
+     */
+    nb_ptr_map keep_alive;
+
+#if defined(NB_FREE_THREADED)
+    PyMutex mutex { };
+#endif
+};
+
 struct nb_internals {
     /// Internal nanobind module
     PyObject *nb_module;
@@ -205,26 +442,46 @@ struct nb_internals {
     /// Types of nanobind functions and methods
     PyTypeObject *nb_func, *nb_method, *nb_bound_method;
 
+    /**
+     * Recently released bound methods that are recycled by the next method
+     * lookup (linked via 'nb_bound_method::self', unused in free-threaded
+     * builds and on PyPy)
+     */
+    struct nb_bound_method *bound_method_freelist = nullptr;
+    uint32_t bound_method_freelist_size = 0;
+
     /// Property variant for static attributes (created on demand)
     PyTypeObject *nb_static_property = nullptr;
     bool nb_static_property_enabled = true;
     descrsetfunc nb_static_property_descr_set = nullptr;
 
+    /// Property variant that accesses data members directly (created on demand)
+    PyTypeObject *nb_member = nullptr;
+
     /// N-dimensional array wrapper (created on demand)
     PyTypeObject *nb_ndarray = nullptr;
 
-    /**
-     * C++ -> Python instance map
-     *
-     * This associative data structure maps a C++ instance pointer onto its
-     * associated PyObject* (if bit 0 of the map value is zero) or a linked
-     * list of type `nb_inst_seq*` (if bit 0 is set---it must be cleared before
-     * interpreting the pointer in this case).
-     *
-     * The latter case occurs when several distinct Python objects reference
-     * the same memory address (e.g. a struct and its first member).
-     */
-    nb_ptr_map inst_c2p;
+    /// How ndarray_import() obtains DLPack capsules from instances of a type
+    nb_ptr_map ndarray_sources;
+
+    /// Interned '__dlpack__' string and framework 'to_dlpack' functions (created on demand)
+    PyObject *ndarray_dlpack_str = nullptr;
+    PyObject *ndarray_dlpack_kwargs = nullptr; // {'max_version': (1, 0)}
+    PyObject *ndarray_to_dlpack[3] { };
+
+    /// Functions used by ndarray_wrap() to create framework arrays (created on
+    /// demand): numpy.array, followed by the tensorflow/pytorch/jax 'from_dlpack'
+    PyObject *ndarray_from_dlpack[4] { };
+    PyObject *ndarray_copy_kwnames = nullptr; // ('copy',)
+
+    /// scipy.sparse.csc_matrix and csr_matrix (created on demand)
+    PyObject *scipy_sparse_types[2] { };
+
+    /// Memory pool backing nb::ndarray_alloc()
+    nb_ndarray_pool ndarray_pool;
+
+    /// Buffer exporter of nb::pickle_buffer (created on demand)
+    PyTypeObject *nb_pickle_buffer = nullptr;
 
     /// C++ -> Python type map -- fast version based on std::type_info pointer equality
     nb_type_map_fast type_c2p_fast;
@@ -232,21 +489,76 @@ struct nb_internals {
     /// C++ -> Python type map -- slow fallback version based on hashed strings
     nb_type_map_slow type_c2p_slow;
 
-    /// Dictionary storing keep_alive references
-    nb_ptr_map keep_alive;
+#if defined(NB_FREE_THREADED)
+    /// Incremented whenever a type is removed (invalidates per-thread caches)
+    std::atomic<uint32_t> type_c2p_epoch { 0 };
+
+    /// Instance map shards, selected by the upper bits of the address hash
+    nb_shard *shards = nullptr;
+    size_t shard_count = 0;
+    uint32_t shard_shift = 0;
+
+    /// Protects the type maps, 'funcs', 'lazy_modules', 'translators', and
+    /// the trampoline caches
+    PyMutex mutex { };
+
+    NB_INLINE nb_shard &shard(void *p) {
+        uint64_t h = fmix64((uint64_t) (uintptr_t) p);
+        return shards[(size_t) (h >> shard_shift)];
+    }
+#else
+    nb_shard shards[1];
+    static constexpr size_t shard_count = 1;
+
+    NB_INLINE nb_shard &shard(void *) { return shards[0]; }
+#endif
 
     /// nb_func/meth instance map for leak reporting (used as set, the value is unused)
     nb_ptr_map funcs;
 
+    /// Modules with deferred function creation (see nb::module_::lazy())
+    nb_ptr_map lazy_modules;
+
     /// Registered C++ -> Python exception translators
     nb_translator_seq translators;
 
+    /**
+     * Translators registered for a specific exception type, indexed by that
+     * type. Only contains entries that are newer than all untyped translators
+     * except for the default one (which handles std::exception subclasses).
+     */
+    nb_translator_map translators_typed;
+
+    /// Incremented when an attribute of a type changes (invalidates 'nb_trampoline_cache')
+    size_t trampoline_epoch = 0;
+
     /// Should nanobind print leak warnings on exit?
     bool print_leak_warnings = true;
 
     /// Should nanobind print warnings after implicit cast failures?
     bool print_implicit_cast_warnings = true;
 
+    /// Is the function call profiler enabled?
+    bool profiling = false;
+
+    /// Is the GIL profiler enabled? (queried by threads without the GIL)
+    std::atomic<bool> gil_profiling { false };
+
+    /// Counters of the GIL profiler, indexed by 'gil_site'
+    nb_gil_profile gil_profile[(size_t) gil_site::count] { };
+
+    /// Registration counters per scope, see nb::registration_stats()
+    nb_reg_map reg_stats;
+
+    /// Number of successful implicit conversions (used by the profiler)
+    uint64_t implicit_count = 0;
+
+    /// Callback that resolves completed futures on the event loop thread
+    PyObject *future_drain = nullptr;
+
+    /// Lock-free stack of operations waiting for the GIL (deferred_schedule())
+    std::atomic<nb_deferred *> deferred { nullptr };
+
     /// Pointer to a boolean that denotes if nanobind is fully initialized.
     bool *is_alive_ptr = nullptr;
 
@@ -261,6 +573,115 @@ struct nb_internals {
 #endif
 };
 
+/**
+ * RAII helpers that protect shared maps in free-threaded builds, where they
+ * lock the mutex of the shard/internals. They must not be held while calling
+ * into Python, which could re-enter and deadlock. Other builds rely on the
+ * GIL, and these helpers don't do anything.
+ */
+#if defined(NB_FREE_THREADED)
+struct lock_shard {
+    NB_INLINE lock_shard(nb_shard &s) : s(s) { PyMutex_Lock(&s.mutex); }
+    NB_INLINE ~lock_shard() { PyMutex_Unlock(&s.mutex); }
+    nb_shard &s;
+};
+
+struct lock_internals {
+    NB_INLINE lock_internals(nb_internals *i) : i(i) { PyMutex_Lock(&i->mutex); }
+    NB_INLINE ~lock_internals() { PyMutex_Unlock(&i->mutex); }
+    nb_internals *i;
+};
+#else
+struct lock_shard {
+    NB_INLINE lock_shard(nb_shard &) { }
+};
+
+struct lock_internals {
+    NB_INLINE lock_internals(nb_internals *) { }
+};
+#endif
+
+/**
+ * Increase the reference count of an instance found in an instance map. In
+ * free-threaded builds, another thread may concurrently be deallocating it,
+ * in which case the function fails and the instance must be ignored. The
+ * caller must hold the shard lock, which keeps the deallocation from
+ * completing.
+ */
+#if defined(NB_FREE_THREADED)
+/// Must be called once on new instances to permit nb_try_inc_ref()
+NB_INLINE void nb_enable_try_inc_ref(PyObject *obj) noexcept {
+#  if PY_VERSION_HEX >= 0x030E00B1
+    PyUnstable_EnableTryIncRef(obj);
+#  else
+    // Follows _PyObject_SetMaybeWeakref() in CPython 3.13 (pycore_object.h)
+    if (_Py_IsImmortal(obj))
+        return;
+
+    while (true) {
+        Py_ssize_t shared = _Py_atomic_load_ssize_relaxed(&obj->ob_ref_shared);
+        if ((shared & _Py_REF_SHARED_FLAG_MASK) != 0)
+            return;
+        if (_Py_atomic_compare_exchange_ssize(&obj->ob_ref_shared, &shared,
+                                              shared | _Py_REF_MAYBE_WEAKREF))
+            return;
+    }
+#  endif
+}
+
+NB_INLINE bool nb_try_inc_ref(PyObject *obj) noexcept {
+#  if PY_VERSION_HEX >= 0x030E00B1
+    return PyUnstable_TryIncRef(obj);
+#  else
+    // Follows _Py_TryIncrefCompare() in CPython 3.13 (pycore_object.h)
+    uint32_t local = _Py_atomic_load_uint32_relaxed(&obj->ob_ref_local);
+    if (local == _Py_IMMORTAL_REFCNT_LOCAL)
+        return true;
+
+    if (_Py_IsOwnedByCurrentThread(obj)) {
+        _Py_atomic_store_uint32_relaxed(&obj->ob_ref_local, local + 1);
+        return true;
+    }
+
+    Py_ssize_t shared = _Py_atomic_load_ssize_relaxed(&obj->ob_ref_shared);
+    while (true) {
+        // A zero or merged shared refcount means that deallocation started
+        if (shared == 0 || shared == _Py_REF_MERGED)
+            return false;
+
+        if (_Py_atomic_compare_exchange_ssize(
+                &obj->ob_ref_shared, &shared,
+                shared + (1 << _Py_REF_SHARED_SHIFT)))
+            return true;
+    }
+#  endif
+}
+#else
+NB_INLINE void nb_enable_try_inc_ref(PyObject *) noexcept { }
+
+NB_INLINE bool nb_try_inc_ref(PyObject *obj) noexcept {
+    Py_INCREF(obj);
+    return true;
+}
+#endif
+
+/// Update/read statistics counters, atomically in free-threaded builds
+NB_INLINE void nb_counter_add(uint64_t &c, uint64_t value) noexcept {
+#if defined(NB_FREE_THREADED)
+    _Py_atomic_add_uint64(&c, value);
+#else
+    c += value;
+#endif
+}
+
+NB_INLINE uint64_t nb_counter_load(const uint64_t &c) noexcept {
+#if defined(NB_FREE_THREADED)
+    return _Py_atomic_load_uint64_relaxed(&c);
+#else
+    return c;
+#endif
+}
+
 /// Convenience macro to potentially access cached functions
 #if defined(Py_LIMITED_API)
 #  define NB_SLOT(type, name) internals->type##_##name
@@ -268,25 +689,89 @@ struct nb_internals {
 #  define NB_SLOT(type, name) type.name
 #endif
 
+#if defined(NB_SUBINTERPRETERS)
+/**
+ * Every interpreter has its own internals (and thus its own copy of all
+ * nanobind type objects). The internals of the active interpreter are cached
+ * per thread, and the cache is re-validated on every access since a thread
+ * may switch between interpreters.
+ */
+struct nb_internals_cache {
+    PyInterpreterState *interp;
+    nb_internals *ptr;
+};
+
+extern NB_THREAD_LOCAL nb_internals_cache internals_cache;
+
+/// Slow path: look up the internals of the current interpreter
+extern nb_internals *internals_fetch() noexcept;
+
+NB_INLINE nb_internals *internals_get() noexcept {
+    nb_internals_cache &c = internals_cache;
+    if (NB_UNLIKELY(c.interp != PyInterpreterState_Get()))
+        return internals_fetch();
+    return c.ptr;
+}
+
+#  define internals (::nanobind::detail::internals_get())
+#  define nb_meta_cache (internals->nb_meta)
+#else
 extern nb_internals *internals;
 extern PyTypeObject *nb_meta_cache;
+#endif
 
 extern char *type_name(const std::type_info *t);
 
+/* Queue 'func(payload)' to run once the GIL is held, if the calling thread
+   doesn't hold it. Returns 'false' when the caller should acquire the GIL
+   and run 'func' itself (which is always the case in stable ABI and
+   subinterpreter builds). */
+extern bool defer_call(void (*func)(void *) noexcept, void *payload) noexcept;
+
+/// Run the queued operations (requires the GIL)
+extern void deferred_drain() noexcept;
+
+/// Called at dispatcher entry to run queued operations, if there are any
+NB_INLINE void deferred_check() noexcept {
+#if !defined(NB_SUBINTERPRETERS)
+    if (NB_UNLIKELY(internals->deferred.load(std::memory_order_relaxed)))
+        deferred_drain();
+#endif
+}
+
 // Forward declarations
 extern PyObject *inst_new_ext(PyTypeObject *tp, void *value);
 extern PyObject *inst_new_int(PyTypeObject *tp);
 extern PyTypeObject *nb_static_property_tp() noexcept;
-extern type_data *nb_type_c2p(nb_internals *internals,
+extern void nb_static_property_set_const(PyObject *prop, PyObject *value) noexcept;
+extern void nb_bound_method_freelist_clear(nb_internals *p) noexcept;
+extern type_data *nb_type_c2p(nb_internals *internals_,
                               const std::type_info *type);
+extern void trampoline_cache_free(nb_trampoline_cache *c) noexcept;
+extern PyObject *nb_enum_get(type_data *t, const void *value) noexcept;
+extern uint64_t nb_time_ns() noexcept;
+extern void nb_reg_record(PyObject *scope, nb_reg_kind kind, uint64_t start,
+                          size_t bytes) noexcept;
+extern void nb_enum_free(PyTypeObject *tp) noexcept;
+struct Buffer;
+extern bool nb_member_format(type_data *t, Buffer &buf) noexcept;
 
 /// Fetch the nanobind function record from a 'nb_func' instance
 NB_INLINE func_data *nb_func_data(void *o) {
     return (func_data *) (((char *) o) + sizeof(nb_func));
 }
 
+/// Fetch the dispatch keys of a 'nb_func' instance with 'count' overloads
+NB_INLINE func_key *nb_func_keys(void *o, size_t count) {
+    return (func_key *) (nb_func_data(o) + count);
+}
+
 #if defined(Py_LIMITED_API)
 extern type_data *nb_type_data_static(PyTypeObject *o) noexcept;
+extern void seq_layout_init() noexcept;
+
+/// Offset of 'type_data' within 'nb_type' instances (zero until first needed)
+extern Py_ssize_t nb_type_data_offset;
 #endif
 
 /// Fetch the nanobind type record from a 'nb_type' instance
@@ -294,6 +779,9 @@ NB_INLINE type_data *nb_type_data(PyTypeObject *o) noexcept{
     #if !defined(Py_LIMITED_API)
         return (type_data *) (((char *) o) + sizeof(PyHeapTypeObject));
     #else
+        Py_ssize_t offset = nb_type_data_offset;
+        if (NB_LIKELY(offset))
+            return (type_data *) (((char *) o) + offset);
         return nb_type_data_static(o);
     #endif
 }
@@ -331,5 +819,32 @@ private:
 
 extern char *strdup_check(const char *);
 
+/**
+ * \brief Thread-local scratch memory for the duration of a call
+ *
+ * Blocks are carved from a per-thread bump arena that is reset once all of
+ * them have been returned, so that dispatch paths (cleanup lists, temporary
+ * shape/stride arrays) don't touch the heap. Requests that don't fit into the
+ * arena fall back to malloc(). Returns nullptr when out of memory.
+ */
+extern void *scratch_alloc(size_t size) noexcept;
+extern void scratch_free(void *ptr) noexcept;
+
+/// RAII wrapper around scratch_alloc(), analogous to scoped_pymalloc
+template <typename T> struct scoped_scratch {
+    scoped_scratch(size_t size = 1) {
+        ptr = (T *) scratch_alloc(size * sizeof(T));
+        if (!ptr)
+            fail("scoped_scratch(): could not allocate %zu bytes of memory!", size);
+    }
+    ~scoped_scratch() { scratch_free(ptr); }
+    scoped_scratch(const scoped_scratch &) = delete;
+    scoped_scratch &operator=(const scoped_scratch &) = delete;
+    T *get() const { return ptr; }
+    T &operator[](size_t i) { return ptr[i]; }
+private:
+    T *ptr;
+};
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
@@ -0,0 +1,322 @@
+#include "nb_internals.h"
+#include "buffer.h"
+#include <algorithm>
+#include <vector>
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// Payload of `nb_member` descriptors, which follows the property object
+struct nb_member_data {
+    member_desc desc;
+    PyTypeObject *scope;
+    bool writable;
+};
+
+static nb_member_data *nb_member_data_get(PyObject *self) {
+#if PY_VERSION_HEX >= 0x030C0000
+    return (nb_member_data *) PyObject_GetTypeData(self, internals->nb_member);
+#else
+    return (nb_member_data *) ((uint8_t *) self + PyProperty_Type.tp_basicsize);
+#endif
+}
+
+/// Return the address of the field, or nullptr if 'obj' can't be accessed directly
+static void *nb_member_ptr(const nb_member_data *d, PyObject *obj) {
+    if (!obj || (Py_TYPE(obj) != d->scope &&
+                 !PyType_IsSubtype(Py_TYPE(obj), d->scope)))
+        return nullptr;
+
+    nb_inst *inst = (nb_inst *) obj;
+    if (!inst->ready || inst->destroyed)
+        return nullptr;
+
+    return (uint8_t *) inst_ptr(inst) + d->desc.offset;
+}
+
+/// `nb_member.__get__()`: read the field, defer to `property` for other cases
+static PyObject *nb_member_descr_get(PyObject *self, PyObject *obj, PyObject *cls) {
+    const nb_member_data *d = nb_member_data_get(self);
+    void *p = nb_member_ptr(d, obj);
+
+    if (p) {
+        switch (d->desc.kind) {
+            case member_kind::bool_: {
+                PyObject *result = *(bool *) p ? Py_True : Py_False;
+                Py_INCREF(result);
+                return result;
+            }
+
+            case member_kind::i8:  return PyLong_FromLong(*(int8_t *) p);
+            case member_kind::u8:  return PyLong_FromUnsignedLong(*(uint8_t *) p);
+            case member_kind::i16: return PyLong_FromLong(*(int16_t *) p);
+            case member_kind::u16: return PyLong_FromUnsignedLong(*(uint16_t *) p);
+            case member_kind::i32: return PyLong_FromLong(*(int32_t *) p);
+            case member_kind::u32: return PyLong_FromUnsignedLong(*(uint32_t *) p);
+            case member_kind::i64: return PyLong_FromLongLong(*(int64_t *) p);
+            case member_kind::u64: return PyLong_FromUnsignedLongLong(*(uint64_t *) p);
+            case member_kind::f32: return PyFloat_FromDouble(*(float *) p);
+            case member_kind::f64: return PyFloat_FromDouble(*(double *) p);
+
+            case member_kind::type: {
+                cleanup_list cleanup(obj);
+                PyObject *result =
+                    nb_type_put(d->desc.type, p, rv_policy::reference_internal,
+                                &cleanup, nullptr);
+                cleanup.release();
+                if (result || PyErr_Occurred())
+                    return result;
+            }
+            break;
+        }
+    }
+
+    return NB_SLOT(PyProperty_Type, tp_descr_get)(self, obj, cls);
+}
+
+template <typename T, typename Load>
+static bool nb_member_load(PyObject *value, void *p, Load load) {
+    T tmp;
+    if (!load(value, (uint8_t) cast_flags::convert, &tmp))
+        return false;
+    *(T *) p = tmp;
+    return true;
+}
+
+/**
+ * `nb_member.__set__()`: write the field. Deletion, read-only fields, and
+ * values that can't be converted are passed on to `property`, which
+ * dispatches to the setter function and reports errors as usual.
+ */
+static int nb_member_descr_set(PyObject *self, PyObject *obj, PyObject *value) {
+    const nb_member_data *d = nb_member_data_get(self);
+    void *p = d->writable && value ? nb_member_ptr(d, obj) : nullptr;
+    bool success = false;
+
+    if (p) {
+        switch (d->desc.kind) {
+            case member_kind::bool_:
+                success = value == Py_True || value == Py_False;
+                if (success)
+                    *(bool *) p = value == Py_True;
+                break;
+
+            case member_kind::i8:  success = nb_member_load<int8_t>(value, p, load_i8); break;
+            case member_kind::u8:  success = nb_member_load<uint8_t>(value, p, load_u8); break;
+            case member_kind::i16: success = nb_member_load<int16_t>(value, p, load_i16); break;
+            case member_kind::u16: success = nb_member_load<uint16_t>(value, p, load_u16); break;
+            case member_kind::i32: success = nb_member_load<int32_t>(value, p, load_i32); break;
+            case member_kind::u32: success = nb_member_load<uint32_t>(value, p, load_u32); break;
+            case member_kind::i64: success = nb_member_load<int64_t>(value, p, load_i64); break;
+            case member_kind::u64: success = nb_member_load<uint64_t>(value, p, load_u64); break;
+            case member_kind::f32: success = nb_member_load<float>(value, p, load_f32); break;
+            case member_kind::f64: success = nb_member_load<double>(value, p, load_f64); break;
+
+            case member_kind::type: {
+                cleanup_list cleanup(obj);
+                void *src = nullptr;
+                if (nb_type_get(d->desc.type, value,
+                                (uint8_t) cast_flags::convert, &cleanup,
+                                &src) && src) {
+                    try {
+                        d->desc.assign(p, src);
+                        success = true;
+                    } catch (...) {
+                        cleanup.release();
+                        nb_translate_exception();
+                        return -1;
+                    }
+                }
+                cleanup.release();
+            }
+            break;
+        }
+    }
+
+    if (success)
+        return 0;
+
+    return NB_SLOT(PyProperty_Type, tp_descr_set)(self, obj, value);
+}
+
+static PyTypeObject *nb_member_tp() noexcept {
+    PyTypeObject *tp = internals->nb_member;
+
+    if (NB_UNLIKELY(!tp)) {
+        PyMemberDef *members;
+
+        #if defined(Py_LIMITED_API)
+            members = (PyMemberDef *) PyType_GetSlot(&PyProperty_Type, Py_tp_members);
+        #else
+            members = PyProperty_Type.tp_members;
+        #endif
+
+        PyType_Slot slots[] = {
+            { Py_tp_base, &PyProperty_Type },
+            { Py_tp_descr_get, (void *) nb_member_descr_get },
+            { Py_tp_descr_set, (void *) nb_member_descr_set },
+            { Py_tp_members, members },
+            { 0, nullptr }
+        };
+
+#if PY_VERSION_HEX >= 0x030C0000
+        int basicsize = -(int) sizeof(nb_member_data);
+#else
+        int basicsize = (int) (PyProperty_Type.tp_basicsize + sizeof(nb_member_data));
+#endif
+
+        PyType_Spec spec = {
+            /* .name = */ "nanobind.nb_member",
+            /* .basicsize = */ basicsize,
+            /* .itemsize = */ 0,
+            /* .flags = */ Py_TPFLAGS_DEFAULT,
+            /* .slots = */ slots
+        };
+
+        tp = (PyTypeObject *) PyType_FromSpec(&spec);
+        check(tp, "nb_member type creation failed!");
+
+        internals->nb_member = tp;
+    }
+
+    return tp;
+}
+
+void property_install_member(PyObject *scope, const char *name,
+                             PyObject *getter, PyObject *setter,
+                             const member_desc *desc) noexcept {
+    object doc = none();
+
+    if (getter && (Py_TYPE(getter) == internals->nb_func ||
+                   Py_TYPE(getter) == internals->nb_method)) {
+        func_data *f = nb_func_data(getter);
+        if (f->flags & (uint32_t) func_flags::has_doc)
+            doc = str(f->doc);
+    }
+
+    object prop = handle(nb_member_tp())(
+        handle(getter),
+        setter ? handle(setter) : handle(Py_None),
+        handle(Py_None), // deleter
+        doc
+    );
+
+    nb_member_data *d = nb_member_data_get(prop.ptr());
+    d->desc = *desc;
+    d->scope = (PyTypeObject *) scope;
+    d->writable = setter != nullptr;
+
+    handle(scope).attr(name) = prop;
+}
+
+/// A field of a PEP 3118 struct format (see nb_member_format())
+struct nb_member_field {
+    const char *name;
+    const nb_member_data *data;
+    type_data *nested;
+    size_t size;
+};
+
+/**
+ * Append the PEP 3118 struct format ("T{...}") of the fields that def_rw()
+ * and def_ro() installed in the dictionary of 't' to 'buf'. Bound fields are
+ * described recursively, and gaps between fields become padding bytes.
+ * Returns 'false' if the type has no such fields.
+ */
+bool nb_member_format(type_data *t, Buffer &buf) noexcept {
+    static const char kind_format[] = "?bBhHiIqQfd";
+    static const uint8_t kind_size[] = { (uint8_t) sizeof(bool), 1, 1, 2, 2,
+                                         4, 4, 8, 8, 4, 8 };
+
+    PyObject *dict = PyObject_GetAttrString((PyObject *) t->type_py, "__dict__"),
+             *items = dict ? PyMapping_Items(dict) : nullptr;
+    Py_XDECREF(dict);
+    if (!items) {
+        PyErr_Clear();
+        return false;
+    }
+
+    std::vector<nb_member_field> fields;
+    for (Py_ssize_t i = 0, n = NB_LIST_GET_SIZE(items); i < n; ++i) {
+        PyObject *item = NB_LIST_GET_ITEM(items, i),
+                 *key = NB_TUPLE_GET_ITEM(item, 0),
+                 *value = NB_TUPLE_GET_ITEM(item, 1);
+
+        if (Py_TYPE(value) != internals->nb_member || !PyUnicode_Check(key))
+            continue;
+
+        const nb_member_data *d = nb_member_data_get(value);
+        if (d->scope != t->type_py)
+            continue;
+
+        nb_member_field f { PyUnicode_AsUTF8AndSize(key, nullptr), d, nullptr, 0 };
+        if (!f.name) {
+            PyErr_Clear();
+            continue;
+        }
+
+        if (d->desc.kind == member_kind::type) {
+            f.nested = nb_type_c2p(internals, d->desc.type);
+            if (!f.nested)
+                continue;
+            f.size = f.nested->size;
+        } else {
+            f.size = kind_size[(int) d->desc.kind];
+        }
+
+        if (d->desc.offset + f.size <= t->size)
+            fields.push_back(f);
+    }
+
+    std::stable_sort(fields.begin(), fields.end(),
+                     [](const nb_member_field &a, const nb_member_field &b) {
+                         return a.data->desc.offset < b.data->desc.offset;
+                     });
+
+    size_t pos = 0, start = buf.size(), count = 0;
+    buf.put("T{");
+
+    for (const nb_member_field &f : fields) {
+        size_t offset = f.data->desc.offset;
+
+        // Skip aliases of fields that were already described
+        if (offset < pos)
+            continue;
+        if (offset > pos)
+            buf.fmt("%zux", offset - pos);
+
+        bool named = true;
+        if (!f.nested) {
+            buf.put(kind_format[(int) f.data->desc.kind]);
+        } else if (!nb_member_format(f.nested, buf)) {
+            // Unnamed padding replaces opaque bound fields
+            buf.fmt("%zux", f.size);
+            named = false;
+        }
+
+        if (named) {
+            buf.put(':');
+            buf.put_dstr(f.name);
+            buf.put(':');
+            count++;
+        }
+
+        pos = offset + f.size;
+    }
+
+    Py_DECREF(items);
+
+    if (!count) {
+        buf.rewind(buf.size() - start);
+        return false;
+    }
+
+    if (pos < t->size)
+        buf.fmt("%zux", (size_t) t->size - pos);
+    buf.put('}');
+
+    return true;
+}
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
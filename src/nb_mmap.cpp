@@ -0,0 +1,187 @@
+/*
+    src/nb_mmap.cpp: ndarrays backed by memory-mapped files
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include <nanobind/ndarray.h>
+#include "nb_internals.h"
+
+#if defined(_WIN32)
+#  if !defined(WIN32_LEAN_AND_MEAN)
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  if !defined(NOMINMAX)
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <errno.h>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// Mapped region, stored within the ndarray handle
+struct ndarray_mapping {
+    void *addr;
+    size_t size;
+};
+
+static void ndarray_unmap(void *p) noexcept {
+    ndarray_mapping *m = (ndarray_mapping *) p;
+    if (!m->addr)
+        return;
+#if defined(_WIN32)
+    UnmapViewOfFile(m->addr);
+#else
+    munmap(m->addr, m->size);
+#endif
+}
+
+ndarray_handle *ndarray_map_file(const char *path, uint64_t offset,
+                                 size_t ndim, const size_t *shape,
+                                 dlpack::dtype *dtype, bool copy_on_write,
+                                 bool ro, int advice) {
+    uint64_t size = ((uint64_t) dtype->bits * dtype->lanes + 7) / 8;
+    for (size_t i = 0; i < ndim; ++i) {
+        if (shape[i] && size > UINT64_MAX / shape[i])
+            raise("nanobind::detail::ndarray_map_file(): array is too large!");
+        size *= shape[i];
+    }
+
+    ndarray_mapping mapping { nullptr, 0 };
+    uint8_t *data = nullptr;
+
+#if defined(_WIN32)
+    int wsize = MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0);
+    scoped_pymalloc<wchar_t> wpath((size_t) (wsize > 0 ? wsize : 1));
+    wpath[0] = L'\0';
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath.get(), wsize);
+
+    HANDLE file = CreateFileW(wpath.get(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING,
+                              advice == 1   ? FILE_FLAG_SEQUENTIAL_SCAN
+                              : advice == 2 ? FILE_FLAG_RANDOM_ACCESS
+                                            : FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        PyErr_SetFromWindowsErr(0);
+        raise_python_error();
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        PyErr_SetFromWindowsErr(0);
+        CloseHandle(file);
+        raise_python_error();
+    }
+
+    if (offset > (uint64_t) file_size.QuadPart ||
+        size > (uint64_t) file_size.QuadPart - offset) {
+        CloseHandle(file);
+        raise("nanobind::detail::ndarray_map_file(): \"%s\" is too small "
+              "to hold the array!", path);
+    }
+
+    if (size) {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        uint64_t start = offset - offset % info.dwAllocationGranularity;
+
+        HANDLE map = CreateFileMappingW(
+            file, nullptr, copy_on_write ? PAGE_WRITECOPY : PAGE_READONLY, 0,
+            0, nullptr);
+        if (map) {
+            mapping.size = (size_t) (offset - start + size);
+            mapping.addr = MapViewOfFile(
+                map, copy_on_write ? FILE_MAP_COPY : FILE_MAP_READ,
+                (DWORD) (start >> 32), (DWORD) start, mapping.size);
+        }
+        DWORD error = mapping.addr ? 0 : GetLastError();
+
+        if (map)
+            CloseHandle(map);
+        CloseHandle(file);
+
+        if (!mapping.addr) {
+            PyErr_SetFromWindowsErr((int) error);
+            raise_python_error();
+        }
+        data = (uint8_t *) mapping.addr + (offset - start);
+    } else {
+        CloseHandle(file);
+    }
+#else
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+        raise_python_error();
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+        raise_python_error();
+    }
+
+    if (offset > (uint64_t) st.st_size ||
+        size > (uint64_t) st.st_size - offset) {
+        close(fd);
+        raise("nanobind::detail::ndarray_map_file(): \"%s\" is too small "
+              "to hold the array!", path);
+    }
+
+    if (size) {
+        uint64_t page_size = (uint64_t) sysconf(_SC_PAGESIZE),
+                 start = offset - offset % page_size;
+        mapping.size = (size_t) (offset - start + size);
+
+        void *addr = mmap(nullptr, mapping.size,
+                          PROT_READ | (copy_on_write ? PROT_WRITE : 0),
+                          MAP_PRIVATE, fd, (off_t) start);
+
+        if (addr == MAP_FAILED) {
+            PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+            close(fd);
+            raise_python_error();
+        }
+        close(fd);
+
+        if (advice)
+            (void) madvise(addr, mapping.size,
+                           advice == 1 ? MADV_SEQUENTIAL : MADV_RANDOM);
+
+        mapping.addr = addr;
+        data = (uint8_t *) addr + (offset - start);
+    } else {
+        close(fd);
+    }
+#endif
+
+    ndarray_handle *th;
+    void *payload;
+    try {
+        th = ndarray_create_payload(data, ndim, shape, nullptr, dtype, ro,
+                                    device::cpu::value, 0,
+                                    sizeof(ndarray_mapping), ndarray_unmap,
+                                    &payload);
+    } catch (...) {
+        ndarray_unmap(&mapping);
+        throw;
+    }
+
+    new (payload) ndarray_mapping(mapping);
+    return th;
+}
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
@@ -1,6 +1,9 @@
 #include <nanobind/ndarray.h>
 #include <atomic>
+#include <cmath>
+#include <limits>
 #include "nb_internals.h"
+#include "buffer.h"
 
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
@@ -13,6 +16,24 @@ struct managed_dltensor {
     void (*deleter)(managed_dltensor *);
 };
 
+/// DLManagedTensorVersioned, produced by '__dlpack__(max_version=(1, 0))'
+struct managed_dltensor_versioned {
+    struct { uint32_t major, minor; } version;
+    void *manager_ctx;
+    void (*deleter)(managed_dltensor_versioned *);
+    uint64_t flags;
+    dlpack::dltensor dltensor;
+};
+
+static constexpr uint64_t dltensor_flag_read_only = 1;
+static constexpr uint64_t dltensor_flag_is_copied = 2;
+
+/// Stream passed to '__dlpack__()' on the current thread (nb::ndarray_stream)
+static thread_local struct {
+    bool set;
+    intptr_t value;
+} ndarray_stream_tls { };
+
 struct ndarray_handle {
     managed_dltensor *ndarray;
     std::atomic<size_t> refcount;
@@ -20,9 +41,16 @@ struct ndarray_handle {
     bool free_shape;
     bool free_strides;
     bool call_deleter;
+    bool free_data; // return 'data' to the ndarray_alloc() pool
     bool ro;
+    void (*payload_free)(void *) noexcept; // see ndarray_create_payload()
 };
 
+/// Offset of the container stored by ndarray_create_payload()
+static constexpr size_t ndarray_payload_offset =
+    (sizeof(ndarray_handle) + alignof(std::max_align_t) - 1) &
+    ~(alignof(std::max_align_t) - 1);
+
 static void nb_ndarray_dealloc(PyObject *self) {
     PyTypeObject *tp = Py_TYPE(self);
     ndarray_dec_ref(((nb_ndarray *) self)->th);
@@ -30,21 +58,15 @@ static void nb_ndarray_dealloc(PyObject *self) {
     Py_DECREF(tp);
 }
 
-static int nd_ndarray_tpbuffer(PyObject *exporter, Py_buffer *view, int) {
-    nb_ndarray *self = (nb_ndarray *) exporter;
-
-    dlpack::dltensor &t = self->th->ndarray->dltensor;
-
-    if (t.device.device_type != device::cpu::value) {
-        PyErr_SetString(PyExc_BufferError, "Only CPU-allocated ndarrays can be "
-                                           "accessed via the buffer protocol!");
-        return -1;
-    }
-
+/// Fill 'view' with a CPU buffer owned by 'exporter' (C-contiguous if !strides)
+static int buffer_fill(PyObject *exporter, void *data, size_t ndim,
+                       const int64_t *shape_in, const int64_t *strides_in,
+                       const dlpack::dtype &dtype, bool ro, Py_buffer *view,
+                       int flags) {
     const char *format = nullptr;
-    switch ((dlpack::dtype_code) t.dtype.code) {
+    switch ((dlpack::dtype_code) dtype.code) {
         case dlpack::dtype_code::Int:
-            switch (t.dtype.bits) {
+            switch (dtype.bits) {
                 case 8: format = "b"; break;
                 case 16: format = "h"; break;
                 case 32: format = "i"; break;
@@ -53,7 +75,7 @@ static int nd_ndarray_tpbuffer(PyObject *exporter, Py_buffer *view, int) {
             break;
 
         case dlpack::dtype_code::UInt:
-            switch (t.dtype.bits) {
+            switch (dtype.bits) {
                 case 8: format = "B"; break;
                 case 16: format = "H"; break;
                 case 32: format = "I"; break;
@@ -62,7 +84,7 @@ static int nd_ndarray_tpbuffer(PyObject *exporter, Py_buffer *view, int) {
             break;
 
         case dlpack::dtype_code::Float:
-            switch (t.dtype.bits) {
+            switch (dtype.bits) {
                 case 16: format = "e"; break;
                 case 32: format = "f"; break;
                 case 64: format = "d"; break;
@@ -70,7 +92,7 @@ static int nd_ndarray_tpbuffer(PyObject *exporter, Py_buffer *view, int) {
             break;
 
         case dlpack::dtype_code::Complex:
-            switch (t.dtype.bits) {
+            switch (dtype.bits) {
                 case 64: format = "Zf"; break;
                 case 128: format = "Zd"; break;
             }
@@ -84,32 +106,35 @@ static int nd_ndarray_tpbuffer(PyObject *exporter, Py_buffer *view, int) {
             break;
     }
 
-    if (!format || t.dtype.lanes != 1) {
+    if (!format || dtype.lanes != 1) {
         PyErr_SetString(
             PyExc_BufferError,
             "Don't know how to convert DLPack dtype into buffer protocol format!");
         return -1;
     }
 
-    view->format = (char *) format;
-    view->itemsize = t.dtype.bits / 8;
-    view->buf = (void *) ((uintptr_t) t.data + t.byte_offset);
-    view->obj = exporter;
-    Py_INCREF(exporter);
+    if (ro && (flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "Object is not writable.");
+        return -1;
+    }
 
-    Py_ssize_t len = view->itemsize;
-    scoped_pymalloc<Py_ssize_t> strides((size_t) t.ndim),
-                                  shape((size_t) t.ndim);
+    Py_ssize_t itemsize = dtype.bits / 8, len = itemsize;
+    scoped_pymalloc<Py_ssize_t> strides(ndim), shape(ndim);
 
-    for (size_t i = 0; i < (size_t) t.ndim; ++i) {
-        len *= (Py_ssize_t) t.shape[i];
-        strides[i] = (Py_ssize_t) t.strides[i] * view->itemsize;
-        shape[i] = (Py_ssize_t) t.shape[i];
+    for (size_t i = ndim; i-- > 0; ) {
+        shape[i] = (Py_ssize_t) shape_in[i];
+        strides[i] = strides_in ? (Py_ssize_t) strides_in[i] * itemsize : len;
+        len *= shape[i];
     }
 
-    view->ndim = t.ndim;
+    view->format = (char *) format;
+    view->itemsize = itemsize;
+    view->buf = data;
+    view->obj = exporter;
+    Py_INCREF(exporter);
+    view->ndim = (int) ndim;
     view->len = len;
-    view->readonly = self->th->ro;
+    view->readonly = ro;
     view->suboffsets = nullptr;
     view->internal = nullptr;
     view->strides = strides.release();
@@ -118,11 +143,83 @@ static int nd_ndarray_tpbuffer(PyObject *exporter, Py_buffer *view, int) {
     return 0;
 }
 
+static int nd_ndarray_tpbuffer(PyObject *exporter, Py_buffer *view, int flags) {
+    nb_ndarray *self = (nb_ndarray *) exporter;
+
+    dlpack::dltensor &t = self->th->ndarray->dltensor;
+
+    if (t.device.device_type != device::cpu::value) {
+        PyErr_SetString(PyExc_BufferError, "Only CPU-allocated ndarrays can be "
+                                           "accessed via the buffer protocol!");
+        return -1;
+    }
+
+    return buffer_fill(exporter, (void *) ((uintptr_t) t.data + t.byte_offset),
+                       (size_t) t.ndim, t.shape, t.strides, t.dtype,
+                       self->th->ro, view, flags & ~PyBUF_WRITABLE);
+}
+
 static void nb_ndarray_releasebuffer(PyObject *, Py_buffer *view) {
     PyMem_Free(view->shape);
     PyMem_Free(view->strides);
 }
 
+int ndarray_export_buffer(PyObject *exporter, void *data, size_t ndim,
+                          const size_t *shape, const dlpack::dtype *dtype,
+                          bool ro, Py_buffer *view, int flags) noexcept {
+    scoped_scratch<int64_t> shape_i64(ndim);
+    for (size_t i = 0; i < ndim; ++i)
+        shape_i64[i] = (int64_t) shape[i];
+    return buffer_fill(exporter, data, ndim, shape_i64.get(), nullptr, *dtype,
+                       ro, view, flags);
+}
+
+int ndarray_export_struct_buffer(PyObject *exporter, void *data, size_t size,
+                                 const std::type_info *type, bool ro,
+                                 Py_buffer *view, int flags) noexcept {
+    type_data *t = nb_type_c2p(internals, type);
+    Buffer format(32);
+
+    if (!t || !nb_member_format(t, format)) {
+        PyErr_Format(PyExc_BufferError,
+                     "Type '%s' has no data members bound via def_rw() or "
+                     "def_ro() that could be exposed via the buffer protocol!",
+                     t ? t->name : type->name());
+        return -1;
+    }
+
+    if (ro && (flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "Object is not writable.");
+        return -1;
+    }
+
+    scoped_pymalloc<Py_ssize_t> strides(1), shape(1);
+    shape[0] = (Py_ssize_t) size;
+    strides[0] = (Py_ssize_t) t->size;
+
+    // The format string is owned by the view (see ndarray_release_buffer())
+    char *format_str = format.copy();
+    view->format = format_str;
+    view->itemsize = (Py_ssize_t) t->size;
+    view->buf = data;
+    view->obj = exporter;
+    Py_INCREF(exporter);
+    view->ndim = 1;
+    view->len = (Py_ssize_t) (size * t->size);
+    view->readonly = ro;
+    view->suboffsets = nullptr;
+    view->internal = format_str;
+    view->strides = strides.release();
+    view->shape = shape.release();
+
+    return 0;
+}
+
+void ndarray_release_buffer(PyObject *exporter, Py_buffer *view) noexcept {
+    nb_ndarray_releasebuffer(exporter, view);
+    free(view->internal);
+}
+
 static PyTypeObject *nd_ndarray_tp() noexcept {
     PyTypeObject *tp = internals->nb_ndarray;
 
@@ -158,16 +255,8 @@ static PyTypeObject *nd_ndarray_tp() noexcept {
     return tp;
 }
 
-static PyObject *dlpack_from_buffer_protocol(PyObject *o, bool ro) {
-    scoped_pymalloc<Py_buffer> view;
-    scoped_pymalloc<managed_dltensor> mt;
-
-    if (PyObject_GetBuffer(o, view.get(),
-                           ro ? PyBUF_RECORDS_RO : PyBUF_RECORDS)) {
-        PyErr_Clear();
-        return nullptr;
-    }
-
+/// Determine the DLPack data type of a buffer
+static bool buffer_dtype(const Py_buffer *view, dlpack::dtype &dt) {
     char format_c = 'B';
     const char *format_str = view->format;
     if (format_str)
@@ -187,11 +276,11 @@ static PyObject *dlpack_from_buffer_protocol(PyObject *o, bool ro) {
     if (skip_first && format_str)
         format_c = *++format_str;
 
-    bool is_complex = format_str[0] == 'Z';
+    bool is_complex = format_str && format_str[0] == 'Z';
     if (is_complex)
         format_c = *++format_str;
 
-    dlpack::dtype dt { };
+    dt = { };
     bool fail = format_str && format_str[1] != '\0';
 
     if (!fail) {
@@ -230,7 +319,21 @@ static PyObject *dlpack_from_buffer_protocol(PyObject *o, bool ro) {
         dt.bits = (uint8_t) (view->itemsize * 8);
     }
 
-    if (fail) {
+    return !fail;
+}
+
+static PyObject *dlpack_from_buffer_protocol(PyObject *o, bool ro) {
+    scoped_pymalloc<Py_buffer> view;
+    scoped_pymalloc<managed_dltensor> mt;
+
+    if (PyObject_GetBuffer(o, view.get(),
+                           ro ? PyBUF_RECORDS_RO : PyBUF_RECORDS)) {
+        PyErr_Clear();
+        return nullptr;
+    }
+
+    dlpack::dtype dt;
+    if (!buffer_dtype(view.get(), dt)) {
         PyBuffer_Release(view.get());
         return nullptr;
     }
@@ -284,6 +387,77 @@ static PyObject *dlpack_from_buffer_protocol(PyObject *o, bool ro) {
     });
 }
 
+/// ndarray imported via the buffer protocol, stored in a single allocation
+struct ndarray_buffer {
+    ndarray_handle handle;
+    managed_dltensor mt;
+    Py_buffer view;
+    int64_t dims[1]; // shape, followed by the strides
+};
+
+/**
+ * Import a NumPy array directly via the buffer protocol, which avoids the
+ * DLPack capsule and several separate allocations. The caller must set the
+ * 'self' and 'ro' fields of the returned handle, or release it using
+ * ndarray_dec_ref().
+ */
+static ndarray_handle *ndarray_import_buffer(PyObject *o, bool ro) noexcept {
+    Py_buffer view;
+    if (PyObject_GetBuffer(o, &view, ro ? PyBUF_RECORDS_RO : PyBUF_RECORDS)) {
+        PyErr_Clear();
+        return nullptr;
+    }
+
+    dlpack::dtype dt;
+    bool fail = !buffer_dtype(&view, dt);
+    for (int i = 0; i < view.ndim && !fail; ++i)
+        fail = view.strides[i] % view.itemsize != 0;
+
+    size_t ndim = (size_t) view.ndim,
+           size = sizeof(ndarray_buffer) +
+                  sizeof(int64_t) * (ndim ? 2 * ndim - 1 : 0);
+
+    ndarray_buffer *b = fail ? nullptr : (ndarray_buffer *) PyMem_Malloc(size);
+    if (!b) {
+        PyBuffer_Release(&view);
+        return nullptr;
+    }
+
+    int64_t *shape = b->dims, *strides = b->dims + ndim;
+    for (size_t i = 0; i < ndim; ++i) {
+        shape[i] = (int64_t) view.shape[i];
+        strides[i] = (int64_t) (view.strides[i] / view.itemsize);
+    }
+
+    b->view = view;
+    b->mt.dltensor.data = view.buf;
+    b->mt.dltensor.device = { device::cpu::value, 0 };
+    b->mt.dltensor.ndim = view.ndim;
+    b->mt.dltensor.dtype = dt;
+    b->mt.dltensor.byte_offset = 0;
+    b->mt.dltensor.shape = shape;
+    b->mt.dltensor.strides = strides;
+    b->mt.manager_ctx = &b->view;
+
+    // The memory is released along with the handle by ndarray_dec_ref()
+    b->mt.deleter = [](managed_dltensor *mt) {
+        PyBuffer_Release((Py_buffer *) mt->manager_ctx);
+    };
+
+    ndarray_handle *th = &b->handle;
+    th->ndarray = &b->mt;
+    th->refcount = 1;
+    th->owner = nullptr;
+    th->self = nullptr;
+    th->free_shape = false;
+    th->free_strides = false;
+    th->call_deleter = true;
+    th->free_data = false;
+    th->ro = ro;
+    th->payload_free = nullptr;
+    return th;
+}
+
 bool ndarray_check(PyObject *o) noexcept {
     PyTypeObject *tp = Py_TYPE(o);
 
@@ -307,61 +481,594 @@ bool ndarray_check(PyObject *o) noexcept {
     return result;
 }
 
+/// Pick the framework-specific 'to_dlpack' fallback based on the type's module
+static ndarray_source ndarray_framework_source(PyTypeObject *tp) noexcept {
+    ndarray_source source = ndarray_source::unknown;
+
+    PyObject *name = PyObject_GetAttrString((PyObject *) tp, "__module__");
+    const char *module_name =
+        name ? PyUnicode_AsUTF8AndSize(name, nullptr) : nullptr;
+
+    if (!module_name)
+        PyErr_Clear();
+    else if (strcmp(module_name, "numpy") == 0)
+        source = ndarray_source::numpy;
+    else if (strncmp(module_name, "tensorflow.", 11) == 0)
+        source = ndarray_source::tensorflow;
+    else if (strcmp(module_name, "torch") == 0)
+        source = ndarray_source::pytorch;
+    else if (strncmp(module_name, "jaxlib", 6) == 0)
+        source = ndarray_source::jax;
+
+    Py_XDECREF(name);
+    return source;
+}
+
+bool ndarray_set_stream(bool set, intptr_t stream,
+                        intptr_t *prev_stream) noexcept {
+    bool prev_set = ndarray_stream_tls.set;
+    if (prev_stream)
+        *prev_stream = ndarray_stream_tls.value;
+    ndarray_stream_tls.set = set;
+    ndarray_stream_tls.value = stream;
+    return prev_set;
+}
+
+/// Does 'o.__dlpack_device__()' report a device with stream semantics?
+static bool ndarray_has_streams(PyObject *o) noexcept {
+    PyObject *device = PyObject_CallMethod(o, "__dlpack_device__", nullptr);
+    long device_type = -1;
+
+    if (device && PyTuple_Check(device) && PyTuple_Size(device) == 2)
+        device_type = PyLong_AsLong(PyTuple_GetItem(device, 0));
+
+    if (PyErr_Occurred())
+        PyErr_Clear();
+
+    Py_XDECREF(device);
+    return device_type == device::cuda::value ||
+           device_type == device::cuda_managed::value ||
+           device_type == device::rocm::value;
+}
+
+/// Keyword arguments of the '__dlpack__()' call (new reference)
+static PyObject *ndarray_dlpack_kwargs(PyObject *o, bool versioned) noexcept {
+    nb_internals *internals_ = internals;
+    PyObject *kwargs = nullptr;
+
+    if (versioned) {
+        kwargs = internals_->ndarray_dlpack_kwargs;
+        if (NB_UNLIKELY(!kwargs)) {
+            kwargs = Py_BuildValue("{s:(ii)}", "max_version", 1, 0);
+            if (!kwargs)
+                return nullptr;
+            lock_internals guard(internals_);
+            if (internals_->ndarray_dlpack_kwargs) {
+                Py_DECREF(kwargs);
+                kwargs = internals_->ndarray_dlpack_kwargs;
+            } else {
+                internals_->ndarray_dlpack_kwargs = kwargs;
+            }
+        }
+        Py_INCREF(kwargs);
+    }
+
+    // Let the producer order its work with respect to the consumer's stream
+    if (ndarray_stream_tls.set && ndarray_has_streams(o)) {
+        PyObject *kwargs_2 = kwargs ? PyDict_Copy(kwargs) : PyDict_New(),
+                 *stream = PyLong_FromSsize_t(ndarray_stream_tls.value);
+        Py_XDECREF(kwargs);
+        kwargs = kwargs_2;
+
+        if (!kwargs || !stream ||
+            PyDict_SetItemString(kwargs, "stream", stream)) {
+            Py_CLEAR(kwargs);
+        }
+        Py_XDECREF(stream);
+    }
+
+    return kwargs;
+}
+
+/// Try to obtain a DLPack capsule from 'o' in the specified way
+static PyObject *ndarray_capsule(PyObject *o, ndarray_source source,
+                                 const ndarray_req *req) noexcept {
+    nb_internals *internals_ = internals;
+    PyObject *result = nullptr;
+
+    switch (source) {
+        case ndarray_source::method:
+        case ndarray_source::method_legacy: {
+                PyObject *name = internals_->ndarray_dlpack_str;
+                if (NB_UNLIKELY(!name)) {
+                    name = PyUnicode_InternFromString("__dlpack__");
+                    if (!name)
+                        break;
+                    lock_internals guard(internals_);
+                    if (internals_->ndarray_dlpack_str) {
+                        Py_DECREF(name);
+                        name = internals_->ndarray_dlpack_str;
+                    } else {
+                        internals_->ndarray_dlpack_str = name;
+                    }
+                }
+
+                /* Request a versioned capsule. Producers predating DLPack 1.0
+                   reject the 'max_version' argument and are instead called
+                   via 'method_legacy'. */
+                PyObject *kwargs = ndarray_dlpack_kwargs(
+                    o, source == ndarray_source::method);
+                if (PyErr_Occurred())
+                    break;
+
+                if (!kwargs) {
+                    result = PyObject_CallMethodObjArgs(o, name, nullptr);
+                } else {
+                    PyObject *func = PyObject_GetAttr(o, name),
+                             *args = func ? PyTuple_New(0) : nullptr;
+                    if (args)
+                        result = PyObject_Call(func, args, kwargs);
+                    Py_XDECREF(args);
+                    Py_XDECREF(func);
+                    Py_DECREF(kwargs);
+                }
+            }
+            break;
+
+        case ndarray_source::tensorflow:
+        case ndarray_source::pytorch:
+        case ndarray_source::jax: {
+                static const char *packages[] = {
+                    "tensorflow.experimental.dlpack", "torch.utils.dlpack",
+                    "jax.dlpack"
+                };
+
+                size_t index = (size_t) source - (size_t) ndarray_source::tensorflow;
+                PyObject *to_dlpack = internals_->ndarray_to_dlpack[index];
+                if (NB_UNLIKELY(!to_dlpack)) {
+                    PyObject *package = PyImport_ImportModule(packages[index]);
+                    if (package) {
+                        to_dlpack = PyObject_GetAttrString(package, "to_dlpack");
+                        Py_DECREF(package);
+                    }
+                    if (!to_dlpack)
+                        break;
+                    lock_internals guard(internals_);
+                    if (internals_->ndarray_to_dlpack[index]) {
+                        Py_DECREF(to_dlpack);
+                        to_dlpack = internals_->ndarray_to_dlpack[index];
+                    } else {
+                        internals_->ndarray_to_dlpack[index] = to_dlpack;
+                    }
+                }
+                result = PyObject_CallFunctionObjArgs(to_dlpack, o, nullptr);
+            }
+            break;
+
+        case ndarray_source::buffer:
+            return dlpack_from_buffer_protocol(o, req->req_ro);
+
+        default:
+            break;
+    }
+
+    if (!result)
+        PyErr_Clear();
+
+    return result;
+}
+
+/// IEEE 754 half precision and bfloat16 values, converted via 'float'
+struct float16_bits { uint16_t value; };
+struct bfloat16_bits { uint16_t value; };
+
+static float float16_to_float(float16_bits h) {
+    uint32_t sign = (uint32_t) (h.value & 0x8000) << 16,
+             exp = (h.value >> 10) & 0x1F, mant = h.value & 0x3FF, bits;
+
+    if (exp == 0x1F) {         // infinity/NaN
+        bits = sign | 0x7F800000 | (mant << 13);
+    } else if (exp == 0) {     // zero/subnormal (mant * 2^-24)
+        float f = (float) mant * 5.9604644775390625e-8f;
+        return sign ? -f : f;
+    } else {
+        bits = sign | ((exp + 112) << 23) | (mant << 13);
+    }
+
+    float f;
+    memcpy(&f, &bits, sizeof(float));
+    return f;
+}
+
+/// Round to the nearest half precision value (ties to even)
+static float16_bits float_to_float16(float f) {
+    uint32_t x;
+    memcpy(&x, &f, sizeof(float));
+    uint16_t sign = (uint16_t) ((x >> 16) & 0x8000);
+    x &= 0x7FFFFFFF;
+
+    if (x > 0x7F800000)        // NaN
+        return { (uint16_t) (sign | 0x7E00) };
+    else if (x >= 0x477FF000)  // infinity, or rounds to it
+        return { (uint16_t) (sign | 0x7C00) };
+    else if (x < 0x38800000)   // zero/subnormal
+        return { (uint16_t) (sign | (uint16_t) std::nearbyint(
+                                        std::fabs(f) * 16777216.f)) };
+
+    // Rebias the exponent and round the mantissa
+    x += 0xC8000FFF + ((x >> 13) & 1);
+    return { (uint16_t) (sign | (x >> 13)) };
+}
+
+static float bfloat16_to_float(bfloat16_bits h) {
+    uint32_t bits = (uint32_t) h.value << 16;
+    float f;
+    memcpy(&f, &bits, sizeof(float));
+    return f;
+}
+
+static bfloat16_bits float_to_bfloat16(float f) {
+    uint32_t x;
+    memcpy(&x, &f, sizeof(float));
+    if ((x & 0x7FFFFFFF) > 0x7F800000) // NaN
+        return { (uint16_t) ((x >> 16) | 0x40) };
+    x += 0x7FFF + ((x >> 16) & 1);
+    return { (uint16_t) (x >> 16) };
+}
+
+/// Convert a value, saturating float -> int conversions (NaN becomes zero)
+template <typename Dst, typename Src> NB_INLINE Dst convert_value(Src v) {
+    if constexpr (std::is_same_v<Src, float16_bits>) {
+        return convert_value<Dst>(float16_to_float(v));
+    } else if constexpr (std::is_same_v<Src, bfloat16_bits>) {
+        return convert_value<Dst>(bfloat16_to_float(v));
+    } else if constexpr (std::is_same_v<Dst, float16_bits>) {
+        return float_to_float16(convert_value<float>(v));
+    } else if constexpr (std::is_same_v<Dst, bfloat16_bits>) {
+        return float_to_bfloat16(convert_value<float>(v));
+    } else if constexpr (std::is_same_v<Dst, bool>) {
+        return v != Src(0);
+    } else if constexpr (std::is_floating_point_v<Src> &&
+                         std::is_integral_v<Dst>) {
+        if (!(v == v))
+            return Dst(0);
+        else if (v <= (Src) std::numeric_limits<Dst>::min())
+            return std::numeric_limits<Dst>::min();
+        else if (v >= (Src) std::numeric_limits<Dst>::max())
+            return std::numeric_limits<Dst>::max();
+        return (Dst) v;
+    } else {
+        return (Dst) v;
+    }
+}
+
+/// Convert 'size' elements separated by 'stride' into contiguous output
+template <typename Dst, typename Src>
+static void convert_kernel(void *out_, const void *in_, size_t size,
+                           int64_t stride) {
+    Dst *out = (Dst *) out_;
+    const Src *in = (const Src *) in_;
+
+    // Separate loop for the common unit-stride case, which vectorizes
+    if (stride == 1) {
+        for (size_t i = 0; i < size; ++i)
+            out[i] = convert_value<Dst>(in[i]);
+    } else {
+        for (size_t i = 0; i < size; ++i)
+            out[i] = convert_value<Dst>(in[(int64_t) i * stride]);
+    }
+}
+
+using convert_fn = void (*)(void *, const void *, size_t, int64_t);
+
+#define NB_CONVERT_ROW(Dst)                                                   \
+    { convert_kernel<Dst, bool>, convert_kernel<Dst, int8_t>,                \
+      convert_kernel<Dst, int16_t>, convert_kernel<Dst, int32_t>,            \
+      convert_kernel<Dst, int64_t>, convert_kernel<Dst, uint8_t>,            \
+      convert_kernel<Dst, uint16_t>, convert_kernel<Dst, uint32_t>,          \
+      convert_kernel<Dst, uint64_t>, convert_kernel<Dst, float>,             \
+      convert_kernel<Dst, double>, convert_kernel<Dst, float16_bits>,        \
+      convert_kernel<Dst, bfloat16_bits> }
+
+/// Kernels indexed by the output and input type (see convert_type())
+static const convert_fn convert_kernels[13][13] = {
+    NB_CONVERT_ROW(bool), NB_CONVERT_ROW(int8_t), NB_CONVERT_ROW(int16_t),
+    NB_CONVERT_ROW(int32_t), NB_CONVERT_ROW(int64_t), NB_CONVERT_ROW(uint8_t),
+    NB_CONVERT_ROW(uint16_t), NB_CONVERT_ROW(uint32_t),
+    NB_CONVERT_ROW(uint64_t), NB_CONVERT_ROW(float), NB_CONVERT_ROW(double),
+    NB_CONVERT_ROW(float16_bits), NB_CONVERT_ROW(bfloat16_bits)
+};
+
+#undef NB_CONVERT_ROW
+
+/// Row/column of 'convert_kernels' for a dtype, or -1 if unsupported
+static int convert_type(dlpack::dtype dt) {
+    int log2_bytes;
+    switch (dt.bits) {
+        case 8: log2_bytes = 0; break;
+        case 16: log2_bytes = 1; break;
+        case 32: log2_bytes = 2; break;
+        case 64: log2_bytes = 3; break;
+        default: return -1;
+    }
+
+    if (dt.lanes != 1)
+        return -1;
+
+    switch ((dlpack::dtype_code) dt.code) {
+        case dlpack::dtype_code::Bool: return dt.bits == 8 ? 0 : -1;
+        case dlpack::dtype_code::Int: return 1 + log2_bytes;
+        case dlpack::dtype_code::UInt: return 5 + log2_bytes;
+        case dlpack::dtype_code::Float:
+            return log2_bytes >= 2 ? 7 + log2_bytes : (log2_bytes == 1 ? 11 : -1);
+        case dlpack::dtype_code::Bfloat: return dt.bits == 16 ? 12 : -1;
+        default: return -1;
+    }
+}
+
+/**
+ * Convert the entries of a strided array with the given shape and strides (in
+ * elements) into contiguous C- or F-ordered output using 'kernel'
+ */
+static void convert_strided(convert_fn kernel, uint8_t *out,
+                            const uint8_t *in, size_t ndim, const size_t *shape,
+                            const int64_t *strides_in, size_t itemsize_in,
+                            size_t itemsize_out, bool f_order) {
+    scoped_scratch<size_t> index(ndim);
+    for (size_t i = 0; i < ndim; ++i)
+        index[i] = 0;
+
+    /* Visit the output in memory order: the innermost dimension is
+       processed by the kernel, and 'index' tracks the remaining ones */
+    size_t inner = ndim == 0 ? 0 : (f_order ? 0 : ndim - 1),
+           inner_size = ndim == 0 ? 1 : shape[inner];
+    int64_t inner_stride = ndim == 0 ? 0 : strides_in[inner];
+
+    while (true) {
+        kernel(out, in, inner_size, inner_stride);
+        out += inner_size * itemsize_out;
+
+        size_t k = 0;
+        for (; k + 1 < ndim; ++k) {
+            // k-th outer dimension, starting with the fastest one
+            size_t d = f_order ? k + 1 : ndim - 2 - k;
+            int64_t step = strides_in[d] * (int64_t) itemsize_in;
+            if (++index[d] < shape[d]) {
+                in += step;
+                break;
+            }
+            in -= (int64_t) (shape[d] - 1) * step;
+            index[d] = 0;
+        }
+
+        if (k + 1 >= ndim)
+            break;
+    }
+}
+
+/**
+ * Copy a CPU array into a pooled C- or F-contiguous array of the requested
+ * dtype. Returns nullptr if the dtypes are unsupported or allocation fails.
+ */
+static ndarray_handle *ndarray_convert(const dlpack::dltensor &t,
+                                       const ndarray_req *req) noexcept {
+    dlpack::dtype dt = req->req_dtype ? req->dtype : t.dtype;
+    int type_in = convert_type(t.dtype), type_out = convert_type(dt);
+    if (type_in < 0 || type_out < 0)
+        return nullptr;
+
+    convert_fn kernel = convert_kernels[type_out][type_in];
+    size_t ndim = (size_t) t.ndim,
+           itemsize_in = t.dtype.bits / 8,
+           itemsize_out = dt.bits / 8;
+    bool f_order = req->req_order == 'F';
+
+    try {
+        scoped_scratch<size_t> shape(ndim);
+        scoped_scratch<int64_t> strides_in(ndim);
+
+        size_t size = 1;
+        int64_t accum = 1;
+        for (size_t i = ndim; i > 0; --i) {
+            shape[i - 1] = (size_t) t.shape[i - 1];
+            strides_in[i - 1] = t.strides ? t.strides[i - 1] : accum;
+            accum *= t.shape[i - 1];
+            size *= shape[i - 1];
+        }
+
+        ndarray_handle *th = ndarray_alloc(ndim, shape.get(), &dt, req->req_ro,
+                                           device::cpu::value, 0);
+
+        dlpack::dltensor &r = th->ndarray->dltensor;
+        if (f_order) {
+            int64_t prod = 1;
+            for (size_t i = 0; i < ndim; ++i) {
+                r.strides[i] = prod;
+                prod *= r.shape[i];
+            }
+        }
+
+        if (size != 0)
+            convert_strided(kernel, (uint8_t *) r.data,
+                            (const uint8_t *) t.data + t.byte_offset, ndim,
+                            shape.get(), strides_in.get(), itemsize_in,
+                            itemsize_out, f_order);
+
+        return th;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void ndarray_copy_to(ndarray_handle *th, void *out, const dlpack::dtype *dtype,
+                     char order, size_t threads) {
+    const dlpack::dltensor &t = th->ndarray->dltensor;
+
+    if (t.device.device_type != device::cpu::value)
+        raise("nanobind::ndarray_copy(): the array must reside in CPU memory!");
+
+    int type_in = convert_type(t.dtype), type_out = convert_type(*dtype);
+    if (type_in < 0 || type_out < 0)
+        raise("nanobind::ndarray_copy(): unsupported dtype!");
+
+    convert_fn kernel = convert_kernels[type_out][type_in];
+    size_t ndim = (size_t) t.ndim,
+           itemsize_in = t.dtype.bits / 8,
+           itemsize_out = dtype->bits / 8;
+    bool f_order = order == 'F';
+
+    scoped_scratch<size_t> shape(ndim);
+    scoped_scratch<int64_t> strides_in(ndim);
+
+    size_t size = 1;
+    int64_t accum = 1;
+    for (size_t i = ndim; i > 0; --i) {
+        shape[i - 1] = (size_t) t.shape[i - 1];
+        strides_in[i - 1] = t.strides ? t.strides[i - 1] : accum;
+        accum *= t.shape[i - 1];
+        size *= shape[i - 1];
+    }
+
+    if (size == 0)
+        return;
+
+    const uint8_t *in = (const uint8_t *) t.data + t.byte_offset;
+    uint8_t *out_u8 = (uint8_t *) out;
+
+    /* Workers process slices along the slowest dimension of the output,
+       each of which occupies a contiguous part of 'out' */
+    size_t outer = f_order ? ndim - 1 : 0,
+           outer_size = ndim == 0 ? 1 : shape[outer],
+           slice_bytes = (size / outer_size) * itemsize_out;
+
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+
+    // Small copies aren't worth the cost of starting threads
+    if (threads > size / 65536)
+        threads = size / 65536;
+
+    // The caller's ndarray handle keeps the source memory alive
+    gil_scoped_release release;
+
+    parallel_run(outer_size, threads, [&](size_t start, size_t end) {
+        scoped_scratch<size_t> shape_chunk(ndim);
+        for (size_t i = 0; i < ndim; ++i)
+            shape_chunk[i] = shape[i];
+        if (ndim)
+            shape_chunk[outer] = end - start;
+
+        int64_t offset =
+            ndim ? (int64_t) start * strides_in[outer] * (int64_t) itemsize_in : 0;
+
+        convert_strided(kernel, out_u8 + start * slice_bytes, in + offset,
+                        ndim, shape_chunk.get(), strides_in.get(), itemsize_in,
+                        itemsize_out, f_order);
+    });
+}
 
 ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
                                bool convert, cleanup_list *cleanup) noexcept {
     object capsule;
     bool is_pycapsule = PyCapsule_CheckExact(o);
 
-    // If this is not a capsule, try calling o.__dlpack__()
+    // Set when the ndarray was imported without a capsule (NumPy)
+    struct direct_handle {
+        ndarray_handle *th = nullptr;
+        ~direct_handle() { ndarray_dec_ref(th); }
+    } direct;
+
     if (!is_pycapsule) {
-        capsule = steal(PyObject_CallMethod(o, "__dlpack__", nullptr));
+        /* Try the way that worked for the previous instance of this type
+           first. Otherwise, probe o.__dlpack__() (with and without version
+           negotiation), a framework-specific 'to_dlpack' function, and the
+           buffer protocol (in this order) and remember the first one that
+           succeeds for the type. */
+        nb_internals *internals_ = internals;
+        PyTypeObject *tp = Py_TYPE(o);
+        ndarray_source cached = ndarray_source::unknown;
 
-        if (!capsule.is_valid()) {
-            PyErr_Clear();
-            PyTypeObject *tp = Py_TYPE(o);
-
-            try {
-                const char *module_name =
-                    borrow<str>(handle(tp).attr("__module__")).c_str();
-
-                object package;
-                if (strncmp(module_name, "tensorflow.", 11) == 0)
-                    package = module_::import_("tensorflow.experimental.dlpack");
-                else if (strcmp(module_name, "torch") == 0)
-                    package = module_::import_("torch.utils.dlpack");
-                else if (strncmp(module_name, "jaxlib", 6) == 0)
-                    package = module_::import_("jax.dlpack");
-
-                if (package.is_valid())
-                    capsule = package.attr("to_dlpack")(handle(o));
-            } catch (...) {
-                capsule.reset();
-            }
+        {
+            lock_internals guard(internals_);
+            nb_ptr_map::iterator it = internals_->ndarray_sources.find(tp);
+            if (it != internals_->ndarray_sources.end())
+                cached = (ndarray_source) (uintptr_t) it->second;
         }
 
-        // Try creating a ndarray via the buffer protocol
-        if (!capsule.is_valid())
-            capsule = steal(dlpack_from_buffer_protocol(o, req->req_ro));
+        auto fetch = [&](ndarray_source source) -> bool {
+            if (source == ndarray_source::numpy)
+                direct.th = ndarray_import_buffer(o, req->req_ro);
+            else
+                capsule = steal(ndarray_capsule(o, source, req));
+            return direct.th || capsule.is_valid();
+        };
+
+        if (!(cached != ndarray_source::unknown && fetch(cached))) {
+            // NumPy arrays are best imported directly
+            ndarray_source framework = ndarray_framework_source(tp);
+            bool is_numpy = framework == ndarray_source::numpy;
+
+            ndarray_source candidates[] = {
+                is_numpy ? framework : ndarray_source::unknown,
+                ndarray_source::method,
+                ndarray_source::method_legacy,
+                is_numpy ? ndarray_source::unknown : framework,
+                ndarray_source::buffer
+            };
+
+            for (ndarray_source source : candidates) {
+                if (source == ndarray_source::unknown || source == cached)
+                    continue;
+
+                if (fetch(source)) {
+                    lock_internals guard(internals_);
+                    internals_->ndarray_sources.try_emplace(
+                        tp, (void *) (uintptr_t) source);
+                    break;
+                }
+            }
+        }
 
-        if (!capsule.is_valid())
+        if (!direct.th && !capsule.is_valid())
             return nullptr;
     } else {
         capsule = borrow(o);
     }
 
     // Extract the pointer underlying the capsule
-    void *ptr = PyCapsule_GetPointer(capsule.ptr(), "dltensor");
-    if (!ptr) {
-        PyErr_Clear();
-        return nullptr;
+    void *ptr;
+    managed_dltensor_versioned *mtv = nullptr;
+    if (direct.th) {
+        ptr = direct.th->ndarray;
+    } else {
+        const char *name = PyCapsule_GetName(capsule.ptr());
+        bool versioned = name && strcmp(name, "dltensor_versioned") == 0;
+        ptr = PyCapsule_GetPointer(capsule.ptr(), versioned
+                                                      ? "dltensor_versioned"
+                                                      : "dltensor");
+        if (!ptr) {
+            PyErr_Clear();
+            return nullptr;
+        }
+
+        if (versioned) {
+            mtv = (managed_dltensor_versioned *) ptr;
+
+            /* Reject unknown ABI versions, read-only data for writable
+               requests, and copies whose modification would go unnoticed */
+            if (mtv->version.major > 1 ||
+                (!req->req_ro && (mtv->flags & (dltensor_flag_read_only |
+                                                dltensor_flag_is_copied))))
+                return nullptr;
+        }
     }
 
     // Check if the ndarray satisfies the requirements
-    dlpack::dltensor &t = ((managed_dltensor *) ptr)->dltensor;
+    dlpack::dltensor &t =
+        mtv ? mtv->dltensor : ((managed_dltensor *) ptr)->dltensor;
 
     bool pass_dtype = true, pass_device = true,
-         pass_shape = true, pass_order = true;
+         pass_shape = true, pass_order = true, pass_align = true;
 
     if (req->req_dtype)
         pass_dtype = t.dtype == req->dtype;
@@ -387,49 +1094,52 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
     for (uint32_t i = 0; i < req->ndim; ++i)
         size *= t.shape[i];
 
-    scoped_pymalloc<int64_t> strides((size_t) t.ndim);
-    if ((req->req_order || !t.strides) && t.ndim > 0) {
-        int64_t accum = 1;
-
-        if (req->req_order == 'C' || !t.strides) {
-            for (size_t i = (size_t) (t.ndim - 1);;) {
-                strides[i] = accum;
-                accum *= t.shape[i];
-                if (i == 0)
+    if (req->req_order && size != 0) { // Tolerate any strides if empty
+        if (!t.strides) {
+            /* The provided tensor does not have a valid strides
+               field, which implies a C-style ordering. */
+            pass_order = req->req_order == 'C';
+        } else {
+            // Compare against the strides of a C/F-contiguous array
+            int64_t accum = 1;
+            size_t ndim = (size_t) t.ndim;
+            for (size_t j = 0; j < ndim; ++j) {
+                size_t i = req->req_order == 'C' ? ndim - 1 - j : j;
+                if (t.shape[i] != 1 && accum != t.strides[i]) {
+                    pass_order = false;
                     break;
-                --i;
-            }
-        } else if (req->req_order == 'F') {
-            for (size_t i = 0; i < (size_t) t.ndim; ++i) {
-                strides[i] = accum;
+                }
                 accum *= t.shape[i];
             }
-        } else {
-            pass_order = false;
         }
+    }
 
-        if (req->req_order && size != 0) { // Tolerate any strides if empty
-            if (!t.strides) {
-                /* The provided tensor does not have a valid strides
-                   field, which implies a C-style ordering. */
-                pass_order = req->req_order == 'C';
-            } else {
-                for (size_t i = 0; i < (size_t) t.ndim; ++i) {
-                    if (t.shape[i] != 1 && strides[i] != t.strides[i]) {
-                        pass_order = false;
-                        break;
-                    }
-                }
-            }
-        }
+    if (req->req_align) {
+        int64_t nelem = 1; // Empty arrays are never dereferenced
+        for (int32_t i = 0; i < t.ndim; ++i)
+            nelem *= t.shape[i];
+        pass_align = nelem == 0 ||
+            ((uintptr_t) t.data + t.byte_offset) % req->req_align == 0;
     }
 
     bool refused_conversion = t.dtype.code == (uint8_t) dlpack::dtype_code::Complex &&
                               req->dtype.code != (uint8_t) dlpack::dtype_code::Complex;
 
     // Support implicit conversion of 'dtype' and order
-    if (pass_device && pass_shape && (!pass_dtype || !pass_order) && convert &&
-        capsule.ptr() != o && !refused_conversion) {
+    if (pass_device && pass_shape && (!pass_dtype || !pass_order || !pass_align) &&
+        convert && !refused_conversion) {
+        /* Convert basic CPU arrays directly instead of via their framework.
+           The result is allocated from the 64-byte aligned memory pool. */
+        if (t.device.device_type == device::cpu::value) {
+            ndarray_handle *h = ndarray_convert(t, req);
+            if (h)
+                return h;
+        }
+
+        // Framework conversions don't provide any alignment guarantees
+        if (capsule.ptr() == o || !pass_align)
+            return nullptr;
+
         PyTypeObject *tp = Py_TYPE(o);
         str module_name_o = borrow<str>(handle(tp).attr("__module__"));
         const char *module_name = module_name_o.c_str();
@@ -451,6 +1161,7 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
                 case (uint8_t) dlpack::dtype_code::Int: prefix = "int"; break;
                 case (uint8_t) dlpack::dtype_code::UInt: prefix = "uint"; break;
                 case (uint8_t) dlpack::dtype_code::Float: prefix = "float"; break;
+                case (uint8_t) dlpack::dtype_code::Bfloat: prefix = "bfloat"; break;
                 case (uint8_t) dlpack::dtype_code::Complex: prefix = "complex"; break;
                 default:
                     return nullptr;
@@ -487,9 +1198,33 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
         }
     }
 
-    if (!pass_dtype || !pass_device || !pass_shape || !pass_order)
+    if (!pass_dtype || !pass_device || !pass_shape || !pass_order || !pass_align)
         return nullptr;
 
+    if (direct.th) {
+        ndarray_handle *th = direct.th;
+        direct.th = nullptr;
+        th->refcount = 0;
+        th->self = o;
+        Py_INCREF(o);
+        return th;
+    }
+
+    // Expose versioned tensors through an adaptor calling their deleter
+    if (mtv) {
+        scoped_pymalloc<managed_dltensor> adaptor;
+        adaptor->dltensor = t;
+        adaptor->manager_ctx = mtv;
+        adaptor->deleter = [](managed_dltensor *mt) {
+            managed_dltensor_versioned *mtv_ =
+                (managed_dltensor_versioned *) mt->manager_ctx;
+            if (mtv_->deleter)
+                mtv_->deleter(mtv_);
+            PyMem_Free(mt);
+        };
+        ptr = adaptor.release();
+    }
+
     // Create a reference-counted wrapper
     scoped_pymalloc<ndarray_handle> result;
     result->ndarray = (managed_dltensor *) ptr;
@@ -497,7 +1232,9 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
     result->owner = nullptr;
     result->free_shape = false;
     result->call_deleter = true;
+    result->free_data = false;
     result->ro = req->req_ro;
+    result->payload_free = nullptr;
     if (is_pycapsule) {
         result->self = nullptr;
     } else {
@@ -506,15 +1243,23 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
     }
 
     // Ensure that the strides member is always initialized
-    if (t.strides) {
+    dlpack::dltensor &rt = result->ndarray->dltensor;
+    if (rt.strides) {
         result->free_strides = false;
     } else {
+        scoped_pymalloc<int64_t> strides((size_t) rt.ndim);
+        int64_t accum = 1;
+        for (size_t i = (size_t) rt.ndim; i > 0; --i) {
+            strides[i - 1] = accum;
+            accum *= rt.shape[i - 1];
+        }
         result->free_strides = true;
-        t.strides = strides.release();
+        rt.strides = strides.release();
     }
 
     // Mark the dltensor capsule as "consumed"
-    if (PyCapsule_SetName(capsule.ptr(), "used_dltensor") ||
+    if (PyCapsule_SetName(capsule.ptr(), mtv ? "used_dltensor_versioned"
+                                             : "used_dltensor") ||
         PyCapsule_SetDestructor(capsule.ptr(), nullptr))
         check(false, "nanobind::detail::ndarray_import(): could not mark "
                      "dltensor capsule as consumed!");
@@ -522,6 +1267,83 @@ ndarray_handle *ndarray_import(PyObject *o, const ndarray_req *req,
     return result.release();
 }
 
+/// Header preceding each block of the ndarray_alloc() pool
+struct alignas(64) ndarray_block {
+    ndarray_block *next; // free list link
+    void *base;          // address returned by malloc()
+    uint32_t size_class; // 'nb_ndarray_pool::classes' if not pooled
+};
+
+#if defined(NB_FREE_THREADED)
+struct lock_pool {
+    NB_INLINE lock_pool(nb_ndarray_pool &p) : p(p) { PyMutex_Lock(&p.mutex); }
+    NB_INLINE ~lock_pool() { PyMutex_Unlock(&p.mutex); }
+    nb_ndarray_pool &p;
+};
+#else
+struct lock_pool {
+    NB_INLINE lock_pool(nb_ndarray_pool &) { }
+};
+#endif
+
+/// Obtain a 64-byte aligned block with room for 'size' bytes
+static void *ndarray_pool_acquire(size_t size) {
+    using pool_t = nb_ndarray_pool;
+    nb_ndarray_pool &pool = internals->ndarray_pool;
+
+    uint32_t size_class = 0;
+    while (size_class < pool_t::classes &&
+           ((size_t) 1 << (pool_t::min_shift + size_class)) < size)
+        size_class++;
+
+    if (size_class < pool_t::classes) {
+        lock_pool guard(pool);
+        ndarray_block *block = (ndarray_block *) pool.free_list[size_class];
+        if (block) {
+            pool.free_list[size_class] = block->next;
+            pool.free_count[size_class]--;
+            return block + 1;
+        }
+        size = (size_t) 1 << (pool_t::min_shift + size_class);
+    }
+
+    if (size > SIZE_MAX - sizeof(ndarray_block) - alignof(ndarray_block))
+        throw std::bad_alloc();
+
+    void *base = malloc(size + sizeof(ndarray_block) + alignof(ndarray_block));
+    if (!base)
+        throw std::bad_alloc();
+
+    uintptr_t aligned = ((uintptr_t) base + alignof(ndarray_block)) &
+                        ~(uintptr_t) (alignof(ndarray_block) - 1);
+    ndarray_block *block = (ndarray_block *) aligned;
+    block->next = nullptr;
+    block->base = base;
+    block->size_class = size_class;
+    return block + 1;
+}
+
+/// Return a block obtained from ndarray_pool_acquire()
+static void ndarray_pool_release(void *ptr) noexcept {
+    using pool_t = nb_ndarray_pool;
+    nb_ndarray_pool &pool = internals->ndarray_pool;
+    ndarray_block *block = (ndarray_block *) ptr - 1;
+    uint32_t size_class = block->size_class;
+
+    if (size_class < pool_t::classes) {
+        size_t limit = pool_t::budget >> (pool_t::min_shift + size_class);
+        lock_pool guard(pool);
+        if (pool.free_count[size_class] < limit) {
+            block->next = (ndarray_block *) pool.free_list[size_class];
+            pool.free_list[size_class] = block;
+            pool.free_count[size_class]++;
+            return;
+        }
+    }
+
+    free(block->base);
+}
+
 dlpack::dltensor *ndarray_inc_ref(ndarray_handle *th) noexcept {
     if (!th)
         return nullptr;
@@ -529,6 +1351,33 @@ dlpack::dltensor *ndarray_inc_ref(ndarray_handle *th) noexcept {
     return &th->ndarray->dltensor;
 }
 
+/// Release the resources of an ndarray handle (requires the GIL)
+static void ndarray_free(void *p) noexcept {
+    ndarray_handle *th = (ndarray_handle *) p;
+    Py_XDECREF(th->owner);
+    Py_XDECREF(th->self);
+    managed_dltensor *mt = th->ndarray;
+    if (th->free_shape) {
+        PyMem_Free(mt->dltensor.shape);
+        mt->dltensor.shape = nullptr;
+    }
+    if (th->free_strides) {
+        PyMem_Free(mt->dltensor.strides);
+        mt->dltensor.strides = nullptr;
+    }
+    if (th->free_data)
+        ndarray_pool_release(mt->dltensor.data);
+    if (th->call_deleter) {
+        if (mt->deleter)
+            mt->deleter(mt);
+    } else {
+        PyMem_Free(mt);
+    }
+    if (th->payload_free)
+        th->payload_free((uint8_t *) th + ndarray_payload_offset);
+    PyMem_Free(th);
+}
+
 void ndarray_dec_ref(ndarray_handle *th) noexcept {
     if (!th)
         return;
@@ -537,33 +1386,20 @@ void ndarray_dec_ref(ndarray_handle *th) noexcept {
     if (rc_value == 0) {
         check(false, "ndarray_dec_ref(): reference count became negative!");
     } else if (rc_value == 1) {
-        gil_scoped_acquire guard;
+        // Threads that don't hold the GIL can leave the cleanup to Python
+        if (defer_call(ndarray_free, th))
+            return;
 
-        Py_XDECREF(th->owner);
-        Py_XDECREF(th->self);
-        managed_dltensor *mt = th->ndarray;
-        if (th->free_shape) {
-            PyMem_Free(mt->dltensor.shape);
-            mt->dltensor.shape = nullptr;
-        }
-        if (th->free_strides) {
-            PyMem_Free(mt->dltensor.strides);
-            mt->dltensor.strides = nullptr;
-        }
-        if (th->call_deleter) {
-            if (mt->deleter)
-                mt->deleter(mt);
-        } else {
-            PyMem_Free(mt);
-        }
-        PyMem_Free(th);
+        gil_scoped_acquire guard;
+        ndarray_free(th);
     }
 }
 
-ndarray_handle *ndarray_create(void *value, size_t ndim, const size_t *shape_in,
-                               PyObject *owner, const int64_t *strides_in,
-                               dlpack::dtype *dtype, bool ro,
-                               int32_t device_type, int32_t device_id) {
+static ndarray_handle *
+ndarray_create_impl(void *value, size_t ndim, const size_t *shape_in,
+                    PyObject *owner, const int64_t *strides_in,
+                    dlpack::dtype *dtype, bool ro, int32_t device_type,
+                    int32_t device_id, size_t payload_size) {
     /* DLPack mandates 256-byte alignment of the 'DLTensor::data' field, but
        PyTorch unfortunately ignores the 'byte_offset' value.. :-( */
 #if 0
@@ -574,12 +1410,18 @@ ndarray_handle *ndarray_create(void *value, size_t ndim, const size_t *shape_in,
               value_rounded = value_int;
 #endif
 
+    // The handle is followed by 'payload_size' bytes, if requested
+    size_t handle_count = 1;
+    if (payload_size)
+        handle_count = (ndarray_payload_offset + payload_size +
+                        sizeof(ndarray_handle) - 1) / sizeof(ndarray_handle);
+
     scoped_pymalloc<managed_dltensor> ndarray;
-    scoped_pymalloc<ndarray_handle> result;
+    scoped_pymalloc<ndarray_handle> result(handle_count);
     scoped_pymalloc<int64_t> shape(ndim), strides(ndim);
 
+    // May be invoked by the consumer on any thread
     auto deleter = [](managed_dltensor *mt) {
-        gil_scoped_acquire guard;
         ndarray_handle *th = (ndarray_handle *) mt->manager_ctx;
         ndarray_dec_ref(th);
     };
@@ -618,11 +1460,63 @@ ndarray_handle *ndarray_create(void *value, size_t ndim, const size_t *shape_in,
     result->free_shape = true;
     result->free_strides = true;
     result->call_deleter = false;
+    result->free_data = false;
     result->ro = ro;
+    result->payload_free = nullptr;
     Py_XINCREF(owner);
     return result.release();
 }
 
+ndarray_handle *ndarray_create(void *value, size_t ndim, const size_t *shape,
+                               PyObject *owner, const int64_t *strides,
+                               dlpack::dtype *dtype, bool ro,
+                               int32_t device_type, int32_t device_id) {
+    return ndarray_create_impl(value, ndim, shape, owner, strides, dtype, ro,
+                               device_type, device_id, 0);
+}
+
+ndarray_handle *ndarray_create_payload(void *value, size_t ndim,
+                                       const size_t *shape,
+                                       const int64_t *strides,
+                                       dlpack::dtype *dtype, bool ro,
+                                       int32_t device_type, int32_t device_id,
+                                       size_t payload_size,
+                                       void (*payload_free)(void *) noexcept,
+                                       void **payload) {
+    ndarray_handle *th =
+        ndarray_create_impl(value, ndim, shape, nullptr, strides, dtype, ro,
+                            device_type, device_id, payload_size);
+    th->payload_free = payload_free;
+    *payload = (uint8_t *) th + ndarray_payload_offset;
+    return th;
+}
+
+ndarray_handle *ndarray_alloc(size_t ndim, const size_t *shape,
+                              dlpack::dtype *dtype, bool ro,
+                              int32_t device_type, int32_t device_id) {
+    if (device_type != device::cpu::value)
+        raise("nanobind::detail::ndarray_alloc(): only CPU memory can be allocated!");
+
+    size_t size = ((size_t) dtype->bits * dtype->lanes + 7) / 8;
+    for (size_t i = 0; i < ndim; ++i) {
+        if (shape[i] && size > SIZE_MAX / shape[i])
+            throw std::bad_alloc();
+        size *= shape[i];
+    }
+
+    void *data = ndarray_pool_acquire(size);
+    ndarray_handle *th;
+    try {
+        th = ndarray_create(data, ndim, shape, nullptr, nullptr, dtype, ro,
+                            device_type, device_id);
+    } catch (...) {
+        ndarray_pool_release(data);
+        throw;
+    }
+    th->free_data = true;
+    return th;
+}
+
 static void ndarray_capsule_destructor(PyObject *o) {
     error_scope scope; // temporarily save any existing errors
     managed_dltensor *mt =
@@ -634,6 +1528,85 @@ static void ndarray_capsule_destructor(PyObject *o) {
         PyErr_Clear();
 }
 
+/// Return the (cached) function turning DLPack capsules into framework arrays
+static PyObject *ndarray_from_dlpack_func(ndarray_framework framework) noexcept {
+    static const char *packages[] = {
+        "numpy", "tensorflow.experimental.dlpack", "torch.utils.dlpack",
+        "jax.dlpack"
+    };
+
+    nb_internals *internals_ = internals;
+    size_t index = (size_t) framework - (size_t) ndarray_framework::numpy;
+    PyObject *func = internals_->ndarray_from_dlpack[index];
+    if (NB_LIKELY(func))
+        return func;
+
+    PyObject *package = PyImport_ImportModule(packages[index]);
+    if (package) {
+        func = PyObject_GetAttrString(
+            package, framework == ndarray_framework::numpy ? "array"
+                                                           : "from_dlpack");
+        Py_DECREF(package);
+    }
+
+    PyObject *kwnames = nullptr;
+    if (func && framework == ndarray_framework::numpy &&
+        !internals_->ndarray_copy_kwnames) {
+        kwnames = Py_BuildValue("(s)", "copy");
+        if (!kwnames)
+            Py_CLEAR(func);
+    }
+
+    if (!func)
+        return nullptr;
+
+    lock_internals guard(internals_);
+    if (kwnames) {
+        if (internals_->ndarray_copy_kwnames)
+            Py_DECREF(kwnames);
+        else
+            internals_->ndarray_copy_kwnames = kwnames;
+    }
+    if (internals_->ndarray_from_dlpack[index]) {
+        Py_DECREF(func);
+        func = internals_->ndarray_from_dlpack[index];
+    } else {
+        internals_->ndarray_from_dlpack[index] = func;
+    }
+    return func;
+}
+
+PyObject *scipy_sparse_type(bool csr) noexcept {
+    nb_internals *internals_ = internals;
+    PyObject *tp = internals_->scipy_sparse_types[csr];
+    if (NB_LIKELY(tp))
+        return tp;
+
+    PyObject *package = PyImport_ImportModule("scipy.sparse");
+    if (!package)
+        return nullptr;
+    tp = PyObject_GetAttrString(package, csr ? "csr_matrix" : "csc_matrix");
+    Py_DECREF(package);
+    if (!tp)
+        return nullptr;
+
+    if (!PyType_Check(tp)) {
+        PyErr_Format(PyExc_TypeError, "scipy.sparse.%s is not a type!",
+                     csr ? "csr_matrix" : "csc_matrix");
+        Py_DECREF(tp);
+        return nullptr;
+    }
+
+    lock_internals guard(internals_);
+    if (internals_->scipy_sparse_types[csr]) {
+        Py_DECREF(tp);
+        tp = internals_->scipy_sparse_types[csr];
+    } else {
+        internals_->scipy_sparse_types[csr] = tp;
+    }
+    return tp;
+}
+
 PyObject *ndarray_wrap(ndarray_handle *th, int framework,
                        rv_policy policy, cleanup_list *cleanup) noexcept {
     if (!th)
@@ -657,7 +1630,9 @@ PyObject *ndarray_wrap(ndarray_handle *th, int framework,
             [[fallthrough]];
 
         case rv_policy::automatic:
-            copy = th->owner == nullptr && th->self == nullptr;
+            // Storage owned by the handle itself need not be copied
+            copy = th->owner == nullptr && th->self == nullptr &&
+                   !th->free_data && !th->payload_free;
             break;
 
         case rv_policy::copy:
@@ -679,56 +1654,42 @@ PyObject *ndarray_wrap(ndarray_handle *th, int framework,
         }
     }
 
-    if ((ndarray_framework) framework == ndarray_framework::numpy) {
-        try {
-            nb_ndarray *h = PyObject_New(nb_ndarray, nd_ndarray_tp());
-            if (!h)
-                return nullptr;
-            h->th = th;
-            ndarray_inc_ref(th);
-
-            object o = steal((PyObject *) h);
-            return module_::import_("numpy")
-                .attr("array")(o, arg("copy") = copy)
-                .release()
-                .ptr();
-        } catch (const std::exception &e) {
+    PyObject *func = nullptr;
+    if ((ndarray_framework) framework != ndarray_framework::none) {
+        check(framework <= (int) ndarray_framework::jax,
+              "nanobind::detail::ndarray_wrap(): unknown framework specified!");
+
+        func = ndarray_from_dlpack_func((ndarray_framework) framework);
+        if (!func) {
+            python_error e;
             PyErr_Format(PyExc_RuntimeError,
-                         "nanobind::detail::ndarray_wrap(): could not "
-                         "convert ndarray to NumPy array: %s", e.what());
+                         "nanobind::detail::ndarray_wrap(): could not import "
+                         "ndarray framework: %s", e.what());
             return nullptr;
         }
     }
 
-    object package;
-    try {
-        switch ((ndarray_framework) framework) {
-            case ndarray_framework::none:
-                break;
-
-            case ndarray_framework::pytorch:
-                package = module_::import_("torch.utils.dlpack");
-                break;
-
-
-            case ndarray_framework::tensorflow:
-                package = module_::import_("tensorflow.experimental.dlpack");
-                break;
-
-            case ndarray_framework::jax:
-                package = module_::import_("jax.dlpack");
-                break;
+    if ((ndarray_framework) framework == ndarray_framework::numpy) {
+        nb_ndarray *h = PyObject_New(nb_ndarray, nd_ndarray_tp());
+        if (!h)
+            return nullptr;
+        h->th = th;
+        ndarray_inc_ref(th);
 
+        PyObject *args[] = { nullptr, (PyObject *) h,
+                             copy ? Py_True : Py_False };
+        PyObject *result =
+            NB_VECTORCALL(func, args + 1, 1 | NB_VECTORCALL_ARGUMENTS_OFFSET,
+                          internals->ndarray_copy_kwnames);
+        Py_DECREF(h);
 
-            default:
-                check(false, "nanobind::detail::ndarray_wrap(): unknown "
-                             "framework specified!");
+        if (!result) {
+            python_error e;
+            PyErr_Format(PyExc_RuntimeError,
+                         "nanobind::detail::ndarray_wrap(): could not "
+                         "convert ndarray to NumPy array: %s", e.what());
         }
-    } catch (const std::exception &e) {
-        PyErr_Format(PyExc_RuntimeError,
-                     "nanobind::detail::ndarray_wrap(): could not import ndarray "
-                     "framework: %s", e.what());
-        return nullptr;
+        return result;
     }
 
     object o;
@@ -740,16 +1701,19 @@ PyObject *ndarray_wrap(ndarray_handle *th, int framework,
         ndarray_inc_ref(th);
     }
 
+    if (func) {
+        PyObject *args[] = { nullptr, o.ptr() };
+        PyObject *result = NB_VECTORCALL(
+            func, args + 1, 1 | NB_VECTORCALL_ARGUMENTS_OFFSET, nullptr);
 
-    if (package.is_valid()) {
-        try {
-            o = package.attr("from_dlpack")(o);
-        } catch (const std::exception &e) {
+        if (!result) {
+            python_error e;
             PyErr_Format(PyExc_RuntimeError,
                          "nanobind::detail::ndarray_wrap(): could not "
                          "import ndarray: %s", e.what());
             return nullptr;
         }
+        o = steal(result);
     }
 
     if (copy) {
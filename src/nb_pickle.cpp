@@ -0,0 +1,156 @@
+/*
+    src/nb_pickle.cpp: pickling with out-of-band buffers (protocol 5)
+
+    Copyright (c) 2023 Wenzel Jakob
+
+    All rights reserved. Use of this source code is governed by a
+    BSD-style license that can be found in the LICENSE file.
+*/
+
+#include "nb_internals.h"
+
+NAMESPACE_BEGIN(NB_NAMESPACE)
+NAMESPACE_BEGIN(detail)
+
+/// Read-only buffer exporter referencing memory owned by another object
+struct nb_pickle_buffer {
+    PyObject_HEAD
+    PyObject *owner;
+    const void *ptr;
+    Py_ssize_t size;
+};
+
+static void nb_pickle_buffer_dealloc(PyObject *self) {
+    PyTypeObject *tp = Py_TYPE(self);
+    Py_DECREF(((nb_pickle_buffer *) self)->owner);
+    PyObject_Free(self);
+    Py_DECREF(tp);
+}
+
+static int nb_pickle_buffer_getbuffer(PyObject *exporter, Py_buffer *view,
+                                      int flags) {
+    nb_pickle_buffer *self = (nb_pickle_buffer *) exporter;
+    return PyBuffer_FillInfo(view, exporter, (void *) self->ptr, self->size,
+                             1, flags);
+}
+
+static PyTypeObject *nb_pickle_buffer_tp() noexcept {
+    PyTypeObject *tp = internals->nb_pickle_buffer;
+
+    if (NB_UNLIKELY(!tp)) {
+        PyType_Slot slots[] = {
+            { Py_tp_dealloc, (void *) nb_pickle_buffer_dealloc },
+#if PY_VERSION_HEX >= 0x03090000
+            { Py_bf_getbuffer, (void *) nb_pickle_buffer_getbuffer },
+#endif
+            { 0, nullptr }
+        };
+
+        PyType_Spec spec = {
+            /* .name = */ "nanobind.nb_pickle_buffer",
+            /* .basicsize = */ (int) sizeof(nb_pickle_buffer),
+            /* .itemsize = */ 0,
+            /* .flags = */ Py_TPFLAGS_DEFAULT,
+            /* .slots = */ slots
+        };
+
+        tp = (PyTypeObject *) PyType_FromSpec(&spec);
+        check(tp, "nb_pickle_buffer type creation failed!");
+
+#if PY_VERSION_HEX < 0x03090000
+        tp->tp_as_buffer->bf_getbuffer = nb_pickle_buffer_getbuffer;
+#endif
+
+        internals->nb_pickle_buffer = tp;
+    }
+
+    return tp;
+}
+
+PyObject *pickle_buffer_new(PyObject *owner, const void *ptr,
+                            size_t size) noexcept {
+    // Without an owner, the memory might not outlive the view. Copy it.
+    if (!owner)
+        return PyBytes_FromStringAndSize((const char *) ptr, (Py_ssize_t) size);
+
+    nb_pickle_buffer *self =
+        PyObject_New(nb_pickle_buffer, nb_pickle_buffer_tp());
+    if (!self)
+        return nullptr;
+
+    Py_INCREF(owner);
+    self->owner = owner;
+    self->ptr = ptr;
+    self->size = (Py_ssize_t) size;
+    return (PyObject *) self;
+}
+
+bool pickle_buffer_get(PyObject *o, cleanup_list *cleanup, const void **ptr,
+                       size_t *size) noexcept {
+    if (!cleanup || !PyObject_CheckBuffer(o))
+        return false;
+
+    /* The memory view holds on to the buffer of 'o' until the call has
+       finished and the cleanup list is released */
+    PyObject *mv = PyMemoryView_FromObject(o);
+    if (!mv) {
+        PyErr_Clear();
+        return false;
+    }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(mv, &view, PyBUF_SIMPLE)) {
+        PyErr_Clear(); // not contiguous
+        Py_DECREF(mv);
+        return false;
+    }
+
+    *ptr = view.buf;
+    *size = (size_t) view.len;
+    PyBuffer_Release(&view);
+    cleanup->append(mv);
+    return true;
+}
+
+PyObject *pickle_reduce_ex(PyObject *self, int protocol) {
+    object state = handle(self).attr("__getstate__")(),
+           pickle_buffer_tp;
+
+    /* Protocol 5 lets the pickler pass 'PickleBuffer' instances out-of-band.
+       Older protocols can't represent them and receive a copy. */
+    if (protocol >= 5)
+        pickle_buffer_tp = module_::import_("pickle").attr("PickleBuffer");
+
+    PyTypeObject *tp = nb_pickle_buffer_tp();
+    auto convert = [&](handle h) -> object {
+        if (Py_TYPE(h.ptr()) != tp)
+            return borrow(h);
+        else if (pickle_buffer_tp.is_valid())
+            return pickle_buffer_tp(h);
+        else
+            return steal(PyBytes_FromObject(h.ptr()));
+    };
+
+    if (PyTuple_Check(state.ptr())) {
+        size_t size = (size_t) NB_TUPLE_GET_SIZE(state.ptr());
+        object result = steal(PyTuple_New((Py_ssize_t) size));
+        for (size_t i = 0; i < size; ++i) {
+            object value = convert(NB_TUPLE_GET_ITEM(state.ptr(), i));
+            if (!value.is_valid())
+                raise_python_error();
+            NB_TUPLE_SET_ITEM(result.ptr(), i, value.release().ptr());
+        }
+        state = std::move(result);
+    } else {
+        state = convert(state);
+        if (!state.is_valid())
+            raise_python_error();
+    }
+
+    return make_tuple(module_::import_("copyreg").attr("__newobj__"),
+                      make_tuple(handle((PyObject *) Py_TYPE(self))), state)
+        .release().ptr();
+}
+
+NAMESPACE_END(detail)
+NAMESPACE_END(NB_NAMESPACE)
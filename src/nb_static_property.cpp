@@ -3,9 +3,30 @@
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
+/// Payload of `nb_static_property` descriptors, which follows the property object
+struct nb_static_property_data {
+    /// Constant returned by `__get__()` (borrowed, the getter holds a reference)
+    PyObject *value;
+};
+
+static nb_static_property_data *nb_static_property_data_get(PyObject *self) {
+#if PY_VERSION_HEX >= 0x030C0000
+    return (nb_static_property_data *) PyObject_GetTypeData(
+        self, internals->nb_static_property);
+#else
+    return (nb_static_property_data *) ((uint8_t *) self +
+                                        PyProperty_Type.tp_basicsize);
+#endif
+}
+
 /// `nb_static_property.__get__()`: Always pass the class instead of the instance.
 static PyObject *nb_static_property_descr_get(PyObject *self, PyObject *, PyObject *cls) {
     if (internals->nb_static_property_enabled) {
+        PyObject *value = nb_static_property_data_get(self)->value;
+        if (value) {
+            Py_INCREF(value);
+            return value;
+        }
         return NB_SLOT(PyProperty_Type, tp_descr_get)(self, cls, cls);
     } else {
         Py_INCREF(self);
@@ -38,9 +59,16 @@ PyTypeObject *nb_static_property_tp() noexcept {
             { 0, nullptr }
         };
 
+#if PY_VERSION_HEX >= 0x030C0000
+        int basicsize = -(int) sizeof(nb_static_property_data);
+#else
+        int basicsize = (int) (PyProperty_Type.tp_basicsize +
+                               sizeof(nb_static_property_data));
+#endif
+
         PyType_Spec spec = {
             /* .name = */ "nanobind.nb_static_property",
-            /* .basicsize = */ 0,
+            /* .basicsize = */ basicsize,
             /* .itemsize = */ 0,
             /* .flags = */ Py_TPFLAGS_DEFAULT,
             /* .slots = */ slots
@@ -56,5 +84,9 @@ PyTypeObject *nb_static_property_tp() noexcept {
     return tp;
 }
 
+void nb_static_property_set_const(PyObject *prop, PyObject *value) noexcept {
+    nb_static_property_data_get(prop)->value = value;
+}
+
 NAMESPACE_END(NB_NAMESPACE)
 NAMESPACE_END(detail)
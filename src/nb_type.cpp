@@ -25,16 +25,42 @@ static PyObject **nb_dict_ptr(PyObject *self) {
 #endif
 }
 
+static PyObject **nb_inline_attrs_ptr(PyObject *self, const type_data *t) {
+    return (PyObject **) ((uint8_t *) self + t->inline_attr_offset);
+}
+
 static int inst_clear(PyObject *self) {
-    PyObject *&dict = *nb_dict_ptr(self);
-    Py_CLEAR(dict);
+    const type_data *t = nb_type_data(Py_TYPE(self));
+
+    if (t->flags & (uint32_t) type_flags::has_dynamic_attr) {
+        PyObject *&dict = *nb_dict_ptr(self);
+        Py_CLEAR(dict);
+    }
+
+    if (t->flags & (uint32_t) type_flags::has_inline_attrs) {
+        PyObject **attrs = nb_inline_attrs_ptr(self, t);
+        for (uint32_t i = 0; i < t->inline_attr_count; ++i)
+            Py_CLEAR(attrs[i]);
+    }
+
     return 0;
 }
 
 static int inst_traverse(PyObject *self, visitproc visit, void *arg) {
-    PyObject *&dict = *nb_dict_ptr(self);
-    if (dict)
-        Py_VISIT(dict);
+    const type_data *t = nb_type_data(Py_TYPE(self));
+
+    if (t->flags & (uint32_t) type_flags::has_dynamic_attr) {
+        PyObject *&dict = *nb_dict_ptr(self);
+        if (dict)
+            Py_VISIT(dict);
+    }
+
+    if (t->flags & (uint32_t) type_flags::has_inline_attrs) {
+        PyObject **attrs = nb_inline_attrs_ptr(self, t);
+        for (uint32_t i = 0; i < t->inline_attr_count; ++i)
+            Py_VISIT(attrs[i]);
+    }
+
 #if PY_VERSION_HEX >= 0x03090000
     Py_VISIT(Py_TYPE(self));
 #endif
@@ -47,18 +73,56 @@ static int inst_init(PyObject *self, PyObject *, PyObject *) {
     return -1;
 }
 
+#if defined(NB_TYPE_STATS)
+/// Approximate memory footprint of an instance (Python object and C++ data)
+static uint64_t inst_footprint(PyTypeObject *tp, const type_data *t,
+                               bool internal) {
+#if !defined(Py_LIMITED_API)
+    if (internal)
+        return (uint64_t) tp->tp_basicsize;
+#else
+    (void) tp; (void) internal;
+#endif
+    return (uint64_t) (sizeof(nb_inst) + t->size);
+}
+
+static void inst_stats_created(PyTypeObject *tp, const type_data *t,
+                               bool internal) {
+    nb_type_stats *s = t->stats;
+    nb_counter_add(s->created, 1);
+    nb_counter_add(s->bytes, inst_footprint(tp, t, internal));
+}
+
+static void inst_stats_destroyed(PyTypeObject *tp, const type_data *t,
+                                 bool internal) {
+    nb_type_stats *s = t->stats;
+    nb_counter_add(s->destroyed, 1);
+    nb_counter_add(s->bytes, (uint64_t) 0 - inst_footprint(tp, t, internal));
+}
+#endif
+
 /// Allocate memory for a nb_type instance with internal storage
 PyObject *inst_new_int(PyTypeObject *tp) {
     bool gc = PyType_HasFeature(tp, Py_TPFLAGS_HAVE_GC);
+    type_data *t = nb_type_data(tp);
 
     nb_inst *self;
-    if (NB_LIKELY(!gc))
-        self = PyObject_New(nb_inst, tp);
-    else
+    if (NB_LIKELY(!gc)) {
+        if (NB_UNLIKELY(t->flags & (uint32_t) type_flags::has_freelist) &&
+            t->freelist) {
+            // Recycle a previously released block of the same size
+            self = (nb_inst *) t->freelist;
+            t->freelist = *(void **) self;
+            t->freelist_size--;
+            PyObject_Init((PyObject *) self, tp);
+        } else {
+            self = PyObject_New(nb_inst, tp);
+        }
+    } else {
         self = (nb_inst *) PyType_GenericAlloc(tp, 0);
+    }
 
     if (NB_LIKELY(self)) {
-        const type_data *t = nb_type_data(tp);
         uint32_t align = (uint32_t) t->align;
         bool intrusive = t->flags & (uint32_t) type_flags::intrusive_ptr;
         bool weak_py = t->flags & (uint32_t) type_flags::weak_py;
@@ -78,11 +142,21 @@ PyObject *inst_new_int(PyTypeObject *tp) {
         self->intrusive = intrusive;
         self->weak_py = weak_py;
         self->destroyed = 0;
-        self->unused = 0;
+
+#if defined(NB_TYPE_STATS)
+        inst_stats_created(tp, t, true);
+#endif
 
         // Update hash table that maps from C++ to Python instance
-        auto [it, success] = internals->inst_c2p.try_emplace((void *) payload, self);
-        check(success, "nanobind::detail::inst_new_int(): unexpected collision!");
+        if (NB_LIKELY(!(t->flags & (uint32_t) type_flags::no_identity))) {
+            nb_enable_try_inc_ref((PyObject *) self);
+            nb_shard &shard = internals->shard((void *) payload);
+            lock_shard guard(shard);
+            auto [it, success] =
+                shard.inst_c2p.try_emplace((void *) payload, self);
+            check(success,
+                  "nanobind::detail::inst_new_int(): unexpected collision!");
+        }
     }
 
     return (PyObject *) self;
@@ -142,10 +216,19 @@ PyObject *inst_new_ext(PyTypeObject *tp, void *value) {
     self->intrusive = intrusive;
     self->weak_py = weak_py;
     self->destroyed = 0;
-    self->unused = 0;
+
+#if defined(NB_TYPE_STATS)
+    inst_stats_created(tp, t, false);
+#endif
+
+    if (NB_UNLIKELY(t->flags & (uint32_t) type_flags::no_identity))
+        return (PyObject *) self;
 
     // Update hash table that maps from C++ to Python instance
-    auto [it, success] = internals->inst_c2p.try_emplace(value, self);
+    nb_enable_try_inc_ref((PyObject *) self);
+    nb_shard &shard = internals->shard(value);
+    lock_shard guard(shard);
+    auto [it, success] = shard.inst_c2p.try_emplace(value, self);
 
     if (NB_UNLIKELY(!success)) {
         void *entry = it->second;
@@ -181,18 +264,56 @@ PyObject *inst_new_ext(PyTypeObject *tp, void *value) {
     return (PyObject *) self;
 }
 
+/// Remove 'inst' from the instance map, returns 'false' if it wasn't found
+static bool nb_inst_unregister(nb_inst_map &inst_c2p, void *p,
+                               nb_inst *inst) noexcept {
+    nb_inst_map::iterator it = inst_c2p.find(p);
+    if (NB_UNLIKELY(it == inst_c2p.end()))
+        return false;
+
+    void *entry = it->second;
+    if (NB_LIKELY(entry == inst)) {
+        inst_c2p.erase(it);
+        return true;
+    } else if (nb_is_seq(entry)) {
+        // Multiple objects are associated with this address. Find the right one!
+        nb_inst_seq *seq = nb_get_seq(entry),
+                    *pred = nullptr;
+
+        do {
+            if ((nb_inst *) seq->inst == inst) {
+                if (pred) {
+                    pred->next = seq->next;
+                } else {
+                    if (seq->next)
+                        it.value() = nb_mark_seq(seq->next);
+                    else
+                        inst_c2p.erase(it);
+                }
+
+                PyMem_Free(seq);
+                return true;
+            }
+
+            pred = seq;
+            seq = seq->next;
+        } while (seq);
+    }
+
+    return false;
+}
+
 static void inst_dealloc(PyObject *self) {
     PyTypeObject *tp = Py_TYPE(self);
-    const type_data *t = nb_type_data(tp);
+    type_data *t = nb_type_data(tp);
 
     bool gc = PyType_HasFeature(tp, Py_TPFLAGS_HAVE_GC);
     if (NB_UNLIKELY(gc)) {
         PyObject_GC_UnTrack(self);
 
-        if (t->flags & (uint32_t) type_flags::has_dynamic_attr) {
-            PyObject *&dict = *nb_dict_ptr(self);
-            Py_CLEAR(dict);
-        }
+        if (t->flags & ((uint32_t) type_flags::has_dynamic_attr |
+                        (uint32_t) type_flags::has_inline_attrs))
+            inst_clear(self);
     }
 
     nb_inst *inst = (nb_inst *) self;
@@ -214,79 +335,77 @@ static void inst_dealloc(PyObject *self) {
     }
 
     if (NB_UNLIKELY(inst->clear_keep_alive)) {
-        nb_ptr_map &keep_alive = internals->keep_alive;
-        nb_ptr_map::iterator it = keep_alive.find(self);
-        check(it != keep_alive.end(),
-              "nanobind::detail::inst_dealloc(\"%s\"): inconsistent "
-              "keep_alive information", t->name);
-
-        nb_weakref_seq *s = (nb_weakref_seq *) it->second;
-        keep_alive.erase(it);
-        do {
-            nb_weakref_seq *c = s;
-            s = c->next;
+        void *entry;
 
-            if (c->callback)
-                c->callback(c->payload);
-            else
-                Py_DECREF((PyObject *) c->payload);
+        {
+            nb_shard &shard = internals->shard(self);
+            lock_shard guard(shard);
 
-            PyObject_Free(c);
-        } while (s);
-    }
+            nb_ptr_map &keep_alive = shard.keep_alive;
+            nb_ptr_map::iterator it = keep_alive.find(self);
+            check(it != keep_alive.end(),
+                  "nanobind::detail::inst_dealloc(\"%s\"): inconsistent "
+                  "keep_alive information", t->name);
 
-    // Update hash table that maps from C++ to Python instance
-    nb_ptr_map &inst_c2p = internals->inst_c2p;
-    nb_ptr_map::iterator it = inst_c2p.find(p);
-    bool found = false;
+            entry = it->second;
+            keep_alive.erase(it);
+        }
 
-    if (NB_LIKELY(it != inst_c2p.end())) {
-        void *entry = it->second;
-        if (NB_LIKELY(entry == inst)) {
-            found = true;
-            inst_c2p.erase(it);
-        } else if (nb_is_seq(entry)) {
-            // Multiple objects are associated with this address. Find the right one!
-            nb_inst_seq *seq = nb_get_seq(entry),
-                        *pred = nullptr;
+        // Release the references without holding the lock
 
+        if (NB_LIKELY(!nb_is_seq(entry))) {
+            Py_DECREF((PyObject *) entry);
+        } else {
+            nb_weakref_seq *s = nb_get_weakref_seq(entry);
             do {
-                if ((nb_inst *) seq->inst == inst) {
-                    found = true;
-
-                    if (pred) {
-                        pred->next = seq->next;
-                    } else {
-                        if (seq->next)
-                            it.value() = nb_mark_seq(seq->next);
-                        else
-                            inst_c2p.erase(it);
-                    }
-
-                    PyMem_Free(seq);
-                    break;
-                }
+                nb_weakref_seq *c = s;
+                s = c->next;
+
+                if (c->callback)
+                    c->callback(c->payload);
+                else
+                    Py_DECREF((PyObject *) c->payload);
 
-                pred = seq;
-                seq = seq->next;
-            } while (seq);
+                PyObject_Free(c);
+            } while (s);
         }
     }
 
+    // Update hash table that maps from C++ to Python instance
+    // (destroyed instances were already removed by nb_inst_set_destroyed())
+    bool found = (t->flags & (uint32_t) type_flags::no_identity) ||
+                 inst->destroyed;
+
+    if (NB_LIKELY(!found)) {
+        nb_shard &shard = internals->shard(p);
+        lock_shard guard(shard);
+        found = nb_inst_unregister(shard.inst_c2p, p, inst);
+    }
+
     check(found,
           "nanobind::detail::inst_dealloc(\"%s\"): attempted to delete an "
           "unknown instance (%p)!", t->name, p);
 
-    if (NB_UNLIKELY(gc))
+#if defined(NB_TYPE_STATS)
+    inst_stats_destroyed(tp, t, inst->internal);
+#endif
+
+    if (NB_UNLIKELY(gc)) {
         NB_SLOT(PyType_Type, tp_free)(self);
-    else
+    } else if (NB_UNLIKELY(t->flags & (uint32_t) type_flags::has_freelist) &&
+               inst->internal && t->freelist_size < t->freelist_capacity) {
+        *(void **) self = t->freelist;
+        t->freelist = self;
+        t->freelist_size++;
+    } else {
         PyObject_Free(self);
+    }
 
     Py_DECREF(tp);
 }
 
-type_data *nb_type_c2p(nb_internals *internals_,
-                       const std::type_info *type) {
+static type_data *nb_type_c2p_locked(nb_internals *internals_,
+                                     const std::type_info *type) {
     nb_type_map_fast &type_c2p_fast = internals_->type_c2p_fast;
     nb_type_map_slow &type_c2p_slow = internals_->type_c2p_slow;
 
@@ -295,7 +414,7 @@ type_data *nb_type_c2p(nb_internals *internals_,
         return it_fast->second;
 
     nb_type_map_slow::iterator it_slow = type_c2p_slow.find(type);
-    if (it_slow != type_c2p_slow.end()) {
+    if (it_slow != type_c2p_slow.end() && it_slow->second) {
         type_data *d = it_slow->second;
 
         nb_alias_chain *chain = (nb_alias_chain *) PyMem_Malloc(sizeof(nb_alias_chain));
@@ -310,10 +429,50 @@ type_data *nb_type_c2p(nb_internals *internals_,
     return nullptr;
 }
 
+#if defined(NB_FREE_THREADED)
+/* Per-thread cache of type lookups, which avoids contention on the internals
+   mutex. Entries are invalidated when a type is removed from the maps. */
+struct nb_type_cache_entry {
+    nb_internals *owner;
+    const std::type_info *type;
+    type_data *value;
+    uint32_t epoch;
+};
+
+static NB_THREAD_LOCAL nb_type_cache_entry nb_type_cache[32];
+#endif
+
+type_data *nb_type_c2p(nb_internals *internals_,
+                       const std::type_info *type) {
+#if defined(NB_FREE_THREADED)
+    uint32_t epoch = internals_->type_c2p_epoch.load(std::memory_order_acquire);
+    nb_type_cache_entry &e =
+        nb_type_cache[(fmix64((uint64_t) (uintptr_t) type) >> 59)];
+
+    if (NB_LIKELY(e.type == type && e.owner == internals_ &&
+                  e.epoch == epoch))
+        return e.value;
+
+    type_data *d;
+    {
+        lock_internals guard(internals_);
+        d = nb_type_c2p_locked(internals_, type);
+    }
+
+    if (d)
+        e = nb_type_cache_entry{ internals_, type, d, epoch };
+
+    return d;
+#else
+    return nb_type_c2p_locked(internals_, type);
+#endif
+}
+
 static void nb_type_dealloc(PyObject *o) {
     type_data *t = nb_type_data((PyTypeObject *) o);
 
     if (t->type && (t->flags & (uint32_t) type_flags::is_python_type) == 0) {
+        lock_internals guard(internals);
         nb_type_map_slow &type_c2p_slow = internals->type_c2p_slow;
         nb_type_map_fast &type_c2p_fast = internals->type_c2p_fast;
 
@@ -344,6 +503,10 @@ static void nb_type_dealloc(PyObject *o) {
         check(!fail,
               "nanobind::detail::nb_type_dealloc(\"%s\"): could not "
               "find type!", t->name);
+
+#if defined(NB_FREE_THREADED)
+        internals->type_c2p_epoch.fetch_add(1, std::memory_order_release);
+#endif
     }
 
     if (t->flags & (uint32_t) type_flags::has_implicit_conversions) {
@@ -351,12 +514,124 @@ static void nb_type_dealloc(PyObject *o) {
         free(t->implicit_py);
     }
 
+    if (t->flags & (uint32_t) type_flags::is_enum)
+        nb_enum_free((PyTypeObject *) o);
+
+    // Python subclasses share the names of their nanobind base
+    if ((t->flags & (uint32_t) type_flags::has_inline_attrs) &&
+        !(t->flags & (uint32_t) type_flags::is_python_type))
+        free(t->inline_attrs);
+
+    if (t->flags & (uint32_t) type_flags::has_freelist) {
+        void *cur = t->freelist;
+        while (cur) {
+            void *next = *(void **) cur;
+            PyObject_Free(cur);
+            cur = next;
+        }
+    }
+
+#if defined(NB_TYPE_STATS)
+    if ((t->flags & (uint32_t) type_flags::is_python_type) == 0)
+        free(t->stats);
+#endif
+
+    trampoline_cache_free(t->trampolines);
+
     free((char *) t->name);
 
     NB_SLOT(PyType_Type, tp_dealloc)(o);
 }
 
 /// Called when a C++ type is extended from within Python
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+/**
+ * Construct an instance of a bound type without going through 'tp_call'. This
+ * allocates the instance and then directly dispatches to the '__init__'
+ * overload chain, which avoids creating a bound method and converting the
+ * arguments into a tuple and dictionary. Installed by nb_type_update_init().
+ */
+static PyObject *nb_type_vectorcall(PyObject *self, PyObject *const *args_in,
+                                    size_t nargsf, PyObject *kwargs_in) {
+    PyTypeObject *tp = (PyTypeObject *) self;
+    PyObject *init = nb_type_data(tp)->init;
+    Py_ssize_t nargs = NB_VECTORCALL_NARGS(nargsf);
+
+    PyObject *inst = inst_new_int(tp);
+    if (!inst)
+        return nullptr;
+
+    constexpr size_t buf_size = 5;
+    PyObject **args, *buf[buf_size], *temp = nullptr;
+    bool alloc = false;
+
+    if (NB_LIKELY(nargsf & PY_VECTORCALL_ARGUMENTS_OFFSET)) {
+        // The caller permits temporarily overwriting 'args_in[-1]'
+        args = (PyObject **) (args_in - 1);
+        temp = args[0];
+    } else {
+        size_t size = (size_t) nargs + 1;
+        if (kwargs_in)
+            size += (size_t) NB_TUPLE_GET_SIZE(kwargs_in);
+
+        if (size <= buf_size) {
+            args = buf;
+        } else {
+            args = (PyObject **) PyMem_Malloc(size * sizeof(PyObject *));
+            if (!args) {
+                Py_DECREF(inst);
+                return PyErr_NoMemory();
+            }
+            alloc = true;
+        }
+
+        memcpy(args + 1, args_in, sizeof(PyObject *) * (size - 1));
+    }
+
+    args[0] = inst;
+
+    // Keep the overload chain alive in case '__init__' is rebound by the call
+    Py_INCREF(init);
+    PyObject *rv = ((nb_func *) init)->vectorcall(init, args, (size_t) nargs + 1,
+                                                  kwargs_in);
+    Py_DECREF(init);
+
+    args[0] = temp;
+
+    if (NB_UNLIKELY(alloc))
+        PyMem_Free(args);
+
+    if (!rv) {
+        Py_DECREF(inst);
+        return nullptr;
+    }
+
+    Py_DECREF(rv); // 'None' returned by '__init__'
+    return inst;
+}
+#endif
+
+/**
+ * Enable the vectorcall-based construction of 'tp' when its '__init__'
+ * attribute refers to a chain of nanobind constructors, and disable it
+ * otherwise (e.g. when '__init__' is rebound from Python).
+ */
+static void nb_type_update_init(PyTypeObject *tp, PyObject *value) noexcept {
+    type_data *t = nb_type_data(tp);
+    bool enable = value && Py_TYPE(value) == internals->nb_method &&
+                  (nb_func_data(value)->flags &
+                   (uint32_t) func_flags::is_constructor) &&
+                  !(t->flags & (uint32_t) type_flags::is_python_type);
+
+    t->init = enable ? value : nullptr;
+
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+    // Custom 'tp_new' slots must not be bypassed
+    enable &= (void *) tp->tp_new == (void *) inst_new_int;
+    tp->tp_vectorcall = enable ? (vectorcallfunc) nb_type_vectorcall : nullptr;
+#endif
+}
+
 static int nb_type_init(PyObject *self, PyObject *args, PyObject *kwds) {
     if (NB_TUPLE_GET_SIZE(args) != 3) {
         PyErr_SetString(PyExc_RuntimeError,
@@ -392,7 +667,8 @@ static int nb_type_init(PyObject *self, PyObject *args, PyObject *kwds) {
 
     *t = *t_b;
     t->flags |=  (uint32_t) type_flags::is_python_type;
-    t->flags &= ~((uint32_t) type_flags::has_implicit_conversions);
+    t->flags &= ~((uint32_t) type_flags::has_implicit_conversions |
+                  (uint32_t) type_flags::has_freelist);
     PyObject *name = nb_type_name(self);
     t->name = strdup_check(PyUnicode_AsUTF8AndSize(name, nullptr));
     Py_DECREF(name);
@@ -400,6 +676,8 @@ static int nb_type_init(PyObject *self, PyObject *args, PyObject *kwds) {
     t->implicit = nullptr;
     t->implicit_py = nullptr;
     t->alias_chain = nullptr;
+    t->trampolines = nullptr;
+    nb_type_update_init((PyTypeObject *) self, nullptr);
 
     return 0;
 }
@@ -438,7 +716,19 @@ static int nb_type_setattro(PyObject* obj, PyObject* name, PyObject* value) {
         PyErr_Clear();
     }
 
-    return NB_SLOT(PyType_Type, tp_setattro)(obj, name, value);
+    int rv = NB_SLOT(PyType_Type, tp_setattro)(obj, name, value);
+
+    if (rv == 0) {
+        if (PyUnicode_Check(name) &&
+            PyUnicode_CompareWithASCIIString(name, "__init__") == 0)
+            nb_type_update_init((PyTypeObject *) obj, value);
+
+        // Methods may have been added, replaced, or removed
+        lock_internals guard(int_p);
+        int_p->trampoline_epoch++;
+    }
+
+    return rv;
 }
 
 #if NB_TYPE_FROM_METACLASS_IMPL || NB_TYPE_GET_SLOT_IMPL
@@ -758,6 +1048,13 @@ static PyTypeObject *nb_type_tp(size_t supplement) noexcept {
 
         handle(tp).attr("__module__") = "nanobind";
 
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+        // Calls of bound types may use their 'tp_vectorcall' (nb_type_vectorcall)
+        tp->tp_flags |= Py_TPFLAGS_HAVE_VECTORCALL;
+        tp->tp_vectorcall_offset =
+            (Py_ssize_t) offsetof(PyTypeObject, tp_vectorcall);
+#endif
+
         int rv = 1;
         if (tp)
             rv = PyDict_SetItem(internals->nb_type_dict, key.ptr(), (PyObject *) tp);
@@ -777,21 +1074,35 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
          has_type_slots    = t->flags & (uint32_t) type_init_flags::has_type_slots,
          has_supplement    = t->flags & (uint32_t) type_init_flags::has_supplement,
          has_dynamic_attr  = t->flags & (uint32_t) type_flags::has_dynamic_attr,
+         has_inline_attrs  = t->flags & (uint32_t) type_flags::has_inline_attrs,
          intrusive_ptr     = t->flags & (uint32_t) type_flags::intrusive_ptr,
          has_shared_from_this = t->flags & (uint32_t) type_flags::has_shared_from_this,
          weak_py = t->flags & (uint32_t) type_flags::weak_py;
 
+    uint64_t start = nb_time_ns();
     str name(t->name), qualname = name;
     object modname;
     PyObject *mod = nullptr;
 
     // Update hash table that maps from std::type_info to Python type
-    auto [it, success] = internals->type_c2p_slow.try_emplace(t->type, nullptr);
+    PyObject *tp_prev = nullptr;
+    bool success;
+    {
+        lock_internals guard(internals);
+        auto [it, success_] =
+            internals->type_c2p_slow.try_emplace(t->type, nullptr);
+        success = success_;
+        if (!success && it->second) {
+            tp_prev = (PyObject *) it->second->type_py;
+            Py_INCREF(tp_prev);
+        }
+    }
+
     if (!success) {
+        check(tp_prev, "nanobind::detail::nb_type_new(\"%s\"): type is "
+                       "concurrently being registered!", t->name);
         PyErr_WarnFormat(PyExc_RuntimeWarning, 1, "nanobind: type '%s' was already registered!\n", t->name);
-        PyObject *tp = (PyObject *) it->second->type_py;
-        Py_INCREF(tp);
-        return tp;
+        return tp_prev;
     }
 
     if (t->scope != nullptr) {
@@ -827,8 +1138,9 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
               "nanobind::detail::nb_type_new(\"%s\"): base type is not a "
               "nanobind type!", t->name);
     } else if (has_base) {
+        lock_internals guard(internals);
         nb_type_map_slow::iterator it2 = internals->type_c2p_slow.find(t->base);
-        check(it2 != internals->type_c2p_slow.end(),
+        check(it2 != internals->type_c2p_slow.end() && it2->second,
                   "nanobind::detail::nb_type_new(\"%s\"): base type \"%s\" not "
                   "known to nanobind!", t->name, type_name(t->base));
         base = (PyObject *) it2->second->type_py;
@@ -840,6 +1152,8 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
         tb = nb_type_data((PyTypeObject *) base);
         if (tb->flags & (uint32_t) type_flags::has_dynamic_attr)
             has_dynamic_attr = true;
+        if (tb->flags & (uint32_t) type_flags::has_inline_attrs)
+            has_inline_attrs = true;
 
         /* Handle a corner case (base class larger than derived class)
            which can arise when extending trampoline base classes */
@@ -903,6 +1217,7 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
         }
     }
 
+    size_t dictoffset = 0;
     bool has_traverse = false;
     for (PyType_Slot *ts = slots; ts != s; ++ts)
         has_traverse |= ts->slot == Py_tp_traverse;
@@ -911,12 +1226,30 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
         // realign to sizeof(void*), add one pointer
         basicsize = (basicsize + ptr_size - 1) / ptr_size * ptr_size;
         basicsize += ptr_size;
-
+        dictoffset = basicsize - ptr_size;
         members[0] = PyMemberDef{ "__dictoffset__", T_PYSSIZET,
-                                  (Py_ssize_t) (basicsize - ptr_size), READONLY,
-                                  nullptr };
+                                  (Py_ssize_t) dictoffset, READONLY, nullptr };
         *s++ = { Py_tp_members, (void *) members };
+    }
 
+    /* Inline attributes of a nanobind base class are declared once more, since
+       the larger C++ instance of this type may overlap their old location */
+    uint32_t n_attrs = 0, n_attrs_base = 0;
+    size_t attr_offset = 0;
+    if (has_inline_attrs) {
+        if (tb && (tb->flags & (uint32_t) type_flags::has_inline_attrs))
+            n_attrs_base = tb->inline_attr_count;
+        n_attrs = n_attrs_base;
+        if (t->flags & (uint32_t) type_flags::has_inline_attrs)
+            n_attrs += t->inline_attr_count;
+
+        // realign to sizeof(void*), add one pointer per attribute
+        basicsize = (basicsize + ptr_size - 1) / ptr_size * ptr_size;
+        attr_offset = basicsize;
+        basicsize += n_attrs * ptr_size;
+    }
+
+    if (has_dynamic_attr || has_inline_attrs) {
         // Install GC traverse and clear routines if not inherited/overridden
         if (!has_traverse) {
             *s++ = { Py_tp_traverse, (void *) inst_traverse };
@@ -946,6 +1279,28 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
     *to = *t; // note: slices off _init parts
     to->flags &= ~(uint32_t) type_init_flags::all_init_flags;
 
+#if defined(NB_FREE_THREADED)
+    // Free lists aren't thread-safe, instances come from the allocator instead
+    to->flags &= ~(uint32_t) type_flags::has_freelist;
+#endif
+
+    if (to->flags & (uint32_t) type_flags::has_freelist) {
+        to->freelist = nullptr;
+        to->freelist_size = 0;
+    }
+
+    to->base_cache[0] = to->base_cache[1] = nullptr;
+    to->implicit_hit = to->implicit_miss = nullptr;
+    to->implicit_py_hint = 0;
+    to->trampolines = nullptr;
+    to->init = nullptr;
+
+#if defined(NB_TYPE_STATS)
+    to->stats = (nb_type_stats *) calloc(1, sizeof(nb_type_stats));
+    check(to->stats, "nanobind::detail::nb_type_new(\"%s\"): out of memory!",
+          t->name);
+#endif
+
     if (!intrusive_ptr && base_intrusive_ptr) {
         to->flags |= (uint32_t) type_flags::intrusive_ptr;
         to->set_self_py = tb->set_self_py;
@@ -969,10 +1324,54 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
     if (has_dynamic_attr) {
         to->flags |= (uint32_t) type_flags::has_dynamic_attr;
         #if defined(Py_LIMITED_API)
-            to->dictoffset = (size_t) (basicsize - ptr_size);
+            to->dictoffset = dictoffset;
         #endif
     }
 
+    to->inline_attrs = nullptr;
+    to->inline_attr_count = to->inline_attr_offset = 0;
+
+    if (has_inline_attrs) {
+        /* Member definitions and names of all attributes in one allocation.
+           The definitions must outlive the descriptors referencing them. */
+        size_t bytes = n_attrs * sizeof(PyMemberDef);
+        for (uint32_t i = 0; i < n_attrs; ++i)
+            bytes += strlen(i < n_attrs_base
+                                ? tb->inline_attrs[i].name
+                                : t->inline_attr_names[i - n_attrs_base]) + 1;
+
+        PyMemberDef *defs = (PyMemberDef *) malloc(bytes);
+        check(defs, "nanobind::detail::nb_type_new(\"%s\"): out of memory!",
+              t->name);
+
+        char *buf = (char *) (defs + n_attrs);
+        for (uint32_t i = 0; i < n_attrs; ++i) {
+            const char *name_i = i < n_attrs_base
+                                     ? tb->inline_attrs[i].name
+                                     : t->inline_attr_names[i - n_attrs_base];
+            size_t len = strlen(name_i) + 1;
+            memcpy(buf, name_i, len);
+            defs[i] = PyMemberDef{ buf, T_OBJECT_EX,
+                                   (Py_ssize_t) (attr_offset + i * ptr_size),
+                                   0, nullptr };
+            buf += len;
+        }
+
+        to->flags |= (uint32_t) type_flags::has_inline_attrs;
+        to->inline_attrs = defs;
+        to->inline_attr_count = n_attrs;
+        to->inline_attr_offset = (uint32_t) attr_offset;
+
+        for (uint32_t i = 0; i < n_attrs; ++i) {
+            object descr = steal(
+                PyDescr_NewMember((PyTypeObject *) result, defs + i));
+            check(descr.is_valid(), "nanobind::detail::nb_type_new(\"%s\"): "
+                  "could not create attribute \"%s\"!", t->name,
+                  defs[i].name);
+            setattr(result, defs[i].name, descr);
+        }
+    }
+
     if (t->scope != nullptr)
         setattr(t->scope, t->name, result);
 
@@ -981,8 +1380,23 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
     if (modname.is_valid())
         setattr(result, "__module__", modname.ptr());
 
-    internals->type_c2p_fast[t->type] = to;
-    internals->type_c2p_slow[t->type] = to;
+    {
+        lock_internals guard(internals);
+        internals->type_c2p_fast[t->type] = to;
+        internals->type_c2p_slow[t->type] = to;
+    }
+
+    // Approximate footprint of the type object (excluding its dictionary)
+    size_t bytes = sizeof(type_data) + strlen(t->name) + 1;
+    if (has_supplement)
+        bytes += t->supplement;
+    if (has_doc)
+        bytes += strlen(t->doc) + 1;
+#if !defined(Py_LIMITED_API)
+    bytes += (size_t) PyType_Type.tp_basicsize;
+#endif
+
+    nb_reg_record(t->scope, nb_reg_kind::type, start, bytes);
 
     return result;
 }
@@ -990,39 +1404,71 @@ PyObject *nb_type_new(const type_init_data *t) noexcept {
 /// Encapsulates the implicit conversion part of nb_type_get()
 static NB_NOINLINE bool nb_type_get_implicit(PyObject *src,
                                              const std::type_info *cpp_type_src,
-                                             const type_data *dst_type,
+                                             type_data *dst_type,
                                              nb_internals *internals_,
                                              cleanup_list *cleanup, void **out) noexcept {
-    if (dst_type->implicit && cpp_type_src) {
+    /* The outcome of the typeid-based search only depends on the source type
+       and is memoized in 'implicit_hit' and 'implicit_miss'. A miss is only
+       recorded if all candidate types are bound, since binding one of them
+       later could turn it into a hit. Free-threaded builds don't memoize. */
+#if defined(NB_FREE_THREADED)
+    constexpr bool memoize = false;
+#else
+    constexpr bool memoize = true;
+#endif
+
+    if (dst_type->implicit && cpp_type_src &&
+        !(memoize && cpp_type_src == dst_type->implicit_miss)) {
+        if (memoize && cpp_type_src == dst_type->implicit_hit)
+            goto found;
+
         const std::type_info **it = dst_type->implicit;
         const std::type_info *v;
+        bool complete = true;
 
         while ((v = *it++)) {
             if (v == cpp_type_src || *v == *cpp_type_src)
-                goto found;
+                goto found_typeid;
         }
 
         it = dst_type->implicit;
         while ((v = *it++)) {
             const type_data *d = nb_type_c2p(internals_, v);
             if (d && PyType_IsSubtype(Py_TYPE(src), d->type_py))
-                goto found;
+                goto found_typeid;
+            complete &= d != nullptr;
         }
+
+        if (memoize && complete)
+            dst_type->implicit_miss = cpp_type_src;
     }
 
+    /* Predicates inspect the value and not just its type, hence only the
+       position of the last successful one is remembered to try it first */
     if (dst_type->implicit_py) {
         bool (**it)(PyTypeObject *, PyObject *, cleanup_list *) noexcept =
             dst_type->implicit_py;
         bool (*v2)(PyTypeObject *, PyObject *, cleanup_list *) noexcept;
+        uint32_t hint = memoize ? dst_type->implicit_py_hint : 0;
+
+        if (it[hint](dst_type->type_py, src, cleanup))
+            goto found;
 
-        while ((v2 = *it++)) {
-            if (v2(dst_type->type_py, src, cleanup))
+        for (uint32_t i = 0; (v2 = it[i]); ++i) {
+            if (i != hint && v2(dst_type->type_py, src, cleanup)) {
+                if (memoize)
+                    dst_type->implicit_py_hint = i;
                 goto found;
+            }
         }
     }
 
     return false;
 
+found_typeid:
+    if (memoize)
+        dst_type->implicit_hit = cpp_type_src;
+
 found:
 
     PyObject *result;
@@ -1045,6 +1491,7 @@ found:
     if (result) {
         cleanup->append(result);
         *out = inst_ptr((nb_inst *) result);
+        nb_counter_add(internals_->implicit_count, 1);
         return true;
     } else {
         PyErr_Clear();
@@ -1094,11 +1541,32 @@ bool nb_type_get(const std::type_info *cpp_type, PyObject *src, uint8_t flags,
         // Check if the source / destination typeid are an exact match
         bool valid = cpp_type == cpp_type_src || *cpp_type == *cpp_type_src;
 
-        // If not, look up the Python type and check the inheritance chain
+        /* If not, look up the Python type and check the inheritance chain.
+           Base classes that were recently found this way are cached in the
+           source type. These entries never become stale, since a Python
+           type keeps its bases alive. (The cache relies on the GIL to
+           serialize updates and is disabled in free-threaded builds.) */
         if (NB_UNLIKELY(!valid)) {
-            dst_type = nb_type_c2p(internals_, cpp_type);
-            if (dst_type)
-                valid = PyType_IsSubtype(src_type, dst_type->type_py);
+#if !defined(NB_FREE_THREADED)
+            if (cpp_type == t->base_cache[0]) {
+                valid = true;
+            } else if (cpp_type == t->base_cache[1]) {
+                t->base_cache[1] = t->base_cache[0];
+                t->base_cache[0] = cpp_type;
+                valid = true;
+            } else
+#endif
+            {
+                dst_type = nb_type_c2p(internals_, cpp_type);
+                if (dst_type)
+                    valid = PyType_IsSubtype(src_type, dst_type->type_py);
+#if !defined(NB_FREE_THREADED)
+                if (valid) {
+                    t->base_cache[1] = t->base_cache[0];
+                    t->base_cache[0] = cpp_type;
+                }
+#endif
+            }
         }
 
         // Success, return the pointer if the instance is correctly initialized
@@ -1115,7 +1583,7 @@ bool nb_type_get(const std::type_info *cpp_type, PyObject *src, uint8_t flags,
                 return false;
             }
 
-            if (NB_UNLIKELY(inst->weak_py && inst->destroyed)) {
+            if (NB_UNLIKELY(inst->destroyed)) {
                 PyErr_WarnFormat(
                     PyExc_RuntimeWarning, 1, "nanobind: %s of type '%s'!\n",
                         "attempted to access an destroyed instance",
@@ -1158,31 +1626,48 @@ static PyMethodDef keep_alive_callback_def = {
     METH_FASTCALL, nullptr
 };
 
+static nb_weakref_seq *nb_weakref_seq_new(void *payload,
+                                          void (*callback)(void *) noexcept = nullptr) {
+    nb_weakref_seq *s =
+        (nb_weakref_seq *) PyObject_Malloc(sizeof(nb_weakref_seq));
+    check(s, "nanobind::detail::keep_alive(): out of memory!");
+
+    s->callback = callback;
+    s->payload = payload;
+    s->next = nullptr;
+    return s;
+}
+
 void keep_alive(PyObject *nurse, PyObject *patient) {
     if (!patient || !nurse || nurse == Py_None || patient == Py_None)
         return;
 
     if (nb_type_check((PyObject *) Py_TYPE(nurse))) {
-        nb_weakref_seq **pp =
-            (nb_weakref_seq **) &internals->keep_alive[nurse];
+        nb_shard &shard = internals->shard(nurse);
+        lock_shard guard(shard);
 
-        do {
-            nb_weakref_seq *p = *pp;
-            if (!p)
-                break;
-            else if (p->payload == patient && !p->callback)
-                return;
-            pp = &p->next;
-        } while (true);
+        // Store a single patient directly in the map, without allocating
+        auto [it, is_new] = shard.keep_alive.try_emplace(nurse, patient);
 
-        nb_weakref_seq *s =
-            (nb_weakref_seq *) PyObject_Malloc(sizeof(nb_weakref_seq));
-        check(s, "nanobind::detail::keep_alive(): out of memory!");
+        if (!is_new) {
+            void *entry = it->second;
+            if (!nb_is_seq(entry)) {
+                if (entry == patient)
+                    return;
+                entry = it.value() = nb_mark_seq(nb_weakref_seq_new(entry));
+            }
 
-        s->payload = patient;
-        s->callback = nullptr;
-        s->next = nullptr;
-        *pp = s;
+            nb_weakref_seq *p = nb_get_weakref_seq(entry);
+            while (true) {
+                if (p->payload == patient && !p->callback)
+                    return;
+                if (!p->next)
+                    break;
+                p = p->next;
+            }
+
+            p->next = nb_weakref_seq_new(patient);
+        }
 
         Py_INCREF(patient);
         ((nb_inst *) nurse)->clear_keep_alive = true;
@@ -1212,15 +1697,18 @@ void keep_alive(PyObject *nurse, void *payload,
     check(nurse, "nanobind::detail::keep_alive(): 'nurse' is undefined!");
 
     if (nb_type_check((PyObject *) Py_TYPE(nurse))) {
-        nb_weakref_seq
-            **pp = (nb_weakref_seq **) &internals->keep_alive[nurse],
-            *s   = (nb_weakref_seq *) PyObject_Malloc(sizeof(nb_weakref_seq));
-        check(s, "nanobind::detail::keep_alive(): out of memory!");
+        nb_shard &shard = internals->shard(nurse);
+        lock_shard guard(shard);
 
-        s->payload = payload;
-        s->callback = callback;
-        s->next = *pp;
-        *pp = s;
+        auto [it, is_new] = shard.keep_alive.try_emplace(nurse, nullptr);
+
+        nb_weakref_seq *s = nb_weakref_seq_new(payload, callback);
+        if (!is_new) {
+            void *entry = it->second;
+            s->next = nb_is_seq(entry) ? nb_get_weakref_seq(entry)
+                                       : nb_weakref_seq_new(entry);
+        }
+        it.value() = nb_mark_seq(s);
 
         ((nb_inst *) nurse)->clear_keep_alive = true;
     } else {
@@ -1230,6 +1718,48 @@ void keep_alive(PyObject *nurse, void *payload,
     }
 }
 
+void keep_alive_visit(PyObject *nurse, void (*deleter)(void *) noexcept,
+                      void (*func)(void **, void *) noexcept,
+                      void *arg) noexcept {
+    check(nb_type_check((PyObject *) Py_TYPE(nurse)),
+          "nanobind::detail::keep_alive_visit(): 'nurse' must be a nanobind "
+          "instance!");
+
+    nb_shard &shard = internals->shard(nurse);
+    lock_shard guard(shard);
+
+    nb_ptr_map &keep_alive = shard.keep_alive;
+    nb_ptr_map::iterator it = keep_alive.find(nurse);
+
+    if (it != keep_alive.end() && nb_is_seq(it->second)) {
+        nb_weakref_seq *s = nb_get_weakref_seq(it->second);
+        do {
+            if (s->callback == deleter) {
+                func(&s->payload, arg);
+                return;
+            }
+            s = s->next;
+        } while (s);
+    }
+
+    void *payload = nullptr;
+    func(&payload, arg);
+    if (!payload)
+        return;
+
+    nb_weakref_seq *s = nb_weakref_seq_new(payload, deleter);
+    if (it == keep_alive.end()) {
+        keep_alive.try_emplace(nurse, nb_mark_seq(s));
+    } else {
+        void *entry = it->second;
+        s->next = nb_is_seq(entry) ? nb_get_weakref_seq(entry)
+                                   : nb_weakref_seq_new(entry);
+        it.value() = nb_mark_seq(s);
+    }
+
+    ((nb_inst *) nurse)->clear_keep_alive = true;
+}
+
 static PyObject *nb_type_put_common(void *value, type_data *t, rv_policy rvp,
                                     cleanup_list *cleanup,
                                     bool *is_new) noexcept {
@@ -1334,7 +1864,6 @@ PyObject *nb_type_put(const std::type_info *cpp_type,
     }
 
     nb_internals *internals_ = internals;
-    nb_ptr_map &inst_c2p = internals_->inst_c2p;
     type_data *td = nullptr;
 
     auto lookup_type = [cpp_type, internals_, &td]() -> bool {
@@ -1347,11 +1876,29 @@ PyObject *nb_type_put(const std::type_info *cpp_type,
         return true;
     };
 
+    /* Moved values are usually temporaries. Look up their type first, since
+       instances of types marked 'no_identity' are never registered. Copied
+       enumerators map to the unique instance representing their value. */
+    if (rvp == rv_policy::move || rvp == rv_policy::copy) {
+        if (!lookup_type())
+            return nullptr;
+        if (td->flags & (uint32_t) type_flags::is_enum) {
+            PyObject *o = nb_enum_get(td, value);
+            if (o)
+                return o;
+        }
+        if (rvp == rv_policy::move &&
+            (td->flags & (uint32_t) type_flags::no_identity))
+            return nb_type_put_common(value, td, rvp, cleanup, is_new);
+    }
+
     if (rvp != rv_policy::copy) {
         // Check if the instance is already registered with nanobind
-        nb_ptr_map::iterator it = inst_c2p.find(value);
+        nb_shard &shard = internals_->shard(value);
+        lock_shard guard(shard);
+        nb_inst_map::iterator it = shard.inst_c2p.find(value);
 
-        if (it != inst_c2p.end()) {
+        if (it != shard.inst_c2p.end()) {
             void *entry = it->second;
             nb_inst_seq seq;
 
@@ -1366,16 +1913,16 @@ PyObject *nb_type_put(const std::type_info *cpp_type,
                 PyTypeObject *tp = Py_TYPE(seq.inst);
 
                 if (nb_type_data(tp)->type == cpp_type) {
-                    Py_INCREF(seq.inst);
-                    return seq.inst;
+                    if (nb_try_inc_ref(seq.inst))
+                        return seq.inst;
                 }
 
                 if (!lookup_type())
                     return nullptr;
 
                 if (PyType_IsSubtype(tp, td->type_py)) {
-                    Py_INCREF(seq.inst);
-                    return seq.inst;
+                    if (nb_try_inc_ref(seq.inst))
+                        return seq.inst;
                 }
 
                 if (seq.next == nullptr)
@@ -1395,6 +1942,81 @@ PyObject *nb_type_put(const std::type_info *cpp_type,
     return nb_type_put_common(value, td, rvp, cleanup, is_new);
 }
 
+/// Return a new reference to a registered instance of 'td' (or of a subclass)
+/// wrapping 'value', or nullptr if there is none
+static PyObject *nb_inst_find(nb_internals *internals_, type_data *td,
+                              void *value) noexcept {
+    nb_shard &shard = internals_->shard(value);
+    lock_shard guard(shard);
+    nb_inst_map::iterator it = shard.inst_c2p.find(value);
+    if (it == shard.inst_c2p.end())
+        return nullptr;
+
+    void *entry = it->second;
+    nb_inst_seq seq;
+
+    if (NB_UNLIKELY(nb_is_seq(entry))) {
+        seq = *nb_get_seq(entry);
+    } else {
+        seq.inst = (PyObject *) entry;
+        seq.next = nullptr;
+    }
+
+    while (true) {
+        PyTypeObject *tp = Py_TYPE(seq.inst);
+
+        if ((tp == td->type_py || PyType_IsSubtype(tp, td->type_py)) &&
+            nb_try_inc_ref(seq.inst))
+            return seq.inst;
+
+        if (seq.next == nullptr)
+            return nullptr;
+
+        seq = *seq.next;
+    }
+}
+
+PyObject *nb_type_put_list(const std::type_info *cpp_type,
+                           void *const *values, size_t size, rv_policy rvp,
+                           cleanup_list *cleanup) noexcept {
+    object result = steal(PyList_New((Py_ssize_t) size));
+    if (!result.is_valid())
+        return nullptr;
+
+    nb_internals *internals_ = internals;
+    type_data *td = nb_type_c2p(internals_, cpp_type);
+    if (!td)
+        return nullptr;
+
+    // Policies that create new instances take the general code path
+    bool fast = rvp == rv_policy::reference ||
+                rvp == rv_policy::reference_internal ||
+                rvp == rv_policy::take_ownership;
+
+    for (size_t i = 0; i < size; ++i) {
+        void *value = values[i];
+        PyObject *o;
+
+        if (!value) {
+            o = Py_None;
+            Py_INCREF(o);
+        } else if (fast) {
+            o = nb_inst_find(internals_, td, value);
+            if (!o)
+                o = nb_type_put_common(value, td, rvp, cleanup, nullptr);
+        } else {
+            o = nb_type_put(cpp_type, value, rvp, cleanup);
+        }
+
+        if (!o)
+            return nullptr;
+
+        NB_LIST_SET_ITEM(result.ptr(), (Py_ssize_t) i, o);
+    }
+
+    return result.release().ptr();
+}
+
 PyObject *nb_type_put_p(const std::type_info *cpp_type,
                         const std::type_info *cpp_type_p,
                         void *value, rv_policy rvp,
@@ -1406,9 +2028,7 @@ PyObject *nb_type_put_p(const std::type_info *cpp_type,
         return Py_None;
     }
 
-    // Check if the instance is already registered with nanobind
     nb_internals *internals_ = internals;
-    nb_ptr_map &inst_c2p = internals_->inst_c2p;
 
     // Look up the corresponding Python type
     type_data *td = nullptr,
@@ -1428,11 +2048,22 @@ PyObject *nb_type_put_p(const std::type_info *cpp_type,
         return true;
     };
 
+    // See nb_type_put() for the rationale
+    if (rvp == rv_policy::move) {
+        if (!lookup_type())
+            return nullptr;
+        type_data *td_i = td_p ? td_p : td;
+        if (td_i->flags & (uint32_t) type_flags::no_identity)
+            return nb_type_put_common(value, td_i, rvp, cleanup, is_new);
+    }
+
     if (rvp != rv_policy::copy) {
         // Check if the instance is already registered with nanobind
-        nb_ptr_map::iterator it = inst_c2p.find(value);
+        nb_shard &shard = internals_->shard(value);
+        lock_shard guard(shard);
+        nb_inst_map::iterator it = shard.inst_c2p.find(value);
 
-        if (it != inst_c2p.end()) {
+        if (it != shard.inst_c2p.end()) {
             void *entry = it->second;
             nb_inst_seq seq;
 
@@ -1449,8 +2080,8 @@ PyObject *nb_type_put_p(const std::type_info *cpp_type,
                 const std::type_info *p = nb_type_data(tp)->type;
 
                 if (p == cpp_type || p == cpp_type_p) {
-                    Py_INCREF(seq.inst);
-                    return seq.inst;
+                    if (nb_try_inc_ref(seq.inst))
+                        return seq.inst;
                 }
 
                 if (!lookup_type())
@@ -1458,8 +2089,8 @@ PyObject *nb_type_put_p(const std::type_info *cpp_type,
 
                 if (PyType_IsSubtype(tp, td->type_py) ||
                     (td_p && PyType_IsSubtype(tp, td_p->type_py))) {
-                    Py_INCREF(seq.inst);
-                    return seq.inst;
+                    if (nb_try_inc_ref(seq.inst))
+                        return seq.inst;
                 }
 
                 if (seq.next == nullptr)
@@ -1508,13 +2139,63 @@ static void nb_type_put_unique_finalize(PyObject *o,
     }
 }
 
+/**
+ * Fast path of nb_type_put_unique(): handle the common case of a pointer that
+ * maps to a single relinquished instance of the exact type (e.g. a
+ * std::unique_ptr that was passed from Python to C++ and is now returned).
+ * Returns nullptr if the general code path must be taken.
+ */
+static PyObject *nb_type_put_unique_fast(const std::type_info *cpp_type,
+                                         const std::type_info *cpp_type_p,
+                                         void *value, bool cpp_delete) noexcept {
+    if (!value)
+        return nullptr;
+
+    nb_shard &shard = internals->shard(value);
+    PyObject *o;
+
+    {
+        lock_shard guard(shard);
+        nb_inst_map::iterator it = shard.inst_c2p.find(value);
+        if (it == shard.inst_c2p.end() || nb_is_seq(it->second))
+            return nullptr;
+
+        o = (PyObject *) it->second;
+        const std::type_info *type = nb_type_data(Py_TYPE(o))->type;
+        if ((type != cpp_type && type != cpp_type_p) || !nb_try_inc_ref(o))
+            return nullptr;
+    }
+
+    /* A single test of the flags (which share a byte) covers the expected
+       state. Anything else is reported by nb_type_put_unique_finalize(). */
+    nb_inst *inst = (nb_inst *) o;
+    bool expected = cpp_delete ? !(inst->ready | inst->destruct | inst->cpp_delete)
+                               : !inst->ready;
+
+    if (NB_UNLIKELY(!expected)) {
+        Py_DECREF(o);
+        return nullptr;
+    }
+
+    if (cpp_delete)
+        inst->ready = inst->destruct = inst->cpp_delete = true;
+    else
+        inst->ready = true;
+
+    return o;
+}
+
 PyObject *nb_type_put_unique(const std::type_info *cpp_type,
                              void *value,
                              cleanup_list *cleanup, bool cpp_delete) noexcept {
+    PyObject *o = nb_type_put_unique_fast(cpp_type, nullptr, value, cpp_delete);
+    if (o)
+        return o;
+
     rv_policy policy = cpp_delete ? rv_policy::take_ownership : rv_policy::none;
 
     bool is_new = false;
-    PyObject *o = nb_type_put(cpp_type, value, policy, cleanup, &is_new);
+    o = nb_type_put(cpp_type, value, policy, cleanup, &is_new);
 
     if (o)
         nb_type_put_unique_finalize(o, cpp_type, cpp_delete, is_new);
@@ -1526,11 +2207,15 @@ PyObject *nb_type_put_unique_p(const std::type_info *cpp_type,
                                const std::type_info *cpp_type_p,
                                void *value,
                                cleanup_list *cleanup, bool cpp_delete) noexcept {
+    PyObject *o =
+        nb_type_put_unique_fast(cpp_type, cpp_type_p, value, cpp_delete);
+    if (o)
+        return o;
+
     rv_policy policy = cpp_delete ? rv_policy::take_ownership : rv_policy::none;
 
     bool is_new = false;
-    PyObject *o =
-        nb_type_put_p(cpp_type, cpp_type_p, value, policy, cleanup, &is_new);
+    o = nb_type_put_p(cpp_type, cpp_type_p, value, policy, cleanup, &is_new);
 
     if (o)
         nb_type_put_unique_finalize(o, cpp_type, cpp_delete, is_new);
@@ -1541,6 +2226,13 @@ PyObject *nb_type_put_unique_p(const std::type_info *cpp_type,
 void nb_type_relinquish_ownership(PyObject *o, bool cpp_delete) {
     nb_inst *inst = (nb_inst *) o;
 
+    // Fast path: Python owns an instance created on the C++ side
+    if (NB_LIKELY(cpp_delete && (inst->ready & inst->destruct &
+                                 inst->cpp_delete & !inst->internal))) {
+        inst->ready = inst->destruct = inst->cpp_delete = false;
+        return;
+    }
+
     // This function is called to indicate ownership *changes*
     check(inst->ready,
           "nanobind::detail::nb_relinquish_ownership('%s'): ownership "
@@ -1676,6 +2368,20 @@ std::pair<bool, bool> nb_inst_state(PyObject *o) noexcept {
 void nb_inst_set_destroyed(PyObject *o)noexcept
 {
     nb_inst *nbi = (nb_inst *)o;
+    if (nbi->destroyed)
+        return;
+
+    /* Detach the instance from its C++ address right away. A new object
+       allocated at the same address then receives a fresh instance, and the
+       map entry remains a single slot instead of turning into a list. */
+    type_data *t = nb_type_data(Py_TYPE(o));
+    if (!(t->flags & (uint32_t) type_flags::no_identity)) {
+        void *p = inst_ptr(nbi);
+        nb_shard &shard = internals->shard(p);
+        lock_shard guard(shard);
+        nb_inst_unregister(shard.inst_c2p, p, nbi);
+    }
+
     nbi->destroyed = true;
 }
 
@@ -1757,8 +2463,15 @@ void nb_inst_replace_copy(PyObject *dst, const PyObject *src) noexcept {
 }
 
 #if defined(Py_LIMITED_API)
+Py_ssize_t nb_type_data_offset = 0;
+
+/* All metaclasses created by nb_type_tp() derive from 'type' and place the
+   type record at the same offset, which is determined on first use */
 type_data *nb_type_data_static(PyTypeObject *o) noexcept {
-    return (type_data *) PyObject_GetTypeData((PyObject *) o, Py_TYPE((PyObject *) o));
+    type_data *t = (type_data *) PyObject_GetTypeData((PyObject *) o,
+                                                      Py_TYPE((PyObject *) o));
+    nb_type_data_offset = (Py_ssize_t) ((char *) t - (char *) o);
+    return t;
 }
 #endif
 
@@ -1791,5 +2504,77 @@ bool nb_inst_python_derived(PyObject *o) noexcept {
            (uint32_t) type_flags::is_python_type;
 }
 
+PyObject *type_stats() {
+#if defined(NB_TYPE_STATS)
+    struct entry {
+        PyTypeObject *type;
+        nb_type_stats stats;
+    };
+
+    // Copy the counters first, the dictionary can't be built with the lock held
+    entry *entries;
+    size_t size = 0;
+    {
+        lock_internals guard(internals);
+        nb_type_map_slow &type_c2p_slow = internals->type_c2p_slow;
+        entries = (entry *) malloc(sizeof(entry) * (type_c2p_slow.size() + 1));
+        check(entries, "nanobind::detail::type_stats(): out of memory!");
+
+        for (const auto &kv : type_c2p_slow) {
+            type_data *t = kv.second;
+            if (!t)
+                continue;
+            entry &e = entries[size++];
+            e.type = t->type_py;
+            e.stats.created = nb_counter_load(t->stats->created);
+            e.stats.destroyed = nb_counter_load(t->stats->destroyed);
+            e.stats.bytes = nb_counter_load(t->stats->bytes);
+            Py_INCREF(e.type);
+        }
+    }
+
+    auto release = [&]() {
+        for (size_t i = 0; i < size; ++i)
+            Py_DECREF(entries[i].type);
+        free(entries);
+    };
+
+    dict result;
+    try {
+        for (size_t i = 0; i < size; ++i) {
+            const nb_type_stats &s = entries[i].stats;
+            dict value;
+            value["live"] = s.created - s.destroyed;
+            value["created"] = s.created;
+            value["destroyed"] = s.destroyed;
+            value["bytes"] = s.bytes;
+            result[handle((PyObject *) entries[i].type)] = value;
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+
+    release();
+    return result.release().ptr();
+#else
+    raise("nanobind::type_stats(): instance accounting is unavailable (the "
+          "extension must be compiled with NB_TYPE_STATS)!");
+#endif
+}
+
+/// Python interface of the type statistics, installed in the internal nanobind module
+PyObject *nb_module_type_stats(PyObject *, PyObject *) {
+    try {
+        return type_stats();
+    } catch (python_error &e) {
+        e.restore();
+        return nullptr;
+    } catch (const std::exception &e) {
+        PyErr_SetString(PyExc_RuntimeError, e.what());
+        return nullptr;
+    }
+}
+
 NAMESPACE_END(detail)
 NAMESPACE_END(NB_NAMESPACE)
@@ -13,15 +13,94 @@
 NAMESPACE_BEGIN(NB_NAMESPACE)
 NAMESPACE_BEGIN(detail)
 
+/// Name of the first slot of trampolines that don't need to consult Python
+static const char trampoline_no_override = 0;
+
+void trampoline_cache_free(nb_trampoline_cache *c) noexcept {
+    if (!c)
+        return;
+    for (size_t i = 0; i < c->size; ++i)
+        Py_XDECREF((PyObject *) c->data[i*2 + 1]);
+    free(c);
+}
+
+/// Remember the override resolved by a trampoline in the instance's type
+static void trampoline_cache_put(type_data *td, size_t size, const char *name,
+                                 PyObject *value) noexcept {
+    nb_trampoline_cache *c = td->trampolines;
+    size_t epoch = internals->trampoline_epoch;
+
+    if (c && (c->size != size || c->epoch != epoch)) {
+        trampoline_cache_free(c);
+        c = td->trampolines = nullptr;
+    }
+
+    if (!c) {
+        c = (nb_trampoline_cache *) calloc(
+            1, sizeof(nb_trampoline_cache) + sizeof(void *) * (2 * size - 1));
+        if (!c)
+            return; // caching is optional
+        c->epoch = epoch;
+        c->size = size;
+        td->trampolines = c;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        void *c_name = c->data[2*i];
+        if (c_name == name)
+            return;
+        if (!c_name) {
+            Py_INCREF(value);
+            c->data[2*i] = (void *) name;
+            c->data[2*i + 1] = value;
+            return;
+        }
+    }
+}
+
 void trampoline_new(void **data, size_t size, void *ptr) noexcept {
     // GIL is held when the trampoline constructor runs
-    nb_ptr_map &inst_c2p = internals->inst_c2p;
-    nb_ptr_map::iterator it = inst_c2p.find(ptr);
-    check(it != inst_c2p.end() && (((uintptr_t) it->second) & 1) == 0,
+    nb_shard &shard = internals->shard(ptr);
+    void *inst = nullptr;
+    {
+        lock_shard guard(shard);
+        nb_inst_map::iterator it = shard.inst_c2p.find(ptr);
+        if (it != shard.inst_c2p.end())
+            inst = it->second;
+    }
+    check(inst && (((uintptr_t) inst) & 1) == 0,
           "nanobind::detail::trampoline_new(): unique instance not found!");
 
-    data[0] = it->second;
+    data[0] = inst;
     memset(data + 1, 0, sizeof(void *) * 2 * size);
+
+    type_data *td = nb_type_data(Py_TYPE((PyObject *) inst));
+
+    /* An instance of the bound type itself (e.g., of an abstract class, or
+       one constructed via the alias) cannot override anything. Virtual
+       calls then go straight to the C++ implementation. */
+    if (size && (td->flags & (uint32_t) type_flags::is_python_type) == 0) {
+        data[1] = (void *) &trampoline_no_override;
+        return;
+    }
+
+    /* Overrides are usually the same for all instances of a type. Start out
+       with the ones that were already resolved, which saves the attribute
+       lookups (and acquiring the GIL) on the first call of each method. */
+    lock_internals guard(internals);
+    nb_trampoline_cache *c = td->trampolines;
+    if (!c || c->size != size || c->epoch != internals->trampoline_epoch)
+        return;
+
+    for (size_t i = 0; i < size; ++i) {
+        void *c_name  = c->data[2*i],
+             *c_value = c->data[2*i + 1];
+        if (!c_name)
+            break;
+        Py_INCREF((PyObject *) c_value);
+        data[2*i + 2] = c_value;
+        data[2*i + 1] = c_name;
+    }
 }
 
 void trampoline_release(void **data, size_t size) noexcept {
@@ -34,24 +113,35 @@ static void trampoline_enter_internal(void **data, size_t size,
                                       const char *name, bool pure, ticket *t) {
     const PyObject *None = Py_None;
     PyGILState_STATE state{ };
+    uint64_t start = 0;
     const char *error = nullptr;
     PyObject *key = nullptr, *value = nullptr;
     PyTypeObject *value_tp = nullptr;
     size_t offset = 0;
 
+    // No need to consult Python (or to acquire the GIL), see trampoline_new()
+    if (data[1] == &trampoline_no_override) {
+        if (pure)
+            raise("nanobind::detail::get_trampoline('%s::%s()'): tried to "
+                  "call a pure virtual function!",
+                  nb_type_data(Py_TYPE((PyObject *) data[0]))->name, name);
+        return;
+    }
+
     // First, perform a quick sweep without lock
     for (size_t i = 0; i < size; i++) {
         void *d_name  = data[2*i + 1],
              *d_value = data[2*i + 2];
         if (name == d_name && d_value) {
             if (d_value != None) {
-                t->state = PyGILState_Ensure();
+                t->state =
+                    gil_state_ensure(gil_site::trampoline, &t->gil_start);
                 t->key = (PyObject *) d_value;
                 return;
             } else {
                 if (pure) {
                     error = "tried to call a pure virtual function";
-                    state = PyGILState_Ensure();
+                    state = gil_state_ensure(gil_site::trampoline, &start);
                     goto fail;
                 } else {
                     return;
@@ -61,13 +151,14 @@ static void trampoline_enter_internal(void **data, size_t size,
     }
 
     // Nothing found -- retry, now with lock held
-    state = PyGILState_Ensure();
+    state = gil_state_ensure(gil_site::trampoline, &start);
     for (size_t i = 0; i < size; i++) {
         void *d_name  = data[2*i + 1],
              *d_value = data[2*i + 2];
         if (name == d_name && d_value) {
             if (d_value != None) {
                 t->state = state;
+                t->gil_start = start;
                 t->key = (PyObject *) d_value;
                 return;
             } else {
@@ -75,7 +166,7 @@ static void trampoline_enter_internal(void **data, size_t size,
                     error = "tried to call a pure virtual function";
                     goto fail;
                 } else {
-                    PyGILState_Release(state);
+                    gil_state_release(gil_site::trampoline, state, start);
                     return;
                 }
             }
@@ -83,18 +174,6 @@ static void trampoline_enter_internal(void **data, size_t size,
     }
 
     // Sill no luck -- perform a lookup and populate the trampoline
-    for (; offset < size; offset++) {
-        if (data[2 * offset + 1] == nullptr &&
-            data[2 * offset + 2] == nullptr)
-            break;
-    }
-
-    if (offset == size) {
-        error = "the trampoline ran out of slots (you will need to increase "
-                "the value provided to the NB_TRAMPOLINE() macro)";
-        goto fail;
-    }
-
     key = PyUnicode_InternFromString(name);
     if (!key) {
         error = "could not intern string";
@@ -123,21 +202,54 @@ static void trampoline_enter_internal(void **data, size_t size,
         key = Py_None;
     }
 
-    data[2 * offset + 1] = (void *) name;
-    data[2 * offset + 2] = key;
+    {
+        /* Another thread may have populated this entry in the meantime (free-
+           threaded build). Claim a slot with the lock held, and publish the
+           value before the name so that the lock-free sweep never sees a
+           name without its value. */
+        lock_internals guard(internals);
+        for (; offset < size; offset++) {
+            void *d_name  = data[2 * offset + 1],
+                 *d_value = data[2 * offset + 2];
+
+            if (d_name == name && d_value) {
+                Py_DECREF(key);
+                key = (PyObject *) d_value;
+                break;
+            }
+
+            if (!d_name && !d_value) {
+                data[2 * offset + 2] = key;
+                data[2 * offset + 1] = (void *) name;
+                break;
+            }
+        }
+
+        if (offset < size)
+            trampoline_cache_put(nb_type_data(Py_TYPE((PyObject *) data[0])),
+                                 size, name, key);
+    }
+
+    if (offset == size) {
+        Py_DECREF(key);
+        error = "the trampoline ran out of slots (you will need to increase "
+                "the value provided to the NB_TRAMPOLINE() macro)";
+        goto fail;
+    }
 
     if (key != None) {
         t->state = state;
+        t->gil_start = start;
         t->key = key;
         return;
     } else {
-        PyGILState_Release(state);
+        gil_state_release(gil_site::trampoline, state, start);
         return;
     }
 
 fail:
     type_data *td = nb_type_data(Py_TYPE((PyObject *) data[0]));
-    PyGILState_Release(state);
+    gil_state_release(gil_site::trampoline, state, start);
 
     raise("nanobind::detail::get_trampoline('%s::%s()'): %s!",
           td->name, name, error);
@@ -156,7 +268,7 @@ void trampoline_enter(void **data, size_t size, const char *name, bool pure, tic
             t->self = handle();
             t->key = handle();
             t->prev = nullptr;
-            PyGILState_Release(t->state);
+            gil_state_release(gil_site::trampoline, t->state, t->gil_start);
             if (pure)
                 raise("nanobind::detail::get_trampoline('%s()'): tried to call "
                       "a pure virtual function!", name);
@@ -171,7 +283,7 @@ void trampoline_leave(ticket *t) noexcept {
     if (!t->key)
         return;
     current_ticket = t->prev;
-    PyGILState_Release(t->state);
+    gil_state_release(gil_site::trampoline, t->state, t->gil_start);
 }
 
 NAMESPACE_END(detail)
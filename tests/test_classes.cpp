@@ -303,6 +303,15 @@ NB_MODULE(test_classes_ext, m) {
 
     m.def("get_d", [](const D &d) { return d.value; });
 
+    // test42_overload_cache
+    m.def("dispatch", [](const A &a) {
+        if (a.a < 0)
+            throw nb::next_overload();
+        return "A";
+    });
+    m.def("dispatch", [](const B &) { return "B"; });
+    m.def("dispatch", [](const D &) { return "D"; });
+
     struct Int {
         int i;
         Int operator+(Int o) const { return {i + o.i}; }
@@ -347,6 +356,32 @@ NB_MODULE(test_classes_ext, m) {
 
     nb::class_<StaticProperties2, StaticProperties>(m, "StaticProperties2");
 
+    // test61_weak_py_address_reuse
+    struct WeakPyEntity { int id = 0; PyObject *py = nullptr; };
+    static WeakPyEntity weak_py_pool[1];
+    nb::class_<WeakPyEntity>(m, "WeakPyEntity",
+        nb::weak_py<WeakPyEntity>([](WeakPyEntity *e, PyObject *o) noexcept { e->py = o; }))
+        .def_ro("id", &WeakPyEntity::id)
+        .def("get_id", [](const WeakPyEntity &e) { return e.id; });
+    m.def("weak_py_spawn", [](int id) {
+        weak_py_pool[0] = WeakPyEntity{ id, nullptr };
+        return &weak_py_pool[0];
+    });
+    m.def("weak_py_get", []() { return &weak_py_pool[0]; });
+    m.def("weak_py_despawn", []() {
+        if (weak_py_pool[0].py)
+            nb::inst_set_destroyed(weak_py_pool[0].py);
+        weak_py_pool[0].py = nullptr;
+    });
+
+    // test60_static_const
+    struct StaticConst { };
+    nb::class_<StaticConst>(m, "StaticConst")
+        .def(nb::init<>())
+        .def_const_static("answer", 42, "Static constant docstring")
+        .def_const_static("name", std::string("const"))
+        .def_const_static("struct_", Struct(7));
+
     // test19_supplement
     struct ClassWithSupplement { };
     struct Supplement {
@@ -449,6 +484,11 @@ NB_MODULE(test_classes_ext, m) {
     m.def("none_2", [](Struct *s) { return s == nullptr; }, nb::arg("arg"));
     m.def("none_3", [](Struct *s) { return s == nullptr; }, nb::arg().none());
     m.def("none_4", [](Struct *s) { return s == nullptr; }, nb::arg("arg").none());
+    m.def("none_5", [](Struct *s, int i) { return s ? s->i + i : i; },
+          nb::arg("s").none(), nb::arg("i") = 1);
+    m.def("none_5", [](const char *) { return -1; });
+    m.def("none_6", [](Struct &) { return 1; }, nb::arg().none());
+    m.def("none_6", [](nb::handle) { return 2; }, nb::arg().none());
 
     // test25_is_final
     struct FinalType { };
@@ -460,6 +500,16 @@ NB_MODULE(test_classes_ext, m) {
     nb::class_<StructWithAttr, Struct>(m, "StructWithAttr", nb::dynamic_attr())
         .def(nb::init<int>());
 
+    struct StructWithSlots : Struct { };
+    nb::class_<StructWithSlots, Struct>(m, "StructWithSlots",
+                                        nb::inline_attrs("prev", "next", "tag"))
+        .def(nb::init<int>());
+
+    struct StructWithSlots2 : StructWithSlots { double extra[4] { }; };
+    nb::class_<StructWithSlots2, StructWithSlots>(
+        m, "StructWithSlots2", nb::inline_attrs("label"), nb::dynamic_attr())
+        .def(nb::init<>());
+
     nb::class_<Wrapper>(m, "Wrapper", nb::type_slots(wrapper_slots))
         .def(nb::init<>())
         .def_rw("value", &Wrapper::value);
@@ -521,6 +571,131 @@ NB_MODULE(test_classes_ext, m) {
         return std::make_pair(rv, i);
     });
 
+#if defined(NB_SUBINTERPRETERS)
+    m.attr("subinterpreters") = true;
+#else
+    m.attr("subinterpreters") = false;
+#endif
+
+#if defined(NB_TYPE_STATS)
+    m.attr("type_stats_enabled") = true;
+#else
+    m.attr("type_stats_enabled") = false;
+#endif
+    m.def("type_stats", &nb::type_stats);
+
+    // test53_pickle_buffer
+    struct Samples {
+        int tag;
+        std::vector<float> values;
+    };
+
+    nb::class_<Samples>(m, "Samples")
+        .def("__init__", [](Samples *s, int tag, size_t n) {
+            new (s) Samples{ tag, std::vector<float>(n) };
+            for (size_t i = 0; i < n; ++i)
+                s->values[i] = (float) i;
+        })
+        .def_ro("tag", &Samples::tag)
+        .def("sum", [](const Samples &s) {
+            double sum = 0;
+            for (float v : s.values)
+                sum += v;
+            return sum;
+        })
+        .def(nb::pickle(
+            [](const Samples &s) {
+                return std::make_tuple(
+                    s.tag, nb::pickle_buffer(s.values.data(),
+                                             s.values.size() * sizeof(float)));
+            },
+            [](Samples &s, const std::tuple<int, nb::pickle_buffer> &state) {
+                const nb::pickle_buffer &buf = std::get<1>(state);
+                const float *data = (const float *) buf.data();
+                new (&s) Samples{ std::get<0>(state),
+                                  std::vector<float>(data, data + buf.size() / sizeof(float)) };
+            }));
+
+    // test54_vectorcall_init
+    struct Sum5 {
+        int value;
+    };
+
+    nb::class_<Sum5>(m, "Sum5")
+        .def("__init__", [](Sum5 *s, int a, int b, int c, int d, int e) {
+            new (s) Sum5{ a + 2 * b + 3 * c + 4 * d + 5 * e };
+        }, "a"_a, "b"_a = 0, "c"_a = 0, "d"_a = 0, "e"_a = 0)
+        .def_ro("value", &Sum5::value);
+
+    // test55_native_slot_operators
+    struct Vec2 {
+        float x, y;
+        Vec2 operator+(const Vec2 &o) const { return { x + o.x, y + o.y }; }
+        Vec2 operator*(float s) const { return { x * s, y * s }; }
+        Vec2 operator-() const { return { -x, -y }; }
+        Vec2 &operator+=(const Vec2 &o) {
+            x += o.x;
+            y += o.y;
+            return *this;
+        }
+        bool operator==(const Vec2 &o) const { return x == o.x && y == o.y; }
+        bool operator!=(const Vec2 &o) const { return !operator==(o); }
+        bool operator!() const { return x == 0 && y == 0; }
+    };
+
+    nb::class_<Vec2>(m, "Vec2")
+        .def(nb::init<float, float>())
+        .def_rw("x", &Vec2::x)
+        .def_rw("y", &Vec2::y)
+        .def("__radd__", [](const Vec2 &v, int i) {
+            return Vec2{ v.x + (float) i, v.y + (float) i };
+        })
+        .def(nb::self != nb::self)
+        .def(nb::self + nb::self, nb::native_slot())
+        .def(nb::self * float(), nb::native_slot())
+        .def(nb::self += nb::self, nb::native_slot())
+        .def(-nb::self, nb::native_slot())
+        .def(nb::self == nb::self, nb::native_slot())
+        .def(!nb::self, nb::native_slot());
+
+    struct Record {
+        bool flag = false;
+        int8_t i8 = -1;
+        uint16_t u16 = 2;
+        int32_t i32 = -3;
+        uint64_t u64 = 4;
+        float f32 = 0.5f;
+        double f64 = 0.25;
+        Vec2 pos { 1, 2 };
+        int id = 7;
+    };
+
+    nb::class_<Record>(m, "Record")
+        .def(nb::init<>())
+        .def_rw("flag", &Record::flag)
+        .def_rw("i8", &Record::i8)
+        .def_rw("u16", &Record::u16)
+        .def_rw("i32", &Record::i32, "A signed integer")
+        .def_rw("u64", &Record::u64)
+        .def_rw("f32", &Record::f32)
+        .def_rw("f64", &Record::f64)
+        .def_rw("pos", &Record::pos)
+        .def_ro("id", &Record::id)
+        .def("sum", [](const Record &r) {
+            return (double) r.flag + r.i8 + r.u16 + r.i32 + (double) r.u64 +
+                   r.f32 + r.f64 + r.pos.x + r.pos.y + r.id;
+        });
+
+    m.def("native_slot_enabled", []() {
+#if !defined(Py_LIMITED_API) && !defined(PYPY_VERSION)
+        // 'Int' uses the generic slot wrapper that dispatches to '__add__'
+        return nb::type_get_slot(nb::type<Vec2>(), Py_nb_add) !=
+               nb::type_get_slot(nb::type<Int>(), Py_nb_add);
+#else
+        return false;
+#endif
+    });
+
 #if !defined(Py_LIMITED_API)
     m.def("test_slots", []() {
         nb::object wrapper_tp = nb::module_::import_("test_classes_ext").attr("Wrapper");
@@ -554,4 +729,26 @@ NB_MODULE(test_classes_ext, m) {
         "get_incrementing_struct_value",
         [](IncrementingStruct &s) { return new Struct(s.i + 100); },
         nb::keep_alive<0, 1>());
+
+    // test43_freelist
+    struct PooledStruct : Struct { using Struct::Struct; };
+    nb::class_<PooledStruct, Struct>(m, "PooledStruct", nb::freelist<2>())
+        .def(nb::init<int>());
+
+    // test44_no_identity
+    struct ValueStruct : Struct { using Struct::Struct; };
+    static ValueStruct value_struct_global(7);
+    nb::class_<ValueStruct, Struct>(m, "ValueStruct", nb::no_identity())
+        .def(nb::init<int>())
+        .def("copy", [](const ValueStruct &v) { return ValueStruct(v.i + 1); });
+    m.def("value_struct_ref", []() -> ValueStruct & { return value_struct_global; },
+          nb::rv_policy::reference);
+    m.def("value_struct_find", [](ValueStruct *v) { return nb::find(v).is_valid(); });
+
+    // test59_move_arg
+    m.def("take_struct", [](Struct s) { return s.i; });
+    m.def("take_struct_move", [](Struct s) { return s.i; }, nb::move_arg<1>());
+    m.def("take_struct_rvalue",
+          [](int offset, Struct &&s) { Struct s2(std::move(s)); return s2.i + offset; },
+          nb::move_arg<2>());
 }
@@ -1,7 +1,7 @@
 import sys
 import test_classes_ext as t
 import pytest
-from common import skip_on_pypy, collect
+from common import skip_on_pypy, collect, is_pypy
 
 
 @pytest.fixture
@@ -525,6 +525,15 @@ def test25_none_arg():
         t.none_2(arg=None)
     assert t.none_3(None) is True
     assert t.none_4(arg=None) is True
+    assert t.none_5(None, 2) == 2
+    assert t.none_5(None) == 1
+    assert t.none_5(t.Struct(5), 2) == 7
+    assert t.none_5(s=None, i=3) == 3
+    assert t.none_5('hello') == -1
+    with pytest.raises(TypeError):
+        t.none_5(None, None)
+    assert t.none_6(t.Struct()) == 1
+    assert t.none_6(None) == 2
     assert t.none_0.__doc__ == 'none_0(arg: test_classes_ext.Struct, /) -> bool'
     assert t.none_1.__doc__ == 'none_1(arg: test_classes_ext.Struct) -> bool'
     assert t.none_2.__doc__ == 'none_2(arg: test_classes_ext.Struct) -> bool'
@@ -565,6 +574,52 @@ def test27_dynamic_attr(clean):
     )
 
 
+def test27_inline_attrs(clean):
+    l = [t.StructWithSlots(i) for i in range(100)]
+    assert not hasattr(l[0], "__dict__")
+
+    # Create a big reference cycle..
+    for i in range(100):
+        l[i].prev = l[i - 1]
+        l[i].next = l[i + 1 if i < 99 else 0]
+
+    for i in range(100):
+        assert l[i].value() == i
+        assert l[i].prev.value() == (i-1 if i > 0 else 99)
+        assert l[i].next.value() == (i+1 if i < 99 else 0)
+
+    s = l[0]
+    with pytest.raises(AttributeError):
+        s.tag
+    s.tag = "x"
+    assert s.tag == "x"
+    del s.tag
+    assert not hasattr(s, "tag")
+    with pytest.raises(AttributeError):
+        s.other = 1
+    del l, s
+    collect()
+
+    assert_stats(
+        value_constructed=100,
+        destructed=100
+    )
+
+    # The derived C++ type is larger and declares the base attributes again
+    d = t.StructWithSlots2()
+    d.prev, d.next, d.tag, d.label, d.other = 1, 2, 3, 4, 5
+    assert (d.prev, d.next, d.tag, d.label, d.other) == (1, 2, 3, 4, 5)
+    assert d.value() == 5
+
+    class Py(t.StructWithSlots):
+        pass
+
+    p = Py(3)
+    p.tag, p.other = "a", "b"
+    assert (p.tag, p.other, p.value()) == ("a", "b", 3)
+    assert p.__dict__ == { "other": "b" }
+
+
 def test28_copy_rvp():
     a = t.Struct.create_reference()
     b = t.Struct.create_copy()
@@ -759,3 +814,460 @@ def test41_implicit_conversion_keep_alive():
     assert d1 == []
     assert d2 == [5]
     assert d3 == [106, 6]
+
+
+def test42_overload_cache():
+    # Repeated calls must resolve the same overloads as the first call
+    a, a_neg = t.A(1), t.A(-1)
+    b, b2 = t.B(2), t.B2(3)
+    for i in range(3):
+        assert t.dispatch(a) == 'A'
+        assert t.dispatch(a_neg) == 'D'
+        assert t.dispatch(b) == 'B'
+        assert t.dispatch(b2) == 'B'
+        assert t.dispatch(5) == 'D'
+        assert t.dispatch(a_neg) == 'D'
+        assert t.dispatch(a) == 'A'
+    with pytest.raises(TypeError):
+        t.dispatch(t.C(4))
+
+
+def test43_freelist():
+    collect()
+    t.get_destructed()
+    objs = [t.PooledStruct(i) for i in range(4)]
+    addrs = { id(o) for o in objs }
+    del objs
+    collect()
+    assert sorted(t.get_destructed()) == [0, 1, 2, 3]
+
+    # Recycled instances must be fully reinitialized
+    p1, p2 = t.PooledStruct(10), t.PooledStruct(11)
+    assert id(p1) in addrs and id(p2) in addrs
+    assert p1.value() == 10 and p2.value() == 11
+    assert isinstance(p1, t.Struct)
+    del p1, p2
+    collect()
+    assert sorted(t.get_destructed()) == [10, 11]
+
+    class PySub(t.PooledStruct):
+        pass
+
+    for i in range(3):
+        assert PySub(i).value() == i
+    collect()
+    assert t.get_destructed() == [0, 1, 2]
+
+
+def test44_no_identity():
+    collect()
+    t.get_destructed()
+    v = t.ValueStruct(1)
+    w = v.copy()
+    assert v.value() == 1 and w.value() == 2
+    assert isinstance(w, t.Struct) and t.Struct.value(w) == 2
+    t.get_destructed() # moved-from temporary
+
+    # Instances are not registered, hence references aren't deduplicated
+    r1, r2 = t.value_struct_ref(), t.value_struct_ref()
+    assert r1 is not r2 and r1.value() == r2.value() == 7
+    assert not t.value_struct_find(v)
+
+    del v, w, r1, r2
+    collect()
+    assert sorted(t.get_destructed()) == [1, 2]
+
+
+
+def test45_instance_map_growth(clean):
+    # Lookups must succeed while the instance map is being resized
+    objs = [t.Struct(i) for i in range(20000)]
+    assert all(o.self() is o for o in objs)
+    del objs[::2]
+    objs += [t.Struct(i) for i in range(20000)]
+    assert all(o.self() is o for o in objs)
+    del objs
+    assert_stats(default_constructed=0, value_constructed=40000, destructed=40000)
+
+
+def test46_base_cast_cache():
+    # Repeated derived -> base casts are served from a per-type cache
+    dog, cat = t.Dog('woof'), t.Cat('meow')
+    for _ in range(3):
+        assert t.go(dog) == 'Dog says woof'
+        assert t.go(cat) == 'Cat says meow'
+        assert t.animal_passthrough(dog) is dog
+    with pytest.raises(TypeError):
+        t.go(t.Struct())
+
+
+def test47_implicitly_convertible_repeated():
+    # Memoized conversion routes must not change the outcome of later calls
+    a, b2, c = t.A(1), t.B2(3), t.C(4)
+    for _ in range(3):
+        assert t.get_d(b2) == 103
+        assert t.get_d(5) == 10005
+        assert t.get_d(a) == 11
+        with pytest.raises(TypeError):
+            t.get_d(c)
+        with pytest.raises(TypeError):
+            t.get_d(object())
+
+
+def test48_keep_alive_multiple(clean):
+    # A nurse referencing several patients spills into a list
+    a = t.Dog('Rufus')
+    s1, s2 = t.Struct(), t.Struct()
+    for s in (s1, s2, s1, s2):
+        assert t.keep_alive_ret(a, s) is s
+    del s, s1, s2
+    assert_stats(default_constructed=2)
+    del a
+    assert_stats(default_constructed=2, destructed=2)
+
+
+@pytest.mark.skipif(not t.subinterpreters,
+                    reason="requires a build with per-interpreter internals")
+def test49_subinterpreters():
+    # Each isolated interpreter (with its own GIL) gets separate internals.
+    # Creating sub-interpreters changes process-wide state (e.g., it disables
+    # PyGILState_Check()), hence the test runs in a separate process.
+    import subprocess
+    import textwrap
+
+    code = textwrap.dedent('''
+        import threading
+        try:
+            import _interpreters as interpreters
+        except ImportError:
+            import _xxsubinterpreters as interpreters
+        import test_classes_ext as t
+
+        code = """if True:
+            import test_classes_ext as t
+            s = t.Struct(5)
+            s.set_value(6)
+            assert s.value() == 6
+            assert t.get_d(5) == 10005
+        """
+
+        errors = []
+
+        def run(i):
+            try:
+                # Python 3.13+ returns exception details instead of raising
+                if interpreters.run_string(i, code) is not None:
+                    errors.append(i)
+            except Exception as e:
+                errors.append(e)
+
+        ids = [interpreters.create() for _ in range(2)]
+        threads = [threading.Thread(target=run, args=(i,)) for i in ids]
+        for th in threads:
+            th.start()
+        for th in threads:
+            th.join()
+        for i in ids:
+            interpreters.destroy(i)
+        assert not errors, errors
+
+        # Types and instances of the main interpreter are unaffected
+        assert t.Struct(7).value() == 7
+    ''')
+
+    result = subprocess.run([sys.executable, '-c', code],
+                            capture_output=True, text=True)
+    assert result.returncode == 0, result.stderr
+
+
+def test50_type_stats():
+    if not t.type_stats_enabled:
+        with pytest.raises(RuntimeError, match='NB_TYPE_STATS'):
+            t.type_stats()
+        return
+
+    class PyStruct(t.Struct):
+        pass
+
+    collect()
+    before = t.type_stats()[t.Struct]
+    objs = [t.Struct(1), t.Struct(2), PyStruct(3)]
+    ext = t.Struct.create_reference()  # wraps an existing C++ instance
+    stats = t.type_stats()[t.Struct]
+    assert stats['created'] == before['created'] + 4
+    assert stats['live'] == before['live'] + 4
+    assert stats['bytes'] > before['bytes']
+    assert PyStruct not in t.type_stats()
+
+    del objs, ext
+    collect()
+    after = t.type_stats()[t.Struct]
+    assert after['destroyed'] == before['destroyed'] + 4
+    assert after['live'] == before['live']
+    assert after['bytes'] == before['bytes']
+
+
+def test51_trampoline_type_cache():
+    lookups = 0
+
+    class Quiet(t.Animal):
+        def __getattribute__(self, name):
+            nonlocal lookups
+            if name == 'name':
+                lookups += 1
+            return super().__getattribute__(name)
+
+        def what(self):
+            return "..."
+
+    # The first instance resolves 'name', later ones reuse the outcome
+    for i in range(3):
+        assert t.go(Quiet()) == 'Animal says ...'
+        assert lookups == 1
+
+    # Changing the class invalidates the cached outcome
+    Quiet.name = lambda self: "Mouse"
+    assert t.go(Quiet()) == 'Mouse says ...'
+
+    del Quiet.name
+    assert t.go(Quiet()) == 'Animal says ...'
+
+
+def test52_trampoline_no_override():
+    # Instances of the bound type use the C++ implementation without
+    # looking up 'void_ret' (which isn't bound, and the lookup would fail)
+    a = t.Animal()
+    assert t.void_ret(a) is None
+    with pytest.raises(RuntimeError) as excinfo:
+        t.go(a)
+    assert ('.Animal::what()\'): tried to call a pure virtual function!' in str(excinfo.value))
+
+
+def test53_pickle_buffer():
+    import pickle
+
+    s = t.Samples(7, 1000)
+    buffers = []
+    data = pickle.dumps(s, protocol=5, buffer_callback=buffers.append)
+
+    # The samples are transferred out-of-band, without a copy in 'data'
+    assert len(buffers) == 1 and len(data) < 1000
+    view = buffers[0].raw()
+    assert view.readonly and view.nbytes == 4000
+
+    # The buffer references the instance
+    del s
+    collect()
+    s2 = pickle.loads(data, buffers=buffers)
+    assert s2.tag == 7 and s2.sum() == 499500
+
+    # In-band transfer and older protocols work as well
+    for protocol in range(pickle.HIGHEST_PROTOCOL + 1):
+        s3 = pickle.loads(pickle.dumps(s2, protocol=protocol))
+        assert s3.tag == 7 and s3.sum() == 499500
+
+    with pytest.raises(TypeError):
+        t.Samples.__new__(t.Samples).__setstate__((1, 2))
+
+
+def test54_vectorcall_init():
+    assert t.Sum5(1).value == 1
+    assert t.Sum5(1, 1, 1, 1, 1).value == 15
+    assert t.Sum5(1, e=2, d=1).value == 15
+    assert t.Sum5(a=1, b=1, c=1, d=1, e=1).value == 15
+    assert t.Sum5(*[0, 1], **{"c": 1}).value == 5
+    with pytest.raises(TypeError, match="incompatible function arguments"):
+        t.Sum5("x")
+
+    # The fast path honors Python subclasses and rebound constructors
+    class Sub(t.Sum5):
+        def __init__(self, x):
+            super().__init__(x, 1)
+            self.x = x
+
+    assert Sub(3).value == 5 and Sub(3).x == 3
+
+    init = t.Sum5.__init__
+    try:
+        t.Sum5.__init__ = lambda self, x: init(self, a=x * 10)
+        assert t.Sum5(2).value == 20
+    finally:
+        t.Sum5.__init__ = init
+    assert t.Sum5(2).value == 2
+
+
+def test55_native_slot_operators():
+    if hasattr(t, "test_slots"): # not available in stable ABI builds
+        assert t.native_slot_enabled() == (not is_pypy)
+    a, b = t.Vec2(1, 2), t.Vec2(3, 5)
+    c = a + b
+    assert (c.x, c.y) == (4, 7)
+    c = a * 2.0
+    assert (c.x, c.y) == (2, 4)
+    c = -a
+    assert (c.x, c.y) == (-1, -2)
+    assert a == t.Vec2(1, 2) and not (a == b)
+    assert a != b and not (a != t.Vec2(1, 2))
+    assert not t.Vec2(0, 0) and a
+    a_id = id(a)
+    a += b
+    assert (a.x, a.y) == (4, 7)
+    if t.native_slot_enabled(): # modified in place
+        assert id(a) == a_id
+
+    # Other operand types fall back to overload resolution
+    c = a * 2
+    assert (c.x, c.y) == (8, 14)
+    c = 1 + b
+    assert (c.x, c.y) == (4, 6)
+    assert (a == 1) is False
+    with pytest.raises(TypeError):
+        a + 1
+    with pytest.raises(TypeError):
+        a += 1
+    assert t.Vec2.__add__.__doc__ == "__add__(self, arg: test_classes_ext.Vec2, /) -> test_classes_ext.Vec2"
+
+
+def test56_native_members():
+    r = t.Record()
+    assert type(t.Record.__dict__["i32"]).__name__ == "nb_member"
+    assert isinstance(t.Record.__dict__["i32"], property)
+    assert t.Record.i32.__doc__ == "A signed integer"
+    assert (r.flag, r.i8, r.u16, r.i32, r.u64) == (False, -1, 2, -3, 4)
+    assert (r.f32, r.f64, r.id) == (0.5, 0.25, 7)
+    assert r.sum() == 12.75
+
+    r.flag, r.i8, r.u16, r.i32 = True, -128, 65535, -(2**31)
+    r.u64, r.f32, r.f64 = 2**64 - 1, 1.5, 3
+    assert (r.flag, r.i8, r.u16, r.i32) == (True, -128, 65535, -(2**31))
+    assert (r.u64, r.f32, r.f64) == (2**64 - 1, 1.5, 3.0)
+    assert type(r.f64) is float
+
+    # Invalid values are reported by the setter function
+    for name, value in [("flag", 1), ("i8", 128), ("u16", -1), ("f32", "x")]:
+        with pytest.raises(TypeError, match="incompatible function arguments"):
+            setattr(r, name, value)
+    assert (r.flag, r.i8, r.u16, r.f32) == (True, -128, 65535, 1.5)
+    with pytest.raises(AttributeError):
+        r.id = 3
+    with pytest.raises(AttributeError):
+        del r.i32
+
+    # Bound types are returned by reference and assigned by copy
+    p = r.pos
+    assert (p.x, p.y) == (1, 2)
+    p.x = 10
+    assert r.pos.x == 10
+    del r
+    assert p.x == 10
+    r = t.Record()
+    v = t.Vec2(3, 4)
+    r.pos = v
+    v.x = 0
+    assert (r.pos.x, r.pos.y) == (3, 4)
+    with pytest.raises(TypeError):
+        r.pos = 1
+
+    class Sub(t.Record):
+        pass
+
+    s = Sub()
+    s.i32 = 5
+    assert s.i32 == 5 and s.sum() == 20.75
+
+
+def test57_bound_method_reuse():
+    # Bound methods are recycled after release; they must not retain state
+    objs = [t.Struct(i) for i in range(40)]
+    methods = [o.value for o in objs]
+    assert [m() for m in methods] == list(range(40))
+    del methods
+    for i in range(3):
+        methods = [o.value for o in reversed(objs)]
+        assert [m.__self__ for m in methods] == objs[::-1]
+        assert [m() for m in methods] == list(range(39, -1, -1))
+        del methods
+    m = objs[3].set_value
+    m(10)
+    del m
+    assert objs[3].value() == 10
+
+
+@skip_on_pypy
+def test58_gc_tracking():
+    # Only types that may participate in reference cycles are GC-tracked
+    import gc
+    assert not gc.is_tracked(t.Struct(1))
+    assert not gc.is_tracked(t.Big())
+    assert gc.is_tracked(t.StructWithAttr(1))
+    assert gc.is_tracked(t.StructWithSlots(1))
+    assert gc.is_tracked(t.Wrapper())
+
+
+def test59_move_arg(clean):
+    s = t.Struct(3)
+    assert t.take_struct(s) == 3
+    assert s.value() == 3
+    assert_stats(value_constructed=1, copy_constructed=1, destructed=1)
+
+    # nb::move_arg<..> moves the argument and destructs the moved-from instance
+    assert t.take_struct_move(s) == 3
+    assert_stats(value_constructed=1, copy_constructed=1, move_constructed=1,
+                 destructed=3)
+    with pytest.warns(RuntimeWarning, match='uninitialized instance'):
+        with pytest.raises(TypeError):
+            s.value()
+    with pytest.warns(RuntimeWarning, match='uninitialized instance'):
+        with pytest.raises(TypeError):
+            t.take_struct_move(s)
+    del s
+    assert_stats(value_constructed=1, copy_constructed=1, move_constructed=1,
+                 destructed=3)
+
+    s = t.Struct(4)
+    assert t.take_struct_rvalue(10, s) == 14
+    with pytest.warns(RuntimeWarning, match='uninitialized instance'):
+        with pytest.raises(TypeError):
+            s.value()
+    del s
+    assert_stats(value_constructed=2, copy_constructed=1, move_constructed=2,
+                 destructed=5)
+
+
+def test60_static_const():
+    assert t.StaticConst.answer == 42
+    assert t.StaticConst.name == "const"
+    assert t.StaticConst().answer == 42
+
+    # The value is converted once and then shared by all accesses
+    s = t.StaticConst.struct_
+    assert s.value() == 7 and s is t.StaticConst.struct_
+    assert t.StaticConst.name is t.StaticConst.name
+
+    with pytest.raises(AttributeError):
+        t.StaticConst.answer = 43
+    assert t.StaticConst.answer == 42
+    assert t.StaticConst.__dict__["answer"].fget(t.StaticConst) == 42
+    if not is_pypy:
+        assert t.StaticConst.__dict__["answer"].__doc__ == "Static constant docstring"
+
+
+def test61_weak_py_address_reuse():
+    a = t.weak_py_spawn(1)
+    assert t.weak_py_get() is a and a.id == 1
+    t.weak_py_despawn()
+
+    with pytest.warns(RuntimeWarning, match='destroyed instance'):
+        with pytest.raises(TypeError):
+            a.get_id()
+    with pytest.warns(RuntimeWarning, match='destroyed instance'):
+        with pytest.raises(TypeError):
+            a.id
+
+    # A new object at the same address receives a new instance
+    b = t.weak_py_spawn(2)
+    assert b is not a and b.id == 2 and t.weak_py_get() is b
+    del a
+    collect()
+    assert t.weak_py_get() is b and b.get_id() == 2
+    t.weak_py_despawn()
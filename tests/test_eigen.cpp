@@ -1,5 +1,6 @@
 #include <nanobind/eigen/dense.h>
 #include <nanobind/eigen/sparse.h>
+#include <nanobind/eigen/tensor.h>
 #include <nanobind/trampoline.h>
 
 namespace nb = nanobind;
@@ -159,6 +160,11 @@ NB_MODULE(test_eigen_ext, m) {
     });
     m.def("sparse_copy_r", [](const SparseMatrixR &m) -> SparseMatrixR { return m; });
     m.def("sparse_copy_c", [](const SparseMatrixC &m) -> SparseMatrixC { return m; });
+    m.def("sparse_map_scale_c", [](Eigen::Map<SparseMatrixC> m, float s) {
+        for (Eigen::Index i = 0; i < m.nonZeros(); ++i)
+            m.valuePtr()[i] *= s;
+    });
+    m.def("sparse_map_sum_r", [](Eigen::Map<SparseMatrixR> m) { return m.sum(); });
     m.def("sparse_r_uncompressed", []() -> SparseMatrixR {
         SparseMatrixR m(2,2);
         m.coeffRef(0,0) = 1.0f;
@@ -166,6 +172,43 @@ NB_MODULE(test_eigen_ext, m) {
         return m.markAsRValue();
     });
 
+    // Zero-copy returns: record the address of the returned storage
+    static const void *ret_data = nullptr;
+    m.def("ret_data", []() { return (uintptr_t) ret_data; });
+    m.def("ret_large", [](int n) {
+        Eigen::MatrixXd x = Eigen::MatrixXd::Constant(n, n, 1.0);
+        ret_data = x.data();
+        return x;
+    });
+    m.def("ret_large_copy", [](int n) {
+        Eigen::MatrixXd x = Eigen::MatrixXd::Constant(n, n, 1.0);
+        ret_data = x.data();
+        return x;
+    }, nb::rv_policy::copy);
+    m.def("ret_fixed", []() -> Eigen::Matrix4d { return Eigen::Matrix4d::Identity(); });
+    m.def("ret_xpr", [](int n) { return Eigen::MatrixXd::Constant(n, n, 1.0) * 2.0; });
+
+    using Tensor3d = Eigen::Tensor<double, 3>;
+    using Tensor3fR = Eigen::Tensor<float, 3, Eigen::RowMajor>;
+    m.def("tensor_sum", [](const Tensor3d &x) -> double {
+        Eigen::Tensor<double, 0> s = x.sum();
+        return s();
+    });
+    m.def("tensor_arange", [](int d0, int d1, int d2) {
+        Tensor3fR x(d0, d1, d2);
+        for (int i = 0; i < d0; ++i)
+            for (int j = 0; j < d1; ++j)
+                for (int k = 0; k < d2; ++k)
+                    x(i, j, k) = (float) (100 * i + 10 * j + k);
+        return x;
+    });
+    m.def("tensor_map_scale", [](Eigen::TensorMap<Eigen::Tensor<float, 2, Eigen::RowMajor>> x, float s) {
+        x = x * s;
+    });
+    m.def("tensor_map_get", [](Eigen::TensorMap<const Eigen::Tensor<float, 2>> x, int i, int j) {
+        return x(i, j);
+    });
+
     /// issue #166
     using Matrix1d = Eigen::Matrix<double,1,1>;
     try {
@@ -250,4 +293,21 @@ NB_MODULE(test_eigen_ext, m) {
         base->modRefDataConst(input);
         return input;
     });
+
+    m.def("copy_to_matrix", [](nb::ndarray<nb::ro, nb::device::cpu> a,
+                               size_t threads) {
+        Eigen::MatrixXd result;
+        nb::ndarray_copy(a, result, threads);
+        return result;
+    });
+    m.def("copy_to_row_major", [](nb::ndarray<nb::ro, nb::device::cpu> a) {
+        Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> result;
+        nb::ndarray_copy(a, result);
+        return result;
+    });
+    m.def("copy_to_v3i", [](nb::ndarray<nb::ro, nb::device::cpu> a) {
+        Eigen::Vector3i result;
+        nb::ndarray_copy(a, result);
+        return result;
+    });
 }
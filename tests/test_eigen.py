@@ -277,27 +277,14 @@ def test09_sparse_failures():
     ):
         t.sparse_r_uncompressed()
 
+    # The matrix types are resolved once, later changes to the module have no effect
+    t.sparse_r()
     csr_matrix = scipy.sparse.csr_matrix
     scipy.sparse.csr_matrix = None
-    with pytest.raises(TypeError, match=re.escape("'NoneType' object is not callable")):
-        t.sparse_r()
-
-    del scipy.sparse.csr_matrix
-    with pytest.raises(
-        AttributeError,
-        match=re.escape("module 'scipy.sparse' has no attribute 'csr_matrix'"),
-    ):
-        t.sparse_r()
-
-    sys_path = sys.path
-    sys.path = []
-    del sys.modules["scipy"]
-    with pytest.raises(ModuleNotFoundError, match=re.escape("No module named 'scipy'")):
-        t.sparse_r()
-
-    # undo sabotage of the module
-    sys.path = sys_path
-    scipy.sparse.csr_matrix = csr_matrix
+    try:
+        assert type(t.sparse_r()) is csr_matrix
+    finally:
+        scipy.sparse.csr_matrix = csr_matrix
 
 @needs_numpy_and_eigen
 def test10_eigen_scalar_default():
@@ -366,4 +353,104 @@ def test13_mutate_python():
     der = Derived()
     assert_array_equal(t.modifyRef(der), vecRef)
     with pytest.raises(ValueError):
-        t.modifyRefConst(der)
\ No newline at end of file
+        t.modifyRefConst(der)
+
+
+@needs_numpy_and_eigen
+def test14_sparse_map():
+    pytest.importorskip("scipy")
+    import scipy.sparse
+
+    c = t.sparse_c()
+    data = c.data.copy()
+    t.sparse_map_scale_c(c, 2)
+    assert_array_equal(c.data, 2 * data)
+    assert t.sparse_map_sum_r(t.sparse_r()) == data.sum()
+
+    # Maps don't perform implicit conversions, which would copy the data
+    with pytest.raises(TypeError):
+        t.sparse_map_scale_c(t.sparse_r(), 2)
+    with pytest.raises(TypeError):
+        t.sparse_map_sum_r(scipy.sparse.csr_matrix(c.toarray().astype(np.float64)))
+
+
+@needs_numpy_and_eigen
+def test15_tensor():
+    a = np.arange(24, dtype=np.float64).reshape(2, 3, 4)
+    assert t.tensor_sum(a) == a.sum()
+    assert t.tensor_sum(np.asfortranarray(a)) == a.sum()
+    assert t.tensor_sum(a.astype(np.int32)) == a.sum()
+
+    for shape in ((2, 3, 4), (10, 10, 10)):
+        b = t.tensor_arange(*shape)
+        assert b.dtype == np.float32 and b.shape == shape
+        i, j, k = np.indices(shape)
+        assert_array_equal(b, 100 * i + 10 * j + k)
+
+    # TensorMap refers to the original data with a matching memory order
+    c = np.arange(6, dtype=np.float32).reshape(2, 3)
+    t.tensor_map_scale(c, 2)
+    assert_array_equal(c, 2 * np.arange(6).reshape(2, 3))
+    with pytest.raises(TypeError):
+        t.tensor_map_scale(np.asfortranarray(c), 2)
+    with pytest.raises(TypeError):
+        t.tensor_map_scale(c.astype(np.float64), 2)
+
+    f = np.asfortranarray(c)
+    assert t.tensor_map_get(f, 1, 2) == c[1, 2]
+    with pytest.raises(TypeError):
+        t.tensor_map_get(c, 1, 2)
+
+
+@needs_numpy_and_eigen
+def test16_return_no_copy():
+    # Returned matrices reference the moved storage, regardless of the policy
+    for f in (t.ret_large, t.ret_large_copy):
+        a = f(1000)
+        assert a.ctypes.data == t.ret_data()
+        assert a.base is not None and not a.flags.owndata
+        assert a.shape == (1000, 1000) and a[999, 999] == 1
+        del a
+
+    a = t.ret_fixed()
+    assert a.base is not None
+    assert_array_equal(a, np.eye(4))
+
+    a = t.ret_xpr(500)
+    assert a.base is not None
+    assert a.shape == (500, 500) and np.all(a == 2)
+
+    # Peak memory: NumPy reports its allocations to tracemalloc, while
+    # Eigen's are invisible to it. Returning a 64 MiB matrix without a copy
+    # must therefore not increase the traced peak by the matrix size.
+    import tracemalloc
+    tracemalloc.start()
+    try:
+        for _ in range(5):
+            a = t.ret_large(2896)
+            del a
+        _, peak = tracemalloc.get_traced_memory()
+    finally:
+        tracemalloc.stop()
+    assert peak < 2896 * 2896 * 8 // 4
+
+
+@needs_numpy_and_eigen
+def test17_ndarray_copy():
+    a = np.arange(12, dtype=np.int32).reshape(3, 4)
+    for threads in (1, 4):
+        assert_array_equal(t.copy_to_matrix(a, threads), a)
+        assert_array_equal(t.copy_to_matrix(a.T, threads), a.T)
+        assert_array_equal(t.copy_to_matrix(a[:, ::2], threads), a[:, ::2])
+
+    b = np.random.rand(700, 300)
+    assert_array_equal(t.copy_to_matrix(b, 0), b)
+    assert_array_equal(t.copy_to_matrix(b.T, 0), b.T)
+    assert_array_equal(t.copy_to_row_major(b.T), np.float32(b.T))
+    assert_array_equal(t.copy_to_matrix(np.arange(5.0), 0), np.arange(5.0)[:, None])
+
+    assert_array_equal(t.copy_to_v3i(np.array([1.5, 2, 3])), [1, 2, 3])
+    with pytest.raises(RuntimeError, match='incompatible array shape'):
+        t.copy_to_v3i(np.array([1, 2]))
+    with pytest.raises(RuntimeError, match='1D or 2D'):
+        t.copy_to_matrix(np.zeros((2, 2, 2)), 0)
@@ -5,6 +5,7 @@ namespace nb = nanobind;
 enum class Enum  : uint32_t { A, B, C = (uint32_t) -1 };
 enum class SEnum : int32_t { A, B, C = (int32_t) -1 };
 enum ClassicEnum { Item1, Item2 };
+enum class Flags : uint8_t { Read = 1, Write = 2, Exec = 4, All = 7 };
 
 struct EnumProperty { Enum get_enum() { return Enum::A; } };
 
@@ -71,6 +72,15 @@ NB_MODULE(test_enum_ext, m) {
     m.def("to_enum", [](uint32_t value) { return (Enum) value; });
     m.def("from_enum", [](SEnum value) { return (int32_t) value; });
 
+    nb::enum_<Flags>(m, "Flags", nb::is_flag())
+        .value("Read", Flags::Read)
+        .value("Write", Flags::Write)
+        .value("Exec", Flags::Exec)
+        .value("All", Flags::All);
+
+    m.def("from_flags", [](Flags value) { return (uint8_t) value; });
+    m.def("to_flags", [](uint8_t value) { return (Flags) value; });
+
     // test for issue #39
     nb::class_<EnumProperty>(m, "EnumProperty")
         .def(nb::init<>())
@@ -147,3 +147,44 @@ def test08_enum_comparisons():
     assert t.SEnum.B > t.Enum.A
     assert t.Enum.A <= t.SEnum.A and t.Enum.A >= t.SEnum.A
     assert t.Enum.A != t.SEnum.A
+
+
+def test09_enum_identity():
+    # Enumerators returned from C++ are the unique instances of their value
+    assert t.to_enum(0) is t.Enum.A
+    assert t.to_enum(0xffffffff) is t.Enum.C
+    assert t.EnumProperty().read_enum is t.Enum.A
+    assert t.to_enum(5) is not t.to_enum(5)
+    assert t.to_enum(5) == 5
+
+
+def test10_enum_flags():
+    f = t.Flags
+    rw = f.Read | f.Write
+    assert type(rw) is f and int(rw) == 3
+    assert repr(rw) == 'test_enum_ext.Flags.Read|Write'
+    assert rw.__name__ == 'Read|Write'
+    assert t.from_flags(rw) == 3
+    assert t.to_flags(6).__name__ == 'Write|Exec'
+    assert repr(t.to_flags(15)) == 'test_enum_ext.Flags.Read|Write|Exec|0x8'
+    assert rw | f.Exec is f.All
+    assert f.All & f.Write is f.Write
+    assert f.All ^ f.Exec == rw
+    assert f.Read | 2 == rw and 2 | f.Read == rw
+    assert type(f.Read | 2) is f
+    assert f.Read | 256 == 257 and type(f.Read | 256) is int
+    assert f(5) == f.Read | f.Exec and f(7) is f.All
+    assert int(~f.Read) == 0xfe
+    assert bool(f.Read) and not (f.Read & f.Write)
+    assert f.Read in {rw & f.Read}
+    assert (f.Read | f.Write) is not (f.Read | f.Write)
+
+    with pytest.raises(RuntimeError, match='could not convert'):
+        f(256)
+    with pytest.raises(RuntimeError, match='could not find entry'):
+        f(0).__name__
+    with pytest.raises(TypeError, match="unsupported operand type"):
+        f.Read + 1
+    # Non-flag enumerations don't support bitwise operations
+    with pytest.raises(TypeError, match="unsupported operand type"):
+        t.Enum.A | t.Enum.B
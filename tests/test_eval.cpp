@@ -79,6 +79,44 @@ NB_MODULE(test_eval_ext, m) {
         return nb::globals().contains("a");
     });
 
+    // test_compiled_expr
+    m.def("compiled_expr_sum", [](int n) {
+        nb::compiled_expr expr("x * 2 + y");
+        nb::dict global;
+        global["y"] = 1;
+        int sum = 0;
+        for (int i = 0; i < n; ++i) {
+            nb::dict local;
+            local["x"] = i;
+            sum += nb::cast<int>(expr(global, local));
+        }
+        return sum;
+    });
+
+    m.def("compiled_expr_statements", []() {
+        nb::compiled_expr code(R"(
+            if x > 0:
+                result = 'positive'
+            else:
+                result = 'other'
+            )", nb::eval_statements);
+        nb::dict a, b;
+        a["x"] = 1;
+        b["x"] = -1;
+        nb::object ret = code(a);
+        code(b);
+        return nb::make_tuple(ret, a["result"], b["result"]);
+    });
+
+    m.def("compiled_expr_failure", []() {
+        try {
+            nb::compiled_expr expr("nonsense code ...");
+        } catch (nb::python_error &e) {
+            return e.matches(PyExc_SyntaxError);
+        }
+        return false;
+    });
+
     m.def("globals_add_b", []() {
         auto globals = nb::globals();
         globals["b"] = 123;
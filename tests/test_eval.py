@@ -42,3 +42,9 @@ def test_write_globals():
     assert "b" not in globals()
     m.globals_add_b()
     assert globals()["b"] == 123
+
+
+def test_compiled_expr():
+    assert m.compiled_expr_sum(100) == 100 * 99 + 100
+    assert m.compiled_expr_statements() == (None, 'positive', 'other')
+    assert m.compiled_expr_failure()
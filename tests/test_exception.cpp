@@ -17,6 +17,21 @@ public:
     virtual const char *what() const noexcept { return "MyError3"; }
 };
 
+class MyError4 : public std::exception {
+public:
+    virtual const char *what() const noexcept { return "MyError4"; }
+};
+
+class MyError4Sub : public MyError4 {
+public:
+    virtual const char *what() const noexcept { return "MyError4Sub"; }
+};
+
+class MyError5 : public std::exception {
+public:
+    virtual const char *what() const noexcept { return "MyError5"; }
+};
+
 NB_MODULE(test_exception_ext, m) {
     m.def("raise_generic", [] { throw std::exception(); });
     m.def("raise_bad_alloc", [] { throw std::bad_alloc(); });
@@ -50,6 +65,23 @@ NB_MODULE(test_exception_ext, m) {
     nb::exception<MyError3>(m, "MyError3");
     m.def("raise_my_error_3", [] { throw MyError3(); });
 
+    // Translators dispatched by the exact exception type
+    nb::register_exception_translator<MyError4>(
+        [](const std::exception_ptr &p, void *) {
+            try {
+                std::rethrow_exception(p);
+            } catch (const MyError4 &e) {
+                PyErr_SetString(PyExc_KeyError, e.what());
+            }
+        });
+    m.def("raise_my_error_4", [] { throw MyError4(); });
+    m.def("raise_my_error_4_sub", [] { throw MyError4Sub(); });
+
+    // A typed translator that declines falls back to the other translators
+    nb::register_exception_translator<MyError5>(
+        [](const std::exception_ptr &p, void *) { std::rethrow_exception(p); });
+    m.def("raise_my_error_5", [] { throw MyError5(); });
+
     m.def("raise_nested", [](nb::callable c) {
             int arg = 123;
             try {
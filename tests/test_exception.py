@@ -102,3 +102,23 @@ def test20_nested():
     assert str(excinfo.value) == 'Call with value 123 failed'
     assert str(excinfo.value.__cause__) == 'division by zero'
 
+
+def test21_typed_translators():
+    with pytest.raises(KeyError) as excinfo:
+        t.raise_my_error_4()
+    assert excinfo.value.args[0] == 'MyError4'
+
+    # Subclasses reach the translator through the regular sequence
+    with pytest.raises(KeyError) as excinfo:
+        t.raise_my_error_4_sub()
+    assert excinfo.value.args[0] == 'MyError4Sub'
+
+    with pytest.raises(RuntimeError) as excinfo:
+        t.raise_my_error_5()
+    assert str(excinfo.value) == 'MyError5'
+
+    # Earlier translators still apply
+    with pytest.raises(IndexError):
+        t.raise_my_error_2()
+    with pytest.raises(t.MyError3):
+        t.raise_my_error_3()
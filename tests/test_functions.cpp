@@ -23,6 +23,8 @@ NB_MODULE(test_functions_ext, m) {
     // Simple binary function (via function pointer)
     auto test_02 = [](int j, int k) -> int { return j - k; };
     m.def("test_02", (int (*)(int, int)) test_02, "j"_a = 8, "k"_a = 1);
+    m.def("test_02_kw", [](int alpha, int beta, int gamma) { return alpha * 100 + beta * 10 + gamma; },
+          "alpha"_a, "beta"_a = 2, "gamma"_a = 3);
 
     // Simple binary function with capture object
     int i = 42;
@@ -97,6 +99,18 @@ NB_MODULE(test_functions_ext, m) {
 #endif
     }, nb::call_guard<nb::gil_scoped_release>());
 
+    m.def("test_gil_release", [](const char *s, int i) -> const char * {
+#if !defined(Py_LIMITED_API)
+        if (PyGILState_Check())
+            return "held";
+#endif
+        return s + i;
+    }, nb::gil_release());
+
+    m.def("test_gil_release_handle", [](nb::handle h) {
+        (void) h;
+    }, nb::gil_release());
+
     m.def("test_print", []{
         nb::print("Test 1");
         nb::print(nb::str("Test 2"));
@@ -147,6 +161,10 @@ NB_MODULE(test_functions_ext, m) {
     m.def("test_11_ul",  [](unsigned long x)        { return x; });
     m.def("test_11_sll", [](signed long long x) { return x; });
     m.def("test_11_ull", [](unsigned long long x)   { return x; });
+    m.def("test_11_u8_noconvert", [](uint8_t x) { return x; },
+          "x"_a.noconvert());
+    m.def("test_11_f64_noconvert", [](double x) { return x; },
+          "x"_a.noconvert());
 
     // Test string caster
     m.def("test_12", [](const char *c) { return nb::str(c); });
@@ -224,6 +242,9 @@ NB_MODULE(test_functions_ext, m) {
         return nb::cast<char>(h);
     });
 
+    m.def("test_char_overload", [](char) { return "char"; });
+    m.def("test_char_overload", [](const char *) { return "str"; });
+
     m.def("test_cast_str", [](nb::handle h) {
         return nb::cast<const char *>(h);
     });
@@ -237,6 +258,65 @@ NB_MODULE(test_functions_ext, m) {
 
     m.def("test_set_contains", [](nb::set s, nb::handle h) { return s.contains(h); });
 
+    m.def("set_profiling", &nb::set_profiling);
+    m.def("profiling_reset", &nb::profiling_reset);
+    m.def("profiling_snapshot", &nb::profiling_snapshot);
+    m.def("registration_stats", &nb::registration_stats);
+
     m.def("test_del_list", [](nb::list l) { nb::del(l[2]); });
     m.def("test_del_dict", [](nb::dict l) { nb::del(l["a"]); });
+
+    m.def("test_bytes_view", [](nb::bytes_view v) {
+        return nb::make_tuple(v.size(), (uintptr_t) v.data(), v);
+    });
+
+    m.def("test_intern", [](nb::object o, nb::dict d) {
+        nb::object value = o.attr(NB_INTERN("value"));
+        o.attr(NB_INTERN("value")) = nb::cast<int>(value) + 1;
+        d[NB_INTERN("key")] = value;
+        return NB_INTERN("key");
+    });
+
+    /// Keyword calls through a cached 'kwnames' tuple
+    m.def("test_call_kw", [](nb::object o) {
+        return o(1, "x"_a = 2, "y"_a = 3);
+    });
+
+    m.def("test_call_kw_name", [](nb::object o, std::string name) {
+        return o(nb::arg(name.c_str()) = 1);
+    });
+
+    m.def("test_call_kw_method", [](nb::object o) {
+        return o.attr("method")(1, "x"_a = 2);
+    });
+
+    /// Lookups with a default value
+    m.def("test_getitem_default", [](nb::handle o, nb::handle key) {
+        return nb::getitem(o, key, nb::str("missing"));
+    });
+
+    m.def("test_getitem_default_str", [](nb::handle o) {
+        return nb::getitem(o, "key", nb::none());
+    });
+
+    /// Functions of this submodule are created upon first access
+    nb::module_ lazy = m.def_submodule("lazy").lazy();
+    lazy.def("add", [](int a, int b) { return a + b; }, "a"_a, "b"_a = 1,
+             "Add two integers");
+    lazy.def("add", [](const std::string &a, const std::string &b) {
+        return a + b;
+    });
+    lazy.def("unused", [s = std::string(100, 'x')]() { return s; });
+    lazy.lazy(false);
+    lazy.def("eager", []() { return 1; });
+    lazy.def("add", [](double a, double b) { return a * b; });
+
+    // test47_many_args
+    auto sum12 = [](int a0, int a1, int a2, int a3, int a4, int a5, int a6,
+                    int a7, int a8, int a9, int a10, double a11) {
+        return a0 + a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8 + a9 + a10 + a11;
+    };
+    m.def("sum12", sum12);
+    m.def("sum12_named", sum12, "a0"_a, "a1"_a, "a2"_a, "a3"_a, "a4"_a,
+          "a5"_a, "a6"_a, "a7"_a, "a8"_a, "a9"_a, "a10"_a, "a11"_a.noconvert());
 }
@@ -28,6 +28,15 @@ def test03_kwargs():
     assert t.test_02(3, k=5) == -2
     assert t.test_02(k=5, j=3) == -2
 
+    # Keyword names given in arbitrary order, and non-interned ones
+    assert t.test_02_kw(alpha=1, beta=4, gamma=7) == 147
+    assert t.test_02_kw(gamma=7, alpha=1) == 127
+    assert t.test_02_kw(1, gamma=5, beta=6) == 165
+    kwargs = { ''.join(['gam', 'ma']) : 9, ''.join(['al', 'pha']) : 4 }
+    assert t.test_02_kw(**kwargs) == 429
+    with pytest.raises(TypeError):
+        t.test_02_kw(1, **{ ''.join(['del', 'ta']) : 1 })
+
 
 def test04_overloads():
     assert t.test_05(0) == 1
@@ -139,6 +148,10 @@ def test13_call_guard():
     assert t.call_guard_value() == 2
     assert t.test_call_guard_wrapper_rvalue_ref(1) == 1
     assert not t.test_release_gil()
+    assert t.test_gil_release("hello", 1) == "ello"
+    with pytest.raises(TypeError):
+        t.test_gil_release("hello", "world")
+    assert t.test_gil_release_handle(1) is None
 
 
 def test14_print(capsys):
@@ -203,6 +216,21 @@ def test21_numpy_overloads():
     assert t.test_11_sll(np.int32(5)) == 5
     assert t.test_11_ull(np.int32(5)) == 5
 
+    # NumPy scalars of a matching kind are accepted without conversion
+    assert t.test_05(np.float32(0.5)) == 2
+    assert t.test_05(np.int64(3)) == 1
+    assert t.test_05(np.uint16(3)) == 1
+    assert t.test_11_u8_noconvert(np.int64(200)) == 200
+    assert t.test_11_f64_noconvert(np.float32(0.5)) == 0.5
+    assert t.test_11_f64_noconvert(np.float64(0.25)) == 0.25
+    for v in [np.int64(256), np.int8(-1), np.float32(1.0), np.bool_(True)]:
+        with pytest.raises(TypeError):
+            t.test_11_u8_noconvert(v)
+    with pytest.raises(TypeError):
+        t.test_11_f64_noconvert(np.int32(1))
+    with pytest.raises(TypeError):
+        t.test_11_f64_noconvert(np.array(1.0))
+
 
 def test22_string_return():
     assert t.test_12("hello") == "hello"
@@ -317,6 +345,9 @@ def test36_test_char():
     with pytest.raises(RuntimeError):
         assert t.test_cast_char(123)
 
+    assert t.test_char_overload('c') == 'char'
+    assert t.test_char_overload('abc') == 'str'
+
 def test37_test_str():
     assert t.test_cast_str('c') == 'c'
     assert t.test_cast_str('abc') == 'abc'
@@ -348,3 +379,133 @@ def test39_del():
 
     with pytest.raises(KeyError):
         t.test_del_dict({})
+
+
+def test40_profiling():
+    t.set_profiling(True)
+    try:
+        t.profiling_reset()
+        for i in range(3):
+            assert t.test_05(0) == 1
+        assert t.test_05(0.0) == 2
+        assert t.test_02(k=5, j=3) == -2
+        snapshot = t.profiling_snapshot()
+    finally:
+        t.set_profiling(False)
+
+    p = snapshot[t.test_05]
+    assert p['calls'] == 4
+    assert p['overload_failures'] == 1
+    assert p['convert_hits'] == 0
+    assert p['time_total'] >= p['time_impl'] >= 0
+    assert snapshot[t.test_02]['calls'] == 1
+    assert t.profiling_snapshot() == {}
+
+
+def test41_bytes_view():
+    import ctypes
+
+    assert t.test_bytes_view(b"") == (0, t.test_bytes_view(b"")[1], b"")
+    assert t.test_bytes_view(b"abc")[::2] == (3, b"abc")
+
+    # The view refers to the memory of mutable buffers without copying
+    ba = bytearray(b"hello")
+    addr = ctypes.addressof((ctypes.c_char * 5).from_buffer(ba))
+    assert t.test_bytes_view(ba) == (5, addr, b"hello")
+    assert t.test_bytes_view(memoryview(ba)[1:]) == (4, addr + 1, b"ello")
+
+    with pytest.raises(TypeError):
+        t.test_bytes_view("hello")
+    with pytest.raises(TypeError):
+        t.test_bytes_view(memoryview(ba)[::2])
+    assert t.test_bytes_view.__doc__ == (
+        "test_bytes_view(arg: collections.abc.Buffer, /) -> tuple"
+    )
+
+
+def test42_intern():
+    class A:
+        value = 5
+
+    a = A()
+    d = {}
+    key = t.test_intern(a, d)
+    assert key == "key" and key is t.test_intern(a, d)
+    assert a.value == 7
+    assert d == { "key": 6 }
+
+
+def test43_call_kw():
+    def f(*args, **kwargs):
+        return args, kwargs
+
+    for _ in range(3):
+        assert t.test_call_kw(f) == ((1,), {"x": 2, "y": 3})
+
+    # Same call site, different (runtime) names
+    for name in ["a", "b", "a", "long_name"]:
+        assert t.test_call_kw_name(f, name) == ((), {name: 1})
+
+    class C:
+        def method(self, *args, **kwargs):
+            return args, kwargs
+
+    assert t.test_call_kw_method(C()) == ((1,), {"x": 2})
+
+
+def test44_getitem_default():
+    d = {"a": 1, 2: "b"}
+    assert t.test_getitem_default(d, "a") == 1
+    assert t.test_getitem_default(d, 2) == "b"
+    assert t.test_getitem_default(d, "c") == "missing"
+    assert t.test_getitem_default([1, 2], 1) == 2
+    assert t.test_getitem_default([1, 2], 5) == "missing"
+    assert t.test_getitem_default_str({"key": 3}) == 3
+    assert t.test_getitem_default_str({}) is None
+
+    class M:
+        def __getitem__(self, key):
+            if key == "value":
+                raise ValueError("invalid key")
+            raise KeyError(key)
+
+    assert t.test_getitem_default(M(), "x") == "missing"
+    with pytest.raises(ValueError, match="invalid key"):
+        t.test_getitem_default(M(), "value")
+    with pytest.raises(TypeError):
+        t.test_getitem_default({}, [])
+
+
+def test45_lazy_module():
+    m = t.lazy
+    assert "eager" in m.__dict__
+    assert "unused" not in m.__dict__
+    assert "add" in m.__dict__ # materialized by the eager overload below
+    assert "unused" in dir(m) and "eager" in dir(m)
+    assert m.add(1, 2) == 3 and m.add(2) == 3
+    assert m.add("a", "b") == "ab"
+    assert m.add(1.5, 2.0) == 3.0
+    assert m.add.__doc__.startswith("add(a: int, b: int = 1) -> int")
+    assert getattr(m, "add") is m.add
+    with pytest.raises(AttributeError, match="module 'test_functions_ext.lazy' has no attribute 'missing'"):
+        m.missing
+    assert not hasattr(m, "missing2")
+
+def test46_registration_stats():
+    stats = t.registration_stats()
+    s = stats["test_functions_ext.lazy"]
+    assert s["functions"] == 5 and s["types"] == 0 and s["enum_values"] == 0
+    assert s["bytes"] > 0 and s["time"] > 0
+    s = stats["test_functions_ext"]
+    assert s["functions"] > 50 and s["bytes"] > s["functions"] * 64
+
+
+def test47_many_args():
+    assert t.sum12(*range(11), 0.5) == 55.5
+    assert t.sum12(*range(12)) == 66
+    assert t.sum12_named(*range(11), 0.5) == 55.5
+    assert t.sum12_named(*range(11), a11=1.5) == 56.5
+    with pytest.raises(TypeError):
+        t.sum12_named(*range(12))
+    with pytest.raises(TypeError):
+        t.sum12(*range(11))
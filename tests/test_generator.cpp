@@ -0,0 +1,50 @@
+#include <nanobind/nanobind.h>
+
+#if defined(__cpp_impl_coroutine)
+#include <nanobind/generator.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+#include <stdexcept>
+#include <vector>
+#endif
+
+namespace nb = nanobind;
+
+NB_MODULE(test_generator_ext, m) {
+#if defined(__cpp_impl_coroutine)
+    struct Record {
+        int id;
+    };
+
+    nb::class_<Record>(m, "Record")
+        .def_ro("id", &Record::id);
+
+    m.def("count", [](int n) -> nb::generator<int> {
+        for (int i = 0; i < n; ++i)
+            co_yield i;
+    });
+
+    m.def("records", [](int n) -> nb::generator<Record> {
+        for (int i = 0; i < n; ++i) {
+            Record r{ i };
+            co_yield r;
+        }
+    });
+
+    m.def("words", [](std::vector<std::string> v) -> nb::generator<const std::string &> {
+        for (const std::string &s : v)
+            co_yield s;
+    });
+
+    m.def("fail_after", [](int n) -> nb::generator<int> {
+        for (int i = 0; i < n; ++i)
+            co_yield i;
+        throw std::runtime_error("generator failed");
+    });
+
+    m.def("call_back", [](nb::callable f, int n) -> nb::generator<nb::object> {
+        for (int i = 0; i < n; ++i)
+            co_yield f(i);
+    });
+#endif
+}
@@ -0,0 +1,46 @@
+import pytest
+
+try:
+    import test_generator_ext as t
+    needs_generator = pytest.mark.skipif(not hasattr(t, "count"),
+                                         reason="C++20 coroutines are required")
+except ImportError:
+    needs_generator = pytest.mark.skip(reason="C++20 coroutines are required")
+
+
+@needs_generator
+def test01_generator():
+    g = t.count(5)
+    assert iter(g) is g
+    assert list(g) == [0, 1, 2, 3, 4]
+    assert list(g) == []
+    assert sum(t.count(1000)) == 499500
+    assert list(t.count(0)) == []
+    assert t.count.__doc__ == (
+        "count(arg: int, /) -> collections.abc.Iterator[int]"
+    )
+
+
+@needs_generator
+def test02_generator_values():
+    assert [r.id for r in t.records(3)] == [0, 1, 2]
+    assert list(t.words(["a", "bc"])) == ["a", "bc"]
+    assert list(t.call_back(lambda i: i * 2, 3)) == [0, 2, 4]
+
+    # Lazy evaluation
+    calls = []
+    g = t.call_back(calls.append, 10)
+    next(g)
+    assert calls == [0]
+    del g
+
+
+@needs_generator
+def test03_generator_exception():
+    g = t.fail_after(2)
+    assert next(g) == 0
+    assert next(g) == 1
+    with pytest.raises(RuntimeError, match="generator failed"):
+        next(g)
+    with pytest.raises(StopIteration):
+        next(g)
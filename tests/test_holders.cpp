@@ -89,6 +89,12 @@ NB_MODULE(test_holders_ext, m) {
           [](std::shared_ptr<Example> shared) { return shared; });
     m.def("passthrough_2",
           [](std::shared_ptr<const Example> shared) { return shared; });
+    m.def("shared_use_count",
+          [](std::shared_ptr<Example> shared) { return shared.use_count(); });
+    m.def("shared_same_owner",
+          [](std::shared_ptr<Example> a, std::shared_ptr<const Example> b) {
+              return !a.owner_before(b) && !b.owner_before(a);
+          });
 
     // ------- enable_shared_from_this -------
 
@@ -189,6 +195,8 @@ NB_MODULE(test_holders_ext, m) {
     m.def("u_polymorphic_factory", []() { return std::unique_ptr<PolymorphicBase>(new PolymorphicSubclass()); });
     m.def("u_polymorphic_factory_2", []() { return std::unique_ptr<PolymorphicBase>(new AnotherPolymorphicSubclass()); });
     m.def("u_factory", []() { return std::unique_ptr<Base>(new Subclass()); });
+    m.def("passthrough_unique_poly",
+          [](std::unique_ptr<PolymorphicBase> p) { return p; });
     m.def("u_factory_2", []() { return std::unique_ptr<Base>(new AnotherSubclass()); });
 
     m.def("s_polymorphic_factory", []() { return std::shared_ptr<PolymorphicBase>(new PolymorphicSubclass()); });
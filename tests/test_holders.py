@@ -44,6 +44,30 @@ def test02_sharedptr_from_python(clean):
     assert t.stats() == (3, 3)
 
 
+def test02_sharedptr_from_python_reuse(clean):
+    # Conversions reuse the shared_ptr control block while C++ holds one
+    e = t.Example(234)
+    assert t.shared_use_count(e) == 1
+    assert t.shared_same_owner(e, e)
+    w = t.SharedWrapper(e)
+    assert t.shared_use_count(e) == 2
+    assert t.shared_same_owner(w.ptr, e)
+    del w
+    collect()
+    assert t.shared_use_count(e) == 1
+    del e
+    collect()
+    assert t.stats() == (1, 1)
+
+    e = t.Example.make_shared(5)
+    assert t.shared_same_owner(e, e)
+    w = t.SharedWrapper(e)
+    assert t.shared_use_count(e) == 2
+    del w, e
+    collect()
+    assert t.stats() == (2, 2)
+
+
 def test03_sharedptr_from_cpp(clean):
     e = t.Example.make(5)
     assert t.passthrough(e) is e
@@ -157,6 +181,22 @@ def test07_uniqueptr_passthrough(clean):
     assert t.stats() == (2, 2)
 
 
+def test07_uniqueptr_roundtrip(clean):
+    # Repeated transfers reuse the same Python instance
+    for f, factory in ((t.passthrough_unique, t.unique_from_cpp),
+                       (t.passthrough_unique_2, t.unique_from_cpp_2)):
+        a = factory()
+        for _ in range(100):
+            b = f(a)
+            assert b is a and b.value in (1, 2)
+        del a, b
+    collect()
+    assert t.stats() == (2, 2)
+
+    a = t.u_polymorphic_factory_2()
+    assert type(a) is t.PolymorphicBase
+    assert t.passthrough_unique_poly(a) is a
+
 def test07_polymorphic_downcast_unique():
     assert isinstance(t.u_factory(), t.Base)
     assert isinstance(t.u_factory_2(), t.Base)
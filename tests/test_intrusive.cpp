@@ -1,5 +1,6 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/pair.h>
+#include <nanobind/stl/vector.h>
 #include <nanobind/trampoline.h>
 #include <nanobind/intrusive/counter.h>
 #include <nanobind/intrusive/ref.h>
@@ -9,6 +10,7 @@ using namespace nb::literals;
 
 static int test_constructed = 0;
 static int test_destructed = 0;
+static int test_batches = 0;
 
 class Test : public nb::intrusive_base {
 public:
@@ -29,15 +31,18 @@ class PyTest : Test {
     }
 };
 
+static std::vector<nb::ref<Test>> test_cache;
+
 NB_MODULE(test_intrusive_ext, m) {
     nb::intrusive_init(
         [](PyObject *o) noexcept {
             nb::gil_scoped_acquire guard;
             Py_INCREF(o);
         },
-        [](PyObject *o) noexcept {
-            nb::gil_scoped_acquire guard;
-            Py_DECREF(o);
+        [](PyObject *o) noexcept { nb::decref_deferred(o); },
+        [](PyObject *const *o, size_t size) noexcept {
+            test_batches++;
+            nb::decref_deferred(o, size);
         });
 
     nb::class_<nb::intrusive_base>(
@@ -54,6 +59,7 @@ NB_MODULE(test_intrusive_ext, m) {
     m.def("reset", [] {
         test_constructed = 0;
         test_destructed = 0;
+        test_batches = 0;
     });
 
     m.def("stats", []() -> std::pair<int, int> {
@@ -63,4 +69,28 @@ NB_MODULE(test_intrusive_ext, m) {
     m.def("get_value_1", [](Test *o) { nb::ref<Test> x(o); return x->value(1); });
     m.def("get_value_2", [](nb::ref<Test> x) { return x->value(2); });
     m.def("get_value_3", [](const nb::ref<Test> &x) { return x->value(3); });
+
+    m.def("cache_add", [](std::vector<nb::ref<Test>> v) {
+        test_cache.insert(test_cache.end(), v.begin(), v.end());
+    });
+
+    m.def("cache_clear", [](bool batch) {
+        if (batch) {
+            nb::intrusive_batch guard;
+            test_cache.clear();
+        } else {
+            test_cache.clear();
+        }
+        return test_batches;
+    });
+
+    m.def("create_single_threaded", [](int n, bool keep) {
+        nb::ref<Test> x = new Test();
+        x->set_single_threaded();
+        for (int i = 0; i < n; ++i) {
+            nb::ref<Test> y = x, z = y;
+            (void) z;
+        }
+        return keep ? x : nb::ref<Test>();
+    });
 }
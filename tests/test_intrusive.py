@@ -56,3 +56,27 @@ def test04_subclass(clean):
     del o
     collect()
     assert t.stats() == (1, 1)
+
+
+def test05_single_threaded(clean):
+    assert t.create_single_threaded(100, False) is None
+    assert t.stats() == (1, 1)
+    t.reset()
+    o = t.create_single_threaded(100, True)
+    assert t.stats() == (1, 0)
+    assert o.value(0) == 123
+    assert t.get_value_2(o) == 125
+    del o
+    collect()
+    assert t.stats() == (1, 1)
+
+
+def test06_batch(clean):
+    t.cache_add([t.Test() for _ in range(5000)])
+    assert t.stats() == (5000, 0)
+    assert t.cache_clear(True) == 2
+    assert t.stats() == (5000, 5000)
+    t.reset()
+    t.cache_add([t.Test() for _ in range(10)])
+    assert t.cache_clear(False) == 0
+    assert t.stats() == (10, 10)
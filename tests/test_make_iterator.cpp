@@ -1,6 +1,8 @@
 #include <nanobind/make_iterator.h>
 #include <nanobind/stl/unordered_map.h>
+#include <nanobind/stl/vector.h>
 #include <nanobind/stl/string.h>
+#include <vector>
 
 namespace nb = nanobind;
 
@@ -35,6 +37,18 @@ NB_MODULE(test_make_iterator_ext, m) {
                                            map.end());
         }, nb::keep_alive<0, 1>());
 
+    struct IntVector {
+        std::vector<int> data;
+    };
+
+    nb::class_<IntVector>(m, "IntVector")
+        .def(nb::init<std::vector<int>>())
+        .def("__iter__",
+             [](const IntVector &v) {
+                 return nb::make_iterator(nb::type<IntVector>(), "iterator",
+                                          v.data.begin(), v.data.end());
+             }, nb::keep_alive<0, 1>());
+
     nb::handle mod = m;
     m.def("iterator_passthrough", [mod](nb::iterator s) -> nb::iterator {
         return nb::make_iterator(mod, "pt_iterator", std::begin(s), std::end(s));
@@ -33,3 +33,28 @@ def test04_passthrough_iterator():
     for d in data:
         m = t.StringMap(d)
         assert list(t.iterator_passthrough(m.values())) == list(m.values())
+
+
+def test05_length_hint_and_batches():
+    import operator
+    v = t.IntVector(list(range(10)))
+    it = iter(v)
+    assert iter(it) is it
+    assert operator.length_hint(it) == 10
+    assert next(it) == 0
+    assert operator.length_hint(it) == 9
+    assert it.next_batch(4) == [1, 2, 3, 4]
+    assert operator.length_hint(it) == 5
+    assert it.next_batch(10) == [5, 6, 7, 8, 9]
+    assert operator.length_hint(it) == 0
+    assert it.next_batch(10) == []
+    with pytest.raises(StopIteration):
+        next(it)
+    assert list(v) == list(range(10))
+    assert list(t.IntVector([])) == []
+
+    # Iterators over unordered maps provide batches, but no length hint
+    m = t.StringMap({'a': 'b'})
+    it = m.values()
+    assert it.next_batch(2) == ['b']
+    assert not hasattr(it, '__length_hint__')
@@ -1,7 +1,12 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
+#include <nanobind/arrow.h>
+#include <nanobind/ndarray_chunks.h>
 #include <nanobind/stl/complex.h>
+#include <nanobind/vectorize.h>
 #include <algorithm>
+#include <cerrno>
+#include <memory>
 #include <vector>
 
 namespace nb = nanobind;
@@ -11,6 +16,18 @@ using namespace nb::literals;
 int destruct_count = 0;
 static float f_global[] { 1, 2, 3, 4, 5, 6, 7, 8 };
 static int i_global[] { 1, 2, 3, 4, 5, 6, 7, 8 };
+alignas(64) static float f_aligned[32];
+
+// DLManagedTensorVersioned (DLPack 1.0) together with its storage
+struct dltensor_versioned {
+    uint32_t version[2] { 1, 0 };
+    void *manager_ctx = nullptr;
+    void (*deleter)(dltensor_versioned *) = nullptr;
+    uint64_t flags = 0;
+    nb::dlpack::dltensor dltensor;
+    float data[2] { 1, 2 };
+    int64_t shape[1] { 2 };
+};
 
 #if defined(__aarch64__)
 namespace nanobind {
@@ -24,6 +41,46 @@ namespace nanobind {
 };
 #endif
 
+// User-registered bfloat16 type
+struct bfloat16 { uint16_t bits; };
+
+namespace nanobind {
+   template <> struct ndarray_traits<bfloat16> {
+       static constexpr bool is_complex = false;
+       static constexpr bool is_float   = true;
+       static constexpr bool is_bfloat  = true;
+       static constexpr bool is_bool    = false;
+       static constexpr bool is_int     = false;
+       static constexpr bool is_signed  = true;
+   };
+};
+
+// Struct array with two int64 children, produced via the Arrow C data interface
+struct arrow_test_batch {
+    int refs = 2; // shared by the top-level schema and array
+    int64_t values[2][3] { { 1, 2, 3 }, { 4, 5, 6 } };
+    const void *buffers[2][2] { };
+    const void *struct_buffers[1] { };
+    ArrowSchema child_schemas[2] { }, *child_schema_ptrs[2] { };
+    ArrowArray child_arrays[2] { }, *child_array_ptrs[2] { };
+};
+
+int arrow_batches_alive = 0;
+
+static void arrow_test_unref(arrow_test_batch *b) {
+    if (--b->refs == 0) {
+        delete b;
+        arrow_batches_alive--;
+    }
+}
+
+// Chunks of 1, 2, .. int64 values; 'fail_at' makes get_next() fail
+struct arrow_test_stream {
+    int n, i = 0, fail_at;
+    int64_t values[8] { 10, 11, 12, 13, 14, 15, 16, 17 };
+    const void *buffers[2] { };
+};
+
 NB_MODULE(test_ndarray_ext, m) {
     m.def("get_shape", [](const nb::ndarray<nb::ro> &t) {
         nb::list l;
@@ -88,6 +145,26 @@ NB_MODULE(test_ndarray_ext, m) {
 
     m.def("make_contig", [](nb::ndarray<nb::c_contig> a) { return a; });
 
+    using aligned_f32 = nb::ndarray<const float, nb::ndim<1>, nb::c_contig,
+                                    nb::align<64>, nb::device::cpu>;
+    m.def("aligned_source", [](size_t offset) {
+        for (size_t i = 0; i < 32; ++i)
+            f_aligned[i] = (float) i;
+        size_t shape[1] = { 16 };
+        return nb::ndarray<float, nb::ndim<1>>(f_aligned + offset, 1, shape);
+    }, nb::rv_policy::reference);
+    m.def("aligned_sum", [](aligned_f32 a) {
+        auto v = a.view();
+        static_assert(decltype(v)::Alignment == 64);
+        float sum = 0;
+        for (float f : v.flat())
+            sum += f;
+        return nb::make_tuple(sum, (uintptr_t) v.data() % 64,
+                              (const float *) v.data() == f_aligned);
+    });
+    m.def("aligned_sum_noconvert", [](aligned_f32 a) { return a.shape(0); },
+          "a"_a.noconvert());
+
     m.def("check_device", [](nb::ndarray<nb::device::cpu>) -> const char * { return "cpu"; });
     m.def("check_device", [](nb::ndarray<nb::device::cuda>) -> const char * { return "cuda"; });
 
@@ -216,6 +293,31 @@ NB_MODULE(test_ndarray_ext, m) {
 
     m.def("check", [](nb::handle h) { return nb::ndarray_check(h); });
 
+    m.def("return_dlpack_versioned", [](uint32_t major, uint64_t flags) {
+        dltensor_versioned *t = new dltensor_versioned();
+        t->version[0] = major;
+        t->flags = flags;
+        t->deleter = [](dltensor_versioned *t2) {
+            destruct_count++;
+            delete t2;
+        };
+        t->dltensor.data = t->data;
+        t->dltensor.device = { nb::device::cpu::value, 0 };
+        t->dltensor.ndim = 1;
+        t->dltensor.dtype = nb::dtype<float>();
+        t->dltensor.shape = t->shape;
+
+        return nb::capsule(t, "dltensor_versioned", [](void *p) noexcept {
+            dltensor_versioned *t2 = (dltensor_versioned *) p;
+            t2->deleter(t2);
+        });
+    });
+
+    m.def("import_with_stream", [](intptr_t stream, nb::handle h) {
+        nb::ndarray_stream guard(stream);
+        return nb::cast<nb::ndarray<nb::ro>>(h).shape(0);
+    });
+
 
     struct Cls {
         auto f1() { return nb::ndarray<nb::numpy, float>(data, { 10 }); }
@@ -274,6 +376,136 @@ NB_MODULE(test_ndarray_ext, m) {
                 v(i, j) *= std::complex<float>(-1.0f, 2.0f);
     }, "x"_a.noconvert());
 
+    m.def("ret_jax_ref", []() {
+        return nb::ndarray<nb::jax, float, nb::shape<8>>(f_global, { 8 });
+    }, nb::rv_policy::reference);
+
+    static const void *vector_array_data = nullptr;
+    m.def("vector_array_ret", [](size_t n) {
+        nb::vector_array<double> v(n);
+        for (size_t i = 0; i < n; ++i)
+            v[i] = 0.5 * (double) i;
+        vector_array_data = v.data();
+        return v;
+    });
+    m.def("vector_array_data", []() { return (uintptr_t) vector_array_data; });
+    m.def("vector_array_ret_torch", []() {
+        return nb::vector_array<float, nb::pytorch>{ 1.f, 2.f, 3.f };
+    });
+    m.def("vector_array_points", [](size_t n) {
+        nb::vector_array<std::array<float, 3>> v(n);
+        for (size_t i = 0; i < n; ++i)
+            v[i] = { (float) i, 0.5f * (float) i, -1.f };
+        vector_array_data = v.data();
+        return v;
+    });
+    m.def("vector_array_grid", [](size_t rows, size_t cols) {
+        nb::vector_array<std::vector<double>> v(rows);
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols + (i == 1 && cols == 5); ++j)
+                v[i].push_back((double) (i * 10 + j));
+        return v;
+    });
+    m.def("vector_array_points_sum",
+          [](const nb::vector_array<std::array<float, 3>> &v) {
+              float sum[3] = { 0.f, 0.f, 0.f };
+              for (const auto &p : v)
+                  for (size_t i = 0; i < 3; ++i)
+                      sum[i] += p[i];
+              return nb::make_tuple(v.size(), sum[0], sum[1], sum[2]);
+          });
+    m.def("vector_array_grid_shape",
+          [](const nb::vector_array<std::vector<int32_t>> &v) {
+              nb::list l;
+              for (const auto &row : v)
+                  l.append(nb::make_tuple(row.size(), row.empty() ? -1 : row.back()));
+              return l;
+          });
+    m.def("vector_array_sum", [](const nb::vector_array<int64_t> &v) {
+        int64_t sum = 0;
+        for (int64_t i : v)
+            sum += i;
+        return sum;
+    });
+
+    m.def("copy_to_vector", [](nb::ndarray<nb::ro, nb::device::cpu> a,
+                               char order, size_t threads) {
+        std::vector<double> v(a.size());
+        if (order == 'C')
+            nb::ndarray_copy(a, v, threads);
+        else
+            nb::ndarray_copy(a, v.data(), order, threads);
+        double checksum = 0;
+        for (size_t i = 0; i < v.size(); ++i)
+            checksum += v[i] * (double) (i % 7);
+        nb::list first;
+        for (size_t i = 0; i < v.size() && i < 4; ++i)
+            first.append(v[i]);
+        return nb::make_tuple(checksum, first);
+    });
+    m.def("copy_to_complex", [](nb::ndarray<nb::ro> a) {
+        std::complex<float> c[4];
+        nb::ndarray_copy(a, c);
+    });
+
+    m.def("chunks_count", [](int32_t total, size_t rows, size_t ring,
+                             int32_t fail_after) {
+        auto pos = std::make_shared<int32_t>(0);
+        return nb::ndarray_chunks<int32_t>(
+            ring, { rows, 2 }, [=](int32_t *buf, size_t capacity) -> size_t {
+                if (fail_after >= 0 && *pos >= fail_after)
+                    throw std::runtime_error("producer failed");
+                size_t n = 0;
+                for (; n < capacity && *pos < total; ++n, ++*pos) {
+                    buf[2 * n] = *pos;
+                    buf[2 * n + 1] = -*pos;
+                }
+                return n;
+            });
+    });
+    m.def("chunk_info", [](nb::ndarray<const int32_t, nb::ndim<2>, nb::device::cpu> a) {
+        auto v = a.view();
+        return nb::make_tuple(a.shape(0), v(0, 0), v(a.shape(0) - 1, 1),
+                              (uintptr_t) a.data());
+    });
+
+    m.def("view_row_sums", [](nb::ndarray<const double, nb::ndim<2>, nb::device::cpu> x) {
+        nb::list l;
+        for (auto row : x.view().rows()) {
+            double sum = 0;
+            row.for_each([&](double v) { sum += v; });
+            l.append(sum);
+        }
+        return l;
+    });
+
+    m.def("view_flat", [](nb::ndarray<const double, nb::ndim<1>, nb::device::cpu> x) {
+        auto v = x.view();
+        nb::list l;
+        v.for_each([&](double value) { l.append(value); });
+        return nb::make_tuple(v.is_contiguous(), v.flat().size(), l);
+    });
+
+    m.def("view_tiles", [](nb::ndarray<const double, nb::ndim<2>, nb::c_contig,
+                                       nb::device::cpu> x, size_t n) {
+        nb::list l;
+        for (auto tile : x.view().tiles(n))
+            l.append(nb::make_tuple(tile.shape(0), tile(0, 0), tile.flat().size()));
+        return l;
+    });
+
+    m.def("view_parallel_scale", [](nb::ndarray<double, nb::ndim<2>, nb::c_contig,
+                                                nb::device::cpu> x,
+                                    double factor, size_t threads) {
+        x.view().parallel_for_each([factor](auto row) {
+            for (double &v : row.flat()) {
+                if (v < 0)
+                    throw std::runtime_error("negative entry");
+                v *= factor;
+            }
+        }, threads);
+    });
+
 #if defined(__aarch64__)
     m.def("ret_numpy_half", []() {
         __fp16 *f = new __fp16[8] { 1, 2, 3, 4, 5, 6, 7, 8 };
@@ -305,4 +537,304 @@ NB_MODULE(test_ndarray_ext, m) {
           [](nb::ndarray<std::complex<double>, nb::ndim<1>, nb::c_contig> data, uint32_t) {
             data(0) = 123;
           });
+
+    m.def("vec_fma", nb::vectorize([](double a, double b, double c) {
+        return a * b + c;
+    }), "a"_a, "b"_a, "c"_a);
+
+    m.def("vec_fma_numpy", nb::vectorize<nb::numpy>([](double a, double b, double c) {
+        return a * b + c;
+    }));
+
+    m.def("vec_scale", nb::vectorize([](double x, int64_t k) {
+        return x * (double) k;
+    }, 4));
+
+    m.def("vec_values", [](nb::ndarray<const double, nb::c_contig, nb::device::cpu> a) {
+        nb::list l;
+        for (size_t i = 0; i < a.size(); ++i)
+            l.append(a.data()[i]);
+        return l;
+    });
+
+    m.def("alloc_pooled", [](size_t n) {
+        auto a = nb::ndarray_alloc<double, nb::c_contig>({ n });
+        for (size_t i = 0; i < n; ++i)
+            a.data()[i] = (double) i;
+        return a;
+    });
+
+    m.def("alloc_pooled_reuse", [](size_t n) {
+        // Released blocks are handed out again by the next allocation
+        void *p1 = nb::ndarray_alloc<float>({ n, 2 }).data(),
+             *p2 = nb::ndarray_alloc<float>({ n, 2 }).data();
+        return p1 == p2 && (uintptr_t) p1 % 64 == 0;
+    });
+
+    m.def("from_vector", [](size_t n) {
+        std::vector<double> v(n);
+        for (size_t i = 0; i < n; ++i)
+            v[i] = (double) i;
+        return nb::ndarray<double>::from_vector(std::move(v));
+    });
+
+    m.def("from_unique_ptr", []() {
+        struct counting_delete {
+            void operator()(double *p) const {
+                destruct_count++;
+                delete[] p;
+            }
+        };
+
+        std::unique_ptr<double[], counting_delete> p(
+            new double[6] { 1, 2, 3, 4, 5, 6 });
+        return nb::ndarray<double, nb::shape<2, 3>>::from_unique_ptr(
+            std::move(p), { 2, 3 });
+    });
+
+    m.def("memory_f32", [](nb::ndarray<const float, nb::f_contig,
+                                       nb::device::cpu> a) {
+        // Elements and strides as laid out in memory
+        nb::list values, strides;
+        for (size_t i = 0; i < a.size(); ++i)
+            values.append(a.data()[i]);
+        for (size_t i = 0; i < a.ndim(); ++i)
+            strides.append(a.stride(i));
+        return nb::make_tuple(values, strides);
+    });
+
+    m.def("memory_i8", [](nb::ndarray<const int8_t, nb::c_contig,
+                                      nb::device::cpu> a) {
+        nb::list values;
+        for (size_t i = 0; i < a.size(); ++i)
+            values.append(a.data()[i]);
+        return values;
+    });
+
+    m.def("bfloat16_bits", [](nb::ndarray<const bfloat16, nb::c_contig,
+                                          nb::device::cpu> a) {
+        nb::list l;
+        for (size_t i = 0; i < a.size(); ++i)
+            l.append(a.data()[i].bits);
+        return l;
+    });
+
+    m.def("ret_bfloat16", []() {
+        auto a = nb::ndarray_alloc<bfloat16>({ 3 });
+        uint16_t bits[3] = { 0x3F80, 0xC020, 0x7F80 };
+        for (size_t i = 0; i < 3; ++i)
+            a.data()[i].bits = bits[i];
+        return a;
+    });
+
+    m.def("map_file", [](const char *path, size_t n, uint64_t offset,
+                         bool sequential) {
+        return nb::ndarray<const double>::map_file(
+            path, { n }, offset, false,
+            sequential ? nb::mmap_advice::sequential : nb::mmap_advice::normal);
+    }, "path"_a, "n"_a, "offset"_a = 0, "sequential"_a = false);
+
+    m.def("map_file_cow", [](const char *path, size_t n) {
+        auto a = nb::ndarray<double, nb::c_contig>::map_file(path, { n });
+        for (size_t i = 0; i < n; ++i)
+            a.data()[i] *= 2;
+        return a;
+    });
+
+    m.def("map_file_ro_mutable", [](const char *path) {
+        return nb::ndarray<double>::map_file(path, { 1 }, 0, false);
+    });
+
+    m.def("arrow_export_i64", [](nb::list values) {
+        size_t n = values.size();
+        auto data = nb::ndarray_alloc<int64_t>({ n });
+        auto mask = nb::ndarray_alloc<uint8_t>({ (n + 7) / 8 });
+        memset(mask.data(), 0, mask.size());
+        for (size_t i = 0; i < n; ++i) {
+            bool valid = !values[i].is_none();
+            data.data()[i] = valid ? nb::cast<int64_t>(values[i]) : 0;
+            if (valid)
+                mask.data()[i / 8] |= (uint8_t) (1 << (i % 8));
+        }
+        return nb::arrow_export(data, mask);
+    });
+
+    m.def("arrow_export_f32", [](nb::ndarray<float, nb::ndim<1>> a) {
+        return nb::arrow_export(a);
+    });
+
+    m.def("arrow_batch", []() {
+        arrow_test_batch *b = new arrow_test_batch();
+        arrow_batches_alive++;
+
+        ArrowSchema *schema = new ArrowSchema();
+        ArrowArray *array = new ArrowArray();
+        const char *names[2] = { "a", "b" };
+
+        for (int i = 0; i < 2; ++i) {
+            b->buffers[i][1] = b->values[i];
+            b->child_schemas[i].format = "l";
+            b->child_schemas[i].name = names[i];
+            b->child_schemas[i].release = [](ArrowSchema *s) { s->release = nullptr; };
+            b->child_arrays[i].length = 3;
+            b->child_arrays[i].n_buffers = 2;
+            b->child_arrays[i].buffers = b->buffers[i];
+            b->child_arrays[i].release = [](ArrowArray *a) { a->release = nullptr; };
+            b->child_schema_ptrs[i] = &b->child_schemas[i];
+            b->child_array_ptrs[i] = &b->child_arrays[i];
+        }
+
+        schema->format = "+s";
+        schema->name = "";
+        schema->n_children = 2;
+        schema->children = b->child_schema_ptrs;
+        schema->private_data = b;
+        schema->release = [](ArrowSchema *s) {
+            arrow_test_unref((arrow_test_batch *) s->private_data);
+            s->release = nullptr;
+        };
+
+        array->length = 2;
+        array->offset = 1;
+        array->n_buffers = 1;
+        array->buffers = b->struct_buffers;
+        array->n_children = 2;
+        array->children = b->child_array_ptrs;
+        array->private_data = b;
+        array->release = [](ArrowArray *a) {
+            arrow_test_unref((arrow_test_batch *) a->private_data);
+            a->release = nullptr;
+        };
+
+        nb::capsule schema_c(schema, "arrow_schema", [](void *p) noexcept {
+            ArrowSchema *s = (ArrowSchema *) p;
+            if (s->release)
+                s->release(s);
+            delete s;
+        });
+        nb::capsule array_c(array, "arrow_array", [](void *p) noexcept {
+            ArrowArray *a = (ArrowArray *) p;
+            if (a->release)
+                a->release(a);
+            delete a;
+        });
+        return nb::make_tuple(schema_c, array_c);
+    });
+
+    m.def("arrow_batches_alive", []() { return arrow_batches_alive; });
+
+    m.def("arrow_stream", [](int n, int fail_at) {
+        ArrowArrayStream *s = new ArrowArrayStream();
+        s->private_data = new arrow_test_stream{ n, 0, fail_at };
+        s->get_schema = [](ArrowArrayStream *, ArrowSchema *out) {
+            *out = ArrowSchema();
+            out->format = "l";
+            out->name = "";
+            out->release = [](ArrowSchema *s) { s->release = nullptr; };
+            return 0;
+        };
+        s->get_next = [](ArrowArrayStream *self, ArrowArray *out) {
+            arrow_test_stream *st = (arrow_test_stream *) self->private_data;
+            if (st->i == st->fail_at)
+                return EIO;
+            *out = ArrowArray();
+            if (st->i < st->n) {
+                st->buffers[1] = st->values;
+                out->length = ++st->i;
+                out->n_buffers = 2;
+                out->buffers = st->buffers;
+                out->release = [](ArrowArray *a) { a->release = nullptr; };
+            }
+            return 0;
+        };
+        s->get_last_error = [](ArrowArrayStream *) {
+            return "stream failure";
+        };
+        s->release = [](ArrowArrayStream *self) {
+            delete (arrow_test_stream *) self->private_data;
+            self->release = nullptr;
+        };
+        return nb::capsule(s, "arrow_array_stream", [](void *p) noexcept {
+            ArrowArrayStream *s = (ArrowArrayStream *) p;
+            if (s->release)
+                s->release(s);
+            delete s;
+        });
+    });
+
+    m.def("arrow_info", [](nb::arrow_array a) {
+        return nb::make_tuple(a.format(), a.size(), a.null_count(),
+                              a.n_children());
+    });
+
+    m.def("arrow_i64_list", [](nb::arrow_array a) {
+        auto v = a.values<int64_t>();
+        nb::list l;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a.is_null(i))
+                l.append(nb::none());
+            else
+                l.append(v(i));
+        }
+        return l;
+    });
+
+    m.def("arrow_values_f32", [](nb::arrow_array a) {
+        auto v = a.values<float>();
+        nb::list l;
+        for (size_t i = 0; i < v.size(); ++i)
+            l.append(v(i));
+        return nb::make_tuple((uintptr_t) v.data(), l);
+    });
+
+    m.def("arrow_columns", [](nb::arrow_array a) {
+        nb::dict d;
+        for (size_t i = 0; i < a.n_children(); ++i) {
+            nb::arrow_array c = a.child(i);
+            auto v = c.values<int64_t>();
+            nb::list l;
+            for (size_t j = 0; j < a.size(); ++j)
+                l.append(v((size_t) a.offset() + j));
+            d[c.name()] = l;
+        }
+        return d;
+    });
+
+    m.def("arrow_identity", [](nb::arrow_array a) { return a; });
+    m.def("arrow_first_child", [](nb::arrow_array a) { return a.child(0); });
+
+    m.def("arrow_stream_chunks", [](nb::arrow_stream s) {
+        nb::list chunks;
+        while (true) {
+            nb::arrow_array a = s.next();
+            if (!a.is_valid())
+                break;
+            nb::list l;
+            auto v = a.values<int64_t>();
+            for (size_t i = 0; i < a.size(); ++i)
+                l.append(v(i));
+            chunks.append(l);
+        }
+        return chunks;
+    });
+
+#if defined(NB_HAS_FLOAT16)
+    m.def("float16_bits", [](nb::ndarray<const _Float16, nb::c_contig,
+                                         nb::device::cpu> a) {
+        nb::list l;
+        for (size_t i = 0; i < a.size(); ++i) {
+            uint16_t bits;
+            memcpy(&bits, a.data() + i, sizeof(uint16_t));
+            l.append(bits);
+        }
+        return l;
+    });
+
+    m.def("ret_float16", []() {
+        auto a = nb::ndarray_alloc<_Float16>({ 4 });
+        uint16_t bits[4] = { 0x3C00, 0xC100, 0x0001, 0xFC00 };
+        memcpy(a.data(), bits, sizeof(bits));
+        return a;
+    });
+#endif
 }
@@ -1,4 +1,5 @@
 import test_ndarray_ext as t
+import array
 import pytest
 import warnings
 import importlib
@@ -644,3 +645,494 @@ def test_uint32_complex_do_not_convert(variant):
     t.set_item(data, arg)
     data2 = np.array([123, 3.0 + 4.0j])
     assert np.all(data == data2)
+
+def test35_vectorize():
+    import array
+    a = array.array('d', [1, 2, 3])
+    assert t.vec_values(t.vec_fma(a, 2.0, 1)) == [3, 5, 7]
+    assert t.get_shape(t.vec_fma(a, 2.0, 1)) == [3]
+
+    # Scalars only produce a 0-dimensional array
+    r = t.vec_fma(2, 3, 4)
+    assert t.vec_values(r) == [10]
+    assert t.get_shape(t.vec_fma(2, 3, 4)) == []
+
+    # Broadcasting of a 2D array against a 1D array
+    m = memoryview(array.array('d', range(6))).cast('B').cast('d', [2, 3])
+    assert t.get_shape(t.vec_fma(m, a, 0.5)) == [2, 3]
+    assert t.vec_values(t.vec_fma(m, a, 0.5)) == [0.5, 2.5, 6.5, 3.5, 8.5, 15.5]
+    assert t.vec_values(t.vec_fma(c=m, b=1, a=a)) == [1, 3, 5, 4, 6, 8]
+
+    with pytest.raises(ValueError, match='could not be broadcast'):
+        t.vec_fma(a, array.array('d', [1, 2]), 0)
+
+    with pytest.raises(TypeError):
+        t.vec_fma(a, "hello", 0)
+
+    assert t.vec_fma.__doc__ == (
+        "vec_fma(a: float | ndarray[dtype=float64, writable=False, device='cpu'], "
+        "b: float | ndarray[dtype=float64, writable=False, device='cpu'], "
+        "c: float | ndarray[dtype=float64, writable=False, device='cpu']) -> ndarray[dtype=float64]")
+
+    # Chunked evaluation on several threads
+    x = array.array('d', range(10000))
+    k = array.array('q', [3])
+    assert t.vec_values(t.vec_scale(x, k)) == [3.0 * i for i in range(10000)]
+
+
+@needs_numpy
+def test36_vectorize_numpy():
+    a = np.arange(6, dtype=np.float64).reshape(2, 3)
+    b = np.array([1, 2, 3], dtype=np.int32) # implicitly converted
+    r = t.vec_fma_numpy(a, b, 1.0)
+    assert isinstance(r, np.ndarray) and r.shape == (2, 3)
+    assert np.all(r == a * b + 1)
+    assert t.vec_fma_numpy(a.T, 2, 0).shape == (3, 2)
+    assert np.all(t.vec_fma_numpy(a.T, 2, 0) == a.T * 2)
+
+
+def test37_import_source_cache():
+    import array
+
+    class Wrapper:
+        calls = 0
+        fail = False
+        def __dlpack__(self):
+            Wrapper.calls += 1
+            if Wrapper.fail:
+                raise RuntimeError("no luck")
+            return t.return_dlpack()
+
+    # The way of importing instances is remembered per type
+    for i in range(3):
+        assert t.get_shape(Wrapper()) == [2, 4]
+        assert t.get_shape(array.array('f', [1, 2, 3])) == [3]
+    assert Wrapper.calls == 3
+
+    # Failures of the remembered way still reach the remaining ones
+    Wrapper.fail = True
+    with pytest.raises(TypeError):
+        t.get_shape(Wrapper())
+    assert Wrapper.calls == 4
+    Wrapper.fail = False
+    assert t.get_shape(Wrapper()) == [2, 4]
+
+
+@needs_numpy
+def test38_numpy_import_direct():
+    # NumPy arrays are imported via the buffer protocol
+    a = np.arange(12, dtype=np.float32).reshape(3, 4)
+    assert t.get_shape(a) == [3, 4]
+    assert t.check_order(a) == 'C' and t.check_order(a.T) == 'F'
+    assert t.check_order(a[:, ::2]) == '?'
+    b = a.copy()
+    b.flags.writeable = False
+    assert t.get_shape(b) == [3, 4]
+    assert t.accept_ro(np.array([1, 2], dtype=np.float32)) == 1
+    assert t.passthrough(a) is a
+
+    with pytest.raises(TypeError):
+        t.pass_float32(a.astype(np.float64))
+
+
+def test39_dlpack_versioned():
+    class Producer:
+        kwargs = None
+        device = (1, 0)
+        def __init__(self, major=1, flags=0):
+            self.major, self.flags = major, flags
+        def __dlpack__(self, **kwargs):
+            Producer.kwargs = kwargs
+            return t.return_dlpack_versioned(self.major, self.flags)
+        def __dlpack_device__(self):
+            return Producer.device
+
+    # Versioned capsules are requested, accepted, and released
+    collect()
+    count = t.destruct_count()
+    assert t.get_shape(Producer()) == [2]
+    assert Producer.kwargs == {'max_version': (1, 0)}
+    assert t.get_shape(t.return_dlpack_versioned(1, 0)) == [2]
+    collect()
+    assert t.destruct_count() - count == 2
+
+    # Read-only and copied tensors only satisfy read-only requests
+    assert t.accept_ro(Producer(flags=1)) == 1
+    assert t.accept_ro(Producer(flags=2)) == 1
+    for flags in (1, 2):
+        with pytest.raises(TypeError):
+            t.pass_float32(Producer(flags=flags))
+
+    # Unknown major versions are refused
+    with pytest.raises(TypeError):
+        t.get_shape(Producer(major=2))
+
+    # The stream is only passed for devices that have streams
+    assert t.import_with_stream(5, Producer()) == 2
+    assert Producer.kwargs == {'max_version': (1, 0)}
+    Producer.device = (2, 0)
+    assert t.import_with_stream(5, Producer()) == 2
+    assert Producer.kwargs == {'max_version': (1, 0), 'stream': 5}
+    t.get_shape(Producer())
+    assert Producer.kwargs == {'max_version': (1, 0)}
+
+
+def test40_ndarray_alloc():
+    for n in (0, 1, 100, 1000000):
+        a = t.alloc_pooled(n)
+        assert t.get_shape(a) == [n]
+        if n <= 100:
+            assert t.vec_values(t.alloc_pooled(n)) == list(range(n))
+    assert t.alloc_pooled_reuse(10)
+    assert t.alloc_pooled_reuse(10000000)
+
+
+def test41_ndarray_from_container():
+    assert t.vec_values(t.from_vector(5)) == [0, 1, 2, 3, 4]
+    assert t.get_shape(t.from_vector(0)) == [0]
+
+    collect()
+    dc = t.destruct_count()
+    a = t.from_unique_ptr()
+    assert t.get_shape(t.from_unique_ptr()) == [2, 3]
+    collect()
+    assert t.destruct_count() - dc == 1
+
+    # The container is destroyed with the last reference to the array
+    assert t.vec_values(a) == [1, 2, 3, 4, 5, 6]
+    del a
+    collect()
+    assert t.destruct_count() - dc == 2
+
+
+def test42_native_conversion():
+    import array
+
+    # Memory views have no 'astype', CPU arrays are converted natively
+    a = array.array('i', [1, 2, 3, 4, 5, 6])
+    assert t.vec_values(a) == [1, 2, 3, 4, 5, 6]
+    assert t.vec_values(memoryview(a)[::2]) == [1, 3, 5]
+
+    m = memoryview(array.array('d', [1, 2, 3, 4, 5, 6])).cast('B').cast('d', (2, 3))
+    assert t.memory_f32(m) == ([1, 4, 2, 5, 3, 6], [1, 2])
+
+    # Out-of-range float -> int conversions saturate
+    b = array.array('d', [-1e10, -1.5, 0.5, 300, float('nan')])
+    assert t.memory_i8(b) == [-128, -1, 0, 127, 0]
+    assert t.memory_i8(array.array('Q', [255, 2**63])) == [-1, 0]
+    assert t.vec_values(array.array('b')) == []
+
+    with pytest.raises(TypeError):
+        t.memory_i8(array.array('u', 'abc'))
+
+
+def test43_half_precision():
+    import array
+
+    # User-registered bfloat16 type
+    assert 'dtype=bfloat16' in t.bfloat16_bits.__doc__
+    b = array.array('f', [1, -2.5, 3.14159, float('inf'), float('nan')])
+    assert t.bfloat16_bits(b) == [0x3F80, 0xC020, 0x4049, 0x7F80, 0x7FC0]
+    assert t.vec_values(t.ret_bfloat16()) == [1, -2.5, float('inf')]
+
+    if not hasattr(t, 'float16_bits'):
+        return
+
+    assert 'dtype=float16' in t.float16_bits.__doc__
+    h = array.array('d', [1, -2.5, 65504, 65520, 1e6, 2**-24, 2**-14, 0.1, -0.0])
+    assert t.float16_bits(h) == [0x3C00, 0xC100, 0x7BFF, 0x7C00, 0x7C00,
+                                 0x0001, 0x0400, 0x2E66, 0x8000]
+    assert t.vec_values(t.ret_float16()) == [1, -2.5, 2**-24, float('-inf')]
+
+
+def test44_map_file():
+    import os, struct, tempfile
+
+    fd, path = tempfile.mkstemp()
+    try:
+        data = struct.pack('7d', *range(7))
+        with os.fdopen(fd, 'wb') as f:
+            f.write(data)
+
+        assert t.vec_values(t.map_file(path, 7)) == list(range(7))
+        assert t.vec_values(t.map_file(path, 3, offset=16, sequential=True)) == [2, 3, 4]
+        assert t.get_shape(t.map_file(path, 0, offset=56)) == [0]
+
+        # Copy-on-write mappings leave the file untouched
+        assert t.vec_values(t.map_file_cow(path, 4)) == [0, 2, 4, 6]
+        with open(path, 'rb') as f:
+            assert f.read() == data
+
+        with pytest.raises(RuntimeError, match='too small'):
+            t.map_file(path, 7, offset=8)
+        with pytest.raises(RuntimeError, match='const scalar type'):
+            t.map_file_ro_mutable(path)
+        with pytest.raises(FileNotFoundError):
+            t.map_file(path + '.missing', 1)
+        collect()
+    finally:
+        os.unlink(path)
+
+
+class ArrowProducer:
+    def __init__(self, func, *args):
+        self.func, self.args = func, args
+
+    def __arrow_c_array__(self, requested_schema=None):
+        return self.func(*self.args)
+
+
+class ArrowStreamProducer:
+    def __init__(self, n, fail_at=-1):
+        self.n, self.fail_at = n, fail_at
+
+    def __arrow_c_stream__(self, requested_schema=None):
+        return t.arrow_stream(self.n, self.fail_at)
+
+
+def test45_arrow_import_export():
+    import array
+
+    values = [1, None, 3, 4, None, 6, 7, 8, 9]
+    p = ArrowProducer(t.arrow_export_i64, values)
+    assert t.arrow_info(p) == ('l', 9, -1, 0)
+    assert t.arrow_i64_list(p) == values
+
+    # Previously imported arrays can be passed back and forth
+    a = t.arrow_identity(p)
+    assert t.arrow_i64_list(a) == values
+    assert t.arrow_i64_list(t.arrow_identity(a)) == values
+
+    # Values are exposed without copying
+    buf = array.array('f', [1.5, 2.5, 3.5])
+    ptr, v = t.arrow_values_f32(ArrowProducer(t.arrow_export_f32, buf))
+    assert ptr == buf.buffer_info()[0]
+    assert v == [1.5, 2.5, 3.5]
+
+    with pytest.raises(RuntimeError, match='incompatible'):
+        t.arrow_values_f32(p)
+    with pytest.raises(TypeError):
+        t.arrow_info(object())
+
+    # Capsules can only be consumed once
+    schema, arr = t.arrow_export_i64([1])
+    once = ArrowProducer(lambda: (schema, arr))
+    assert t.arrow_info(once) == ('l', 1, -1, 0)
+    with pytest.raises(TypeError):
+        t.arrow_info(once)
+    del a, p, once, schema, arr
+    collect()
+
+
+def test46_arrow_struct_and_stream():
+    collect()
+    assert t.arrow_batches_alive() == 0
+    batch = ArrowProducer(t.arrow_batch)
+    assert t.arrow_info(batch) == ('+s', 2, 0, 2)
+    assert t.arrow_columns(batch) == {'a': [2, 3], 'b': [5, 6]}
+    with pytest.raises(TypeError, match='child'):
+        t.arrow_first_child(batch)
+
+    # Unconsumed capsules are released by their destructor
+    t.arrow_batch()
+    collect()
+    assert t.arrow_batches_alive() == 0
+
+    assert t.arrow_stream_chunks(ArrowStreamProducer(3)) == [[10], [10, 11], [10, 11, 12]]
+    assert t.arrow_stream_chunks(ArrowStreamProducer(0)) == []
+    with pytest.raises(RuntimeError, match='stream failure'):
+        t.arrow_stream_chunks(ArrowStreamProducer(3, fail_at=1))
+
+
+def test47_view_iteration():
+    import array
+
+    buf = array.array('d', range(12))
+    m = memoryview(buf).cast('B').cast('d', [3, 4])
+    assert t.view_row_sums(m) == [6, 22, 38]
+    assert t.view_tiles(m, 2) == [(2, 0, 8), (1, 8, 4)]
+    assert t.view_tiles(m, 5) == [(3, 0, 12)]
+
+    assert t.view_flat(memoryview(buf)) == (True, 12, list(range(12)))
+    assert t.view_flat(memoryview(buf)[::3]) == (False, 0, [0, 3, 6, 9])
+
+    big = array.array('d', range(64 * 256))
+    m = memoryview(big).cast('B').cast('d', [64, 256])
+    t.view_parallel_scale(m, 2, 4)
+    assert big.tolist() == [2.0 * i for i in range(64 * 256)]
+    t.view_parallel_scale(m, 0.5, 1)
+    assert big[-1] == 64 * 256 - 1
+
+    big[1000] = -1
+    with pytest.raises(RuntimeError, match='negative entry'):
+        t.view_parallel_scale(m, 2, 4)
+
+
+def test48_framework_function_cache():
+    import importlib.util, sys, types
+    if importlib.util.find_spec('jax') is not None:
+        pytest.skip('jax is installed')
+
+    calls = []
+    def from_dlpack(capsule):
+        calls.append(type(capsule).__name__)
+        return 'jax array'
+
+    mod = types.ModuleType('jax.dlpack')
+    mod.from_dlpack = from_dlpack
+    sys.modules['jax'] = types.ModuleType('jax')
+    sys.modules['jax.dlpack'] = mod
+    try:
+        assert t.ret_jax_ref() == 'jax array'
+    finally:
+        del sys.modules['jax'], sys.modules['jax.dlpack']
+
+    # The cached function is used without importing the module again
+    assert t.ret_jax_ref() == 'jax array'
+    assert calls == ['PyCapsule'] * 2
+    collect()
+
+
+def test49_vector_array():
+    # Arguments behave like std::vector<T>
+    assert t.vector_array_sum([1, 2, 3]) == 6
+    assert t.vector_array_sum(()) == 0
+    with pytest.raises(TypeError):
+        t.vector_array_sum([1.5])
+    assert 'numpy.ndarray[dtype=float64, shape=(*), device=\'cpu\']' in t.vector_array_ret.__doc__
+
+
+@needs_numpy
+def test50_vector_array_numpy():
+    a = t.vector_array_ret(1000)
+    assert isinstance(a, np.ndarray) and a.dtype == np.float64
+    assert a.shape == (1000,) and a[999] == 499.5
+
+    # The vector was moved into the array instead of being copied
+    assert a.ctypes.data == t.vector_array_data()
+    assert a.base is not None and not a.flags.owndata
+    assert t.vector_array_sum(np.array([1, 2, 3], dtype=np.int64)) == 6
+    del a
+    collect()
+
+
+@needs_torch
+def test51_vector_array_torch():
+    a = t.vector_array_ret_torch()
+    assert isinstance(a, torch.Tensor) and a.dtype == torch.float32
+    assert a.tolist() == [1, 2, 3]
+
+
+def test52_vector_array_rows():
+    # Sequences of rows and 2D buffers are accepted as input
+    assert t.vector_array_points_sum([(1, 2, 3), [4, 5, 6]]) == (2, 5, 7, 9)
+    assert t.vector_array_points_sum([]) == (0, 0, 0, 0)
+    with pytest.raises(TypeError):
+        t.vector_array_points_sum([(1, 2)])
+    buf = memoryview(array.array('f', range(6)).tobytes()).cast('f', (2, 3))
+    assert t.vector_array_points_sum(buf) == (2, 3, 5, 7)
+
+    assert t.vector_array_grid_shape([[1], [2, 3], []]) == [(1, 1), (2, 3), (0, -1)]
+    buf = memoryview(array.array('i', range(6)).tobytes()).cast('i', (3, 2))
+    assert t.vector_array_grid_shape(buf) == [(2, 1), (2, 3), (2, 5)]
+
+    # Ragged rows can't be returned as an array
+    with pytest.raises(ValueError, match='same size'):
+        t.vector_array_grid(3, 5)
+    assert 'numpy.ndarray[dtype=float32, shape=(*, 3), device=\'cpu\']' in t.vector_array_points.__doc__
+
+
+@needs_numpy
+def test53_vector_array_rows_numpy():
+    a = t.vector_array_points(100)
+    assert a.shape == (100, 3) and a.dtype == np.float32
+    assert a[99].tolist() == [99, 49.5, -1]
+
+    # std::array rows are moved into the array
+    assert a.ctypes.data == t.vector_array_data()
+
+    b = t.vector_array_grid(3, 4)
+    assert b.shape == (3, 4) and b.dtype == np.float64
+    assert b[2, 3] == 23
+    assert t.vector_array_grid(0, 4).shape == (0, 0)
+
+    assert t.vector_array_points_sum(a) == (100, 4950, 2475, -100)
+    assert t.vector_array_grid_shape(np.ones((2, 3), dtype=np.int32)) == [(3, 1), (3, 1)]
+    del a, b
+    collect()
+
+
+def test54_ndarray_copy():
+    def copy_ref(data, order_data):
+        x = [float(v) for v in order_data]
+        return (sum(v * (i % 7) for i, v in enumerate(x)), x[:4])
+
+    n = 300000
+    data = array.array('i', range(n))
+    buf = memoryview(data.tobytes()).cast('i', (3, n // 3))
+
+    # Copy in C order, with and without threads
+    expected = copy_ref(data, data)
+    for threads in (1, 4, 0):
+        assert t.copy_to_vector(buf, 'C', threads) == expected
+
+    # Copy in F order
+    f_order = [data[r * (n // 3) + c] for c in range(n // 3) for r in range(3)]
+    assert t.copy_to_vector(buf, 'F', 4) == copy_ref(data, f_order)
+
+    # Strided input
+    strided = memoryview(data)[::3]
+    assert t.copy_to_vector(strided, 'C', 2) == copy_ref(None, data[::3])
+
+    assert t.copy_to_vector(memoryview(array.array('d')), 'C', 0) == (0, [])
+
+    with pytest.raises(RuntimeError, match='unsupported dtype'):
+        t.copy_to_complex(memoryview(array.array('f', [1, 2, 3, 4])))
+
+
+def test55_align():
+    # Aligned inputs are passed through
+    assert t.aligned_sum(t.aligned_source(0)) == (120, 0, True)
+    assert t.aligned_sum_noconvert(t.aligned_source(0)) == 16
+
+    # Misaligned inputs are copied into aligned storage (if permitted)
+    assert t.aligned_sum(t.aligned_source(1)) == (136, 0, False)
+    with pytest.raises(TypeError, match='incompatible function arguments'):
+        t.aligned_sum_noconvert(t.aligned_source(1))
+
+    buf = memoryview(array.array('f', range(17)).tobytes())[4:].cast('f')
+    assert t.aligned_sum(buf) == (136, 0, False)
+    assert 'align=64' in t.aligned_sum.__doc__
+
+
+def test56_ndarray_chunks():
+    infos = [t.chunk_info(c) for c in t.chunks_count(10, 3, 2, -1)]
+    assert [i[:3] for i in infos] == [(3, 0, -2), (3, 3, -5), (3, 6, -8), (1, 9, -9)]
+
+    # Buffers are recycled once the chunks have been released
+    assert len(set(i[3] for i in infos)) <= 2
+    assert 'collections.abc.Iterator[ndarray[dtype=int32, device=\'cpu\']]' in t.chunks_count.__doc__
+
+    # Holding on to all buffers would cause a deadlock
+    it = t.chunks_count(10, 3, 2, -1)
+    held = [next(it), next(it)]
+    with pytest.raises(RuntimeError, match='all 2 buffers'):
+        next(it)
+    del held
+    collect()
+    assert t.chunk_info(next(it))[:3] == (3, 6, -8)
+    del it
+
+    # Errors raised by the producer are propagated after the preceding chunks
+    it = t.chunks_count(10, 2, 4, 4)
+    assert [t.chunk_info(c)[0] for c in (next(it), next(it))] == [2, 2]
+    with pytest.raises(RuntimeError, match='producer failed'):
+        next(it)
+    with pytest.raises(StopIteration):
+        next(it)
+
+    # Iterators can be discarded before reaching the end of the stream
+    it = t.chunks_count(1000000, 10, 4, -1)
+    next(it)
+    del it
+    collect()
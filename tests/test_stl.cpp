@@ -10,9 +10,14 @@
 #include <nanobind/stl/map.h>
 #include <nanobind/stl/array.h>
 #include <nanobind/stl/unordered_set.h>
+#include <nanobind/stl/unordered_map.h>
 #include <nanobind/stl/set.h>
 #include <nanobind/stl/filesystem.h>
 #include <nanobind/stl/complex.h>
+#include <nanobind/stl/future.h>
+#include <nanobind/callback_queue.h>
+#include <nanobind/sequence_view.h>
+#include <thread>
 
 NB_MAKE_OPAQUE(std::vector<float, std::allocator<float>>)
 
@@ -56,6 +61,8 @@ struct StructWithReadonlyMap {
     std::map<std::string, uint64_t> map;
 };
 
+static int add_five(int x) { return x + 5; }
+
 struct FuncWrapper {
     std::function<void(void)> f;
     static int alive;
@@ -216,6 +223,19 @@ NB_MODULE(test_stl_ext, m) {
                 fail();
     });
 
+    m.def("vec_movable_out_ptr", [](std::vector<Movable *> x) {
+        x.push_back(nullptr);
+        x.push_back(x[0]);
+        return x;
+    }, nb::rv_policy::reference);
+
+    m.def("vec_movable_out_ptr_static", [](bool copy) {
+        static Movable storage[3] { Movable(1), Movable(2), Movable(3) };
+        std::vector<Movable *> result { &storage[0], &storage[1], &storage[0], &storage[2] };
+        return nb::cast(result, copy ? nb::rv_policy::copy
+                                     : nb::rv_policy::reference);
+    });
+
     // ----- test29 ------
     using fvec = std::vector<float, std::allocator<float>>;
     nb::class_<fvec>(m, "float_vec")
@@ -241,6 +261,109 @@ NB_MODULE(test_stl_ext, m) {
         return f;
     });
 
+    m.def("add_five", &add_five);
+    m.def("add_five_guarded", &add_five,
+          nb::call_guard<nb::gil_scoped_release>());
+
+    m.def("function_is_native", [](std::function<int(int)> &f) {
+        using Caster = nb::detail::type_caster<std::function<int(int)>>;
+        return f.target<Caster::pyfunc_wrapper_t>() == nullptr;
+    });
+
+    // Copies of wrapped Python callables don't require the GIL
+    m.def("copy_function_in_threads", [](const std::function<int(int)> &f) {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+            threads.emplace_back([&f] {
+                for (int j = 0; j < 1000; ++j) {
+                    std::function<int(int)> g = f;
+                    (void) g;
+                }
+            });
+        for (std::thread &t : threads)
+            t.join();
+    });
+
+    m.def("release_function_in_thread", [](std::function<void()> f) {
+        std::thread t([g = std::move(f)]() mutable { g = nullptr; });
+        t.join();
+    }, nb::call_guard<nb::gil_scoped_release>());
+
+    m.def("set_gil_profiling", &nb::set_gil_profiling);
+    m.def("gil_profiling_reset", &nb::gil_profiling_reset);
+    m.def("gil_profiling_snapshot", &nb::gil_profiling_snapshot);
+
+    m.def("call_function_in_thread", [](std::function<int(int)> f, int n) {
+        int result = 0;
+        std::thread t([&] {
+            for (int i = 0; i < n; ++i)
+                result += f(i);
+            nb::gil_scoped_acquire guard;
+        });
+        t.join();
+        return result;
+    }, nb::call_guard<nb::gil_scoped_release>());
+
+    m.def("decref_in_thread", [](nb::object o) {
+        PyObject *p = o.release().ptr();
+        nb::gil_scoped_release release;
+        std::thread t([p] { nb::decref_deferred(p); });
+        t.join();
+    });
+
+    m.def("callback_queue_threads", [](nb::handle handler, bool batch,
+                                       bool flush, int n_threads) {
+        nb::callback_queue<int, std::string> q(handler, batch);
+        {
+            nb::gil_scoped_release release;
+            std::vector<std::thread> threads;
+            for (int i = 0; i < n_threads; ++i)
+                threads.emplace_back([&q, i] {
+                    for (int j = 0; j < 100; ++j)
+                        q.push(i * 100 + j, std::to_string(j));
+                });
+            for (auto &t : threads)
+                t.join();
+        }
+        return flush ? q.flush() : q.size();
+    });
+
+    m.def("sequence_view_get", [](nb::sequence_view<int> v, size_t i) {
+        return nb::make_tuple(v.size(), v[i]);
+    });
+    m.def("sequence_view_sum", [](const nb::sequence_view<double> &v) {
+        double sum = 0;
+        for (double d : v)
+            sum += d;
+        return sum;
+    });
+    m.def("sequence_view_movable", [](nb::sequence_view<Movable *> v) {
+        int sum = 0;
+        for (Movable *m : v)
+            sum += m->value;
+        return sum;
+    });
+    m.def("sequence_view_strings", [](nb::sequence_view<std::string> v) {
+        std::string result;
+        for (size_t i = 0; i < v.size(); ++i)
+            result += v[i];
+        return result;
+    });
+    m.def("sequence_view_ret", [](nb::sequence_view<int> v) { return v; });
+
+    // test82_pair_tuple_direct
+    m.def("pair_return_movable_vectors", []() {
+        std::pair<std::vector<Movable>, std::vector<Movable>> p;
+        p.first.emplace_back(1);
+        p.second.reserve(2);
+        p.second.emplace_back(2);
+        p.second.emplace_back(3);
+        return p;
+    });
+    m.def("tuple_sum", [](const std::tuple<int, double, Movable *> &v) {
+        return std::get<0>(v) + std::get<1>(v) + std::get<2>(v)->value;
+    });
+
     m.def("identity_list", [](std::list<int> &x) { return x; });
 
     PyType_Slot slots[] = {
@@ -256,6 +379,7 @@ NB_MODULE(test_stl_ext, m) {
     // ----- test35 ------
     m.def("identity_string", [](std::string& x) { return x; });
     m.def("identity_string_view", [](std::string_view& x) { return x; });
+    m.def("string_view_ptr", [](std::string_view x) { return (uintptr_t) x.data(); });
 
     // ----- test36-test42 ------
     m.def("optional_copyable", [](std::optional<Copyable> &) {}, nb::arg("x").none());
@@ -277,6 +401,10 @@ NB_MODULE(test_stl_ext, m) {
     m.def("variant_ret_var_none", []() { return std::variant<std::monostate, Copyable, int>(); });
     m.def("variant_unbound_type", [](std::variant<std::monostate, nb::list, nb::tuple, int> &x) { return x; },
           nb::arg("x") = nb::none());
+    m.def("variant_double_int", [](std::variant<double, int> x) -> nb::object {
+        return nb::make_tuple(x.index(), x);
+    });
+    m.def("variant_double_str", [](std::variant<double, std::string> x) { return x; });
 
     // ----- test50-test57 ------
     m.def("map_return_movable_value", [](){
@@ -422,6 +550,7 @@ NB_MODULE(test_stl_ext, m) {
         return p.replace_extension(ext);
     });
     m.def("parent_path", [](const std::filesystem::path &p) { return p.parent_path(); });
+    m.def("parent_path_str", [](const nb::path_str &p) -> nb::path_str { return p.parent_path(); });
 #endif
 
     struct ClassWithMovableField {
@@ -459,4 +588,57 @@ NB_MODULE(test_stl_ext, m) {
     m.def("vector_str", [](std::string& x){
         return x;
     });
+
+    // test72 std::future
+    m.def("future_int", [](int i) {
+        return std::async(std::launch::async, [i] { return i * 2; });
+    });
+    m.def("future_string", []() {
+        return std::async(std::launch::deferred, [] { return std::string("hello"); });
+    });
+    m.def("future_movable", [](int i) {
+        return std::async(std::launch::async, [i] { return Movable(i); });
+    });
+    m.def("future_void", []() { return std::async(std::launch::async, [] { }); });
+    m.def("future_fail", []() {
+        return std::async(std::launch::async, []() -> int {
+            throw std::invalid_argument("future failed");
+        });
+    });
+    m.def("future_invalid", []() { return std::future<int>(); });
+
+    // test77 streaming conversion of iterables
+    m.def("unordered_set_int_in", [](const std::unordered_set<int> &x) {
+        return std::set<int>(x.begin(), x.end());
+    });
+    m.def("unordered_map_int_in",
+          [](const std::unordered_map<std::string, int> &x) {
+              return std::map<std::string, int>(x.begin(), x.end());
+          });
+
+    // test78 implicit conversions of many list entries (and nested calls
+    // doing the same) grow the cleanup list
+    struct ImplicitInt { int value; };
+    nb::class_<ImplicitInt>(m, "ImplicitInt")
+        .def(nb::init<int>())
+        .def(nb::init_implicit<int>());
+    m.def("implicit_int_sum", [](const std::vector<ImplicitInt> &v,
+                                 nb::handle cb) {
+        int result = 0;
+        for (const ImplicitInt &i : v)
+            result += i.value;
+        if (!cb.is_none())
+            result += nb::cast<int>(cb());
+        return result;
+    }, nb::arg("v"), nb::arg("cb") = nb::none());
+
+    // test73 bulk loading of buffers
+    m.def("vec_double_in", [](const std::vector<double> &x) { return x; });
+    m.def("vec_double_in_noconvert", [](const std::vector<double> &x) { return x; },
+          nb::arg("x").noconvert());
+    m.def("vec_u8_in", [](const std::vector<uint8_t> &x) { return x; });
+    m.def("vec_int_in", [](const std::vector<int> &x) { return x; });
+    m.def("array_bool_in", [](const std::array<bool, 3> &x) {
+        return (int) x[0] + 2 * (int) x[1] + 4 * (int) x[2];
+    });
 }
@@ -1,6 +1,8 @@
 import test_stl_ext as t
 import pytest
 import sys
+import time
+import weakref
 from common import collect, skip_on_pypy
 
 @pytest.fixture
@@ -325,6 +327,16 @@ def test30_std_function():
     f2()
     assert l == [1]
 
+    # Functions bound by nanobind are called directly from C++
+    assert t.call_function(t.add_five, 3) == 8
+    assert t.function_is_native(t.add_five)
+    assert t.function_is_native(t.return_function())
+    assert not t.function_is_native(lambda x: x + 5)
+
+    # .. unless an annotation requires the nanobind dispatcher
+    assert t.call_function(t.add_five_guarded, 3) == 8
+    assert not t.function_is_native(t.add_five_guarded)
+
 
 def test31_std_function_roundtrip():
     def f():
@@ -387,6 +399,17 @@ def test35_string_and_string_view():
     assert t.identity_string_view("البرتقالي") == "البرتقالي"
     assert t.identity_string_view("🍊") == "🍊"
 
+    # Byte strings and buffers are referenced without a copy
+    import ctypes
+    assert t.identity_string_view(b"orange") == "orange"
+    assert t.identity_string_view(bytearray(b"\xe6\xa9\x98")) == "橘"
+    ba = bytearray(b"orange")
+    addr = ctypes.addressof((ctypes.c_char * 6).from_buffer(ba))
+    assert t.string_view_ptr(ba) == addr
+    assert t.string_view_ptr(memoryview(ba)[2:]) == addr + 2
+    with pytest.raises(TypeError):
+        t.identity_string_view(1)
+
 
 def test36_std_optional_copyable(clean):
     t.optional_copyable(t.Copyable())
@@ -528,6 +551,13 @@ def test49_std_variant_unbound_type():
         " -> Union[None, list, tuple, int]"
     )
 
+    # Exact matches take precedence over implicit conversions
+    assert t.variant_double_int(5) == (1, 5)
+    assert t.variant_double_int(5.5) == (0, 5.5)
+    assert t.variant_double_str(5) == 5.0
+    assert type(t.variant_double_str(5)) is float
+    assert t.variant_double_str("5") == "5"
+
 def test50_map_return_movable_value():
     for i, (k, v) in enumerate(sorted(t.map_return_movable_value().items())):
         assert k == chr(ord("a") + i)
@@ -758,6 +788,13 @@ def test66_replace_extension():
     assert t.parent_path(b"foo/bar") == Path("foo")
     assert t.parent_path(PseudoStrPath()) == Path("foo")
     assert t.parent_path(PseudoBytesPath()) == Path("foo")
+    assert t.parent_path(Path("foo/bar")) is not t.parent_path(Path("foo/bar"))
+
+    # nb::path_str returns a plain 'str'
+    assert t.parent_path_str(Path("foo/bar")) == "foo"
+    assert type(t.parent_path_str("foo/bar")) is str
+    assert t.parent_path_str(PseudoBytesPath()) == "foo"
+    assert t.parent_path_str.__doc__ == "parent_path_str(arg: str, /) -> str"
 
 def test67_vector_bool():
     bool_vector = [True, False, True, False]
@@ -836,3 +873,285 @@ def test71_null_input():
         t.vec_movable_in_value([None])
     with pytest.raises(TypeError):
         t.map_copyable_in_value({'a': None})
+
+def test72_future():
+    import asyncio
+
+    async def run():
+        assert await t.future_int(21) == 42
+        assert await t.future_string() == "hello"
+        assert (await t.future_movable(3)).value == 3
+        assert await t.future_void() is None
+
+        # Many completions that are batched into a few event loop callbacks
+        assert await asyncio.gather(*[t.future_int(i) for i in range(100)]) == \
+            [i * 2 for i in range(100)]
+
+        with pytest.raises(ValueError, match='future failed'):
+            await t.future_fail()
+
+        with pytest.raises(RuntimeError, match='no shared state'):
+            t.future_invalid()
+
+    asyncio.run(run())
+
+    with pytest.raises(RuntimeError, match='no running event loop'):
+        t.future_int(1)
+
+    assert 'Awaitable[int]' in t.future_int.__doc__
+
+
+def test73_buffer_bulk_load():
+    from array import array
+
+    x = array('d', [1.5, -2.0, 3.25])
+    assert t.vec_double_in(x) == [1.5, -2.0, 3.25]
+    assert t.vec_double_in(array('f', [1.5, 2.5])) == [1.5, 2.5]
+    assert t.vec_double_in(memoryview(x)[::2]) == [1.5, 3.25]
+    assert t.vec_double_in(array('d')) == []
+
+    # Integers are only turned into floats when implicit conversions are enabled
+    assert t.vec_double_in(array('i', [1, 2])) == [1.0, 2.0]
+    with pytest.raises(TypeError):
+        t.vec_double_in_noconvert(array('i', [1, 2]))
+    assert t.vec_double_in_noconvert(x) == [1.5, -2.0, 3.25]
+
+    # Integer conversions are checked for overflow, floats are rejected
+    assert t.vec_int_in(array('q', [1, -2, 3])) == [1, -2, 3]
+    assert t.vec_int_in(array('B', [255])) == [255]
+    with pytest.raises(TypeError):
+        t.vec_int_in(array('q', [1 << 40]))
+    with pytest.raises(TypeError):
+        t.vec_int_in(array('d', [1.0]))
+    with pytest.raises(TypeError):
+        t.vec_u8_in(array('b', [-1]))
+
+    # Byte-like buffers are not strings
+    assert t.vec_u8_in(bytearray(b'\x01\x02')) == [1, 2]
+    with pytest.raises(TypeError):
+        t.vec_u8_in(b'\x01\x02')
+
+    # 2D buffers are not flattened
+    with pytest.raises(TypeError):
+        t.vec_double_in(memoryview(x).cast('B').cast('d', (1, 3)))
+
+    assert t.array_bool_in(memoryview(bytes([1, 0, 1])).cast('?')) == 5
+    with pytest.raises(TypeError):
+        t.array_bool_in(memoryview(bytes([1, 0])).cast('?'))
+    assert t.array_in(array('i', [1, 2, 3])) == 6
+
+
+def test74_std_function_threads():
+    def f(x):
+        return x
+
+    # Copying the callable on threads that don't hold the GIL must not deadlock
+    t.copy_function_in_threads(f)
+    if hasattr(sys, "getrefcount"):
+        assert sys.getrefcount(f) == 2
+
+    # The last copy can be released on another thread
+    class Callback:
+        def __call__(self):
+            pass
+
+    c = Callback()
+    r = weakref.ref(c)
+    t.release_function_in_thread(c)
+    del c
+    for _ in range(1000):
+        if r() is None:
+            break
+        time.sleep(0.001)
+    assert r() is None
+
+
+def test75_deferred_decref():
+    class A:
+        pass
+
+    a = A()
+    r = weakref.ref(a)
+    t.decref_in_thread(a)
+    del a
+
+    # Releases queued by other threads are processed at the next call
+    t.identity_string("")
+    assert r() is None
+
+
+def test76_callback_queue():
+    for batch in (False, True):
+        events = []
+
+        if batch:
+            def handler(batch):
+                assert isinstance(batch, list)
+                events.extend(batch)
+        else:
+            def handler(i, s):
+                events.append((i, s))
+
+        # Explicit flush
+        assert t.callback_queue_threads(handler, batch, True, 4) == 400
+        assert sorted(events) == [(i, str(i % 100)) for i in range(400)]
+
+        # Automatic flush once the interpreter gets around to it
+        events.clear()
+        t.callback_queue_threads(handler, batch, False, 4)
+        for _ in range(1000):
+            if len(events) == 400:
+                break
+            t.identity_string("")
+            time.sleep(0.001)
+        assert sorted(events) == [(i, str(i % 100)) for i in range(400)]
+
+
+def test77_stream_iterables():
+    from collections import deque
+
+    # Sequences other than list/tuple are consumed in chunks
+    assert t.vec_int_in(range(100)) == list(range(100))
+    assert t.vec_int_in(range(0)) == []
+    assert t.vec_int_in(deque([1, 2, 3])) == [1, 2, 3]
+    assert t.vector_str(deque(["a", "b"])) == ["a", "b"]
+    with pytest.raises(TypeError):
+        t.vec_int_in(range(2**62, 2**62 + 2))
+
+    class Seq:
+        def __len__(self):
+            return 40
+        def __getitem__(self, i):
+            if i == 35:
+                raise RuntimeError("failure")
+            return i
+
+    with pytest.raises(TypeError):
+        t.vec_int_in(Seq())
+
+    # Generators are still rejected by the list caster
+    with pytest.raises(TypeError):
+        t.vec_int_in(i for i in range(3))
+
+    # The set caster accepts arbitrary iterables
+    assert t.unordered_set_int_in(i % 50 for i in range(1000)) == set(range(50))
+    assert t.unordered_set_int_in(range(70)) == set(range(70))
+    with pytest.raises(TypeError):
+        t.unordered_set_int_in(5)
+    with pytest.raises(TypeError):
+        t.unordered_set_int_in([1, None])
+
+    class Key(str):
+        __slots__ = ()
+
+    d = {f"k{i}": i for i in range(100)}
+    assert t.unordered_map_int_in(d) == d
+    assert t.unordered_map_int_in({Key("a"): 1}) == {"a": 1}
+    with pytest.raises(TypeError):
+        t.unordered_map_int_in({"a": "b"})
+
+    from types import MappingProxyType
+    assert t.unordered_map_int_in(MappingProxyType(d)) == d
+
+
+def test78_cleanup_list_growth():
+    v = list(range(100))
+    inner = lambda: t.implicit_int_sum(v * 50)
+    for _ in range(3):
+        assert t.implicit_int_sum(v) == 4950
+        assert t.implicit_int_sum(v, inner) == 51 * 4950
+        assert t.implicit_int_sum(v, lambda: t.implicit_int_sum([1, 2])) == 4953
+    with pytest.raises(TypeError):
+        t.implicit_int_sum(v, lambda: t.implicit_int_sum(v + ["x"]))
+    assert t.implicit_int_sum(v + [t.ImplicitInt(5)]) == 4955
+
+
+def test79_gil_profiling():
+    t.set_gil_profiling(True)
+    try:
+        t.gil_profiling_reset()
+        assert t.call_function_in_thread(lambda i: i * 2, 5) == 20
+        snapshot = t.gil_profiling_snapshot()
+    finally:
+        t.set_gil_profiling(False)
+
+    callback = snapshot['callback']
+    assert callback['acquisitions'] == 5
+    assert sum(callback['wait_histogram']) == 5
+    assert len(callback['wait_histogram']) == 32
+    assert callback['wait_time'] >= 0 and callback['hold_time'] > 0
+    assert snapshot['gil_scoped_acquire']['acquisitions'] == 1
+    assert 'trampoline' not in snapshot
+
+    # Disabling the profiler keeps the counters, but stops their growth
+    t.call_function_in_thread(lambda i: i, 3)
+    assert t.gil_profiling_snapshot() == snapshot
+    t.gil_profiling_reset()
+    assert t.gil_profiling_snapshot() == {}
+
+
+def test80_vec_movable_out_ptr(clean):
+    a, b = t.Movable(1), t.Movable(2)
+    r = t.vec_movable_out_ptr([a, b])
+    assert r[0] is a and r[1] is b and r[2] is None and r[3] is a
+
+    # New wrappers are created once per pointer
+    r = t.vec_movable_out_ptr_static(False)
+    assert [m.value for m in r] == [1, 2, 1, 3]
+    assert r[0] is r[2]
+    del r
+
+    r = t.vec_movable_out_ptr_static(True)
+    assert [m.value for m in r] == [1, 2, 1, 3]
+    assert r[0] is not r[2]
+    del r
+    assert_stats(value_constructed=5, copy_constructed=4, destructed=4)
+
+
+def test81_sequence_view():
+    # Only the accessed element is converted
+    big = [0] * 100000 + ['not an int']
+    assert t.sequence_view_get(big, 5) == (100001, 0)
+    with pytest.raises(TypeError, match='could not convert element 100000'):
+        t.sequence_view_get(big, 100000)
+    with pytest.raises(IndexError):
+        t.sequence_view_get(big, 100001)
+
+    assert t.sequence_view_get((1, 2, 3), 2) == (3, 3)
+    assert t.sequence_view_get(range(10), 9) == (10, 9)
+    assert t.sequence_view_sum([1, 2.5, 3]) == 6.5
+    assert t.sequence_view_sum([]) == 0
+    with pytest.raises(TypeError, match='could not convert'):
+        t.sequence_view_sum([1, None])
+
+    assert t.sequence_view_movable([t.Movable(1), t.Movable(2)]) == 3
+    assert t.sequence_view_strings(['a', 'b', 'c']) == 'abc'
+
+    # Strings and non-sequences are not accepted
+    for v in ('abc', b'abc', 5, None):
+        with pytest.raises(TypeError, match='incompatible function arguments'):
+            t.sequence_view_get(v, 0)
+
+    x = [1, 2]
+    assert t.sequence_view_ret(x) is x
+    assert 'sequence_view_get(arg0: collections.abc.Sequence[int], arg1: int, /)' in t.sequence_view_get.__doc__
+
+
+def test82_pair_tuple_direct(clean):
+    # Elements of returned temporaries are moved rather than copied
+    a, b = t.pair_return_movable_vectors()
+    assert [v.value for v in a] == [1] and [v.value for v in b] == [2, 3]
+    del a, b
+    assert_stats(
+        value_constructed=3,
+        move_constructed=3,
+        destructed=6)
+
+    m = t.Movable(3)
+    assert t.tuple_sum((1, 2.5, m)) == 6.5
+    assert t.tuple_sum([1, 2.5, m]) == 6.5
+    with pytest.raises(TypeError):
+        t.tuple_sum((1, 2.5))
+    with pytest.raises(TypeError):
+        t.tuple_sum({1, 2.5, m})
+    assert t.swap_pair([1, 2.5]) == (2.5, 1)
@@ -37,19 +37,20 @@ def test_map_string_double(capfd):
     assert len(mm2) == 0
     assert repr(mm) == "test_bind_map_ext.MapStringDouble({'a': 1.0, 'b': 2.5})"
 
+    # Dictionaries are converted directly, and failures leave the map unchanged
     with pytest.raises(TypeError):
-        mm2.update({"a" : "b"})
-    captured = capfd.readouterr().err.strip()
-    ref = "nanobind: implicit conversion from type 'dict' to type 'test_bind_map_ext.MapStringDouble' failed!"
-
-    # Work around Pytest-related flakiness (https://github.com/pytest-dev/pytest/issues/10843)
-    if platform.system() == 'Windows':
-        assert captured == ref or captured == ''
-    else:
-        assert captured == ref
+        mm2.update({"c" : 1.0, "a" : "b"})
+    assert capfd.readouterr().err.strip() == ''
+    assert len(mm2) == 0
 
     mm2.update({"a" : 2.5})
     assert len(mm2) == 1
+    mm2.update({"a" : 3, "b" : 4})
+    assert dict(mm2.items()) == {"a" : 3.0, "b" : 4.0}
+
+    um = t.UnorderedMapStringDouble({"x" : 1.0})
+    um.update({str(i) : i for i in range(100)})
+    assert len(um) == 101 and um["42"] == 42.0
 
     # Construction from an iterable
     mm3 = t.MapStringDouble(
@@ -6,6 +6,7 @@ namespace nb = nanobind;
 
 NB_MODULE(test_bind_vector_ext, m) {
     nb::bind_vector<std::vector<unsigned int>>(m, "VectorInt");
+    nb::bind_vector<std::vector<double>>(m, "VectorDouble");
     nb::bind_vector<std::vector<bool>>(m, "VectorBool");
 
     // Ensure that a repeated binding call is ignored
@@ -44,4 +45,35 @@ NB_MODULE(test_bind_vector_ext, m) {
             result.emplace_back(i);
         return result;
     });
+
+    // test_vector_struct_buffer
+    struct Vec2 { float x, y; };
+    struct Particle {
+        Vec2 pos;
+        double mass;
+        uint8_t flags;
+        int32_t hidden;
+    };
+    struct Opaque { int value; };
+
+    nb::class_<Vec2>(m, "Vec2")
+        .def(nb::init<>())
+        .def_rw("x", &Vec2::x)
+        .def_rw("y", &Vec2::y);
+    nb::class_<Particle>(m, "Particle")
+        .def(nb::init<>())
+        .def_rw("pos", &Particle::pos)
+        .def_rw("mass", &Particle::mass)
+        .def_rw("flags", &Particle::flags);
+    nb::class_<Opaque>(m, "Opaque").def(nb::init<>());
+
+    nb::bind_vector<std::vector<Particle>>(m, "VectorParticle");
+    nb::bind_vector<std::vector<Opaque>>(m, "VectorOpaque");
+
+    m.def("dlpack_sum", [](nb::ndarray<const double, nb::ndim<1>, nb::device::cpu> a) {
+        double sum = 0;
+        for (size_t i = 0; i < a.shape(0); ++i)
+            sum += a(i);
+        return sum;
+    });
 }
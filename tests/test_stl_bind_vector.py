@@ -41,17 +41,10 @@ def test01_vector_int(capfd):
     assert v_int2 == t.VectorInt([0, 99, 2, 3, 4, 5, 6, 7])
 
     # test error handling, and that the vector is unchanged
+    # (elements are converted directly, without an implicit conversion)
     with pytest.raises(TypeError):
         v_int2.extend([8, "a"])
-
-    captured = capfd.readouterr().err.strip()
-    ref = "nanobind: implicit conversion from type 'list' to type 'test_bind_vector_ext.VectorInt' failed!"
-
-    # Work around Pytest-related flakiness (https://github.com/pytest-dev/pytest/issues/10843)
-    if platform.system() == 'Windows':
-        assert captured == ref or captured == ''
-    else:
-        assert captured == ref
+    assert capfd.readouterr().err.strip() == ''
 
     assert v_int2 == t.VectorInt([0, 99, 2, 3, 4, 5, 6, 7])
 
@@ -145,3 +138,104 @@ def test05_vector_slicing():
     check_del(slice(200, 10, 1))
     check_del(slice(200, 10, -1))
     check_del(slice(200, 10, -3))
+
+
+def test06_vector_buffer():
+    v = t.VectorDouble([1.0, 2.0, 3.0])
+    m = memoryview(v)
+    assert m.format == 'd' and m.shape == (3,) and not m.readonly
+    assert m.tolist() == [1.0, 2.0, 3.0]
+
+    # The view refers to the vector storage and keeps the vector alive
+    m[1] = 5.0
+    assert v[1] == 5.0
+    del v
+    assert m.tolist() == [1.0, 5.0, 3.0]
+    m.release()
+
+    u = t.VectorInt([1, 2])
+    assert memoryview(u).format == 'I'
+    with pytest.raises(TypeError):
+        memoryview(t.VectorBool([True]))
+    assert memoryview(t.VectorEl()).format == 'T{i:a:}'
+
+    # DLPack export
+    v = t.VectorDouble([1.0, 2.0, 3.0])
+    assert v.__dlpack_device__() == (1, 0)
+    assert t.dlpack_sum(v) == 6.0
+    assert not hasattr(t.VectorEl(), '__dlpack__')
+
+    try:
+        import numpy as np
+    except ImportError:
+        return
+    a = np.asarray(v)
+    a[0] = 10
+    assert v[0] == 10
+    assert np.all(np.from_dlpack(v) == [10, 2, 3])
+
+
+def test07_vector_bulk():
+    import array
+
+    # Extend from a buffer in a single operation, with dtype conversion
+    v = t.VectorDouble([1.0])
+    v.extend(array.array('d', [2.0, 3.0]))
+    v.extend(array.array('i', [4, 5]))
+    assert list(v) == [1.0, 2.0, 3.0, 4.0, 5.0]
+    assert list(t.VectorDouble(array.array('f', [1.5, 2.5]))) == [1.5, 2.5]
+
+    # Failed buffer conversions leave the vector unchanged
+    u = t.VectorInt([1])
+    with pytest.raises(TypeError):
+        u.extend(array.array('i', [2, -3]))
+    assert list(u) == [1]
+    u.extend(array.array('i', [2, 3]))
+    u.extend(u)
+    assert list(u) == [1, 2, 3, 1, 2, 3]
+
+    # Slices with unit stride are copied as ranges
+    assert list(u[1:4]) == [2, 3, 1]
+    u[1:3] = t.VectorInt([7, 8])
+    assert list(u) == [1, 7, 8, 1, 2, 3]
+    u[:] = u
+    assert list(u) == [1, 7, 8, 1, 2, 3]
+
+
+def test08_vector_struct_buffer():
+    import struct
+
+    v = t.VectorParticle()
+    for i in range(3):
+        p = t.Particle()
+        p.pos.x, p.pos.y = i, 2 * i
+        p.mass, p.flags = 0.5 * i, i + 1
+        v.append(p)
+
+    # The fields follow the def_rw() bindings, others become padding
+    m = memoryview(v)
+    assert m.format == 'T{T{f:x:f:y:}:pos:d:mass:B:flags:7x}'
+    assert m.itemsize == 24 and m.shape == (3,) and m.nbytes == 72
+    assert not m.readonly
+
+    # The view refers to the vector storage
+    b = m.cast('B')
+    assert struct.unpack_from('=ffdB', b, 48) == (2.0, 4.0, 1.0, 3)
+    struct.pack_into('=d', b, 32, 10.0)
+    assert v[1].mass == 10.0
+    b.release()
+    m.release()
+
+    assert not hasattr(v, '__dlpack__')
+    with pytest.raises(BufferError):
+        memoryview(t.VectorOpaque())
+
+    try:
+        import numpy as np
+    except ImportError:
+        return
+    a = np.asarray(v)
+    assert a.dtype.names == ('pos', 'mass', 'flags')
+    assert np.all(a['pos']['y'] == [0, 2, 4])
+    a['mass'][0] = 2.5
+    assert v[0].mass == 2.5